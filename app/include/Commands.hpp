@@ -31,8 +31,10 @@ class Commands {
         /**
          * @brief Opens a JSON file
          * @param filename Name of the file to open
+         * @param isLazy Whether arrays and objects are only parsed when first used
+         * @param threadCount Number of threads parsing an eager document, 0 to use one per hardware thread
          */
-        void open(const std::string& filename);
+        void open(const std::string& filename, const bool isLazy, const size_t threadCount);
 
         /**
          * @brief Closes the currently opened file
@@ -111,6 +113,11 @@ class Commands {
          */
         Json* json = nullptr;
 
+        /**
+         * @brief Writer of saved files, whose buffer is kept from one save to the next
+         */
+        JsonFileWriter fileWriter;
+
         /**
          * @brief Helper function to delete JSON payload
          */
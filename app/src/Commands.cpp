@@ -1,7 +1,131 @@
+#include <cstdio>
+#include <cstdlib>
 #include <iostream>
 #include <fstream>
-#include <sstream>
 #include "Commands.hpp"
+#include "JsonFile.hpp"
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define COMMANDS_POSIX
+#endif
+
+/**
+ * @brief Anonymous namespace for writing files a document may still refer to
+ */
+namespace {
+    /**
+     * @brief Checks whether two names refer to the same file by device and inode
+     * @param first Name of the first file
+     * @param second Name of the second file
+     * @return True if both names refer to the same existing file, false otherwise
+     */
+    bool isSameFile(const std::string& first, const std::string& second) {
+#ifdef COMMANDS_POSIX
+        struct stat firstStatus;
+        struct stat secondStatus;
+
+        return stat(first.c_str(), &firstStatus) == 0 && stat(second.c_str(), &secondStatus) == 0 &&
+            firstStatus.st_dev == secondStatus.st_dev && firstStatus.st_ino == secondStatus.st_ino;
+#else
+        return first == second;
+#endif
+    }
+
+    /**
+     * @brief Resolves the file a name refers to, following symbolic links
+     * @param filename Name of the file
+     * @return Canonical name of the file, or the given name if it does not exist yet
+     */
+    std::string resolveFile(const std::string& filename) {
+#ifdef COMMANDS_POSIX
+        char* resolved = realpath(filename.c_str(), nullptr);
+
+        if(resolved != nullptr) {
+            const std::string result(resolved);
+            std::free(resolved);
+            return result;
+        }
+#endif
+
+        return filename;
+    }
+
+    /**
+     * @brief Syncs the directory holding a file, ignoring failures
+     * @param filename Name of the file
+     */
+    void syncDirectory(const std::string& filename) {
+#ifdef COMMANDS_POSIX
+        const size_t slash = filename.rfind('/');
+        const std::string directory = slash == std::string::npos ? "." : slash == 0 ? "/" : filename.substr(0, slash);
+        const int descriptor = ::open(directory.c_str(), O_RDONLY);
+
+        if(descriptor >= 0) {
+            ::fsync(descriptor);
+            ::close(descriptor);
+        }
+#endif
+    }
+
+    /**
+     * @brief Replaces the content of a file through a synced temporary file renamed over it
+     * @param filename Name of the file to replace or create, symbolic links are followed
+     * @param writer Writer to stream the document through
+     * @param json Document to write
+     * @param path Optional path within the document to write specific part
+     * @return True if the file was replaced, false if it could not be written
+     * @throws std::runtime_error if the path does not exist in the document, after removing the temporary file
+     */
+    bool replaceFile(const std::string& filename, JsonFileWriter& writer, Json& json, const std::string& path) {
+        const std::string target = resolveFile(filename);
+        std::string temporaryName = target;
+
+        if(!writer.openTemporary(temporaryName)) {
+            return false;
+        }
+
+#ifdef COMMANDS_POSIX
+        struct stat status;
+        mode_t mode;
+
+        if(stat(target.c_str(), &status) == 0) {
+            mode = status.st_mode & 07777;
+        }
+        else {
+            mode = umask(0);
+            umask(mode);
+            mode = 0666 & ~mode;
+        }
+
+        if(chmod(temporaryName.c_str(), mode) != 0) {
+            writer.close();
+            std::remove(temporaryName.c_str());
+            return false;
+        }
+#endif
+
+        try {
+            json.save(writer, path);
+        } catch(...) {
+            writer.close();
+            std::remove(temporaryName.c_str());
+            throw;
+        }
+
+        if(!writer.sync() || !writer.close() || std::rename(temporaryName.c_str(), target.c_str()) != 0) {
+            writer.close();
+            std::remove(temporaryName.c_str());
+            return false;
+        }
+
+        syncDirectory(target);
+
+        return true;
+    }
+}
 
 /**
  * @brief Destructor for Commands class, cleans up json pointer
@@ -16,28 +140,34 @@ Commands::~Commands() {
 /**
  * @brief Opens a JSON file for processing
  * @param filename Path to the file to be opened
+ * @param isLazy Whether arrays and objects are only parsed when first used, so errors in them are only reported then
+ * @param threadCount Number of threads parsing an eager document, 0 to use one per hardware thread
  */
-void Commands::open(const std::string& filename) {
+void Commands::open(const std::string& filename, const bool isLazy, const size_t threadCount) {
 
     if(fileName != "") {
         std::cout<<"File is already opened!\n";
     }
 
-    std::ifstream inputStream(filename, std::ios::in);
+    JsonFile file;
+
+    if(!file.open(filename)) {
+        if(std::ifstream(filename).is_open()) {
+            std::cout<<"Could not read file "<<filename<<".\n";
+            return;
+        }
 
-    if(!inputStream.is_open()) {
         std::ofstream outputStream(filename, std::ios::out);
 
         outputStream << "{}";
 
         std::cout<<"There is no file " <<filename<<".\nSuccessfully created "<< filename<<'\n';
 
-        inputStream.close();
         return;
     }
 
     try {
-        json = new Json(inputStream);
+        json = new Json(file, isLazy, threadCount);
         fileName = filename;
         std::cout<<"Successfully opened file " << filename << "!\n";
     }catch(std::runtime_error err) {
@@ -47,8 +177,6 @@ void Commands::open(const std::string& filename) {
         }
         std::cout<<err.what()<<'\n';
     }
-
-    inputStream.close();
 }
 
 /**
@@ -78,15 +206,10 @@ void Commands::save(const std::string& path) {
     }
 
     try {
-        std::ostringstream outputStream;
-
-        json->save(outputStream, path);
-
-        std::ofstream fileStream(fileName, std::ios::trunc);
-
-        fileStream << outputStream.str();
-
-        fileStream.close();
+        if(!replaceFile(fileName, fileWriter, *json, path)) {
+            std::cout<<"Couldn't save file "<<fileName <<"!\n";
+            return;
+        }
 
         std::cout<<"Successfuly saved changes in file "<<fileName <<"!\n";
     }catch(std::runtime_error err) {
@@ -106,20 +229,15 @@ void Commands::saveAs(const std::string& filename, const std::string& path) {
     }
 
     try {
-        std::ofstream fileStream(filename, std::ios::out);
-
-        if(!fileStream.is_open()) {
-            std::cout<<"Couldn't open file "<<filename <<"!\n";
+        if(isSameFile(filename, fileName)) {
+            save(path);
             return;
         }
 
-        std::ostringstream outputStream;
-
-        json->save(outputStream, path);
-
-        fileStream << outputStream.str();
-
-        fileStream.close();
+        if(!replaceFile(filename, fileWriter, *json, path)) {
+            std::cout<<"Couldn't save file "<<filename <<"!\n";
+            return;
+        }
 
         std::cout<<"Successfuly saved another file "<<fileName <<"!\n";
     }catch(std::runtime_error err) {
@@ -133,7 +251,8 @@ void Commands::saveAs(const std::string& filename, const std::string& path) {
 void Commands::help() {
     const std::string options = 
     "The following commands are supported:\n"
-    "open <file>                opens file\n"
+    "open <file> [lazy]         opens file; with lazy, arrays and objects are parsed when first used\n"
+    "open <file> parallel       opens file, parsing it on all hardware threads\n"
     "close                      closes currently opened file\n"
     "help                       prints list with available commands\n"
     "print                      prints current json\n"
@@ -160,7 +279,11 @@ void Commands::print() {
         return;
     }
 
-    json->print(std::cout);
+    try {
+        json->print(std::cout);
+    }catch(std::runtime_error err) {
+        std::cout<<err.what()<<'\n';
+    }
 }
 
 /**
@@ -172,7 +295,11 @@ void Commands::prettyPrint() {
         return;
     }
 
-    json->prettyPrint(std::cout);
+    try {
+        json->prettyPrint(std::cout);
+    }catch(std::runtime_error err) {
+        std::cout<<err.what()<<'\n';
+    }
 }
 
 /**
@@ -89,12 +89,15 @@ void performCommand(Commands& cmds, const std::vector<std::string>& args, bool&
     switch (cmd)
     {
         case Command::Open : {
-            if(args.size() != 2) {
+            if(args.size() != 2 && (args.size() != 3 || (args[2] != "lazy" && args[2] != "parallel"))) {
                 std::cout<<"Invalid number of arguments!\n";
                 break;
             }
 
-            cmds.open(args[1]);
+            const bool isLazy = args.size() == 3 && args[2] == "lazy";
+            const bool isParallel = args.size() == 3 && args[2] == "parallel";
+
+            cmds.open(args[1], isLazy, isParallel ? 0 : 1);
             break;
         }
         case Command::Close : {
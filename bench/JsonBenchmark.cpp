@@ -0,0 +1,162 @@
+#include <chrono>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <iterator>
+#include <sstream>
+#include <string>
+#include "JsonArena.hpp"
+#include "JsonParser.hpp"
+#include "JsonParallelParser.hpp"
+#include "JsonValidator.hpp"
+#include "JsonPrinter.hpp"
+
+/**
+ * @brief Anonymous namespace for the generated documents and the timing helper
+ */
+namespace {
+    /**
+     * @brief Number of times every step is run, the fastest run is reported
+     */
+    const size_t Repetitions = 3;
+
+    /**
+     * @brief Builds a flat array of numbers, strings and literals
+     * @param count Number of elements
+     * @return Generated document
+     */
+    std::string makeFlatArray(const size_t count) {
+        std::string document = "[";
+
+        for(size_t i = 0; i < count; i++) {
+            switch(i % 4) {
+                case 0: document += std::to_string(i); break;
+                case 1: document += "\"value " + std::to_string(i) + "\""; break;
+                case 2: document += "-" + std::to_string(i) + ".5e-2"; break;
+                default: document += i % 8 == 3 ? "true" : "null"; break;
+            }
+
+            document += i + 1 < count ? "," : "]";
+        }
+
+        return document;
+    }
+
+    /**
+     * @brief Builds an array of nested records
+     * @param count Number of records
+     * @return Generated document
+     */
+    std::string makeRecords(const size_t count) {
+        std::string document = "[\n";
+
+        for(size_t i = 0; i < count; i++) {
+            document += "  {\"id\": " + std::to_string(i) + ", \"name\": \"record \\\"" + std::to_string(i) +
+                        "\\\"\", \"tags\": [\"a\", \"b\", \"c\"], \"position\": {\"x\": " + std::to_string(i % 1000) +
+                        ".25, \"y\": -" + std::to_string(i % 777) + ".5}, \"active\": " + (i % 2 == 0 ? "true" : "false") + "}";
+            document += i + 1 < count ? ",\n" : "\n]\n";
+        }
+
+        return document;
+    }
+
+    /**
+     * @brief Runs a step several times and prints its fastest time and throughput
+     * @param name Name of the step
+     * @param size Number of characters the step processes
+     * @param step Step to time
+     */
+    void measure(const std::string& name, const size_t size, const std::function<void()>& step) {
+        double best = 0;
+
+        for(size_t i = 0; i < Repetitions; i++) {
+            const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+            step();
+            const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+            if(i == 0 || seconds < best) {
+                best = seconds;
+            }
+        }
+
+        std::cout << "  " << name << ": " << best * 1000 << " ms, " << size / best / (1024 * 1024) << " MB/s\n";
+    }
+
+    /**
+     * @brief Times parsing, validating and printing a document
+     * @param name Name of the document
+     * @param document Document to time
+     */
+    void run(const std::string& name, const std::string& document) {
+        std::cout << name << " (" << document.size() / (1024 * 1024) << " MB)\n";
+
+        measure("parse from a stream", document.size(), [&document]() {
+            JsonArena arena;
+            JsonArena::Scope scope(arena);
+            std::istringstream stream(document);
+            JsonParser::parse(stream);
+        });
+
+        measure("parse from a buffer", document.size(), [&document]() {
+            JsonArena arena;
+            JsonArena::Scope scope(arena);
+            JsonParser::parse(document.data(), document.size());
+        });
+
+        measure("parse and validate", document.size(), [&document]() {
+            JsonArena arena;
+            JsonArena::Scope scope(arena);
+            JsonParser::parseValidated(document.data(), document.size());
+        });
+
+        measure("parse on all threads", document.size(), [&document]() {
+            JsonArena arena;
+            JsonArena::Scope scope(arena);
+            JsonParallelParser parser;
+            parser.parse(document.data(), document.size());
+        });
+
+        measure("validate", document.size(), [&document]() {
+            JsonValidator::check(document.data(), document.size());
+        });
+
+        measure("validate on all threads", document.size(), [&document]() {
+            JsonValidator::check(document.data(), document.size(), 0);
+        });
+
+        JsonArena arena;
+        JsonArena::Scope scope(arena);
+        const JsonValue* value = JsonParser::parse(document.data(), document.size());
+
+        measure("print", document.size(), [value]() {
+            JsonPrinter::print(value);
+        });
+    }
+}
+
+/**
+ * @brief Times the parser, validator and printer on generated documents, or on the files given as arguments
+ * @param argc Number of arguments
+ * @param argv Paths of JSON files to time instead of the generated documents
+ * @return 0 on success, 1 if a file could not be read
+ */
+int main(int argc, char* argv[]) {
+    if(argc < 2) {
+        run("flat array", makeFlatArray(2000000));
+        run("nested records", makeRecords(200000));
+        return 0;
+    }
+
+    for(int i = 1; i < argc; i++) {
+        std::ifstream file(argv[i], std::ios::binary);
+
+        if(!file) {
+            std::cerr << "Couldn't read " << argv[i] << "\n";
+            return 1;
+        }
+
+        run(argv[i], std::string(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>()));
+    }
+
+    return 0;
+}
@@ -3,8 +3,13 @@
 
 #include "JsonValue.hpp"
 #include "JsonEditor.hpp"
+#include "JsonFile.hpp"
+#include "JsonFileWriter.hpp"
+#include "JsonLazySource.hpp"
+#include "JsonParallelParser.hpp"
 #include "JsonParser.hpp"
 #include "JsonPrinter.hpp"
+#include "JsonSchema.hpp"
 #include "JsonSearcher.hpp"
 #include "JsonSerializer.hpp"
 #include "JsonValidator.hpp"
@@ -20,6 +25,21 @@ class Json {
          */
         Json(std::istream& stream);
 
+        /**
+         * @brief Constructs a Json object from a contiguous buffer, such as a memory-mapped file
+         * @param data Pointer to the first character of the JSON text
+         * @param length Number of characters in the buffer
+         */
+        Json(const char* data, const size_t length);
+
+        /**
+         * @brief Constructs a Json object from an opened file
+         * @param file Opened file, whose content is taken over by the document and left closed
+         * @param isLazy Whether arrays and objects are only parsed when first accessed
+         * @param threadCount Number of threads parsing an eager document, 0 to use one per hardware thread
+         */
+        Json(JsonFile& file, const bool isLazy, const size_t threadCount = 1);
+
         /**
          * @brief Deleted copy constructor
          */
@@ -31,17 +51,25 @@ class Json {
         Json& operator=(const Json& other) = delete;
 
         /**
-         * @brief Destructor
+         * @brief Destructor, frees the whole document by releasing its arena
          */
         ~Json();
 
         /**
-         * @brief Validates JSON content from an input stream
+         * @brief Validates JSON content from an input stream, read in fixed-size chunks instead of as a whole
          * @param stream Input stream to validate
          * @return Validation result message
          */
         static std::string validate(std::istream& stream);
 
+        /**
+         * @brief Validates the content of an opened file, which may be split between several threads
+         * @param file Opened file to validate
+         * @param threadCount Number of threads validating the file, 0 to use one per hardware thread
+         * @return Validation result message
+         */
+        static std::string validate(const JsonFile& file, const size_t threadCount = 1);
+
         /**
          * @brief Prints JSON content to output stream
          * @param stream Output stream to print to
@@ -54,6 +82,13 @@ class Json {
          */
         void prettyPrint(std::ostream& stream);
 
+        /**
+         * @brief Prints JSON content to output stream with the formatter and options of the call
+         * @param stream Output stream to print to
+         * @param options Formatter type, indentation width and key order to print with
+         */
+        void print(std::ostream& stream, const JsonFormatOptions& options);
+
         /**
          * @brief Searches JSON content using regex pattern
          * @param stream Output stream for search results
@@ -92,18 +127,23 @@ class Json {
          * @brief Saves JSON content to output stream
          * @param stream Output stream to save to
          * @param path Optional path to save specific part
+         * @param options Formatter type, indentation width and key order to save with
          */
-        void save(std::ostream& stream, const std::string& path);
-
-    private:
-        JsonValue* json;  ///< Pointer to the root JSON value
+        void save(std::ostream& stream, const std::string& path, const JsonFormatOptions& options = JsonFormatOptions());
 
         /**
-         * @brief Reads content from input stream
-         * @param stream Input stream to read from
-         * @return String containing stream content
+         * @brief Saves JSON content to a writer
+         * @param writer Writer to append to, such as a JsonFileWriter streaming to a file
+         * @param path Optional path to save specific part
+         * @param options Formatter type, indentation width and key order to save with
          */
-        static std::string readStreamContent(std::istream& stream);
+        void save(JsonWriter& writer, const std::string& path, const JsonFormatOptions& options = JsonFormatOptions());
+
+    private:
+        JsonArena arena;                  ///< Arena holding every value of the document
+        JsonValue* json;                  ///< Pointer to the root JSON value
+        JsonFile source;                  ///< Text of a document opened from a file, which its strings and unparsed values refer to
+        JsonLazySource* lazy = nullptr;   ///< Source parsing the values of a lazily parsed document, nullptr when eager
 };
 
 #endif
\ No newline at end of file
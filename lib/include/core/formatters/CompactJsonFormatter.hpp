@@ -19,26 +19,29 @@ class CompactJsonFormatter : public JsonFormatter {
          * @brief Formats a JsonArray into a compact string representation
          * @param value Pointer to the JsonArray to format
          * @param indent Indentation level (unused in compact format)
+         * @param options Options of the call
          * @return Formatted string representation of the JsonArray
          */
-        std::string format(const JsonArray* value, const size_t indent = 0) const override;
+        std::string format(const JsonArray* value, const size_t indent = 0, const JsonFormatOptions& options = JsonFormatOptions()) const override;
 
         /**
          * @brief Formats a JsonObject into a compact string representation
          * @param value Pointer to the JsonObject to format
          * @param indent Indentation level (unused in compact format)
+         * @param options Options of the call
          * @return Formatted string representation of the JsonObject
          */
-        std::string format(const JsonObject* value, const size_t indent = 0) const override;
-    private:
+        std::string format(const JsonObject* value, const size_t indent = 0, const JsonFormatOptions& options = JsonFormatOptions()) const override;
+
         /**
-         * @brief Writes JSON value to output stream in compact format
-         * @param os Output stream to write to
+         * @brief Appends JSON value to a writer in compact format
+         * @param writer Writer to append to
          * @param value Pointer to the JsonValue to write
          * @param indent Indentation level (unused in compact format)
+         * @param options Options of the call, of which the compact formatter only uses sortKeys
          */
-        void writeJsonIntoStream(std::ostream& os, const JsonValue* value, const size_t indent = 0) const override;
-
+        void writeJson(JsonWriter& writer, const JsonValue* value, const size_t indent = 0, const JsonFormatOptions& options = JsonFormatOptions()) const override;
+    private:
         /**
          * @brief Default constructor (private for singleton pattern)
          */
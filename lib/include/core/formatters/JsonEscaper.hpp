@@ -0,0 +1,48 @@
+#ifndef JSONESCAPER
+#define JSONESCAPER
+
+#include <cstddef>
+#include <string>
+#include "JsonWriter.hpp"
+#include "JsonInstructionSet.hpp"
+
+/**
+ * @brief Class that escapes decoded text for a JSON string, finding the characters to escape 16 or 32 at a time
+ */
+class JsonEscaper {
+    public:
+        /**
+         * @brief Appends text to a writer escaped as the content of a JSON string, without quotes
+         * @param writer Writer to append to
+         * @param data Pointer to the first character of the text
+         * @param length Number of characters in the text
+         */
+        static void write(JsonWriter& writer, const char* data, const size_t length);
+
+        /**
+         * @brief Finds the first character of a range that must be escaped in a JSON string
+         * @param begin Pointer to the first character to check
+         * @param end Pointer one past the last character to check
+         * @return Pointer to the first '"', '\\' or control character, end if there is none
+         */
+        static const char* findEscape(const char* begin, const char* end);
+
+        /**
+         * @brief Finds the first character of a range that must be escaped using a given instruction set
+         * @param begin Pointer to the first character to check
+         * @param end Pointer one past the last character to check
+         * @param set Instruction set to use, Scalar is used instead if the running CPU does not support it
+         * @return Pointer to the first '"', '\\' or control character, end if there is none
+         */
+        static const char* findEscape(const char* begin, const char* end, const InstructionSet set);
+
+        /**
+         * @brief Decodes the escapes of validated string content, joining surrogate pairs into one code point
+         * @param begin Pointer to the first character after the opening quote
+         * @param end Pointer to the closing quote
+         * @param result String receiving the decoded UTF-8 text, replaced entirely
+         */
+        static void decode(const char* begin, const char* end, std::string& result);
+};
+
+#endif
\ No newline at end of file
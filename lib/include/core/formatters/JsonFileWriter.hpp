@@ -0,0 +1,101 @@
+#ifndef JSONFILEWRITER
+#define JSONFILEWRITER
+
+#include <fstream>
+#include <string>
+#include <vector>
+#include "JsonWriter.hpp"
+
+/**
+ * @brief Writer handing the text straight to a file descriptor in large blocks
+ * @inherit JsonWriter
+ */
+class JsonFileWriter : public JsonWriter {
+    public:
+        static const size_t BufferSize = 1024 * 1024;  ///< Number of characters collected before they are written to the file
+
+        /**
+         * @brief Constructs a writer with no file open
+         */
+        JsonFileWriter();
+
+        /**
+         * @brief Deleted copy constructor
+         */
+        JsonFileWriter(const JsonFileWriter& other) = delete;
+
+        /**
+         * @brief Deleted assignment operator
+         */
+        JsonFileWriter& operator=(const JsonFileWriter& other) = delete;
+
+        /**
+         * @brief Destructor, writes the collected characters and closes the file
+         */
+        ~JsonFileWriter();
+
+        /**
+         * @brief Creates or truncates a file and writes to it, closing the previously opened one
+         * @param filename Name of the file to write
+         * @return True if the file was opened, false if it could not be opened for writing
+         */
+        bool open(const std::string& filename);
+
+        /**
+         * @brief Creates a new file with a unique name and writes to it, closing the previously opened one
+         * @param filename Prefix of the name, replaced by the name of the created file
+         * @return True if the file was created, false if no file could be created
+         */
+        bool openTemporary(std::string& filename);
+
+        /**
+         * @brief Writes the collected characters and waits until the file's content reaches the storage device
+         * @return True if every character appended since the file was opened reached the device, false otherwise
+         */
+        bool sync();
+
+        /**
+         * @brief Writes the collected characters and closes the file
+         * @return True if every character appended since the file was opened reached it, false otherwise
+         */
+        bool close();
+
+        /**
+         * @brief Checks whether a file is open
+         * @return True if a file is open, false otherwise
+         */
+        bool isOpen() const;
+
+        /**
+         * @brief Writes the collected characters to the file
+         */
+        void flush() override;
+    private:
+        int descriptor;            ///< Descriptor of the open file on POSIX systems, -1 when none is open
+        std::ofstream stream;      ///< Stream of the open file on other systems
+        std::vector<char> buffer;  ///< Characters not yet written to the file
+        bool hasFailed;            ///< Whether a write to the open file has failed
+
+        /**
+         * @brief Points the writer at an empty buffer after a file was opened
+         */
+        void startBuffer();
+
+        /**
+         * @brief Writes the collected characters and the new ones, with a single call if they do not fit the buffer
+         * @param data Pointer to the first character
+         * @param length Number of characters
+         */
+        void overflow(const char* data, const size_t length) override;
+
+        /**
+         * @brief Writes two ranges of characters to the file one after the other
+         * @param first Pointer to the first character of the first range
+         * @param firstLength Number of characters in the first range
+         * @param second Pointer to the first character of the second range
+         * @param secondLength Number of characters in the second range
+         */
+        void writeRanges(const char* first, const size_t firstLength, const char* second, const size_t secondLength);
+};
+
+#endif
\ No newline at end of file
@@ -4,20 +4,23 @@
 #include "JsonFormatter.hpp"
 
 /**
- * @brief Configuration namespace for JSON formatting options
+ * @brief Configuration namespace for JSON formatting options, keeping no state of its own
  */
 namespace JsonFormatConfig {
     /**
-     * @brief Gets the current JSON formatter instance
-     * @return Pointer to the current JsonFormatter
+     * @brief Gets the JSON formatter of a type
+     * @param type The FormatterType to get
+     * @return Pointer to the JsonFormatter
      */
-    const JsonFormatter* getFormatter();
+    const JsonFormatter* getFormatter(const FormatterType& type);
 
     /**
-     * @brief Sets the type of formatter to use
-     * @param _type The FormatterType to set
+     * @brief Appends a JSON value to a writer with the formatter and options of a call
+     * @param writer Writer to append to
+     * @param value Pointer to the JsonValue to write
+     * @param options Options of the call
      */
-    void setFormatterType(const FormatterType& _type);
+    void writeJson(JsonWriter& writer, const JsonValue* value, const JsonFormatOptions& options);
 }
 
 #endif
\ No newline at end of file
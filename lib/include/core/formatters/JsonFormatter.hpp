@@ -1,8 +1,10 @@
 #ifndef JSONFORMATTER
 #define JSONFORMATTER
 
+#include <vector>
 #include "JsonArray.hpp"
 #include "JsonObject.hpp"
+#include "JsonWriter.hpp"
 
 /**
  * @brief Enumeration of available JSON formatting types
@@ -12,6 +14,15 @@ enum class FormatterType {
     Pretty    ///< Pretty formatting with indentation and newlines
 };
 
+/**
+ * @brief Options of a single formatting call, passed along with the value
+ */
+struct JsonFormatOptions {
+    FormatterType type = FormatterType::Pretty;  ///< Formatter that writes the value
+    size_t indentWidth = 2;                      ///< Number of spaces per indentation level of the pretty formatter
+    bool sortKeys = false;                       ///< Whether object keys are written in byte order of the decoded keys instead of insertion order
+};
+
 /**
  * @brief Abstract base class for JSON formatters
  */
@@ -21,17 +32,28 @@ class JsonFormatter{
          * @brief Formats a JsonArray into a string
          * @param value Pointer to the JsonArray to format
          * @param indent Current indentation level
+         * @param options Options of the call
          * @return Formatted string representation
          */
-        virtual std::string format(const JsonArray* value, const size_t indent = 0) const = 0;
+        virtual std::string format(const JsonArray* value, const size_t indent = 0, const JsonFormatOptions& options = JsonFormatOptions()) const = 0;
 
         /**
          * @brief Formats a JsonObject into a string
          * @param value Pointer to the JsonObject to format
          * @param indent Current indentation level
+         * @param options Options of the call
          * @return Formatted string representation
          */
-        virtual std::string format(const JsonObject* value, const size_t indent = 0) const = 0;
+        virtual std::string format(const JsonObject* value, const size_t indent = 0, const JsonFormatOptions& options = JsonFormatOptions()) const = 0;
+
+        /**
+         * @brief Appends JSON value to a writer in a single pass
+         * @param writer Writer to append to
+         * @param value Pointer to the JsonValue to write
+         * @param indent Current indentation level
+         * @param options Options of the call
+         */
+        virtual void writeJson(JsonWriter& writer, const JsonValue* value, const size_t indent = 0, const JsonFormatOptions& options = JsonFormatOptions()) const = 0;
 
         /**
          * @brief Virtual destructor
@@ -39,12 +61,38 @@ class JsonFormatter{
         virtual ~JsonFormatter() = default;
     protected:
         /**
-         * @brief Writes JSON value to an output stream
-         * @param os Output stream to write to
-         * @param value Pointer to the JsonValue to write
-         * @param indent Current indentation level
+         * @brief Array or object being written, kept on an explicit stack instead of the call stack
+         */
+        struct WriteFrame {
+            const JsonValue* value;             ///< Array or object being written
+            size_t indent;                      ///< Indentation level of the value
+            size_t position;                    ///< Number of elements or key-value pairs written so far
+            JsonObject::ConstIterator current;  ///< Next key-value pair of an object
+            JsonObject::ConstIterator end;      ///< One past the last key-value pair of an object
+            size_t sortedBase;                  ///< Index of the object's first pair in the sorted pairs, when keys are sorted
+        };
+
+        /**
+         * @brief Pairs of the objects being written with sorted keys, innermost object last
+         */
+        typedef std::vector<const JsonObject::Entry*> SortedEntries;
+
+        /**
+         * @brief Appends the pairs of an object to the sorted pairs, ordered by the bytes of their decoded keys
+         * @param object Object whose pairs to append
+         * @param sortedEntries Sorted pairs of the objects being written
+         * @return Index of the object's first pair in the sorted pairs
+         */
+        static size_t appendSortedEntries(const JsonObject* object, SortedEntries& sortedEntries);
+
+        /**
+         * @brief Takes the next pair of an object being written, in sorted or insertion order
+         * @param frame Frame of the object
+         * @param sortedEntries Sorted pairs of the objects being written
+         * @param sortKeys Whether the object's keys are sorted
+         * @return Pointer to the next pair, nullptr when every pair has been written
          */
-        virtual void writeJsonIntoStream(std::ostream& os, const JsonValue* value, const size_t indent = 0) const = 0;
+        static const JsonObject::Entry* nextEntry(WriteFrame& frame, const SortedEntries& sortedEntries, const bool sortKeys);
 };
 
 #endif
\ No newline at end of file
@@ -0,0 +1,53 @@
+#ifndef JSONSTREAMWRITER
+#define JSONSTREAMWRITER
+
+#include <iostream>
+#include <vector>
+#include "JsonWriter.hpp"
+
+/**
+ * @brief Writer handing the text to an output stream in blocks of a fixed size
+ * @inherit JsonWriter
+ */
+class JsonStreamWriter : public JsonWriter {
+    public:
+        static const size_t BufferSize = 64 * 1024;  ///< Number of characters collected before they are written to the stream
+
+        /**
+         * @brief Constructor that writes to a stream
+         * @param _stream Stream to write to, which must outlive the writer
+         */
+        JsonStreamWriter(std::ostream& _stream);
+
+        /**
+         * @brief Deleted copy constructor
+         */
+        JsonStreamWriter(const JsonStreamWriter& other) = delete;
+
+        /**
+         * @brief Deleted assignment operator
+         */
+        JsonStreamWriter& operator=(const JsonStreamWriter& other) = delete;
+
+        /**
+         * @brief Destructor, flushes the writer
+         */
+        ~JsonStreamWriter();
+
+        /**
+         * @brief Writes the collected characters to the stream
+         */
+        void flush() override;
+    private:
+        std::ostream& stream;      ///< Stream written to
+        std::vector<char> buffer;  ///< Characters not yet written to the stream
+
+        /**
+         * @brief Writes the collected characters to the stream, then collects or directly writes new ones
+         * @param data Pointer to the first character
+         * @param length Number of characters
+         */
+        void overflow(const char* data, const size_t length) override;
+};
+
+#endif
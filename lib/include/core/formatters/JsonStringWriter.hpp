@@ -0,0 +1,49 @@
+#ifndef JSONSTRINGWRITER
+#define JSONSTRINGWRITER
+
+#include <string>
+#include "JsonWriter.hpp"
+
+/**
+ * @brief Writer appending straight into the storage of a caller-supplied string, which grows geometrically
+ * @inherit JsonWriter
+ */
+class JsonStringWriter : public JsonWriter {
+    public:
+        /**
+         * @brief Constructor that appends to the end of a string
+         * @param _output String to append to; it holds spare characters past the text until the writer is flushed
+         */
+        JsonStringWriter(std::string& _output);
+
+        /**
+         * @brief Deleted copy constructor
+         */
+        JsonStringWriter(const JsonStringWriter& other) = delete;
+
+        /**
+         * @brief Deleted assignment operator
+         */
+        JsonStringWriter& operator=(const JsonStringWriter& other) = delete;
+
+        /**
+         * @brief Destructor, flushes the writer
+         */
+        ~JsonStringWriter();
+
+        /**
+         * @brief Trims the string to the characters appended so far
+         */
+        void flush() override;
+    private:
+        std::string& output;  ///< String appended to
+
+        /**
+         * @brief Grows the string to fit characters and appends them
+         * @param data Pointer to the first character
+         * @param length Number of characters
+         */
+        void overflow(const char* data, const size_t length) override;
+};
+
+#endif
@@ -0,0 +1,69 @@
+#ifndef JSONWRITER
+#define JSONWRITER
+
+#include <cstddef>
+#include <cstring>
+
+/**
+ * @brief Abstract destination of formatted JSON text, appending to a buffer without a virtual call
+ */
+class JsonWriter {
+    public:
+        /**
+         * @brief Virtual destructor
+         */
+        virtual ~JsonWriter() = default;
+
+        /**
+         * @brief Appends one character
+         * @param symbol Character to append
+         */
+        void put(const char symbol) {
+            if(current == end) {
+                overflow(&symbol, 1);
+                return;
+            }
+
+            *current++ = symbol;
+        }
+
+        /**
+         * @brief Appends a range of characters
+         * @param data Pointer to the first character
+         * @param length Number of characters
+         */
+        void write(const char* data, const size_t length) {
+            if(static_cast<size_t>(end - current) < length) {
+                overflow(data, length);
+                return;
+            }
+
+            std::memcpy(current, data, length);
+            current += length;
+        }
+
+        /**
+         * @brief Appends a null-terminated string
+         * @param text String to append
+         */
+        void write(const char* text) {
+            write(text, std::strlen(text));
+        }
+
+        /**
+         * @brief Hands every character appended so far over to the destination
+         */
+        virtual void flush() = 0;
+    protected:
+        char* current = nullptr;  ///< Where the next character goes
+        char* end = nullptr;      ///< One past the last character that fits the buffer
+
+        /**
+         * @brief Appends characters that do not fit the rest of the buffer, draining or growing it first
+         * @param data Pointer to the first character
+         * @param length Number of characters
+         */
+        virtual void overflow(const char* data, const size_t length) = 0;
+};
+
+#endif
@@ -19,32 +19,35 @@ class PrettyJsonFormatter : public JsonFormatter {
          * @brief Formats a JsonArray into a pretty-printed string
          * @param value Pointer to the JsonArray to format
          * @param indent Current indentation level
+         * @param options Options of the call
          * @return Formatted string representation of the JsonArray
          */
-        std::string format(const JsonArray* value, const size_t indent = 0) const override;
+        std::string format(const JsonArray* value, const size_t indent = 0, const JsonFormatOptions& options = JsonFormatOptions()) const override;
 
         /**
          * @brief Formats a JsonObject into a pretty-printed string
          * @param value Pointer to the JsonObject to format
          * @param indent Current indentation level
+         * @param options Options of the call
          * @return Formatted string representation of the JsonObject
          */
-        std::string format(const JsonObject* value, const size_t indent = 0) const override;
-    private:
+        std::string format(const JsonObject* value, const size_t indent = 0, const JsonFormatOptions& options = JsonFormatOptions()) const override;
+
         /**
-         * @brief Writes JSON value to output stream with proper formatting
-         * @param os Output stream to write to
+         * @brief Appends JSON value to a writer with proper formatting
+         * @param writer Writer to append to
          * @param value Pointer to the JsonValue to write
          * @param indent Current indentation level
+         * @param options Options of the call
          */
-        void writeJsonIntoStream(std::ostream& os, const JsonValue* value, const size_t indent = 0) const override;
-
+        void writeJson(JsonWriter& writer, const JsonValue* value, const size_t indent = 0, const JsonFormatOptions& options = JsonFormatOptions()) const override;
+    private:
         /**
-         * @brief Writes indentation spaces to the output stream
-         * @param os Output stream to write to
-         * @param indent Number of indentation levels
+         * @brief Appends indentation spaces to a writer
+         * @param writer Writer to append to
+         * @param width Number of spaces to append
          */
-        void writeIndentationIntoStream(std::ostream& os, const size_t indent) const;
+        void writeIndentation(JsonWriter& writer, const size_t width) const;
 
         /**
          * @brief Default constructor (private for singleton pattern)
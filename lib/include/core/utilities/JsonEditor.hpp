@@ -83,12 +83,33 @@ class JsonEditor : public JsonValueVisitor {
         JsonValue* object = nullptr;  ///< Pointer to the current JSON object being edited
 
         /**
-         * @brief Creates a new JSON value from a path and string value
+         * @brief Sets a value at the specified path, taking ownership of it
+         * @param path Path to the target location
+         * @param value Value to set, deleted if it cannot be set
+         */
+        void replace(const std::string& path, JsonValue* value);
+
+        /**
+         * @brief Creates a new value at the specified path, taking ownership of it
          * @param path Path where to create the value
-         * @param value String representation of the value to create
-         * @return Pointer to the created JSON value
+         * @param value Value to create, deleted if it cannot be created
+         */
+        void insert(const std::string& path, JsonValue* value);
+
+        /**
+         * @brief Detaches the value at the specified path from its parent
+         * @param path Path to the value to detach
+         * @return Detached value, owned by the caller
+         */
+        JsonValue* detach(const std::string& path);
+
+        /**
+         * @brief Nests a value in one object for every segment of a path
+         * @param path Path where to create the value
+         * @param value Value to nest, taken ownership of
+         * @return Pointer to the outermost created JSON value
          */
-        JsonValue* createFromPath(const std::string& path, const std::string& value);
+        JsonValue* createFromPath(const std::string& path, JsonValue* value);
 };
 
 #endif
\ No newline at end of file
@@ -0,0 +1,69 @@
+#ifndef JSONEVENTHANDLER
+#define JSONEVENTHANDLER
+
+#include <cstddef>
+
+/**
+ * @brief Abstract handler receiving the tokens of a JSON document from JsonEventParser
+ */
+class JsonEventHandler {
+    public:
+        /**
+         * @brief Called when an object is opened
+         */
+        virtual void startObject() = 0;
+
+        /**
+         * @brief Called when the innermost open object is closed
+         */
+        virtual void endObject() = 0;
+
+        /**
+         * @brief Called when an array is opened
+         */
+        virtual void startArray() = 0;
+
+        /**
+         * @brief Called when the innermost open array is closed
+         */
+        virtual void endArray() = 0;
+
+        /**
+         * @brief Visit method for the key of a key-value pair, followed by the events of its value
+         * @param data Pointer to the first character between the quotes, escape sequences are left as written
+         * @param length Number of characters between the quotes
+         */
+        virtual void visitKey(const char* data, const size_t length) = 0;
+
+        /**
+         * @brief Visit method for null values
+         */
+        virtual void visitNull() = 0;
+
+        /**
+         * @brief Visit method for boolean values
+         * @param value The boolean value
+         */
+        virtual void visitBoolean(const bool value) = 0;
+
+        /**
+         * @brief Visit method for number values
+         * @param data Pointer to the first character of the number as written
+         * @param length Number of characters in the number
+         */
+        virtual void visitNumber(const char* data, const size_t length) = 0;
+
+        /**
+         * @brief Visit method for string values
+         * @param data Pointer to the first character between the quotes, escape sequences are left as written
+         * @param length Number of characters between the quotes
+         */
+        virtual void visitString(const char* data, const size_t length) = 0;
+
+        /**
+         * @brief Virtual destructor
+         */
+        virtual ~JsonEventHandler() = default;
+};
+
+#endif
\ No newline at end of file
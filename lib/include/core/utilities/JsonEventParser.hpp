@@ -0,0 +1,223 @@
+#ifndef JSONEVENTPARSER
+#define JSONEVENTPARSER
+
+#include <iostream>
+#include <string>
+#include <vector>
+#include "JsonEventHandler.hpp"
+#include "JsonKeyTable.hpp"
+#include "JsonValidator.hpp"
+
+/**
+ * @brief Parser that validates JSON text and reports its tokens to a JsonEventHandler without building any JsonValue
+ */
+class JsonEventParser {
+    public:
+        /**
+         * @brief Parses JSON content from an input stream chunk by chunk
+         * @param stream Input stream containing JSON data
+         * @param handler Handler to report the tokens to
+         * @param maxDepth Maximum number of arrays and objects enclosing each other, at least 1
+         * @param isRejectingDuplicates Whether an object holding a key twice is invalid
+         * @throws std::runtime_error with the validator's row/position message if the JSON is invalid
+         */
+        static void parse(std::istream& stream, JsonEventHandler& handler, const size_t maxDepth = JsonValidator::DefaultMaxDepth,
+                          const bool isRejectingDuplicates = false);
+
+        /**
+         * @brief Parses JSON content from a contiguous buffer
+         * @param data Pointer to the first character of the JSON text
+         * @param length Number of characters in the buffer
+         * @param handler Handler to report the tokens to
+         * @param maxDepth Maximum number of arrays and objects enclosing each other, at least 1
+         * @param isRejectingDuplicates Whether an object holding a key twice is invalid
+         * @throws std::runtime_error with the validator's row/position message if the JSON is invalid
+         */
+        static void parse(const char* data, const size_t length, JsonEventHandler& handler,
+                          const size_t maxDepth = JsonValidator::DefaultMaxDepth, const bool isRejectingDuplicates = false);
+    private:
+        /**
+         * @brief Parsing state of an open array or object
+         */
+        struct Frame {
+            char brace;             ///< Opening brace/bracket character
+            size_t stateOfReading;  ///< Position inside the current element: key, ':', value or ','
+            bool isCommaFound;      ///< Whether the last token was a ','
+            size_t keysBase;        ///< Position of the first key of the object in keys
+            size_t tableBase;       ///< Position of the object's hash table in keyTable, JsonKeyTable::NoTable while it has none
+        };
+
+        /**
+         * @brief Characters of a key of an open object, located in the key text
+         */
+        struct Key {
+            size_t offset;  ///< Offset of the first character in keyText
+            size_t length;  ///< Number of characters between the quotes
+        };
+
+        /**
+         * @brief Keys of the open objects as JsonKeyTable reaches them
+         */
+        struct OpenKeys {
+            const std::string& keyText;    ///< Characters of the keys
+            const std::vector<Key>& keys;  ///< Keys of the open objects
+
+            /**
+             * @brief Gets the number of keys of the open objects
+             * @return Number of keys
+             */
+            size_t size() const;
+
+            /**
+             * @brief Hashes a key of an open object
+             * @param position Position of the key in keys
+             * @return Hash of the key
+             */
+            size_t hash(const size_t position) const;
+
+            /**
+             * @brief Compares two keys of the open objects
+             * @param first Position of the first key in keys
+             * @param second Position of the second key in keys
+             * @return True if the keys are equal, false otherwise
+             */
+            bool isSame(const size_t first, const size_t second) const;
+        };
+
+        JsonEventHandler& handler;   ///< Handler the tokens are reported to
+        std::istream* stream;        ///< Stream the chunks are read from, nullptr when parsing a buffer
+        size_t maxDepth;             ///< Number of arrays and objects allowed to enclose each other
+        bool isRejectingDuplicates;  ///< Whether the keys of the open objects are kept to reject duplicates
+        std::vector<char> buffer;    ///< Storage of the current chunk when reading a stream
+        const char* chunk;           ///< First character of the current chunk
+        const char* current;         ///< Next character to be read
+        const char* chunkEnd;        ///< One past the last character of the current chunk
+        size_t chunkOffset;          ///< Offset of the current chunk from the beginning of the input
+        bool isInToken;              ///< Whether a token is being read
+        const char* tokenStart;      ///< First character of the current token inside the current chunk
+        size_t tokenOffset;          ///< Offset of the current token from the beginning of the input
+        std::string token;           ///< Characters of the current token that were in previous chunks
+        size_t row;                  ///< Row of the next character, counting the newlines read so far
+        size_t lastNewline;          ///< Offset of the last newline read
+        bool isNewlineFound;         ///< Whether any newline was read
+        std::vector<Frame> frames;   ///< Open arrays and objects, innermost last
+        std::string keyText;         ///< Characters of the keys of the open objects, one after another
+        std::vector<Key> keys;       ///< Keys of the open objects, grouped by object
+        JsonKeyTable keyTable;       ///< Hash tables of the open objects that outgrew the linear scan
+
+        /**
+         * @brief Constructs a parser over a stream or a buffer
+         * @param _handler Handler to report the tokens to
+         * @param _stream Stream to read chunks from, nullptr to parse the buffer
+         * @param data Pointer to the first character of the buffer
+         * @param length Number of characters in the buffer
+         * @param _maxDepth Maximum number of arrays and objects enclosing each other
+         * @param _isRejectingDuplicates Whether an object holding a key twice is invalid
+         */
+        JsonEventParser(JsonEventHandler& _handler, std::istream* _stream, const char* data, const size_t length,
+                        const size_t _maxDepth, const bool _isRejectingDuplicates);
+
+        /**
+         * @brief Parses the whole input as a single top-level JSON value
+         * @throws std::runtime_error if the JSON is invalid
+         */
+        void run();
+
+        /**
+         * @brief Replaces the exhausted chunk with the next one, keeping the part of the current token read so far
+         * @return True if more characters were read, false at the end of the input
+         */
+        bool fill();
+
+        /**
+         * @brief Skips whitespace characters, counting the newlines among them
+         */
+        void skipWhitespace();
+
+        /**
+         * @brief Gets the offset of the next character from the beginning of the input
+         * @return Offset of the next character
+         */
+        size_t getOffset() const;
+
+        /**
+         * @brief Starts a token at the next character
+         */
+        void beginToken();
+
+        /**
+         * @brief Ends the current token before the next character
+         * @param length Resulting number of characters in the token
+         * @return Pointer to the first character of the token
+         */
+        const char* endToken(size_t& length);
+
+        /**
+         * @brief Gets the characters of the current token read so far
+         * @return Copy of the characters
+         */
+        std::string getTokenText() const;
+
+        /**
+         * @brief Reads a value that is not an array or object and reports it
+         * @throws std::runtime_error if the value is invalid
+         */
+        void readPrimary();
+
+        /**
+         * @brief Reads null, true or false
+         * @param literal The expected literal
+         * @param length Number of characters in the literal
+         * @param valueName Name of the value kind used in the error message
+         * @param expected Description of the expected text used in the error message
+         * @throws std::runtime_error if other characters were found instead of the literal
+         */
+        void readLiteral(const char* literal, const size_t length, const char* valueName, const char* expected);
+
+        /**
+         * @brief Reads a number, leaving the cursor after it
+         * @param length Resulting number of characters in the number
+         * @return Pointer to the first character of the number
+         * @throws std::runtime_error if the number is invalid
+         */
+        const char* readNumber(size_t& length);
+
+        /**
+         * @brief Reads a string, leaving the cursor after its closing quote
+         * @param length Resulting number of characters in the string including the quotes
+         * @return Pointer to the opening quote
+         * @throws std::runtime_error if the string is unclosed or contains invalid characters or ill-formed UTF-8
+         */
+        const char* readString(size_t& length);
+
+        /**
+         * @brief Checks that the characters of the current string read so far are well-formed UTF-8
+         * @param data Pointer to the opening quote
+         * @param length Number of characters read so far, without the closing quote
+         * @throws std::runtime_error if the characters contain an ill-formed UTF-8 sequence
+         */
+        void checkUtf8(const char* data, const size_t length) const;
+
+        /**
+         * @brief Reads a key of the innermost object, rejecting duplicates, and reports it
+         * @throws std::runtime_error if the key is invalid or already exists in the object
+         */
+        void readKey();
+
+        /**
+         * @brief Handles a closing brace/bracket inside the innermost array or object
+         * @param symbol The closing character
+         * @throws std::runtime_error if the closing character is not valid here
+         */
+        void close(const char symbol);
+
+        /**
+         * @brief Computes the row and position JsonValidator reports after a number of characters were read
+         * @param consumed Number of characters read from the beginning of the input
+         * @param _row Resulting row number
+         * @param position Resulting position in row
+         */
+        void locate(const size_t consumed, size_t& _row, size_t& position) const;
+};
+
+#endif
\ No newline at end of file
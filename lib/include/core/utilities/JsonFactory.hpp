@@ -2,6 +2,7 @@
 #define JSONFACTORY
 
 #include "JsonValue.hpp"
+#include "JsonArray.hpp"
 #include "JsonObject.hpp"
 
 /**
@@ -16,6 +17,14 @@ class JsonFactory {
          */
         static JsonValue* create(const std::string& value);
 
+        /**
+         * @brief Creates a JSON value from a range of characters holding its representation
+         * @param data Pointer to the first character of the representation
+         * @param length Number of characters in the representation
+         * @return Pointer to the created JsonValue
+         */
+        static JsonValue* create(const char* data, const size_t length);
+
         /**
          * @brief Creates a JSON array from a vector of JSON values
          * @param values Vector of pointers to JSON values
@@ -23,6 +32,13 @@ class JsonFactory {
          */
         static JsonValue* create(const std::vector<JsonValue*>& values);
 
+        /**
+         * @brief Creates a JSON array that takes ownership of JSON values
+         * @param values Storage of pointers to JSON values to take over
+         * @return Pointer to the created JsonArray
+         */
+        static JsonValue* create(JsonArray::Values&& values);
+
         /**
          * @brief Creates a JSON object from keys and values
          * @param keys List of keys for the object
@@ -30,6 +46,29 @@ class JsonFactory {
          * @return Pointer to the created JsonObject
          */
         static JsonValue* create(const std::list<std::string>& keys, const std::unordered_map<std::string, JsonValue*>& values);
+
+        /**
+         * @brief Creates a JSON object that takes ownership of the values, the keys are copied
+         * @param keys List of keys
+         * @param values Map of key-value pairs whose values to take over
+         * @return Pointer to the created JsonObject
+         */
+        static JsonValue* create(std::list<std::string>&& keys, std::unordered_map<std::string, JsonValue*>&& values);
+
+        /**
+         * @brief Creates a JSON object that takes ownership of key-value pairs
+         * @param entries Pairs with unique keys to take over, in insertion order
+         * @return Pointer to the created JsonObject
+         */
+        static JsonValue* create(JsonObject::Entries&& entries);
+
+        /**
+         * @brief Creates a JSON array or object whose content is parsed from its source when first accessed
+         * @param brace Opening brace/bracket of the value
+         * @param span Source and position of the value's text
+         * @return Pointer to the created JsonArray or JsonObject
+         */
+        static JsonValue* create(const char brace, const JsonSpan& span);
 };
 
 #endif
\ No newline at end of file
@@ -0,0 +1,81 @@
+#ifndef JSONFILE
+#define JSONFILE
+
+#include <cstddef>
+#include <string>
+
+/**
+ * @brief Read-only view of the whole content of a file, memory-mapped when possible
+ */
+class JsonFile {
+    public:
+        /**
+         * @brief Constructs a view of no file
+         */
+        JsonFile();
+
+        /**
+         * @brief Deleted copy constructor
+         */
+        JsonFile(const JsonFile& other) = delete;
+
+        /**
+         * @brief Deleted assignment operator
+         */
+        JsonFile& operator=(const JsonFile& other) = delete;
+
+        /**
+         * @brief Destructor, unmaps or frees the content
+         */
+        ~JsonFile();
+
+        /**
+         * @brief Opens a file and makes its whole content available, replacing the previously opened one
+         * @param filename Name of the file to open
+         * @return True if the file was opened, false if it could not be opened or read
+         */
+        bool open(const std::string& filename);
+
+        /**
+         * @brief Releases the content of the opened file
+         */
+        void close();
+
+        /**
+         * @brief Exchanges the opened files of two views
+         * @param other View to exchange with
+         */
+        void swap(JsonFile& other);
+
+        /**
+         * @brief Gets the content of the opened file
+         * @return Pointer to the first character, valid until the file is closed
+         */
+        const char* getData() const;
+
+        /**
+         * @brief Gets the size of the content of the opened file
+         * @return Number of characters
+         */
+        size_t getLength() const;
+
+        /**
+         * @brief Checks whether the content is memory-mapped rather than read into a buffer
+         * @return True if the file is mapped, false otherwise
+         */
+        bool isMapped() const;
+    private:
+        const char* data;     ///< First character of the content
+        size_t length;        ///< Number of characters in the content
+        void* mapping;        ///< Start of the mapping, nullptr when the content is in the buffer
+        std::string content;  ///< Content read from files that are not mapped
+
+        /**
+         * @brief Maps or reads the file behind an open descriptor
+         * @param descriptor Descriptor of the file opened for reading
+         * @return True if the whole content was mapped or read, false if reading failed
+         */
+        bool load(const int descriptor);
+};
+
+#endif
@@ -0,0 +1,44 @@
+#ifndef JSONGRAMMAR
+#define JSONGRAMMAR
+
+#include <cstddef>
+
+/**
+ * @brief Class with the token rules of the JSON grammar shared by the parsers
+ */
+class JsonGrammar {
+    public:
+        /**
+         * @brief Checks if a character is a decimal digit
+         * @param symbol Character to check
+         * @return True if the character is a digit, false otherwise
+         */
+        static bool isDigit(const char symbol) {
+            return symbol >= '0' && symbol <= '9';
+        }
+
+        /**
+         * @brief Checks a number token against the JSON number grammar -?(0|[1-9]\d*)(\.\d+)?([eE][+-]?\d+)?
+         * @param value Pointer to the first character of the token
+         * @param length Length of the token
+         * @return True if the token is a valid JSON number, false otherwise
+         */
+        static bool isValidNumber(const char* value, const size_t length);
+
+        /**
+         * @brief Checks if a character may follow a backslash inside a JSON string
+         * @param symbol Character after the backslash
+         * @return True if the escape sequence is valid, false otherwise
+         */
+        static bool isEscapeCharacter(const char symbol);
+
+        /**
+         * @brief Skips the characters a JSON string may contain as they are
+         * @param begin Pointer to the first character to check
+         * @param end Pointer one past the last character to check
+         * @return Pointer to the first quote, backslash or control character, end if there is none
+         */
+        static const char* skipPlainCharacters(const char* begin, const char* end);
+};
+
+#endif
\ No newline at end of file
@@ -0,0 +1,32 @@
+#ifndef JSONINSTRUCTIONSET
+#define JSONINSTRUCTIONSET
+
+/**
+ * @brief Instruction sets the vectorized scanners are compiled for
+ */
+enum class InstructionSet {
+    Scalar,  ///< Plain C++, at most a word at a time
+    Sse,     ///< 128-bit SSE vectors, up to SSE4.2
+    Avx2     ///< 256-bit AVX2 vectors
+};
+
+/**
+ * @brief Class that tells which instruction sets the running CPU supports
+ */
+class JsonInstructionSet {
+    public:
+        /**
+         * @brief Checks whether the scanners can use an instruction set on the running CPU
+         * @param set Instruction set to check
+         * @return True if the set is compiled in and the CPU supports it, false otherwise
+         */
+        static bool isSupported(const InstructionSet set);
+
+        /**
+         * @brief Gets the widest instruction set the scanners can use on the running CPU
+         * @return Widest supported instruction set, Scalar if there is no other
+         */
+        static InstructionSet getWidest();
+};
+
+#endif
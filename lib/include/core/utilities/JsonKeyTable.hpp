@@ -0,0 +1,112 @@
+#ifndef JSONKEYTABLE
+#define JSONKEYTABLE
+
+#include <cstddef>
+#include <vector>
+
+/**
+ * @brief Hash tables finding duplicate keys in the open objects of a document without allocating per key
+ */
+class JsonKeyTable {
+    public:
+        static const size_t NoTable = static_cast<size_t>(-1);  ///< Table position of an object whose keys are still scanned linearly
+
+        /**
+         * @brief Checks whether the key last pushed already exists in the innermost object, adding it if not
+         * @param keys Adapter of the key stack, which ends with the new key
+         * @param base Position of the object's first key on the stack
+         * @param tableBase Position of the object's table among the slots, NoTable until one is built, set when it is
+         * @return True if the key is a duplicate, false otherwise
+         */
+        template<typename Keys>
+        bool isDuplicate(const Keys& keys, const size_t base, size_t& tableBase);
+
+        /**
+         * @brief Drops the table of the innermost object as the object is closed
+         * @param tableBase Position of the object's table among the slots, NoTable if it has none
+         */
+        void release(const size_t tableBase);
+    private:
+        /**
+         * @brief Slot of a hash table
+         */
+        struct Slot {
+            size_t position;  ///< Position of the key on the key stack plus one, 0 for an empty slot
+            size_t hash;      ///< Hash of the key, kept so growing the table does not hash the keys again
+        };
+
+        static const size_t LinearSearchLimit = 16;  ///< Number of keys up to which an object is scanned linearly
+        static const size_t InitialSize = 64;        ///< Number of slots of the table an object gets once it outgrows the linear scan
+
+        std::vector<Slot> slots;  ///< Hash tables of the open objects that outgrew the linear scan, innermost last
+
+        /**
+         * @brief Puts a key into a table that has a free slot
+         * @param tableBase Position of the table among the slots
+         * @param mask Number of slots of the table minus one
+         * @param key Slot of the key
+         */
+        void insert(const size_t tableBase, const size_t mask, const Slot& key);
+
+        /**
+         * @brief Doubles the table of the innermost object, placing the keys by their stored hashes
+         * @param tableBase Position of the object's table among the slots, which must be the last table
+         */
+        void grow(const size_t tableBase);
+};
+
+/**
+ * @brief Checks whether the key last pushed already exists in the innermost object, building a table for large ones
+ * @param keys Adapter of the key stack, which ends with the new key
+ * @param base Position of the object's first key on the stack
+ * @param tableBase Position of the object's table among the slots, NoTable until one is built, set when it is
+ * @return True if the key is a duplicate, false otherwise
+ */
+template<typename Keys>
+bool JsonKeyTable::isDuplicate(const Keys& keys, const size_t base, size_t& tableBase) {
+    const size_t last = keys.size() - 1;
+
+    if(tableBase == NoTable) {
+        for(size_t i = base; i < last; i++) {
+            if(keys.isSame(i, last)) {
+                return true;
+            }
+        }
+
+        if(last - base < LinearSearchLimit) {
+            return false;
+        }
+
+        tableBase = slots.size();
+        slots.resize(tableBase + InitialSize, Slot{0, 0});
+
+        for(size_t i = base; i <= last; i++) {
+            insert(tableBase, InitialSize - 1, Slot{i + 1, keys.hash(i)});
+        }
+
+        return false;
+    }
+
+    const size_t hash = keys.hash(last);
+    const size_t size = slots.size() - tableBase;
+    const size_t mask = size - 1;
+    size_t slot = hash & mask;
+
+    for(; slots[tableBase + slot].position != 0; slot = (slot + 1) & mask) {
+        const Slot& other = slots[tableBase + slot];
+
+        if(other.hash == hash && keys.isSame(other.position - 1, last)) {
+            return true;
+        }
+    }
+
+    slots[tableBase + slot] = Slot{last + 1, hash};
+
+    if((last + 1 - base) * 2 > size) {
+        grow(tableBase);
+    }
+
+    return false;
+}
+
+#endif
@@ -0,0 +1,54 @@
+#ifndef JSONLAZYSOURCE
+#define JSONLAZYSOURCE
+
+#include "JsonArray.hpp"
+#include "JsonParser.hpp"
+
+/**
+ * @brief Source of a lazily parsed document, parsing its arrays and objects into the document's arena
+ * @inherit JsonSource
+ */
+class JsonLazySource : public JsonSource {
+    public:
+        /**
+         * @brief Constructs a source over the text of a document
+         * @param _data Pointer to the first character of the document, which must outlive the source
+         * @param _length Number of characters in the document
+         * @param _arena Arena the document's values are carved from
+         */
+        JsonLazySource(const char* _data, const size_t _length, JsonArena& _arena);
+
+        /**
+         * @brief Parses the elements of an array, leaving nested arrays and objects unparsed
+         * @param array Array to fill
+         * @param begin Offset of the opening bracket in the document
+         * @param end Offset one past the closing bracket
+         * @throws std::runtime_error with the validator's message if the document is invalid
+         */
+        void load(JsonArray& array, const size_t begin, const size_t end) override;
+
+        /**
+         * @brief Parses the key-value pairs of an object, leaving nested arrays and objects unparsed
+         * @param object Object to fill
+         * @param begin Offset of the opening brace in the document
+         * @param end Offset one past the closing brace
+         * @throws std::runtime_error with the validator's message if the document is invalid
+         */
+        void load(JsonObject& object, const size_t begin, const size_t end) override;
+    private:
+        const char* data;       ///< First character of the document
+        size_t length;          ///< Number of characters in the document
+        JsonArena& arena;       ///< Arena the document's values are carved from
+        ParserScratch scratch;  ///< Buffers reused from one level to the next
+
+        /**
+         * @brief Parses one array or object of the document
+         * @param begin Offset of the opening brace/bracket
+         * @param end Offset one past the end of the value's text
+         * @return Pointer to the parsed JsonArray or JsonObject
+         * @throws std::runtime_error with the validator's message if the document is invalid
+         */
+        JsonValue* parse(const size_t begin, const size_t end);
+};
+
+#endif
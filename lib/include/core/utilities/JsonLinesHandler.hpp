@@ -0,0 +1,33 @@
+#ifndef JSONLINESHANDLER
+#define JSONLINESHANDLER
+
+#include <cstddef>
+#include <string>
+#include "JsonValue.hpp"
+
+/**
+ * @brief Abstract handler receiving the records of newline-delimited JSON on the thread that started reading
+ */
+class JsonLinesHandler {
+    public:
+        /**
+         * @brief Visit method for a record that is valid JSON
+         * @param line Line of the record, counting from 1
+         * @param value Parsed record, only valid for the duration of the call; nullptr when the reader only validates
+         */
+        virtual void visitRecord(const size_t line, JsonValue* value) = 0;
+
+        /**
+         * @brief Visit method for a record that is not valid JSON, reading continues with the next record
+         * @param line Line of the record, counting from 1
+         * @param message The validator's message, with the row and position inside the record
+         */
+        virtual void visitError(const size_t line, const std::string& message) = 0;
+
+        /**
+         * @brief Virtual destructor
+         */
+        virtual ~JsonLinesHandler() = default;
+};
+
+#endif
@@ -0,0 +1,75 @@
+#ifndef JSONLINESREADER
+#define JSONLINESREADER
+
+#include <iostream>
+#include "JsonLinesHandler.hpp"
+#include "JsonValidator.hpp"
+
+/**
+ * @brief Reader of newline-delimited JSON (JSON Lines) that parses or validates the records on worker threads
+ */
+class JsonLinesReader {
+    public:
+        /**
+         * @brief Constructs a reader
+         * @param _threadCount Number of worker threads, 0 to use one per hardware thread
+         * @param _isOrdered Whether records are delivered in input order rather than as soon as they are parsed
+         * @param _maxDepth Maximum number of arrays and objects enclosing each other in a record, at least 1
+         */
+        JsonLinesReader(const size_t _threadCount = 0, const bool _isOrdered = true,
+                        const size_t _maxDepth = JsonValidator::DefaultMaxDepth);
+
+        /**
+         * @brief Parses every record of a contiguous buffer, such as a memory-mapped file
+         * @param data Pointer to the first character of the input
+         * @param length Number of characters in the input
+         * @param handler Handler to deliver the records to
+         */
+        void read(const char* data, const size_t length, JsonLinesHandler& handler) const;
+
+        /**
+         * @brief Parses every record of a stream, holding only the batches in flight in memory
+         * @param stream Input stream with newline-delimited JSON
+         * @param handler Handler to deliver the records to
+         */
+        void read(std::istream& stream, JsonLinesHandler& handler) const;
+
+        /**
+         * @brief Validates every record of a contiguous buffer without building any values
+         * @param data Pointer to the first character of the input
+         * @param length Number of characters in the input
+         * @param handler Handler to deliver the results to
+         */
+        void validate(const char* data, const size_t length, JsonLinesHandler& handler) const;
+
+        /**
+         * @brief Validates every record of a stream without building any values
+         * @param stream Input stream with newline-delimited JSON
+         * @param handler Handler to deliver the results to
+         */
+        void validate(std::istream& stream, JsonLinesHandler& handler) const;
+
+        /**
+         * @brief Gets the number of worker threads
+         * @return Number of worker threads
+         */
+        size_t getThreadCount() const;
+    private:
+        size_t threadCount;  ///< Number of worker threads
+        bool isOrdered;      ///< Whether records are delivered in input order
+        size_t maxDepth;     ///< Number of arrays and objects allowed to enclose each other in a record
+
+        /**
+         * @brief Cuts the input into batches, feeds them to the workers and delivers the results
+         * @param data Pointer to the first character of the input, ignored when reading a stream
+         * @param length Number of characters in the input, ignored when reading a stream
+         * @param stream Stream to read the input from, nullptr to read the buffer
+         * @param handler Handler to deliver the records to
+         * @param isBuilding Whether JsonValue nodes are created for the records
+         * @throws Any exception thrown by the handler, after the workers have stopped
+         */
+        void run(const char* data, const size_t length, std::istream* stream, JsonLinesHandler& handler,
+                 const bool isBuilding) const;
+};
+
+#endif
@@ -0,0 +1,58 @@
+#ifndef JSONNUMBERCONVERTER
+#define JSONNUMBERCONVERTER
+
+#include <cstddef>
+#include <cstdint>
+#include "JsonNumber.hpp"
+
+/**
+ * @brief Binary value of a JSON number token
+ */
+struct NumberValue {
+    NumberType type;  ///< Which member of the union holds the value
+    union {
+        int64_t integer;           ///< Value of a NumberType::Integer
+        uint64_t unsignedInteger;  ///< Value of a NumberType::UnsignedInteger
+        double floating;           ///< Value of a NumberType::Double
+    };
+    bool isTextNeeded;  ///< Whether printing the binary value would not reproduce the token, so the token must be kept
+};
+
+/**
+ * @brief Class that converts JSON number tokens to their binary value
+ */
+class JsonNumberConverter {
+    public:
+        /**
+         * @brief Converts a number token to a 64-bit integer if it fits, to the nearest double otherwise
+         * @param data Pointer to the first character of the token
+         * @param length Number of characters in the token
+         * @return Binary value of the token
+         */
+        static NumberValue parse(const char* data, const size_t length);
+
+        /**
+         * @brief Writes the shortest text that reads back as a binary value not needing its source token
+         * @param value Binary value with isTextNeeded false
+         * @param buffer Buffer of at least MaxTextLength characters to write to
+         * @return Number of characters written
+         */
+        static size_t format(const NumberValue& value, char* buffer);
+
+        static const size_t MaxTextLength = 32;  ///< Upper bound of the characters written by format
+    private:
+        /**
+         * @brief Converts a decimal significand and exponent to the nearest double
+         * @param significand Up to 19 leading significant digits of the number
+         * @param exponent Power of ten the significand is scaled by
+         * @param isTruncated Whether nonzero digits after the first 19 were dropped from the significand
+         * @param isNegative Whether the number has a minus sign
+         * @param data Pointer to the first character of the token, used by the fallback
+         * @param length Number of characters in the token
+         * @return Nearest double
+         */
+        static double toDouble(const uint64_t significand, const int64_t exponent, const bool isTruncated, const bool isNegative,
+                               const char* data, const size_t length);
+};
+
+#endif
\ No newline at end of file
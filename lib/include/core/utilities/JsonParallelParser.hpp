@@ -0,0 +1,96 @@
+#ifndef JSONPARALLELPARSER
+#define JSONPARALLELPARSER
+
+#include <vector>
+#include "JsonParser.hpp"
+
+/**
+ * @brief Parser that splits a single large document between worker threads
+ */
+class JsonParallelParser : public JsonSource {
+    public:
+        /**
+         * @brief Constructs a parser
+         * @param _threadCount Number of threads parsing a document including the calling one, 0 to use one per hardware thread
+         * @param _isBorrowing Whether string values refer to the document instead of copying it; it must then outlive them
+         * @param _maxDepth Maximum number of arrays and objects enclosing each other, at least 1
+         */
+        JsonParallelParser(const size_t _threadCount = 0, const bool _isBorrowing = false,
+                           const size_t _maxDepth = JsonValidator::DefaultMaxDepth);
+
+        /**
+         * @brief Deleted copy constructor
+         */
+        JsonParallelParser(const JsonParallelParser& other) = delete;
+
+        /**
+         * @brief Deleted assignment operator
+         */
+        JsonParallelParser& operator=(const JsonParallelParser& other) = delete;
+
+        /**
+         * @brief Parses JSON content from a contiguous buffer, validating it
+         * @param _data Pointer to the first character of the JSON text
+         * @param _length Number of characters in the buffer
+         * @return Pointer to the parsed JsonValue
+         * @throws std::runtime_error with the validator's row/position message if the JSON is invalid
+         */
+        JsonValue* parse(const char* _data, const size_t _length);
+
+        /**
+         * @brief Gets the number of threads parsing a document
+         * @return Number of threads, including the calling one
+         */
+        size_t getThreadCount() const;
+
+        /**
+         * @brief Gets the number of pieces the last document was split into
+         * @return Number of pieces parsed by the threads, 0 if the document was parsed on the calling thread alone
+         */
+        size_t getPieceCount() const;
+
+        /**
+         * @brief Parses the elements of an array of the document being parsed
+         * @param array Array to fill
+         * @param begin Offset of the opening bracket in the document
+         * @param end Offset one past the closing bracket
+         * @throws std::runtime_error if the array is invalid
+         */
+        void load(JsonArray& array, const size_t begin, const size_t end) override;
+
+        /**
+         * @brief Parses the key-value pairs of an object of the document being parsed
+         * @param object Object to fill
+         * @param begin Offset of the opening brace in the document
+         * @param end Offset one past the closing brace
+         * @throws std::runtime_error if the object is invalid
+         */
+        void load(JsonObject& object, const size_t begin, const size_t end) override;
+    private:
+        size_t threadCount;                   ///< Number of threads parsing a document
+        bool isBorrowing;                     ///< Whether string values refer to the document instead of copying it
+        size_t maxDepth;                      ///< Number of arrays and objects allowed to enclose each other
+        size_t pieceCount;                    ///< Number of pieces the last document was split into, 0 if it was parsed serially
+        const char* data;                     ///< First character of the document being parsed
+        size_t length;                        ///< Number of characters in the document being parsed
+        StructuralIndex index;                ///< Structural index of the document being parsed
+        std::vector<UnparsedValue>* pending;  ///< Collects the nested values left unparsed while splitting, nullptr while parsing pieces in full
+
+        /**
+         * @brief Parses one array or object of the document, one level deep while splitting and in full otherwise
+         * @param begin Offset of the opening brace/bracket
+         * @param end Offset one past the closing brace/bracket
+         * @return Pointer to the parsed JsonArray or JsonObject
+         * @throws std::runtime_error if the value is invalid
+         */
+        JsonValue* parseValue(const size_t begin, const size_t end);
+
+        /**
+         * @brief Parses the pieces of the document on the worker threads and the calling thread
+         * @param pieces Unparsed values to parse in full, largest first
+         * @return True if every piece was parsed, false if any was invalid
+         */
+        bool parsePieces(const std::vector<UnparsedValue>& pieces);
+};
+
+#endif
@@ -1,66 +1,234 @@
 #ifndef JSONPARSER
 #define JSONPARSER
 
+#include <vector>
 #include "JsonObject.hpp"
+#include "JsonStructuralIndexer.hpp"
+#include "JsonValidator.hpp"
+
+/**
+ * @brief Array or object left unparsed by the parser, together with the span of its text
+ */
+struct UnparsedValue {
+    JsonValue* value;  ///< Unparsed JsonArray or JsonObject
+    JsonSpan span;     ///< Text of the value
+};
+
+/**
+ * @brief Parsing state of an array or object whose nested value is being parsed
+ */
+struct ParserFrame {
+    char brace;             ///< Opening brace/bracket character
+    bool isCommaFound;      ///< Whether the last token was a ','
+    size_t stateOfReading;  ///< Position inside the current element: key, ':', value or ','
+    size_t valuesBase;      ///< Position of the first element of the array on the value stack
+    size_t entriesBase;     ///< Position of the first key-value pair of the object on the entry stack
+    size_t tableBase;       ///< Position of the object's key hash table among the slots, JsonKeyTable::NoTable while its keys are scanned linearly
+};
+
+/**
+ * @brief Read position inside a contiguous buffer of JSON text
+ */
+struct ParserCursor {
+    const char* begin;    ///< First character of the buffer
+    const char* current;  ///< Next character to be read
+    const char* end;      ///< One past the last character of the buffer
+    bool isValidating;    ///< Whether the grammar is fully checked while parsing
+    bool isBorrowing;     ///< Whether string values refer to the buffer instead of copying it
+    size_t maxDepth;      ///< Number of arrays and objects allowed to enclose each other
+    const uint32_t* structural;     ///< Next unread entry of the structural index, nullptr when parsing without one
+    const uint32_t* structuralEnd;  ///< One past the last entry of the structural index
+    const uint32_t* special;        ///< Next unread offset of a backslash or control character inside a string
+    const uint32_t* specialEnd;     ///< One past the last offset of a backslash or control character
+    JsonSource* source;   ///< Document nested arrays and objects are left unparsed in, nullptr to parse them
+    size_t sourceOffset;  ///< Offset of the buffer inside the source document
+    std::vector<UnparsedValue>* unparsed;     ///< Collects the arrays and objects left unparsed, nullptr when not needed
+    std::vector<JsonValue*> values;           ///< Children of the arrays being parsed, shared by all nesting levels
+    std::vector<JsonObject::Entry> entries;   ///< Key-value pairs of the objects being parsed, shared by all nesting levels
+    std::vector<ParserFrame> frames;          ///< Arrays and objects enclosing the one being parsed, innermost last
+};
+
+/**
+ * @brief Buffers kept between the parses of the levels of a lazily parsed document
+ */
+struct ParserScratch {
+    StructuralIndex index;                    ///< Structural index of the last parsed level
+    std::vector<JsonValue*> values;           ///< Spare storage for the cursor's array stack
+    std::vector<JsonObject::Entry> entries;   ///< Spare storage for the cursor's object stack
+    std::vector<ParserFrame> frames;          ///< Spare storage for the cursor's frame stack
+};
 
 /**
  * @brief Parser class for converting JSON text into JsonValue objects
  */
 class JsonParser {
     public:
+        /**
+         * @brief Parses JSON content from a contiguous buffer
+         * @param data Pointer to the first character of the JSON text
+         * @param length Number of characters in the buffer
+         * @param maxDepth Maximum number of arrays and objects enclosing each other, at least 1
+         * @return Pointer to the parsed JsonValue
+         */
+        static JsonValue* parse(const char* data, const size_t length, const size_t maxDepth = JsonValidator::DefaultMaxDepth);
+
         /**
          * @brief Parses JSON content from an input stream
          * @param stream Input stream containing JSON data
+         * @param maxDepth Maximum number of arrays and objects enclosing each other, at least 1
+         * @return Pointer to the parsed JsonValue
+         */
+        static JsonValue* parse(std::istream& stream, const size_t maxDepth = JsonValidator::DefaultMaxDepth);
+
+        /**
+         * @brief Parses JSON content from a contiguous buffer, validating it in the same pass
+         * @param data Pointer to the first character of the JSON text
+         * @param length Number of characters in the buffer
+         * @param isBorrowing Whether string values refer to the buffer instead of copying it; it must then outlive them
+         * @param maxDepth Maximum number of arrays and objects enclosing each other, at least 1
+         * @return Pointer to the parsed JsonValue
+         * @throws std::runtime_error with the validator's row/position message if the JSON is invalid
+         */
+        static JsonValue* parseValidated(const char* data, const size_t length, const bool isBorrowing = false,
+                                         const size_t maxDepth = JsonValidator::DefaultMaxDepth);
+
+        /**
+         * @brief Parses JSON content from an input stream, validating it in the same pass
+         * @param stream Input stream containing JSON data
+         * @param maxDepth Maximum number of arrays and objects enclosing each other, at least 1
          * @return Pointer to the parsed JsonValue
+         * @throws std::runtime_error with the validator's row/position message if the JSON is invalid
+         */
+        static JsonValue* parseValidated(std::istream& stream, const size_t maxDepth = JsonValidator::DefaultMaxDepth);
+
+        /**
+         * @brief Parses the top-level value of a document lazily
+         * @param data Pointer to the first character of the document, which must outlive the value
+         * @param length Number of characters in the document
+         * @param source Source the document's arrays and objects are parsed by
+         * @return Pointer to the top-level JsonValue
+         * @throws std::runtime_error with the validator's row/position message if a top-level primitive is invalid
+         */
+        static JsonValue* parseLazy(const char* data, const size_t length, JsonSource* source);
+
+        /**
+         * @brief Parses one array or object of a lazily parsed document, recording nested values with their spans
+         * @param data Pointer to the first character of the document
+         * @param begin Offset of the opening brace/bracket
+         * @param end Offset one past the end of the value's text
+         * @param source Source the nested arrays and objects are parsed by
+         * @param scratch Buffers reused from the previous level
+         * @return Pointer to the parsed JsonArray or JsonObject
+         * @throws std::runtime_error if the level is invalid; the message is relative to the span
+         */
+        static JsonValue* parseLevel(const char* data, const size_t begin, const size_t end, JsonSource* source,
+                                     ParserScratch& scratch);
+
+        /**
+         * @brief Parses one array or object of a document whose structural index was built beforehand
+         * @param data Pointer to the first character of the document
+         * @param length Number of characters in the document
+         * @param index Structural index of the whole document
+         * @param begin Offset of the opening brace/bracket
+         * @param end Offset one past the end of the value's text
+         * @param source Source the nested arrays and objects are left unparsed in, nullptr to parse them too
+         * @param unparsed Collects the nested arrays and objects left unparsed, may be nullptr
+         * @param isBorrowing Whether string values refer to the document instead of copying it; it must then outlive them
+         * @param maxDepth Maximum number of arrays and objects enclosing each other inside the value
+         * @param scratch Stacks reused from the previous value parsed by the calling thread; its index is not used
+         * @return Pointer to the parsed JsonArray or JsonObject
+         * @throws std::runtime_error with the validator's row/position message if the value is invalid
          */
-        static JsonValue* parse(std::istream& stream);
+        static JsonValue* parseIndexed(const char* data, const size_t length, const StructuralIndex& index, const size_t begin,
+                                       const size_t end, JsonSource* source, std::vector<UnparsedValue>* unparsed,
+                                       const bool isBorrowing, const size_t maxDepth, ParserScratch& scratch);
     private:
         /**
-         * @brief Parses a JSON null value
-         * @param stream Input stream to parse from
-         * @return String representation of null value
+         * @brief Parses a whole buffer as a single top-level JSON value
+         * @param data Pointer to the first character of the JSON text
+         * @param length Number of characters in the buffer
+         * @param isValidating Whether the grammar is fully checked while parsing
+         * @param isBorrowing Whether string values refer to the buffer instead of copying it
+         * @param maxDepth Maximum number of arrays and objects enclosing each other
+         * @return Pointer to the parsed JsonValue
          */
-        static std::string parseNull(std::istream& stream);
+        static JsonValue* parseBuffer(const char* data, const size_t length, const bool isValidating, const bool isBorrowing,
+                                      const size_t maxDepth);
 
         /**
-         * @brief Parses a JSON boolean value
-         * @param stream Input stream to parse from
-         * @param lastSymbol Last character read from stream
-         * @return String representation of boolean value
+         * @brief Reads a JSON null value, leaving the cursor after it
+         * @param cursor Cursor positioned on the first character of the value
          */
-        static std::string parseBoolean(std::istream& stream, const char lastSymbol);
+        static void parseNull(ParserCursor& cursor);
 
         /**
-         * @brief Parses a JSON number value
-         * @param stream Input stream to parse from
-         * @param lastSymbol Last character read from stream
-         * @return String representation of number value
+         * @brief Reads a JSON boolean value, leaving the cursor after it
+         * @param cursor Cursor positioned on the first character of the value
          */
-        static std::string parseNumber(std::istream& stream, const char lastSymbol);
+        static void parseBoolean(ParserCursor& cursor);
 
         /**
-         * @brief Parses a JSON string value
-         * @param stream Input stream to parse from
-         * @param lastSymbol Last character read from stream
-         * @return Parsed string value
+         * @brief Reads a JSON number value, leaving the cursor after it
+         * @param cursor Cursor positioned on the first character of the value
          */
-        static std::string parseString(std::istream& stream, const char lastSymbol);
+        static void parseNumber(ParserCursor& cursor);
+
+        /**
+         * @brief Reads a JSON string value, leaving the cursor after its closing quote
+         * @param cursor Cursor positioned on the opening quote
+         */
+        static void parseString(ParserCursor& cursor);
+
+        /**
+         * @brief Checks that the characters of a string read so far are well-formed UTF-8
+         * @param cursor Cursor over the parsed buffer
+         * @param start Opening quote of the string
+         * @param symbol Character the string was read up to
+         * @throws std::runtime_error if an ill-formed UTF-8 sequence starts before symbol
+         */
+        static void checkUtf8(const ParserCursor& cursor, const char* start, const char* symbol);
 
         /**
          * @brief Parses a primary JSON value (null, boolean, number, or string)
-         * @param stream Input stream to parse from
-         * @param lastSymbol Last character read from stream
+         * @param cursor Cursor positioned on the first character of the value
          * @return Pointer to the parsed JsonValue
          */
-        static JsonValue* parsePrimary(std::istream& stream, const char lastSymbol);
+        static JsonValue* parsePrimary(ParserCursor& cursor);
 
         /**
-         * @brief Parses a JSON object or array
-         * @param stream Input stream to parse from
+         * @brief Parses a JSON object or array together with everything nested in it without recursion
+         * @param cursor Cursor positioned right after the opening brace/bracket
          * @param lastBrace Opening brace/bracket character
          * @return Pointer to the parsed JsonValue
+         * @throws std::runtime_error if the value is invalid or nested deeper than the maximum depth
+         */
+        static JsonValue* parseJson(ParserCursor& cursor, const char lastBrace);
+
+        /**
+         * @brief Skips a nested JSON object or array of a lazily parsed document without looking at its content
+         * @param cursor Cursor positioned on the opening brace/bracket, with a structural index
+         * @param brace Opening brace/bracket character
+         * @return Pointer to the unparsed JsonArray or JsonObject
+         * @throws std::runtime_error if the brace/bracket is never closed
+         */
+        static JsonValue* skipJson(ParserCursor& cursor, const char brace);
+
+        /**
+         * @brief Throws the message the validator gives for an error, located relative to the cursor's buffer
+         * @param cursor Cursor over the parsed buffer
+         * @param error Kind of the error
+         * @param offset Offset from the beginning of the buffer the error is reported at
+         * @param length Number of characters of the offending token
+         * @throws std::runtime_error always
+         */
+        [[noreturn]] static void fail(const ParserCursor& cursor, const ValidationError error, const size_t offset, const size_t length);
+
+        /**
+         * @brief Reads entire stream content
+         * @param stream Input stream to read from
+         * @return String containing stream content
          */
-        static JsonValue* parseJson(std::istream& stream, const char lastBrace);
+        static std::string readStreamContent(std::istream& stream);
 };
 
 #endif
\ No newline at end of file
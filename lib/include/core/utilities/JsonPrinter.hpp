@@ -2,6 +2,7 @@
 #define JSONPRINTER
 
 #include "JsonFormatConfig.hpp"
+#include "JsonWriter.hpp"
 
 /**
  * @brief Utility class for printing JSON values in different formats
@@ -21,6 +22,36 @@ class JsonPrinter {
          * @return Formatted string representation of the JSON value
          */
         static std::string prettyPrint(const JsonValue* const jsonValue);
+
+        /**
+         * @brief Appends a JSON value in compact format to a writer
+         * @param writer Writer to append to
+         * @param jsonValue Pointer to the constant JSON value to print
+         */
+        static void print(JsonWriter& writer, const JsonValue* const jsonValue);
+
+        /**
+         * @brief Appends a JSON value in pretty-printed format to a writer
+         * @param writer Writer to append to
+         * @param jsonValue Pointer to the constant JSON value to print
+         */
+        static void prettyPrint(JsonWriter& writer, const JsonValue* const jsonValue);
+
+        /**
+         * @brief Prints a JSON value with the formatter and options of the call
+         * @param jsonValue Pointer to the constant JSON value to print
+         * @param options Formatter type, indentation width and key order to print with
+         * @return Formatted string representation of the JSON value
+         */
+        static std::string print(const JsonValue* const jsonValue, const JsonFormatOptions& options);
+
+        /**
+         * @brief Appends a JSON value to a writer with the formatter and options of the call
+         * @param writer Writer to append to
+         * @param jsonValue Pointer to the constant JSON value to print
+         * @param options Formatter type, indentation width and key order to print with
+         */
+        static void print(JsonWriter& writer, const JsonValue* const jsonValue, const JsonFormatOptions& options);
 };
 
 #endif
\ No newline at end of file
@@ -0,0 +1,71 @@
+#ifndef JSONSCHEMA
+#define JSONSCHEMA
+
+#include <string>
+#include <utility>
+#include "JsonValue.hpp"
+
+struct SchemaProgram;
+
+/**
+ * @brief JSON Schema (draft 2020-12 core and validation vocabularies) compiled once into a validation program
+ */
+class JsonSchema {
+    public:
+        /**
+         * @brief Compiles a parsed schema
+         * @param schema Root of the schema, an object or a boolean
+         * @throws std::runtime_error if the schema is malformed or uses an unsupported keyword, a pattern is not a valid regex
+         * or a $ref cannot be resolved
+         */
+        JsonSchema(const JsonValue& schema);
+
+        /**
+         * @brief Parses and compiles the text of a schema
+         * @param data Pointer to the first character of the schema's text
+         * @param length Number of characters in the text
+         * @throws std::runtime_error if the text is not valid JSON or the schema cannot be compiled
+         */
+        JsonSchema(const char* data, const size_t length);
+
+        /**
+         * @brief Deleted copy constructor
+         */
+        JsonSchema(const JsonSchema& other) = delete;
+
+        /**
+         * @brief Deleted assignment operator
+         */
+        JsonSchema& operator=(const JsonSchema& other) = delete;
+
+        /**
+         * @brief Destructor that frees the program
+         */
+        ~JsonSchema();
+
+        /**
+         * @brief Checks a value against the schema, stopping at the first failing keyword
+         * @param value Value to check
+         * @return True if the value is valid against the schema, false otherwise
+         */
+        bool isValid(const JsonValue& value) const;
+
+        /**
+         * @brief Validates a value against the schema
+         * @param value Value to validate
+         * @return Pair of boolean (valid/invalid) and a message naming the failing keyword and where it failed
+         */
+        std::pair<bool, std::string> validate(const JsonValue& value) const;
+
+        /**
+         * @brief Parses JSON text into a scratch arena and validates it against the schema
+         * @param data Pointer to the first character of the JSON text
+         * @param length Number of characters in the text
+         * @return Pair of boolean (valid/invalid) and error message string, the syntax error if the text is not valid JSON
+         */
+        std::pair<bool, std::string> validate(const char* data, const size_t length) const;
+    private:
+        SchemaProgram* program;  ///< Compiled nodes of the schema and the tables their checks refer to
+};
+
+#endif
@@ -66,6 +66,12 @@ class JsonSearcher : public JsonValueVisitor {
     private:
         std::regex regex;  ///< Regular expression pattern for searching
         std::vector<JsonValue*> searchResults;  ///< Vector storing search results
+
+        /**
+         * @brief Searches the keys of every object in an array or object, nested ones included
+         * @param root Array or object to search
+         */
+        void search(const JsonValue* root);
 };
 
 #endif
\ No newline at end of file
@@ -3,6 +3,7 @@
 
 #include <iostream>
 #include "Path.hpp"
+#include "JsonFormatConfig.hpp"
 #include "JsonValue.hpp"
 
 /**
@@ -15,8 +16,18 @@ class JsonSerializer {
          * @param json Pointer to the constant JSON value to save
          * @param stream Output stream to write to
          * @param path Optional path within the JSON to save specific part
+         * @param options Formatter type, indentation width and key order to save with
          */
-        static void save(const JsonValue* const json, std::ostream& stream, const std::string& path);
+        static void save(const JsonValue* const json, std::ostream& stream, const std::string& path, const JsonFormatOptions& options = JsonFormatOptions());
+
+        /**
+         * @brief Saves a JSON value to a writer
+         * @param json Pointer to the constant JSON value to save
+         * @param writer Writer to append to
+         * @param path Optional path within the JSON to save specific part
+         * @param options Formatter type, indentation width and key order to save with
+         */
+        static void save(const JsonValue* const json, JsonWriter& writer, const std::string& path, const JsonFormatOptions& options = JsonFormatOptions());
 };
 
 #endif
\ No newline at end of file
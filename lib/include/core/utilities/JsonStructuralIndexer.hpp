@@ -0,0 +1,98 @@
+#ifndef JSONSTRUCTURALINDEXER
+#define JSONSTRUCTURALINDEXER
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "JsonInstructionSet.hpp"
+
+/**
+ * @brief Offsets found by the structural scan of a JSON buffer
+ */
+struct StructuralIndex {
+    std::vector<uint32_t> structurals;  ///< Offsets of brackets, ':', ',', unescaped quotes and first characters of other values outside strings
+    std::vector<uint32_t> specials;     ///< Offsets of backslashes and control characters inside strings and of the first ill-formed UTF-8 sequence
+};
+
+/**
+ * @brief Opening brace/bracket left unclosed in the part of a buffer it is found in
+ */
+struct OpenBracket {
+    char brace;     ///< Opening brace/bracket character
+    size_t offset;  ///< Offset of the character in the buffer
+};
+
+/**
+ * @brief Brackets of a part of a buffer left once the pairs closed inside it are removed
+ */
+struct BracketProfile {
+    std::string closers;               ///< Closing brackets of levels opened before the part, in order
+    std::vector<OpenBracket> openers;  ///< Levels opened and not closed in the part, outermost first
+    bool isBroken = false;             ///< Whether a pair of the part mismatches or more brackets are left than the depth limit
+};
+
+/**
+ * @brief Quotes, commas and brackets of a chunk, for starting outside (0) and inside (1) a string
+ */
+struct ChunkScan {
+    bool isQuoteCountOdd = false;  ///< Whether the chunk has an odd number of unescaped quotes
+    bool hasComma[2];              ///< Whether the chunk has a comma outside strings per guess
+    size_t commas[2];              ///< Offset of the first comma outside strings per guess
+    BracketProfile heads[2];       ///< Brackets outside strings before the first comma per guess
+    BracketProfile tails[2];       ///< Brackets outside strings from the first comma on per guess
+};
+
+/**
+ * @brief Class that scans JSON text 64 bytes at a time and records where its structural characters are
+ */
+class JsonStructuralIndexer {
+    public:
+        /**
+         * @brief Checks whether a buffer is small enough for its offsets to fit in the index
+         * @param length Number of characters in the buffer
+         * @return True if the buffer can be indexed, false otherwise
+         */
+        static bool canIndex(const size_t length);
+
+        /**
+         * @brief Builds the structural index of a buffer using the widest instruction set the CPU supports
+         * @param data Pointer to the first character of the JSON text
+         * @param length Number of characters in the buffer
+         * @param result Index to fill, previous content is discarded
+         */
+        static void index(const char* data, const size_t length, StructuralIndex& result);
+
+        /**
+         * @brief Builds the structural index of a buffer using a given instruction set
+         * @param data Pointer to the first character of the JSON text
+         * @param length Number of characters in the buffer
+         * @param result Index to fill, previous content is discarded
+         * @param set Instruction set to use, Scalar is used instead if the running CPU does not support it
+         */
+        static void index(const char* data, const size_t length, StructuralIndex& result, const InstructionSet set);
+
+        /**
+         * @brief Scans a chunk of a buffer for its quotes, commas and brackets using the widest instruction set
+         * @param data Pointer to the first character of the JSON text
+         * @param begin Offset of the chunk's first character
+         * @param end Offset one past the chunk's last character
+         * @param depthLimit Number of unmatched brackets after which a profile is broken
+         * @param result Scan to fill
+         */
+        static void scanChunk(const char* data, const size_t begin, const size_t end, const size_t depthLimit, ChunkScan& result);
+
+        /**
+         * @brief Scans a chunk of a buffer for its quotes, commas and brackets using a given instruction set
+         * @param data Pointer to the first character of the JSON text
+         * @param begin Offset of the chunk's first character
+         * @param end Offset one past the chunk's last character
+         * @param depthLimit Number of unmatched brackets after which a profile is broken
+         * @param result Scan to fill
+         * @param set Instruction set to use, Scalar is used instead if the running CPU does not support it
+         */
+        static void scanChunk(const char* data, const size_t begin, const size_t end, const size_t depthLimit, ChunkScan& result,
+                              const InstructionSet set);
+};
+
+#endif
\ No newline at end of file
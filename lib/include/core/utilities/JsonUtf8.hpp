@@ -0,0 +1,30 @@
+#ifndef JSONUTF8
+#define JSONUTF8
+
+#include <cstddef>
+#include "JsonInstructionSet.hpp"
+
+/**
+ * @brief Class that checks JSON text for well-formed UTF-8, 64 bytes at a time
+ */
+class JsonUtf8 {
+    public:
+        /**
+         * @brief Finds the first ill-formed UTF-8 sequence in a range using the widest instruction set the CPU supports
+         * @param begin Pointer to the first character to check
+         * @param end Pointer one past the last character to check
+         * @return Pointer to the first byte of the first ill-formed sequence, end if the whole range is well-formed
+         */
+        static const char* findInvalid(const char* begin, const char* end);
+
+        /**
+         * @brief Finds the first ill-formed UTF-8 sequence in a range using a given instruction set
+         * @param begin Pointer to the first character to check
+         * @param end Pointer one past the last character to check
+         * @param set Instruction set to use, Scalar is used instead if the running CPU does not support it
+         * @return Pointer to the first byte of the first ill-formed sequence, end if the whole range is well-formed
+         */
+        static const char* findInvalid(const char* begin, const char* end, const InstructionSet set);
+};
+
+#endif
@@ -4,15 +4,39 @@
 #include <iostream>
 #include <string>
 #include <utility>
-#include <unordered_set>
 
 /**
- * @brief Enumeration for different JSON reading modes
+ * @brief Kinds of errors found in JSON text
  */
-enum class ReadingMode {
-    ReadingPrimary,  ///< Reading a primary value (null, boolean, number, string)
-    ReadingArray,    ///< Reading an array
-    ReadingObject    ///< Reading an object
+enum class ValidationError {
+    None,                       ///< The text is valid
+    InvalidNull,                ///< A token starting with 'n' is not null
+    InvalidBoolean,             ///< A token starting with 't' or 'f' is not true or false
+    InvalidNumber,              ///< A token starting with '-' or a digit is not a valid number
+    ControlCharacter,           ///< A string contains a control character
+    InvalidEscape,              ///< A string contains an invalid escape sequence
+    InvalidUtf8,                ///< A string contains an ill-formed UTF-8 sequence
+    UnclosedString,             ///< A string is not closed before the end of the text
+    InvalidValue,               ///< No value starts where one is expected, or another value follows the top-level value
+    AdditionalClosingBracket,   ///< A closing bracket follows the top-level value
+    MissingClosingBracket,      ///< An array or object is not closed before the end of the text
+    AdditionalComma,            ///< A comma is followed by a closing bracket
+    MismatchingClosingBracket,  ///< An array is closed by '}' or an object by ']'
+    MissingKeySeparator,        ///< A key is not followed by ':'
+    InvalidKey,                 ///< A key is not a string
+    DuplicateKey,               ///< A key appears twice in the same object
+    MissingComma,               ///< Two elements are not separated by ','
+    MaximumDepthExceeded        ///< Arrays and objects are nested deeper than the maximum depth
+};
+
+/**
+ * @brief First error found in JSON text, located by byte offset
+ */
+struct ValidationResult {
+    ValidationError error;  ///< Kind of the error, ValidationError::None when the text is valid
+    size_t offset;          ///< Offset of the character or token the error is reported at, the text's length at its end
+    size_t length;          ///< Number of characters of the offending token quoted by the message, 0 when none is quoted
+    size_t regionCount;     ///< Number of regions checked on separate threads, 0 when the text was checked on one thread
 };
 
 /**
@@ -20,77 +44,64 @@ enum class ReadingMode {
  */
 class JsonValidator {
     public:
+        static const size_t DefaultMaxDepth = 1000000;  ///< Nesting depth allowed when no other is given
+
         /**
-         * @brief Validates JSON content from an input stream
+         * @brief Validates JSON content from an input stream, reading it in fixed-size chunks
          * @param stream Input stream containing JSON data
+         * @param maxDepth Maximum number of arrays and objects enclosing each other, at least 1
          * @return Pair of boolean (valid/invalid) and error message string
          */
-        static std::pair<bool, std::string> validateJson(std::istream& stream);
-    private:
-        /**
-         * @brief Validates a JSON null value
-         * @param stream Input stream to validate
-         * @param lastSymbol Last character read
-         * @param row Current row number
-         * @param lastRowPosition Position in current row
-         * @return Pair of validation result and error message
-         */
-        static std::pair<bool, std::string> validateNull(std::istream& stream, const char lastSymbol, const size_t row, size_t& lastRowPosition);
+        static std::pair<bool, std::string> validateJson(std::istream& stream, const size_t maxDepth = DefaultMaxDepth);
 
         /**
-         * @brief Validates a JSON boolean value
-         * @param stream Input stream to validate
-         * @param lastSymbol Last character read
-         * @param row Current row number
-         * @param lastRowPosition Position in current row
-         * @return Pair of validation result and error message
+         * @brief Validates JSON content from a contiguous buffer
+         * @param data Pointer to the first character of the JSON text
+         * @param length Number of characters in the buffer
+         * @return Pair of boolean (valid/invalid) and error message string
          */
-        static std::pair<bool, std::string> validateBoolean(std::istream& stream, const char lastSymbol, const size_t row, size_t& lastRowPosition);
+        static std::pair<bool, std::string> validateJson(const char* data, const size_t length);
 
         /**
-         * @brief Validates a JSON number value
-         * @param stream Input stream to validate
-         * @param lastSymbol Last character read
-         * @param row Current row number
-         * @param lastRowPosition Position in current row
-         * @return Pair of validation result and error message
+         * @brief Validates JSON content from a contiguous buffer, splitting it between several threads
+         * @param data Pointer to the first character of the JSON text
+         * @param length Number of characters in the buffer
+         * @param threadCount Number of threads validating the buffer including the calling one, 0 to use one per hardware thread
+         * @param maxDepth Maximum number of arrays and objects enclosing each other, at least 1
+         * @return Pair of boolean (valid/invalid) and error message string, the same as validating on one thread
          */
-        static std::pair<bool, std::string> validateNumber(std::istream& stream, const char lastSymbol, const size_t row, size_t& lastRowPosition);
+        static std::pair<bool, std::string> validateJson(const char* data, const size_t length, const size_t threadCount,
+                                                         const size_t maxDepth = DefaultMaxDepth);
 
         /**
-         * @brief Validates a JSON string value
-         * @param stream Input stream to validate
-         * @param lastSymbol Last character read
-         * @param row Current row number
-         * @param lastRowPosition Position in current row
-         * @return Pair of validation result and error message
+         * @brief Finds the first error in JSON content from a contiguous buffer in a single pass
+         * @param data Pointer to the first character of the JSON text
+         * @param length Number of characters in the buffer
+         * @return First error found, ValidationError::None when the JSON is valid
          */
-        static std::pair<bool, std::string> validateString(std::istream& stream, const char lastSymbol, const size_t row, size_t& lastRowPosition);
+        static ValidationResult check(const char* data, const size_t length);
 
         /**
-         * @brief Validates a primary JSON value
-         * @param stream Input stream to validate
-         * @param symbol Current symbol being processed
-         * @param row Current row number
-         * @param position Current position in row
-         * @param stateOfReading Current reading state
-         * @param mode Current reading mode
-         * @param isCommaFound Flag indicating if comma was found
-         * @param objectKeys Set of object keys for duplicate detection
-         * @return Pair of validation result and error message
+         * @brief Finds the first error in JSON content from a contiguous buffer on several threads
+         * @param data Pointer to the first character of the JSON text
+         * @param length Number of characters in the buffer
+         * @param threadCount Number of threads checking the buffer including the calling one, 0 to use one per hardware thread
+         * @param maxDepth Maximum number of arrays and objects enclosing each other, at least 1
+         * @return First error found, the same as check on one thread reports
          */
-        static std::pair<bool, std::string> validatePrimary(std::istream& stream, const char symbol, const size_t row, size_t& position, size_t& stateOfReading, const ReadingMode& mode, bool& isCommaFound, std::unordered_set<std::string>& objectKeys);
+        static ValidationResult check(const char* data, const size_t length, const size_t threadCount,
+                                      const size_t maxDepth = DefaultMaxDepth);
 
         /**
-         * @brief Main validation function for JSON content
-         * @param stream Input stream to validate
-         * @param row Current row number
-         * @param position Current position in row
-         * @param lastBrace Last opening brace/bracket encountered
-         * @param mode Current reading mode
-         * @return Pair of validation result and error message
+         * @brief Builds the row/position message of an error found in a buffer
+         * @param data Pointer to the first character of the JSON text the error was found in
+         * @param length Number of characters in the buffer
+         * @param result Error to describe, not ValidationError::None
+         * @param maxDepth Nesting depth the text was checked against, quoted when it was exceeded
+         * @return Human-readable message of the error
          */
-        static std::pair<bool, std::string> validate(std::istream& stream, size_t& row, size_t& position, char lastBrace = '\0', const ReadingMode& mode = ReadingMode::ReadingPrimary);
+        static std::string describe(const char* data, const size_t length, const ValidationResult& result,
+                                    const size_t maxDepth = DefaultMaxDepth);
 };
 
 #endif
\ No newline at end of file
@@ -45,7 +45,7 @@ class Path {
         /**
          * @brief Extracts the key from a path
          * @param path Path to extract key from
-         * @return The extracted key
+         * @return The extracted key, escaped as the content of a JSON string
          */
         static std::string getKey(const std::string& path);
 
@@ -58,9 +58,9 @@ class Path {
         static std::string getLastPath(const JsonValue* const rootValue, const std::string& path);
 
         /**
-         * @brief Gets the root segment of a path
+         * @brief Gets the root segment of a path as an escaped key
          * @param path Path to extract root from
-         * @return The root path segment
+         * @return The root path segment, escaped as the content of a JSON string
          */
         static std::string getRoot(const std::string& path);
 
@@ -0,0 +1,235 @@
+#ifndef JSONARENA
+#define JSONARENA
+
+#include <cstddef>
+#include <string>
+
+/**
+ * @brief Chunked bump allocator owning the memory of a whole JSON document
+ */
+class JsonArena {
+    public:
+        /**
+         * @brief Makes an arena the target of JsonArena::allocate on the current thread for the lifetime of the scope
+         */
+        class Scope {
+            public:
+                /**
+                 * @brief Activates an arena, remembering the previously active one
+                 * @param arena Arena to allocate from
+                 */
+                Scope(JsonArena& arena);
+
+                /**
+                 * @brief Deleted copy constructor
+                 */
+                Scope(const Scope& other) = delete;
+
+                /**
+                 * @brief Deleted assignment operator
+                 */
+                Scope& operator=(const Scope& other) = delete;
+
+                /**
+                 * @brief Restores the previously active arena
+                 */
+                ~Scope();
+            private:
+                JsonArena* previous;  ///< Arena that was active before this scope
+        };
+
+        /**
+         * @brief Constructs an empty arena, chunks are only allocated on first use
+         */
+        JsonArena();
+
+        /**
+         * @brief Deleted copy constructor
+         */
+        JsonArena(const JsonArena& other) = delete;
+
+        /**
+         * @brief Deleted assignment operator
+         */
+        JsonArena& operator=(const JsonArena& other) = delete;
+
+        /**
+         * @brief Destructor that releases all chunks
+         */
+        ~JsonArena();
+
+        /**
+         * @brief Allocates memory from the arena active on this thread, or from the heap when there is none
+         * @param size Number of bytes to allocate
+         * @return Pointer to memory aligned for any JSON value or container node
+         */
+        static void* allocate(const size_t size);
+
+        /**
+         * @brief Frees memory returned by allocate, keeping small blocks of the active arena for reuse
+         * @param pointer Pointer returned by allocate, may be nullptr
+         * @param size Number of bytes passed to allocate
+         */
+        static void deallocate(void* pointer, const size_t size);
+
+        /**
+         * @brief Gets the arena allocate carves from on the current thread
+         * @return Active arena, nullptr when allocations go to the heap
+         */
+        static JsonArena* getActive();
+
+        /**
+         * @brief Takes over all chunks of another arena, which is left empty
+         * @param other Arena to take the chunks of
+         */
+        void adopt(JsonArena& other);
+
+        /**
+         * @brief Frees all chunks at once; everything allocated from the arena becomes invalid
+         */
+        void release();
+
+        /**
+         * @brief Gets the number of chunks currently held by the arena
+         * @return Number of chunks
+         */
+        size_t getChunkCount() const;
+    private:
+        /**
+         * @brief Header of a chunk, followed by its usable memory
+         */
+        struct Chunk {
+            Chunk* next;  ///< Previously allocated chunk
+        };
+
+        static const size_t FreeListCount = 32;  ///< Number of free lists, one per aligned size up to 256 bytes
+
+        Chunk* chunks;                     ///< Most recently allocated chunk
+        char* current;                     ///< First free byte of the most recent chunk
+        char* limit;                       ///< One past the last byte of the most recent chunk
+        size_t chunkCount;                 ///< Number of chunks held
+        size_t nextChunkSize;              ///< Usable size of the next regular chunk
+        void* freeLists[FreeListCount];    ///< Freed blocks of each size, linked through their first bytes
+
+        static thread_local JsonArena* active;  ///< Arena allocate carves from on this thread
+
+        /**
+         * @brief Bumps the current chunk, adding a new chunk when it is full
+         * @param size Number of bytes to carve, multiple of the alignment
+         * @return Pointer to the carved memory
+         */
+        void* carve(const size_t size);
+
+        /**
+         * @brief Allocates a new chunk and links it in
+         * @param size Minimum usable size of the chunk
+         * @param isDedicated Whether the chunk holds a single large allocation and leaves the current chunk in use
+         * @return Pointer to the usable memory of the chunk
+         */
+        char* addChunk(const size_t size, const bool isDedicated);
+};
+
+/**
+ * @brief Stateless standard allocator routing container storage through JsonArena::allocate
+ */
+template<typename T>
+class JsonAllocator {
+    public:
+        typedef T value_type;             ///< Allocated type
+        typedef T* pointer;               ///< Pointer to allocated type
+        typedef const T* const_pointer;   ///< Const pointer to allocated type
+        typedef T& reference;             ///< Reference to allocated type
+        typedef const T& const_reference; ///< Const reference to allocated type
+        typedef size_t size_type;         ///< Type of element counts
+        typedef ptrdiff_t difference_type;///< Type of pointer differences
+
+        /**
+         * @brief Allocator of another type
+         */
+        template<typename U>
+        struct rebind {
+            typedef JsonAllocator<U> other;  ///< Rebound allocator
+        };
+
+        /**
+         * @brief Default constructor
+         */
+        JsonAllocator() noexcept {}
+
+        /**
+         * @brief Converting constructor from an allocator of another type
+         */
+        template<typename U>
+        JsonAllocator(const JsonAllocator<U>&) noexcept {}
+
+        /**
+         * @brief Allocates storage for a number of elements
+         * @param count Number of elements
+         * @return Pointer to the storage
+         */
+        T* allocate(const size_t count) {
+            return static_cast<T*>(JsonArena::allocate(count * sizeof(T)));
+        }
+
+        /**
+         * @brief Frees storage returned by allocate
+         * @param pointer Pointer to the storage
+         * @param count Number of elements
+         */
+        void deallocate(T* pointer, const size_t count) noexcept {
+            JsonArena::deallocate(pointer, count * sizeof(T));
+        }
+};
+
+/**
+ * @brief All JsonAllocator instances are interchangeable
+ */
+template<typename T, typename U>
+inline bool operator==(const JsonAllocator<T>&, const JsonAllocator<U>&) noexcept {
+    return true;
+}
+
+/**
+ * @brief All JsonAllocator instances are interchangeable
+ */
+template<typename T, typename U>
+inline bool operator!=(const JsonAllocator<T>&, const JsonAllocator<U>&) noexcept {
+    return false;
+}
+
+/**
+ * @brief String whose characters live in the active JsonArena
+ */
+typedef std::basic_string<char, std::char_traits<char>, JsonAllocator<char>> ArenaString;
+
+/**
+ * @brief FNV-1a hash of an ArenaString, used to key containers by arena strings
+ */
+struct ArenaStringHash {
+    /**
+     * @brief Hashes a string
+     * @param value String to hash
+     * @return Hash of the string
+     */
+    size_t operator()(const ArenaString& value) const {
+        return (*this)(value.data(), value.length());
+    }
+
+    /**
+     * @brief Hashes a range of characters the same way as a string holding them
+     * @param data Pointer to the first character
+     * @param length Number of characters
+     * @return Hash of the characters
+     */
+    size_t operator()(const char* data, const size_t length) const {
+        unsigned long long hash = 14695981039346656037ULL;
+
+        for(size_t i = 0; i < length; i++) {
+            hash = (hash ^ static_cast<unsigned char>(data[i])) * 1099511628211ULL;
+        }
+
+        return static_cast<size_t>(hash);
+    }
+};
+
+#endif
\ No newline at end of file
@@ -3,6 +3,7 @@
 
 #include <vector>
 #include "JsonValue.hpp"
+#include "JsonSource.hpp"
 
 /**
  * @brief Class representing a JSON array
@@ -10,6 +11,11 @@
  */
 class JsonArray : public JsonValue {
     public:
+        /**
+         * @brief Storage of the array elements, carved from the active JsonArena
+         */
+        typedef std::vector<JsonValue*, JsonAllocator<JsonValue*>> Values;
+
         /**
          * @brief Gets the type of JSON value
          * @return ValueType of the array
@@ -28,6 +34,12 @@ class JsonArray : public JsonValue {
          */
         void print(std::ostream& stream) const override;
 
+        /**
+         * @brief Appends array content to a writer
+         * @param writer Writer to append to
+         */
+        void print(JsonWriter& writer) const override;
+
         /**
          * @brief Accepts a visitor for the Visitor pattern
          * @param visitor Reference to the visitor
@@ -45,6 +57,18 @@ class JsonArray : public JsonValue {
          */
         JsonArray(const std::vector<JsonValue*>& _arrayData);
 
+        /**
+         * @brief Constructor taking ownership of JSON values without cloning them
+         * @param _arrayData Storage of pointers to JSON values to take over
+         */
+        JsonArray(Values&& _arrayData);
+
+        /**
+         * @brief Constructor of an array whose elements are parsed from its source when first accessed
+         * @param _unparsed Span of the array's text, carved from the active JsonArena
+         */
+        JsonArray(JsonSpan* _unparsed);
+
         /**
          * @brief Copy constructor
          * @param other Array to copy from
@@ -101,20 +125,40 @@ class JsonArray : public JsonValue {
          * @param value Pointer to the JSON value to add
          */
         void addValue(const JsonValue* const value);     
+
+        /**
+         * @brief Parses the elements from the source if they were not parsed yet
+         * @throws std::runtime_error if the source text is invalid
+         */
+        void load() const;
+    protected:
+        /**
+         * @brief Copies the array with empty elements, leaving a task in the list for each of them
+         * @param pending List to append the elements' tasks to
+         * @return Pointer to the copy
+         */
+        JsonValue* cloneShallow(std::vector<CloneTask>& pending) const override;
+
+        /**
+         * @brief Moves the elements to the end of a list, leaving the array empty
+         * @param children List to append the elements to
+         */
+        void releaseChildren(std::vector<JsonValue*>& children) override;
     private:
-        std::vector<JsonValue*> values;  ///< Vector storing JSON values
+        Values values;                         ///< Vector storing JSON values
+        mutable JsonSpan* unparsed = nullptr;  ///< Text of the elements while not parsed yet, nullptr once they are
 
         /**
-         * @brief Copies data from another array
-         * @param _arrayData Vector of JSON values to copy
+         * @brief Drops the unparsed text without parsing it
          */
-        void copyData(const std::vector<JsonValue*>& _arrayData);
+        void discardUnparsed();
 
         /**
-         * @brief Resets array data
-         * @param _arrayData Vector of JSON values to reset with
+         * @brief Copies data from another array
+         * @param _arrayData Pointer to the first JSON value to copy
+         * @param size Number of JSON values to copy
          */
-        void resetData(std::vector<JsonValue*>& _arrayData);
+        void copyData(JsonValue* const* _arrayData, const size_t size);
 
         /**
          * @brief Deletes all values in the array
@@ -15,6 +15,12 @@ class JsonBoolean : public JsonValue {
          */
         JsonBoolean(const bool _value);
 
+        /**
+         * @brief Gets the stored boolean value
+         * @return The boolean value
+         */
+        bool getValue() const;
+
         /**
          * @brief Gets the type of JSON value
          * @return ValueType of the boolean
@@ -33,6 +39,12 @@ class JsonBoolean : public JsonValue {
          */
         void print(std::ostream& stream) const override;
 
+        /**
+         * @brief Appends boolean value to a writer
+         * @param writer Writer to append to
+         */
+        void print(JsonWriter& writer) const override;
+
         /**
          * @brief Accepts a visitor for the Visitor pattern
          * @param visitor Reference to the visitor
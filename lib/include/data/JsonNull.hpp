@@ -27,6 +27,12 @@ class JsonNull : public JsonValue {
          */
         void print(std::ostream& stream) const override;
 
+        /**
+         * @brief Appends null value to a writer
+         * @param writer Writer to append to
+         */
+        void print(JsonWriter& writer) const override;
+
         /**
          * @brief Accepts a visitor for the Visitor pattern
          * @param visitor Reference to the visitor
@@ -1,10 +1,20 @@
 #ifndef JSONNUMBER
 #define JSONNUMBER
 
+#include <cstdint>
 #include "JsonValue.hpp"
 
 /**
- * @brief Class representing a JSON number value
+ * @brief Binary representation a JSON number is stored in
+ */
+enum class NumberType {
+    Integer,          ///< Integer that fits int64_t
+    UnsignedInteger,  ///< Integer above INT64_MAX that fits uint64_t
+    Double            ///< Any other number, stored as the nearest double
+};
+
+/**
+ * @brief Class representing a JSON number value stored in binary
  * @inherit JsonValue
  */
 class JsonNumber : public JsonValue {
@@ -15,6 +25,73 @@ class JsonNumber : public JsonValue {
          */
         JsonNumber(const std::string& _value);
 
+        /**
+         * @brief Constructor that initializes the number value from a range of characters
+         * @param data Pointer to the first character of the value
+         * @param length Number of characters in the value
+         */
+        JsonNumber(const char* data, const size_t length);
+
+        /**
+         * @brief Constructor that initializes the number from a computed double
+         * @param _value Value of the number, printed as the shortest decimal that reads back as it
+         */
+        JsonNumber(const double _value);
+
+        /**
+         * @brief Constructor that initializes the number from a computed signed integer
+         * @param _value Value of the number
+         */
+        JsonNumber(const int _value);
+
+        /**
+         * @brief Constructor that initializes the number from a computed signed integer
+         * @param _value Value of the number
+         */
+        JsonNumber(const long _value);
+
+        /**
+         * @brief Constructor that initializes the number from a computed signed integer
+         * @param _value Value of the number
+         */
+        JsonNumber(const long long _value);
+
+        /**
+         * @brief Constructor that initializes the number from a computed unsigned integer
+         * @param _value Value of the number
+         */
+        JsonNumber(const unsigned int _value);
+
+        /**
+         * @brief Constructor that initializes the number from a computed unsigned integer
+         * @param _value Value of the number
+         */
+        JsonNumber(const unsigned long _value);
+
+        /**
+         * @brief Constructor that initializes the number from a computed unsigned integer
+         * @param _value Value of the number
+         */
+        JsonNumber(const unsigned long long _value);
+
+        /**
+         * @brief Copy constructor
+         * @param other Number to copy from
+         */
+        JsonNumber(const JsonNumber& other);
+
+        /**
+         * @brief Copy assignment operator
+         * @param other Number to copy from
+         * @return Reference to this number
+         */
+        JsonNumber& operator=(const JsonNumber& other);
+
+        /**
+         * @brief Destructor that frees the kept source text
+         */
+        ~JsonNumber();
+
         /**
          * @brief Gets the type of JSON value
          * @return ValueType of the number
@@ -33,13 +110,70 @@ class JsonNumber : public JsonValue {
          */
         void print(std::ostream& stream) const override;
 
+        /**
+         * @brief Appends number value to a writer
+         * @param writer Writer to append to
+         */
+        void print(JsonWriter& writer) const override;
+
         /**
          * @brief Accepts a visitor for the Visitor pattern
          * @param visitor Reference to the visitor
          */
         void accept(JsonValueVisitor& visitor) override;
+
+        /**
+         * @brief Gets the binary representation the number is stored in
+         * @return NumberType of the number
+         */
+        NumberType getNumberType() const;
+
+        /**
+         * @brief Gets the number as a signed 64-bit integer
+         * @return Value of the number
+         * @throws std::out_of_range if the number is not an integer that fits int64_t
+         */
+        int64_t getInt64() const;
+
+        /**
+         * @brief Gets the number as an unsigned 64-bit integer
+         * @return Value of the number
+         * @throws std::out_of_range if the number is not an integer that fits uint64_t
+         */
+        uint64_t getUint64() const;
+
+        /**
+         * @brief Gets the number as a double, rounding integers above 2^53 to the nearest double
+         * @return Value of the number
+         */
+        double getDouble() const;
     private:
-        std::string value;  ///< String representation of the number value
+        NumberType type;  ///< Which member of the union holds the value
+        union {
+            int64_t integer;           ///< Value of a NumberType::Integer
+            uint64_t unsignedInteger;  ///< Value of a NumberType::UnsignedInteger
+            double floating;           ///< Value of a NumberType::Double
+        };
+        char* text;  ///< Null-terminated source text, nullptr when printing the binary value reproduces it
+
+        /**
+         * @brief Converts a number token and keeps its text if needed
+         * @param data Pointer to the first character of the token
+         * @param length Number of characters in the token
+         */
+        void setValue(const char* data, const size_t length);
+
+        /**
+         * @brief Copies the source text into memory from JsonArena::allocate
+         * @param data Pointer to the first character of the text, may be nullptr
+         * @param length Number of characters in the text
+         */
+        void setText(const char* data, const size_t length);
+
+        /**
+         * @brief Frees the kept source text
+         */
+        void releaseText();
 };
 
 
@@ -1,10 +1,12 @@
 #ifndef JSONOBJECT
 #define JSONOBJECT
 
+#include <cstdint>
 #include <list>
 #include <unordered_map>
 #include <vector>
 #include "JsonValue.hpp"
+#include "JsonSource.hpp"
 
 /**
  * @brief Class representing a JSON object containing key-value pairs
@@ -12,6 +14,72 @@
  */
 class JsonObject : public JsonValue {
     public:
+        /**
+         * @brief Key-value pair of the object
+         */
+        struct Entry {
+            ArenaString key;   ///< Key of the pair
+            JsonValue* value;  ///< Owned value of the pair, nullptr for a removed pair awaiting compaction
+        };
+
+        /**
+         * @brief Entries of the object in insertion order, carved from the active JsonArena
+         */
+        typedef std::vector<Entry, JsonAllocator<Entry>> Entries;
+
+        /**
+         * @brief Forward iterator over the key-value pairs in insertion order, skipping removed pairs
+         */
+        class ConstIterator {
+            public:
+                /**
+                 * @brief Constructs an iterator positioned on the first pair in a range that is not removed
+                 * @param _current Entry to start from
+                 * @param _end One past the last entry of the object
+                 */
+                ConstIterator(const Entry* _current, const Entry* _end);
+
+                /**
+                 * @brief Gets the pair the iterator is positioned on
+                 * @return Reference to the pair
+                 */
+                const Entry& operator*() const;
+
+                /**
+                 * @brief Gets the pair the iterator is positioned on
+                 * @return Pointer to the pair
+                 */
+                const Entry* operator->() const;
+
+                /**
+                 * @brief Advances to the next pair that is not removed
+                 * @return Reference to this iterator
+                 */
+                ConstIterator& operator++();
+
+                /**
+                 * @brief Checks if two iterators are positioned on the same pair
+                 * @param other Iterator to compare with
+                 * @return True if both are on the same pair, false otherwise
+                 */
+                bool operator==(const ConstIterator& other) const;
+
+                /**
+                 * @brief Checks if two iterators are positioned on different pairs
+                 * @param other Iterator to compare with
+                 * @return True if they are on different pairs, false otherwise
+                 */
+                bool operator!=(const ConstIterator& other) const;
+            private:
+                const Entry* current;  ///< Entry the iterator is positioned on
+                const Entry* end;      ///< One past the last entry of the object
+
+                /**
+                 * @brief Moves forward until a pair that is not removed or the end is reached
+                 */
+                void skipRemoved();
+        };
+
         /**
          * @brief Gets the type of JSON value
          * @return ValueType of the object
@@ -30,6 +98,12 @@ class JsonObject : public JsonValue {
          */
         void print(std::ostream& stream) const override;
 
+        /**
+         * @brief Appends object content to a writer
+         * @param writer Writer to append to
+         */
+        void print(JsonWriter& writer) const override;
+
         /**
          * @brief Accepts a visitor for the Visitor pattern
          * @param visitor Reference to the visitor
@@ -39,7 +113,7 @@ class JsonObject : public JsonValue {
         /**
          * @brief Default constructor
          */
-        JsonObject() = default;
+        JsonObject();
 
         /**
          * @brief Constructor from keys and values
@@ -48,6 +122,25 @@ class JsonObject : public JsonValue {
          */
         JsonObject(const std::list<std::string>& _keys, const std::unordered_map<std::string, JsonValue*>& _objectData);
 
+        /**
+         * @brief Constructor taking ownership of the values without cloning them, the keys are copied
+         * @param _keys List of keys
+         * @param _objectData Map of key-value pairs whose values to take over
+         */
+        JsonObject(std::list<std::string>&& _keys, std::unordered_map<std::string, JsonValue*>&& _objectData);
+
+        /**
+         * @brief Constructor taking ownership of key-value pairs without copying them
+         * @param _entries Pairs with unique keys to take over, in insertion order
+         */
+        JsonObject(Entries&& _entries);
+
+        /**
+         * @brief Constructor of an object whose key-value pairs are parsed from its source when first accessed
+         * @param _unparsed Span of the object's text, carved from the active JsonArena
+         */
+        JsonObject(JsonSpan* _unparsed);
+
         /**
          * @brief Copy constructor
          * @param other Object to copy from
@@ -111,6 +204,13 @@ class JsonObject : public JsonValue {
          */
         void addKVP(const std::string& key, const JsonValue* const value);
 
+        /**
+         * @brief Adds a key-value pair taking ownership of the value instead of cloning it
+         * @param key Key to add
+         * @param value Pointer to value to take ownership of
+         */
+        void adoptKVP(const std::string& key, JsonValue* const value);
+
         /**
          * @brief Edits an existing key-value pair
          * @param key Key to edit
@@ -118,39 +218,128 @@ class JsonObject : public JsonValue {
          */
         void editKVP(const std::string& key, const JsonValue* const value);
 
+        /**
+         * @brief Replaces the value of an existing key-value pair with one the object takes ownership of
+         * @param key Key to edit
+         * @param value Pointer to value to take ownership of
+         * @return Pointer to the previous value, now owned by the caller
+         */
+        JsonValue* exchangeKVP(const std::string& key, JsonValue* const value);
+
         /**
          * @brief Removes a key-value pair
          * @param key Key to remove
          */
         void removeKVP(const std::string& key);
 
+        /**
+         * @brief Removes a key-value pair handing its value over instead of deleting it
+         * @param key Key to remove
+         * @return Pointer to the value, now owned by the caller
+         */
+        JsonValue* releaseKVP(const std::string& key);
+
         /**
          * @brief Gets the value associated with a key
          * @param key Key to look up
          * @return Const pointer to the value
          */
         const JsonValue* getValue(const std::string& key) const;
+
+        /**
+         * @brief Gets an iterator to the first key-value pair in insertion order
+         * @return Iterator to the first pair
+         */
+        ConstIterator begin() const;
+
+        /**
+         * @brief Gets an iterator past the last key-value pair
+         * @return Iterator past the last pair
+         */
+        ConstIterator end() const;
+
+        /**
+         * @brief Parses the key-value pairs from the source if they were not parsed yet
+         * @throws std::runtime_error if the source text is invalid
+         */
+        void load() const;
+    protected:
+        /**
+         * @brief Copies the object with empty values, leaving a task in the list for each of them
+         * @param pending List to append the values' tasks to
+         * @return Pointer to the copy
+         */
+        JsonValue* cloneShallow(std::vector<CloneTask>& pending) const override;
+
+        /**
+         * @brief Moves the values to the end of a list, leaving the object empty
+         * @param children List to append the values to
+         */
+        void releaseChildren(std::vector<JsonValue*>& children) override;
     private:
-        std::list<std::string> keys;  ///< List of keys maintaining insertion order
-        std::unordered_map<std::string, JsonValue*> values;  ///< Map of key-value pairs
+        /**
+         * @brief Slots of the hash index, each 0 when empty or the position of an entry plus one
+         */
+        typedef std::vector<uint32_t, JsonAllocator<uint32_t>> Index;
+
+        Entries entries;                       ///< Key-value pairs in insertion order, including removed pairs awaiting compaction
+        Index index;                           ///< Open-addressing hash index into entries, empty while the object is small
+        size_t removedCount;                   ///< Number of removed pairs still in entries
+        mutable JsonSpan* unparsed = nullptr;  ///< Text of the pairs while not parsed yet, nullptr once they are
+
+        /**
+         * @brief Drops the unparsed text without parsing it
+         */
+        void discardUnparsed();
 
         /**
-         * @brief Copies data from another object
+         * @brief Copies data from keys and values given as standard containers
          * @param _keys List of keys to copy
          * @param _objectData Map of values to copy
          */
         void copyData(const std::list<std::string>& _keys, const std::unordered_map<std::string, JsonValue*>& _objectData);
 
         /**
-         * @brief Resets object data
-         * @param _objectData Map of new values
+         * @brief Copies data from another object, dropping removed pairs
+         * @param other Object to copy from
          */
-        void resetData(std::unordered_map<std::string, JsonValue*>& _objectData);
+        void copyData(const JsonObject& other);
 
         /**
-         * @brief Deletes all values in the object
+         * @brief Deletes all values in the object and empties it
          */
         void deleteData();
+
+        /**
+         * @brief Finds the entry holding a key
+         * @param data Pointer to the first character of the key
+         * @param length Number of characters in the key
+         * @return Position of the entry, entries.size() if the key does not exist
+         */
+        size_t find(const char* data, const size_t length) const;
+
+        /**
+         * @brief Appends a key-value pair and indexes it, the key must not exist yet
+         * @param key Key to add
+         * @param value Value to take ownership of
+         */
+        void append(ArenaString&& key, JsonValue* value);
+
+        /**
+         * @brief Adds an entry to the hash index
+         * @param position Position of the entry
+         */
+        void insertIntoIndex(const size_t position);
+
+        /**
+         * @brief Rebuilds the hash index for the current entries, or drops it if the object is small
+         */
+        void rebuildIndex();
+
+        /**
+         * @brief Removes the pairs marked as removed from entries and rebuilds the index
+         */
+        void compact();
 };
 
 
@@ -0,0 +1,47 @@
+#ifndef JSONSOURCE
+#define JSONSOURCE
+
+#include <cstddef>
+
+class JsonArray;
+class JsonObject;
+
+/**
+ * @brief Abstract source of the text of a lazily parsed document
+ */
+class JsonSource {
+    public:
+        /**
+         * @brief Parses the elements of an array, leaving nested arrays and objects unparsed
+         * @param array Array to fill
+         * @param begin Offset of the opening bracket in the document
+         * @param end Offset one past the closing bracket
+         * @throws std::runtime_error with the validator's message if the document is invalid
+         */
+        virtual void load(JsonArray& array, const size_t begin, const size_t end) = 0;
+
+        /**
+         * @brief Parses the key-value pairs of an object, leaving nested arrays and objects unparsed
+         * @param object Object to fill
+         * @param begin Offset of the opening brace in the document
+         * @param end Offset one past the closing brace
+         * @throws std::runtime_error with the validator's message if the document is invalid
+         */
+        virtual void load(JsonObject& object, const size_t begin, const size_t end) = 0;
+
+        /**
+         * @brief Virtual destructor
+         */
+        virtual ~JsonSource() = default;
+};
+
+/**
+ * @brief Text of an array or object that has not been parsed yet
+ */
+struct JsonSpan {
+    JsonSource* source;  ///< Document the text belongs to
+    size_t begin;        ///< Offset of the opening brace/bracket in the document
+    size_t end;          ///< Offset one past the closing brace/bracket
+};
+
+#endif
@@ -4,7 +4,7 @@
 #include "JsonValue.hpp"
 
 /**
- * @brief Class representing a JSON string value
+ * @brief Class representing a JSON string value as its raw token, owned or borrowed from the document
  * @inherit JsonValue
  */
 class JsonString : public JsonValue {
@@ -15,6 +15,44 @@ class JsonString : public JsonValue {
          */
         JsonString(const std::string& _value);
 
+        /**
+         * @brief Constructor that initializes the string value from a range of characters
+         * @param data Pointer to the first character of the value
+         * @param _length Number of characters in the value
+         * @param _isBorrowed Whether the string refers to the characters instead of copying them; they must then outlive it
+         */
+        JsonString(const char* data, const size_t _length, const bool _isBorrowed = false);
+
+        /**
+         * @brief Copy constructor, the copy always owns its characters
+         * @param other String to copy from
+         */
+        JsonString(const JsonString& other);
+
+        /**
+         * @brief Copy assignment operator, the string always owns its characters afterwards
+         * @param other String to copy from
+         * @return Reference to this string
+         */
+        JsonString& operator=(const JsonString& other);
+
+        /**
+         * @brief Destructor that frees the owned characters
+         */
+        ~JsonString();
+
+        /**
+         * @brief Gets the raw token of the string, quotes and escapes included
+         * @return Pointer to the opening quote
+         */
+        const char* getText() const;
+
+        /**
+         * @brief Gets the number of characters in the raw token
+         * @return Length of the token, quotes included
+         */
+        size_t getLength() const;
+
         /**
          * @brief Gets the type of JSON value
          * @return ValueType of the string
@@ -33,13 +71,28 @@ class JsonString : public JsonValue {
          */
         void print(std::ostream& stream) const override;
 
+        /**
+         * @brief Appends string value to a writer
+         * @param writer Writer to append to
+         */
+        void print(JsonWriter& writer) const override;
+
         /**
          * @brief Accepts a visitor for the Visitor pattern
          * @param visitor Reference to the visitor
          */
         void accept(JsonValueVisitor& visitor) override;
     private:
-        std::string value;  ///< The stored string value
+        const char* text;  ///< Raw token, quotes included
+        size_t length;     ///< Number of characters in the token
+        bool isBorrowed;   ///< Whether text points into the document's text instead of storage owned by the string
+
+        /**
+         * @brief Copies characters into storage owned by the string
+         * @param data Pointer to the first character to copy
+         * @param _length Number of characters to copy
+         */
+        void setText(const char* data, const size_t _length);
 };
 
 
@@ -3,8 +3,11 @@
 
 #include <iostream>
 #include <string>
+#include <vector>
+#include "JsonArena.hpp"
 
 class JsonValueVisitor;
+class JsonWriter;
 
 /**
  * @brief Enumeration of possible JSON value types
@@ -41,6 +44,12 @@ class JsonValue {
          */
         virtual void print(std::ostream& stream) const = 0;
 
+        /**
+         * @brief Appends JSON value to a writer
+         * @param writer Writer to append to
+         */
+        virtual void print(JsonWriter& writer) const = 0;
+
         /**
          * @brief Accepts a visitor for the Visitor pattern
          * @param visitor Reference to the visitor
@@ -51,6 +60,54 @@ class JsonValue {
          * @brief Virtual destructor
          */
         virtual ~JsonValue() = default;
+
+        /**
+         * @brief Allocates JSON values from the active JsonArena, or from the heap when none is active
+         * @param size Size of the value in bytes
+         * @return Pointer to the allocated memory
+         */
+        static void* operator new(const size_t size);
+
+        /**
+         * @brief Frees a JSON value allocated by operator new, see JsonArena::deallocate
+         * @param pointer Pointer to the value
+         * @param size Size of the value in bytes
+         */
+        static void operator delete(void* pointer, const size_t size);
+    protected:
+        /**
+         * @brief Value still to be copied by cloneTree and the place its copy goes to
+         */
+        struct CloneTask {
+            const JsonValue* source;  ///< Value to copy
+            JsonValue** target;       ///< Place the copy is stored in
+        };
+
+        /**
+         * @brief Copies the value without its children, leaving a task in the list for each of them
+         * @param pending List to append the children's tasks to
+         * @return Pointer to the copy
+         */
+        virtual JsonValue* cloneShallow(std::vector<CloneTask>& pending) const;
+
+        /**
+         * @brief Deep copies a value together with everything nested in it without recursing into the nesting
+         * @param value Value to copy
+         * @return Pointer to the copy
+         */
+        static JsonValue* cloneTree(const JsonValue* value);
+
+        /**
+         * @brief Moves the children of an array or object to the end of a list, leaving it empty; other values have none
+         * @param children List to append the children to
+         */
+        virtual void releaseChildren(std::vector<JsonValue*>& children);
+
+        /**
+         * @brief Deletes values together with everything nested in them without recursing into the nesting
+         * @param values Values to delete, left empty
+         */
+        static void deleteTrees(std::vector<JsonValue*>& values);
 };
 
 /**
@@ -1,6 +1,38 @@
 #include "Json.hpp"
 #include "JsonFactory.hpp"
 #include "Path.hpp"
+#include "JsonStreamWriter.hpp"
+
+/**
+ * @brief Anonymous namespace for loading lazily parsed values before they are written
+ */
+namespace {
+    /**
+     * @brief Parses every array and object nested in a value that was not parsed yet
+     * @param value Value to load
+     * @throws std::runtime_error if the text of a nested value is invalid
+     */
+    void loadTree(const JsonValue* value) {
+        std::vector<const JsonValue*> pending(1, value);
+
+        while(!pending.empty()) {
+            const JsonValue* current = pending.back();
+            pending.pop_back();
+
+            if(current -> getType() == ValueType::Array) {
+                const JsonArray* array = static_cast<const JsonArray*>(current);
+
+                for(size_t i = 0; i < array -> getSize(); i++) {
+                    pending.push_back((*array)[i]);
+                }
+            } else if(current -> getType() == ValueType::Object) {
+                for(const JsonObject::Entry& entry : *static_cast<const JsonObject*>(current)) {
+                    pending.push_back(entry.value);
+                }
+            }
+        }
+    }
+}
 
 /**
  * @brief Constructor that initializes JSON from input stream
@@ -8,45 +40,95 @@
  * @throws std::runtime_error if stream is empty or JSON is invalid
  */
 Json::Json(std::istream& stream) {
-    const std::string content = readStreamContent(stream);
+    if(stream.peek() == std::char_traits<char>::eof()) {
+        throw std::runtime_error("Empty stream!");
+    }
+
+    JsonArena::Scope scope(arena);
 
-    if(content == "") {
+    json = JsonParser::parseValidated(stream);
+}
+
+/**
+ * @brief Constructor that initializes JSON from a contiguous buffer without copying it
+ * @param data Pointer to the first character of the JSON text
+ * @param length Number of characters in the buffer
+ * @throws std::runtime_error if the buffer is empty or JSON is invalid
+ */
+Json::Json(const char* data, const size_t length) {
+    if(length == 0) {
         throw std::runtime_error("Empty stream!");
     }
 
-    std::istringstream contentStream(content);
-    std::pair<bool, std::string> isValid = JsonValidator::validateJson(contentStream);
+    JsonArena::Scope scope(arena);
 
-    if(!isValid.first) {
-        throw std::runtime_error(isValid.second);
+    json = JsonParser::parseValidated(data, length);
+}
+
+/**
+ * @brief Constructor that initializes JSON from an opened file, eagerly on several threads or lazily
+ * @param file Opened file, whose content is taken over by the document and left closed
+ * @param isLazy Whether arrays and objects are only parsed when first accessed
+ * @param threadCount Number of threads parsing an eager document, 0 to use one per hardware thread
+ * @throws std::runtime_error if the file is empty or, when eager or a top-level primitive, JSON is invalid
+ */
+Json::Json(JsonFile& file, const bool isLazy, const size_t threadCount) {
+    if(file.getLength() == 0) {
+        throw std::runtime_error("Empty stream!");
     }
-    
-    contentStream.clear();
-    contentStream.str(content);
-    contentStream.seekg(0);
-    
-    json = JsonParser::parse(contentStream);
 
+    JsonArena::Scope scope(arena);
+
+    source.swap(file);
+
+    if(!isLazy) {
+        JsonParallelParser parser(threadCount, true);
+        json = parser.parse(source.getData(), source.getLength());
+        return;
+    }
+
+    lazy = new JsonLazySource(source.getData(), source.getLength(), arena);
+
+    try {
+        json = JsonParser::parseLazy(source.getData(), source.getLength(), lazy);
+    }
+    catch(...) {
+        delete lazy;
+        throw;
+    }
 }
 
 /**
- * @brief Destructor that cleans up JSON data
+ * @brief Destructor, frees the whole document by releasing its arena
  */
 Json::~Json() {
-    delete json;
     json = nullptr;
+    delete lazy;
 }
 
 /**
- * @brief Validates JSON content from input stream
+ * @brief Validates JSON content from input stream, reading it in fixed-size chunks instead of as a whole
  * @param stream Input stream to validate
  * @return Validation result message
  */
 std::string Json::validate(std::istream& stream) {
-    const std::string content = readStreamContent(stream);
+    std::pair<bool, std::string> isValid = JsonValidator::validateJson(stream);
+
+    if(isValid.first) {
+        return "The json is valid!";
+    }
 
-    std::istringstream contentStream(content);
-    std::pair<bool, std::string> isValid = JsonValidator::validateJson(contentStream);
+    return isValid.second;
+}
+
+/**
+ * @brief Validates the content of an opened file straight from its mapping, on several threads
+ * @param file Opened file to validate
+ * @param threadCount Number of threads validating the file, 0 to use one per hardware thread
+ * @return Validation result message
+ */
+std::string Json::validate(const JsonFile& file, const size_t threadCount) {
+    std::pair<bool, std::string> isValid = JsonValidator::validateJson(file.getData(), file.getLength(), threadCount);
 
     if(isValid.first) {
         return "The json is valid!";
@@ -56,19 +138,49 @@ std::string Json::validate(std::istream& stream) {
 }
 
 /**
- * @brief Prints JSON content to output stream in compact format
+ * @brief Prints JSON content to output stream in compact format, loading a lazy document first
  * @param stream Output stream to print to
+ * @throws std::runtime_error if the document is lazy and its text is invalid
  */
 void Json::print(std::ostream& stream) {
-    stream << JsonPrinter::print(json);
+    if(lazy != nullptr) {
+        loadTree(json);
+    }
+
+    JsonStreamWriter writer(stream);
+
+    JsonPrinter::print(writer, json);
 }
 
 /**
- * @brief Prints JSON content to output stream in pretty format
+ * @brief Prints JSON content to output stream in pretty format, loading a lazy document first
  * @param stream Output stream to print to
+ * @throws std::runtime_error if the document is lazy and its text is invalid
  */
 void Json::prettyPrint(std::ostream& stream) {
-    stream << JsonPrinter::prettyPrint(json);
+    if(lazy != nullptr) {
+        loadTree(json);
+    }
+
+    JsonStreamWriter writer(stream);
+
+    JsonPrinter::prettyPrint(writer, json);
+}
+
+/**
+ * @brief Prints JSON content to output stream with the formatter and options of the call
+ * @param stream Output stream to print to
+ * @param options Formatter type, indentation width and key order to print with
+ * @throws std::runtime_error if the document is lazy and its text is invalid
+ */
+void Json::print(std::ostream& stream, const JsonFormatOptions& options) {
+    if(lazy != nullptr) {
+        loadTree(json);
+    }
+
+    JsonStreamWriter writer(stream);
+
+    JsonPrinter::print(writer, json, options);
 }
 
 /**
@@ -97,8 +209,9 @@ void Json::search(std::ostream& stream, const std::string& searchRegex) {
     }
 
     JsonValue* arrayWithResults = JsonFactory::create(searchResults);
+    JsonStreamWriter writer(stream);
 
-    stream << JsonPrinter::prettyPrint(arrayWithResults);
+    JsonPrinter::prettyPrint(writer, arrayWithResults);
 
     delete arrayWithResults;
 
@@ -122,15 +235,14 @@ void Json::set(const std::string& path, const std::string& value) {
         throw std::runtime_error(errorMessageSteam.str());
     }
 
-    std::istringstream valueStream(value);
-
-    std::pair<bool, std::string> isValid = JsonValidator::validateJson(valueStream);
+    std::pair<bool, std::string> isValid = JsonValidator::validateJson(value.data(), value.length());
 
     if(!isValid.first) {
         const std::string message = "Invalid value! " + isValid.second;
         throw std::runtime_error(message);
     }
 
+    JsonArena::Scope scope(arena);
     JsonEditor editor(json);
 
     json -> accept(editor);
@@ -156,15 +268,14 @@ void Json::create(const std::string& path, const std::string& value) {
         throw std::runtime_error("Cannot perform create on path to already existing element!");
     }
 
-    std::istringstream valueStream(value);
-
-    std::pair<bool, std::string> isValid = JsonValidator::validateJson(valueStream);
+    std::pair<bool, std::string> isValid = JsonValidator::validateJson(value.data(), value.length());
 
     if(!isValid.first) {
         const std::string message = "Invalid value! " + isValid.second;
         throw std::runtime_error(message);
     }
 
+    JsonArena::Scope scope(arena);
     JsonEditor editor(json);
 
     json -> accept(editor);
@@ -189,6 +300,7 @@ void Json::erase(const std::string& path) {
         throw std::runtime_error("Cannot perform delete on path to non-existing element!");
     }
 
+    JsonArena::Scope scope(arena);
     JsonEditor editor(json);
 
     json -> accept(editor);
@@ -218,6 +330,7 @@ void Json::move(const std::string& from, const std::string& to) {
         throw std::runtime_error("Cannot perform move on path to non-existing element!");
     }
 
+    JsonArena::Scope scope(arena);
     JsonEditor editor(json);
 
     json -> accept(editor);
@@ -226,24 +339,39 @@ void Json::move(const std::string& from, const std::string& to) {
 }
 
 /**
- * @brief Saves JSON content to output stream
+ * @brief Saves JSON content to output stream, loading the saved part of a lazy document first
  * @param stream Output stream to save to
  * @param path Optional path to save specific part
- * @throws std::runtime_error if path is invalid
+ * @param options Formatter type, indentation width and key order to save with
+ * @throws std::runtime_error if path is invalid or, in a lazy document, the text of the saved part is invalid
  */
-void Json::save(std::ostream& stream, const std::string& path) {
+void Json::save(std::ostream& stream, const std::string& path, const JsonFormatOptions& options) {
     if(!(Path::validatePath(json, path))) {
         throw std::runtime_error("Cannot perform save on path to non-existing element!");
     }
 
-    JsonSerializer::save(json, stream, path);
+    if(lazy != nullptr) {
+        loadTree(Path::getValue(json, path));
+    }
+
+    JsonSerializer::save(json, stream, path, options);
 }
 
 /**
- * @brief Helper method to read entire stream content
- * @param stream Input stream to read from
- * @return String containing stream content
+ * @brief Saves JSON content to a writer, loading the saved part of a lazy document first
+ * @param writer Writer to append to
+ * @param path Optional path to save specific part
+ * @param options Formatter type, indentation width and key order to save with
+ * @throws std::runtime_error if path is invalid or, in a lazy document, the text of the saved part is invalid
  */
-std::string Json::readStreamContent(std::istream& stream) {
-    return std::string((std::istreambuf_iterator<char>(stream)), std::istreambuf_iterator<char>());
+void Json::save(JsonWriter& writer, const std::string& path, const JsonFormatOptions& options) {
+    if(!(Path::validatePath(json, path))) {
+        throw std::runtime_error("Cannot perform save on path to non-existing element!");
+    }
+
+    if(lazy != nullptr) {
+        loadTree(Path::getValue(json, path));
+    }
+
+    JsonSerializer::save(json, writer, path, options);
 }
\ No newline at end of file
@@ -1,5 +1,7 @@
-#include <sstream>
+#include <stdexcept>
+#include <vector>
 #include "CompactJsonFormatter.hpp"
+#include "JsonStringWriter.hpp"
 
 /**
  * @brief Gets the singleton instance of CompactJsonFormatter
@@ -14,93 +16,141 @@ CompactJsonFormatter& CompactJsonFormatter::getInstance() {
  * @brief Formats a JsonArray into a compact string representation
  * @param value Pointer to the JsonArray to format
  * @param indent Indentation level (unused in compact format)
+ * @param options Options of the call
  * @return Formatted string representation of the array
  */
-std::string CompactJsonFormatter::format(const JsonArray* value, const size_t indent) const {
-    const size_t size = value -> getSize();
+std::string CompactJsonFormatter::format(const JsonArray* value, const size_t indent, const JsonFormatOptions& options) const {
+    std::string output;
+    JsonStringWriter writer(output);
 
-    if(size == 0)
-        return std::string("[]");
+    writeJson(writer, value, indent, options);
+    writer.flush();
 
-    std::ostringstream output;
-
-    output << '[';
-
-    for(size_t i = 0; i < size - 1; i++){
-        writeJsonIntoStream(output, (*value)[i]);
-        output << ',';
-    }
-
-    writeJsonIntoStream(output, (*value)[size - 1]);
-
-    output << ']';
-
-    return output.str();
+    return output;
 }
 
 /**
  * @brief Formats a JsonObject into a compact string representation
  * @param value Pointer to the JsonObject to format
  * @param indent Indentation level (unused in compact format)
+ * @param options Options of the call
  * @return Formatted string representation of the object
  */
-std::string CompactJsonFormatter::format(const JsonObject* value, const size_t indent) const {
-    const size_t size = value -> getSize();
-
-    if(size == 0)
-        return std::string("{}");
+std::string CompactJsonFormatter::format(const JsonObject* value, const size_t indent, const JsonFormatOptions& options) const {
+    std::string output;
+    JsonStringWriter writer(output);
 
-    std::ostringstream output;
+    writeJson(writer, value, indent, options);
+    writer.flush();
 
-    output << '{';
-
-    std::vector<std::string> keys = value -> getKeys();
-
-    for(size_t i = 0; i < size - 1; i++){
-        output << '\"' << keys[i] << '\"' << ':';
-        writeJsonIntoStream(output, value -> getValue(keys[i]));
-        output << ',';
-    }
-
-    output << '\"' << keys[size - 1] << '\"' << ':';
-    writeJsonIntoStream(output, value -> getValue(keys[size - 1]));
-    output << '}';
-
-    return output.str();
+    return output;
 }
 
 /**
- * @brief Writes JSON value to output stream in compact format
- * @param os Output stream to write to
+ * @brief Writes JSON value to output stream in compact format with an explicit stack
+ * @param writer Writer to append to
  * @param value Pointer to the JsonValue to write
  * @param indent Indentation level (unused in compact format)
+ * @param options Options of the call, of which the compact formatter only uses sortKeys
  * @throws std::runtime_error if value type is invalid
  */
-void CompactJsonFormatter::writeJsonIntoStream(std::ostream& os, const JsonValue* value, const size_t indent) const {
-
-    switch(value -> getType()) {
-
-        case ValueType::Null :
-        case ValueType::Boolean :
-        case ValueType::Number : 
-        case ValueType::String : {
-            os << value;
-            break;
+void CompactJsonFormatter::writeJson(JsonWriter& writer, const JsonValue* value, const size_t indent, const JsonFormatOptions& options) const {
+    std::vector<WriteFrame> frames;
+    SortedEntries sortedEntries;
+    const JsonValue* next = value;
+
+    while(true) {
+        if(next != nullptr) {
+            switch(next -> getType()) {
+
+                case ValueType::Null :
+                case ValueType::Boolean :
+                case ValueType::Number :
+                case ValueType::String : {
+                    next -> print(writer);
+                    break;
+                }
+
+                case ValueType::Array : {
+                    if(static_cast<const JsonArray*>(next) -> getSize() == 0) {
+                        writer.write("[]", 2);
+                        break;
+                    }
+
+                    writer.put('[');
+                    frames.push_back(WriteFrame{next, 0, 0, JsonObject::ConstIterator(nullptr, nullptr), JsonObject::ConstIterator(nullptr, nullptr), 0});
+                    break;
+                }
+
+                case ValueType::Object : {
+                    const JsonObject* object = static_cast<const JsonObject*>(next);
+
+                    if(object -> getSize() == 0) {
+                        writer.write("{}", 2);
+                        break;
+                    }
+
+                    writer.put('{');
+
+                    if(options.sortKeys) {
+                        frames.push_back(WriteFrame{next, 0, 0, JsonObject::ConstIterator(nullptr, nullptr), JsonObject::ConstIterator(nullptr, nullptr), appendSortedEntries(object, sortedEntries)});
+                    } else {
+                        frames.push_back(WriteFrame{next, 0, 0, object -> begin(), object -> end(), 0});
+                    }
+                    break;
+                }
+
+                default: {
+                    throw std::runtime_error("Invalid value type in CompactJsonFormatter!");
+                }
+
+            }
+
+            next = nullptr;
         }
 
-        case ValueType::Array : {
-            os << format(static_cast<const JsonArray*>(value));
+        if(frames.empty()) {
             break;
         }
 
-        case ValueType::Object : {
-            os << format(static_cast<const JsonObject*>(value));
-            break;
+        WriteFrame& frame = frames.back();
+
+        if(frame.value -> getType() == ValueType::Array) {
+            const JsonArray* array = static_cast<const JsonArray*>(frame.value);
+
+            if(frame.position == array -> getSize()) {
+                writer.put(']');
+                frames.pop_back();
+                continue;
+            }
+
+            if(frame.position > 0)
+                writer.put(',');
+
+            next = (*array)[frame.position++];
+            continue;
         }
 
-        default: {
-            throw std::runtime_error("Invalid value type in CompactJsonFormatter!");
+        const JsonObject::Entry* entry = nextEntry(frame, sortedEntries, options.sortKeys);
+
+        if(entry == nullptr) {
+            writer.put('}');
+
+            if(options.sortKeys)
+                sortedEntries.resize(frame.sortedBase);
+
+            frames.pop_back();
+            continue;
         }
 
+        if(frame.position > 0)
+            writer.put(',');
+
+        writer.put('\"');
+        writer.write(entry -> key.data(), entry -> key.length());
+        writer.write("\":", 2);
+        next = entry -> value;
+
+        frame.position++;
     }
 }
\ No newline at end of file
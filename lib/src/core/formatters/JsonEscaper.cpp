@@ -0,0 +1,322 @@
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include "JsonEscaper.hpp"
+#include "JsonInstructionSet.hpp"
+
+#if (defined(__x86_64__) || defined(__i386__)) && (defined(__GNUC__) || defined(__clang__))
+#define JSON_ESCAPER_X86 1
+#include <immintrin.h>
+#else
+#define JSON_ESCAPER_X86 0
+#endif
+
+/**
+ * @brief Anonymous namespace for the escape finders of each instruction set and the helpers of the decoder
+ */
+namespace {
+    /**
+     * @brief Number of characters below which a range is checked a word at a time instead of with vectors
+     */
+    const size_t BlockSize = 32;
+
+    /**
+     * @brief Signature of a function finding the first character that must be escaped in a range
+     */
+    typedef const char* (*EscapeFinder)(const char* begin, const char* end);
+
+    /**
+     * @brief Checks if a character must be escaped in a JSON string
+     * @param symbol Character to check
+     * @return True for '"', '\\' and control characters, false otherwise
+     */
+    inline bool mustEscape(const unsigned char symbol) {
+        return symbol < 0x20 || symbol == '\"' || symbol == '\\';
+    }
+
+    /**
+     * @brief Finds the first character that must be escaped, skipping eight clean characters at once
+     * @param begin Pointer to the first character to check
+     * @param end Pointer one past the last character to check
+     * @return Pointer to the first character that must be escaped, end if there is none
+     */
+    const char* findEscapeScalar(const char* begin, const char* end) {
+        const uint64_t ones = 0x0101010101010101ULL;
+        const uint64_t highs = 0x8080808080808080ULL;
+        const char* symbol = begin;
+
+        while(end - symbol >= static_cast<std::ptrdiff_t>(sizeof(uint64_t))) {
+            uint64_t word;
+            std::memcpy(&word, symbol, sizeof(word));
+
+            const uint64_t quotes = word ^ (ones * '\"');
+            const uint64_t backslashes = word ^ (ones * '\\');
+            const uint64_t flagged = ((word - ones * 0x20) | (quotes - ones) | (backslashes - ones)) & ~word & highs;
+
+            if(flagged != 0) {
+                break;
+            }
+
+            symbol += sizeof(word);
+        }
+
+        while(symbol < end && !mustEscape(static_cast<unsigned char>(*symbol))) {
+            symbol++;
+        }
+
+        return symbol;
+    }
+
+#if JSON_ESCAPER_X86
+    /**
+     * @brief Finds the first character that must be escaped 16 characters at a time with SSE2 instructions
+     * @param begin Pointer to the first character to check
+     * @param end Pointer one past the last character to check
+     * @return Pointer to the first character that must be escaped, end if there is none
+     */
+    __attribute__((target("sse2")))
+    const char* findEscapeSse2(const char* begin, const char* end) {
+        const __m128i quote = _mm_set1_epi8('\"');
+        const __m128i backslash = _mm_set1_epi8('\\');
+        const __m128i lastControl = _mm_set1_epi8(0x1F);
+        const char* block = begin;
+
+        for(; end - block >= 16; block += 16) {
+            const __m128i input = _mm_loadu_si128(reinterpret_cast<const __m128i*>(block));
+            const __m128i control = _mm_cmpeq_epi8(_mm_min_epu8(input, lastControl), input);
+            const __m128i flagged = _mm_or_si128(control, _mm_or_si128(_mm_cmpeq_epi8(input, quote), _mm_cmpeq_epi8(input, backslash)));
+            const int mask = _mm_movemask_epi8(flagged);
+
+            if(mask != 0) {
+                return block + __builtin_ctz(static_cast<unsigned int>(mask));
+            }
+        }
+
+        return findEscapeScalar(block, end);
+    }
+
+    /**
+     * @brief Finds the first character that must be escaped 32 characters at a time with AVX2 instructions
+     * @param begin Pointer to the first character to check
+     * @param end Pointer one past the last character to check
+     * @return Pointer to the first character that must be escaped, end if there is none
+     */
+    __attribute__((target("avx2")))
+    const char* findEscapeAvx2(const char* begin, const char* end) {
+        const __m256i quote = _mm256_set1_epi8('\"');
+        const __m256i backslash = _mm256_set1_epi8('\\');
+        const __m256i lastControl = _mm256_set1_epi8(0x1F);
+        const char* block = begin;
+
+        for(; end - block >= 32; block += 32) {
+            const __m256i input = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(block));
+            const __m256i control = _mm256_cmpeq_epi8(_mm256_min_epu8(input, lastControl), input);
+            const __m256i flagged = _mm256_or_si256(control, _mm256_or_si256(_mm256_cmpeq_epi8(input, quote), _mm256_cmpeq_epi8(input, backslash)));
+            const unsigned int mask = static_cast<unsigned int>(_mm256_movemask_epi8(flagged));
+
+            if(mask != 0) {
+                return block + __builtin_ctz(mask);
+            }
+        }
+
+        return findEscapeScalar(block, end);
+    }
+#endif
+
+    /**
+     * @brief Picks the finder of an instruction set
+     * @param set Instruction set to use, the scalar finder is picked if the running CPU does not support it
+     * @return Pointer to the finder
+     */
+    EscapeFinder selectFinder(const InstructionSet set) {
+#if JSON_ESCAPER_X86
+        if(JsonInstructionSet::isSupported(set)) {
+            switch(set) {
+                case InstructionSet::Avx2: return findEscapeAvx2;
+                case InstructionSet::Sse: return findEscapeSse2;
+                default: break;
+            }
+        }
+#endif
+        return findEscapeScalar;
+    }
+
+    /**
+     * @brief Appends the escape sequence of a character, the short form where JSON has one and \\u00XX otherwise
+     * @param writer Writer to append to
+     * @param symbol Character that must be escaped
+     */
+    void writeEscape(JsonWriter& writer, const unsigned char symbol) {
+        static const char hexDigits[] = "0123456789abcdef";
+
+        switch(symbol) {
+            case '\"': writer.write("\\\"", 2); return;
+            case '\\': writer.write("\\\\", 2); return;
+            case '\b': writer.write("\\b", 2); return;
+            case '\f': writer.write("\\f", 2); return;
+            case '\n': writer.write("\\n", 2); return;
+            case '\r': writer.write("\\r", 2); return;
+            case '\t': writer.write("\\t", 2); return;
+            default: {
+                const char sequence[6] = {'\\', 'u', '0', '0', hexDigits[symbol >> 4], hexDigits[symbol & 0x0F]};
+                writer.write(sequence, sizeof(sequence));
+            }
+        }
+    }
+
+    /**
+     * @brief Reads the four hexadecimal digits of a \\u escape
+     * @param data Pointer to the first digit
+     * @return Value of the digits
+     */
+    unsigned readHex(const char* data) {
+        unsigned value = 0;
+
+        for(size_t i = 0; i < 4; i++) {
+            const char symbol = data[i];
+            const unsigned digit = symbol <= '9' ? symbol - '0' : (symbol | 0x20) - 'a' + 10;
+
+            value = value * 16 + digit;
+        }
+
+        return value;
+    }
+
+    /**
+     * @brief Appends the UTF-8 encoding of a code point
+     * @param codePoint Code point to encode
+     * @param result String to append to
+     */
+    void appendUtf8(const unsigned codePoint, std::string& result) {
+        if(codePoint < 0x80) {
+            result += static_cast<char>(codePoint);
+        }
+        else if(codePoint < 0x800) {
+            result += static_cast<char>(0xC0 | (codePoint >> 6));
+            result += static_cast<char>(0x80 | (codePoint & 0x3F));
+        }
+        else if(codePoint < 0x10000) {
+            result += static_cast<char>(0xE0 | (codePoint >> 12));
+            result += static_cast<char>(0x80 | ((codePoint >> 6) & 0x3F));
+            result += static_cast<char>(0x80 | (codePoint & 0x3F));
+        }
+        else {
+            result += static_cast<char>(0xF0 | (codePoint >> 18));
+            result += static_cast<char>(0x80 | ((codePoint >> 12) & 0x3F));
+            result += static_cast<char>(0x80 | ((codePoint >> 6) & 0x3F));
+            result += static_cast<char>(0x80 | (codePoint & 0x3F));
+        }
+    }
+}
+
+/**
+ * @brief Appends text to a writer escaped as the content of a JSON string, copying each clean run at once
+ * @param writer Writer to append to
+ * @param data Pointer to the first character of the text
+ * @param length Number of characters in the text
+ */
+void JsonEscaper::write(JsonWriter& writer, const char* data, const size_t length) {
+    const char* current = data;
+    const char* end = data + length;
+
+    while(true) {
+        const char* special = findEscape(current, end);
+
+        writer.write(current, special - current);
+
+        if(special == end) {
+            break;
+        }
+
+        writeEscape(writer, static_cast<unsigned char>(*special));
+        current = special + 1;
+    }
+}
+
+/**
+ * @brief Finds the first character of a range that must be escaped with the widest instruction set supported
+ * @param begin Pointer to the first character to check
+ * @param end Pointer one past the last character to check
+ * @return Pointer to the first '"', '\\' or control character, end if there is none
+ */
+const char* JsonEscaper::findEscape(const char* begin, const char* end) {
+    static const EscapeFinder find = selectFinder(JsonInstructionSet::getWidest());
+
+    if(end - begin < static_cast<std::ptrdiff_t>(BlockSize)) {
+        return findEscapeScalar(begin, end);
+    }
+
+    return find(begin, end);
+}
+
+/**
+ * @brief Finds the first character of a range that must be escaped using a given instruction set
+ * @param begin Pointer to the first character to check
+ * @param end Pointer one past the last character to check
+ * @param set Instruction set to use, the scalar finder is used if the running CPU does not support it
+ * @return Pointer to the first '"', '\\' or control character, end if there is none
+ */
+const char* JsonEscaper::findEscape(const char* begin, const char* end, const InstructionSet set) {
+    if(end - begin < static_cast<std::ptrdiff_t>(BlockSize)) {
+        return findEscapeScalar(begin, end);
+    }
+
+    return selectFinder(set)(begin, end);
+}
+
+/**
+ * @brief Decodes the escapes of validated string content, joining surrogate pairs into one code point
+ * @param begin Pointer to the first character after the opening quote
+ * @param end Pointer to the closing quote
+ * @param result String receiving the decoded UTF-8 text, replaced entirely
+ */
+void JsonEscaper::decode(const char* begin, const char* end, std::string& result) {
+    result.clear();
+
+    for(const char* symbol = begin; symbol < end; symbol++) {
+        if(*symbol != '\\') {
+            result += *symbol;
+            continue;
+        }
+
+        symbol++;
+
+        switch(*symbol) {
+            case 'b':
+                result += '\b';
+                break;
+            case 'f':
+                result += '\f';
+                break;
+            case 'n':
+                result += '\n';
+                break;
+            case 'r':
+                result += '\r';
+                break;
+            case 't':
+                result += '\t';
+                break;
+            case 'u': {
+                unsigned codePoint = readHex(symbol + 1);
+
+                symbol += 4;
+
+                if(codePoint >= 0xD800 && codePoint < 0xDC00 && end - symbol > 6 && symbol[1] == '\\' && symbol[2] == 'u') {
+                    const unsigned low = readHex(symbol + 3);
+
+                    if(low >= 0xDC00 && low < 0xE000) {
+                        codePoint = 0x10000 + ((codePoint - 0xD800) << 10) + (low - 0xDC00);
+                        symbol += 6;
+                    }
+                }
+
+                appendUtf8(codePoint, result);
+                break;
+            }
+            default:
+                result += *symbol;
+                break;
+        }
+    }
+}
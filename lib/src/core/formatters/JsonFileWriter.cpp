@@ -0,0 +1,263 @@
+#include "JsonFileWriter.hpp"
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <cerrno>
+#include <cstdlib>
+#include <fcntl.h>
+#include <sys/uio.h>
+#include <unistd.h>
+#define JSONFILEWRITER_POSIX
+#endif
+
+/**
+ * @brief Constructs a writer with no file open; the buffer is only allocated when a file is opened
+ */
+JsonFileWriter::JsonFileWriter() : descriptor(-1), hasFailed(false) {}
+
+/**
+ * @brief Destructor, writes the collected characters and closes the file
+ */
+JsonFileWriter::~JsonFileWriter() {
+    close();
+}
+
+/**
+ * @brief Creates or truncates a file and writes to it, closing the previously opened one
+ * @param filename Name of the file to write
+ * @return True if the file was opened, false if it could not be opened for writing
+ */
+bool JsonFileWriter::open(const std::string& filename) {
+    close();
+
+#ifdef JSONFILEWRITER_POSIX
+    do {
+        descriptor = ::open(filename.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0666);
+    } while(descriptor < 0 && errno == EINTR);
+
+    if(descriptor < 0) {
+        return false;
+    }
+#else
+    stream.open(filename, std::ios::out | std::ios::trunc | std::ios::binary);
+
+    if(!stream.is_open()) {
+        return false;
+    }
+#endif
+
+    startBuffer();
+
+    return true;
+}
+
+/**
+ * @brief Creates a new file with a unique name with mkstemp and writes to it
+ * @param filename Prefix of the name, replaced by the name of the created file
+ * @return True if the file was created, false if no file could be created
+ */
+bool JsonFileWriter::openTemporary(std::string& filename) {
+    close();
+
+#ifdef JSONFILEWRITER_POSIX
+    filename += ".XXXXXX";
+
+    do {
+        descriptor = ::mkstemp(&filename[0]);
+    } while(descriptor < 0 && errno == EINTR);
+
+    if(descriptor < 0) {
+        return false;
+    }
+
+    startBuffer();
+
+    return true;
+#else
+    filename += ".tmp";
+
+    return open(filename);
+#endif
+}
+
+/**
+ * @brief Writes the collected characters and waits until the file's content reaches the storage device
+ * @return True if every character appended since the file was opened reached the device, false otherwise
+ */
+bool JsonFileWriter::sync() {
+    if(!isOpen()) {
+        return false;
+    }
+
+    flush();
+
+#ifdef JSONFILEWRITER_POSIX
+    while(!hasFailed && ::fsync(descriptor) != 0) {
+        if(errno != EINTR) {
+            hasFailed = true;
+        }
+    }
+#else
+    stream.flush();
+
+    if(!stream) {
+        hasFailed = true;
+    }
+#endif
+
+    return !hasFailed;
+}
+
+/**
+ * @brief Writes the collected characters and closes the file
+ * @return True if every character appended since the file was opened reached it, false otherwise
+ */
+bool JsonFileWriter::close() {
+    if(!isOpen()) {
+        return false;
+    }
+
+    flush();
+
+#ifdef JSONFILEWRITER_POSIX
+    if(::close(descriptor) != 0 && errno != EINTR) {
+        hasFailed = true;
+    }
+
+    descriptor = -1;
+#else
+    stream.close();
+
+    if(!stream) {
+        hasFailed = true;
+    }
+
+    stream.clear();
+#endif
+
+    current = nullptr;
+    end = nullptr;
+
+    return !hasFailed;
+}
+
+/**
+ * @brief Checks whether a file is open
+ * @return True if a file is open, false otherwise
+ */
+bool JsonFileWriter::isOpen() const {
+#ifdef JSONFILEWRITER_POSIX
+    return descriptor >= 0;
+#else
+    return stream.is_open();
+#endif
+}
+
+/**
+ * @brief Writes the collected characters to the file
+ */
+void JsonFileWriter::flush() {
+    if(!isOpen()) {
+        return;
+    }
+
+    writeRanges(buffer.data(), current - buffer.data(), nullptr, 0);
+    current = buffer.data();
+}
+
+/**
+ * @brief Points the writer at an empty buffer after a file was opened, allocating it on the first open
+ */
+void JsonFileWriter::startBuffer() {
+    buffer.resize(BufferSize);
+    current = buffer.data();
+    end = buffer.data() + buffer.size();
+    hasFailed = false;
+}
+
+/**
+ * @brief Writes the collected characters and the new ones, with a single call if they do not fit the buffer
+ * @param data Pointer to the first character
+ * @param length Number of characters
+ */
+void JsonFileWriter::overflow(const char* data, const size_t length) {
+    if(!isOpen()) {
+        hasFailed = true;
+        return;
+    }
+
+    if(length >= buffer.size()) {
+        writeRanges(buffer.data(), current - buffer.data(), data, length);
+        current = buffer.data();
+        return;
+    }
+
+    const size_t room = end - current;
+
+    std::memcpy(current, data, room);
+    current = end;
+    flush();
+
+    std::memcpy(current, data + room, length - room);
+    current += length - room;
+}
+
+/**
+ * @brief Writes two ranges of characters to the file, retrying partial and interrupted writes
+ * @param first Pointer to the first character of the first range
+ * @param firstLength Number of characters in the first range
+ * @param second Pointer to the first character of the second range
+ * @param secondLength Number of characters in the second range
+ */
+void JsonFileWriter::writeRanges(const char* first, const size_t firstLength, const char* second, const size_t secondLength) {
+    if(hasFailed) {
+        return;
+    }
+
+#ifdef JSONFILEWRITER_POSIX
+    struct iovec ranges[2] = {
+        {const_cast<char*>(first), firstLength},
+        {const_cast<char*>(second), secondLength}
+    };
+    struct iovec* range = ranges;
+    int count = 2;
+
+    while(count > 0) {
+        if(range -> iov_len == 0) {
+            range++;
+            count--;
+            continue;
+        }
+
+        const ssize_t written = ::writev(descriptor, range, count);
+
+        if(written < 0) {
+            if(errno == EINTR) {
+                continue;
+            }
+
+            hasFailed = true;
+            return;
+        }
+
+        size_t left = static_cast<size_t>(written);
+
+        while(count > 0 && left >= range -> iov_len) {
+            left -= range -> iov_len;
+            range++;
+            count--;
+        }
+
+        if(count > 0) {
+            range -> iov_base = static_cast<char*>(range -> iov_base) + left;
+            range -> iov_len -= left;
+        }
+    }
+#else
+    stream.write(first, firstLength);
+    stream.write(second, secondLength);
+
+    if(!stream) {
+        hasFailed = true;
+    }
+#endif
+}
\ No newline at end of file
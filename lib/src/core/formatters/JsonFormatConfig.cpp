@@ -3,17 +3,11 @@
 #include "PrettyJsonFormatter.hpp"
 
 /**
- * @brief Anonymous namespace for internal configuration state
+ * @brief Gets the JSON formatter of a type
+ * @param type The FormatterType to get
+ * @return Pointer to the JsonFormatter
  */
-namespace {
-    static FormatterType type = FormatterType::Pretty;  ///< Current formatter type
-}
-
-/**
- * @brief Gets the current JSON formatter instance
- * @return Pointer to the current JsonFormatter
- */
-const JsonFormatter* JsonFormatConfig::getFormatter() {
+const JsonFormatter* JsonFormatConfig::getFormatter(const FormatterType& type) {
     if(type == FormatterType::Compact){
         return &CompactJsonFormatter::getInstance();
     }
@@ -22,9 +16,11 @@ const JsonFormatter* JsonFormatConfig::getFormatter() {
 }
 
 /**
- * @brief Sets the type of formatter to use
- * @param _type The FormatterType to set
+ * @brief Appends a JSON value to a writer with the formatter and options of a call
+ * @param writer Writer to append to
+ * @param value Pointer to the JsonValue to write
+ * @param options Options of the call
  */
-void JsonFormatConfig::setFormatterType(const FormatterType& _type) {
-    type = _type;
+void JsonFormatConfig::writeJson(JsonWriter& writer, const JsonValue* value, const JsonFormatOptions& options) {
+    getFormatter(options.type) -> writeJson(writer, value, 0, options);
 }
\ No newline at end of file
@@ -0,0 +1,102 @@
+#include <algorithm>
+#include <cstring>
+#include <string>
+#include <utility>
+#include "JsonFormatter.hpp"
+#include "JsonEscaper.hpp"
+
+/**
+ * @brief Anonymous namespace for ordering the pairs of objects written with sorted keys
+ */
+namespace {
+    /**
+     * @brief Decoded key of a pair next to the pair
+     */
+    typedef std::pair<std::string, const JsonObject::Entry*> DecodedEntry;
+
+    /**
+     * @brief Checks if the key of a pair comes before the key of another in byte order of the keys as written
+     * @param left First pair
+     * @param right Second pair
+     * @return True if the first key is ordered before the second, false otherwise
+     */
+    bool isKeyBefore(const JsonObject::Entry* left, const JsonObject::Entry* right) {
+        const size_t length = std::min(left -> key.length(), right -> key.length());
+        const int order = length == 0 ? 0 : std::memcmp(left -> key.data(), right -> key.data(), length);
+
+        return order < 0 || (order == 0 && left -> key.length() < right -> key.length());
+    }
+
+    /**
+     * @brief Checks if the decoded key of a pair comes before the decoded key of another in byte order
+     * @param left First pair
+     * @param right Second pair
+     * @return True if the first key is ordered before the second, false otherwise
+     */
+    bool isDecodedKeyBefore(const DecodedEntry& left, const DecodedEntry& right) {
+        return left.first < right.first;
+    }
+}
+
+/**
+ * @brief Appends the pairs of an object to the sorted pairs, ordered by the bytes of their decoded keys
+ * @param object Object whose pairs to append
+ * @param sortedEntries Sorted pairs of the objects being written
+ * @return Index of the object's first pair in the sorted pairs
+ */
+size_t JsonFormatter::appendSortedEntries(const JsonObject* object, SortedEntries& sortedEntries) {
+    const size_t base = sortedEntries.size();
+    bool hasEscapes = false;
+
+    for(JsonObject::ConstIterator it = object -> begin(); it != object -> end(); ++it) {
+        sortedEntries.push_back(&*it);
+        hasEscapes = hasEscapes || it -> key.find('\\') != ArenaString::npos;
+    }
+
+    if(!hasEscapes) {
+        std::stable_sort(sortedEntries.begin() + base, sortedEntries.end(), isKeyBefore);
+
+        return base;
+    }
+
+    std::vector<DecodedEntry> decodedEntries(sortedEntries.size() - base);
+
+    for(size_t i = 0; i < decodedEntries.size(); i++) {
+        const ArenaString& key = sortedEntries[base + i] -> key;
+
+        JsonEscaper::decode(key.data(), key.data() + key.length(), decodedEntries[i].first);
+        decodedEntries[i].second = sortedEntries[base + i];
+    }
+
+    std::stable_sort(decodedEntries.begin(), decodedEntries.end(), isDecodedKeyBefore);
+
+    for(size_t i = 0; i < decodedEntries.size(); i++) {
+        sortedEntries[base + i] = decodedEntries[i].second;
+    }
+
+    return base;
+}
+
+/**
+ * @brief Takes the next pair of an object being written, in sorted or insertion order
+ * @param frame Frame of the object
+ * @param sortedEntries Sorted pairs of the objects being written
+ * @param sortKeys Whether the object's keys are sorted
+ * @return Pointer to the next pair, nullptr when every pair has been written
+ */
+const JsonObject::Entry* JsonFormatter::nextEntry(WriteFrame& frame, const SortedEntries& sortedEntries, const bool sortKeys) {
+    if(sortKeys) {
+        const size_t index = frame.sortedBase + frame.position;
+
+        return index < sortedEntries.size() ? sortedEntries[index] : nullptr;
+    }
+
+    if(frame.current == frame.end) {
+        return nullptr;
+    }
+
+    const JsonObject::Entry* entry = &*frame.current;
+    ++frame.current;
+
+    return entry;
+}
\ No newline at end of file
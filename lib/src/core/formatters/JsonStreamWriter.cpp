@@ -0,0 +1,42 @@
+#include "JsonStreamWriter.hpp"
+
+/**
+ * @brief Constructor that writes to a stream
+ * @param _stream Stream to write to, which must outlive the writer
+ */
+JsonStreamWriter::JsonStreamWriter(std::ostream& _stream) : stream(_stream), buffer(BufferSize) {
+    current = buffer.data();
+    end = buffer.data() + buffer.size();
+}
+
+/**
+ * @brief Destructor, flushes the writer
+ */
+JsonStreamWriter::~JsonStreamWriter() {
+    flush();
+}
+
+/**
+ * @brief Writes the collected characters to the stream
+ */
+void JsonStreamWriter::flush() {
+    stream.write(buffer.data(), current - buffer.data());
+    current = buffer.data();
+}
+
+/**
+ * @brief Writes the collected characters to the stream, then collects or writes the new ones
+ * @param data Pointer to the first character
+ * @param length Number of characters
+ */
+void JsonStreamWriter::overflow(const char* data, const size_t length) {
+    flush();
+
+    if(length >= buffer.size()) {
+        stream.write(data, length);
+        return;
+    }
+
+    std::memcpy(current, data, length);
+    current += length;
+}
@@ -0,0 +1,52 @@
+#include <algorithm>
+#include "JsonStringWriter.hpp"
+
+/**
+ * @brief Anonymous namespace for the growth policy of string writers
+ */
+namespace {
+    const size_t InitialCapacity = 256;  ///< Spare characters the string gets on the first growth
+}
+
+/**
+ * @brief Constructor that appends to the end of a string
+ * @param _output String to append to; it holds spare characters past the text until the writer is flushed
+ */
+JsonStringWriter::JsonStringWriter(std::string& _output) : output(_output) {}
+
+/**
+ * @brief Destructor, flushes the writer
+ */
+JsonStringWriter::~JsonStringWriter() {
+    flush();
+}
+
+/**
+ * @brief Trims the string to the characters appended so far
+ */
+void JsonStringWriter::flush() {
+    if(current == nullptr) {
+        return;
+    }
+
+    output.resize(current - &output[0]);
+    current = nullptr;
+    end = nullptr;
+}
+
+/**
+ * @brief Grows the string to at least double its size to fit characters and appends them
+ * @param data Pointer to the first character
+ * @param length Number of characters
+ */
+void JsonStringWriter::overflow(const char* data, const size_t length) {
+    const size_t written = current == nullptr ? output.size() : current - &output[0];
+
+    output.resize(std::max(written + length, std::max(output.size() * 2, written + InitialCapacity)));
+
+    current = &output[0] + written;
+    end = &output[0] + output.size();
+
+    std::memcpy(current, data, length);
+    current += length;
+}
@@ -1,5 +1,8 @@
-#include <sstream>
+#include <algorithm>
+#include <stdexcept>
+#include <vector>
 #include "PrettyJsonFormatter.hpp"
+#include "JsonStringWriter.hpp"
 
 /**
  * @brief Gets the singleton instance of PrettyJsonFormatter
@@ -14,118 +17,153 @@ PrettyJsonFormatter& PrettyJsonFormatter::getInstance() {
  * @brief Formats a JsonArray into a pretty-printed string
  * @param value Pointer to the JsonArray to format
  * @param indent Current indentation level
+ * @param options Options of the call
  * @return Formatted string representation of the array
  */
-std::string PrettyJsonFormatter::format(const JsonArray* value, const size_t indent) const {
-    const size_t size = value -> getSize();
+std::string PrettyJsonFormatter::format(const JsonArray* value, const size_t indent, const JsonFormatOptions& options) const {
+    std::string output;
+    JsonStringWriter writer(output);
 
-    if(size == 0)
-        return std::string("[]");
+    writeJson(writer, value, indent, options);
+    writer.flush();
 
-    std::ostringstream output;
-
-    output << "[\n";
-
-    for(size_t i = 0; i < size - 1; i++){
-        writeIndentationIntoStream(output, indent + 1);
-        writeJsonIntoStream(output, (*value)[i], indent + 1);
-        output << ",\n";
-    }
-
-    writeIndentationIntoStream(output, indent + 1);
-    writeJsonIntoStream(output, (*value)[size - 1], indent + 1);
-    output << '\n';
-
-    writeIndentationIntoStream(output, indent);
-    output << "]";
-    if(indent == 0)
-        output << '\n';
-
-    return output.str();
+    return output;
 }
 
 /**
  * @brief Formats a JsonObject into a pretty-printed string
  * @param value Pointer to the JsonObject to format
  * @param indent Current indentation level
+ * @param options Options of the call
  * @return Formatted string representation of the object
  */
-std::string PrettyJsonFormatter::format(const JsonObject* value, const size_t indent) const {
-    const size_t size = value -> getSize();
-
-    if(size == 0)
-        return std::string("{}");
-
-    std::ostringstream output;
-
-    output << "{\n";
-
-    std::vector<std::string> keys = value -> getKeys();
-
-    for(size_t i = 0; i < size - 1; i++){
-        writeIndentationIntoStream(output, indent + 1);
-        output << '\"' << keys[i] << '\"' <<  " : ";
-        writeJsonIntoStream(output, value -> getValue(keys[i]), indent + 1);
-        output << ",\n";
-    }
-
-    writeIndentationIntoStream(output, indent + 1);
-    output << '\"' << keys[size - 1] << '\"' << " : ";
-    writeJsonIntoStream(output, value -> getValue(keys[size - 1]), indent + 1);
-    output << "\n";
+std::string PrettyJsonFormatter::format(const JsonObject* value, const size_t indent, const JsonFormatOptions& options) const {
+    std::string output;
+    JsonStringWriter writer(output);
 
-    writeIndentationIntoStream(output, indent);
-    output << "}";
+    writeJson(writer, value, indent, options);
+    writer.flush();
 
-    if(indent == 0)
-        output << '\n';
-
-    return output.str();
+    return output;
 }
 
 /**
- * @brief Writes JSON value to output stream with proper formatting
- * @param os Output stream to write to
+ * @brief Writes JSON value to output stream with proper formatting with an explicit stack
+ * @param writer Writer to append to
  * @param value Pointer to the JsonValue to write
  * @param indent Current indentation level
+ * @param options Options of the call
  * @throws std::runtime_error if value type is invalid
  */
-void PrettyJsonFormatter::writeJsonIntoStream(std::ostream& os, const JsonValue* value, const size_t indent) const {
-
-    switch(value -> getType()) {
-
-        case ValueType::Null :
-        case ValueType::Boolean :
-        case ValueType::Number :
-        case ValueType::String : {
-            os << value;
-            break;
+void PrettyJsonFormatter::writeJson(JsonWriter& writer, const JsonValue* value, const size_t indent, const JsonFormatOptions& options) const {
+    std::vector<WriteFrame> frames;
+    SortedEntries sortedEntries;
+    const JsonValue* next = value;
+    size_t nextIndent = indent;
+
+    while(true) {
+        if(next != nullptr) {
+            switch(next -> getType()) {
+
+                case ValueType::Null :
+                case ValueType::Boolean :
+                case ValueType::Number :
+                case ValueType::String : {
+                    next -> print(writer);
+                    break;
+                }
+
+                case ValueType::Array : {
+                    if(static_cast<const JsonArray*>(next) -> getSize() == 0) {
+                        writer.write("[]", 2);
+                        break;
+                    }
+
+                    writer.write("[\n", 2);
+                    frames.push_back(WriteFrame{next, nextIndent, 0, JsonObject::ConstIterator(nullptr, nullptr), JsonObject::ConstIterator(nullptr, nullptr), 0});
+                    break;
+                }
+
+                case ValueType::Object : {
+                    const JsonObject* object = static_cast<const JsonObject*>(next);
+
+                    if(object -> getSize() == 0) {
+                        writer.write("{}", 2);
+                        break;
+                    }
+
+                    writer.write("{\n", 2);
+
+                    if(options.sortKeys) {
+                        frames.push_back(WriteFrame{next, nextIndent, 0, JsonObject::ConstIterator(nullptr, nullptr), JsonObject::ConstIterator(nullptr, nullptr), appendSortedEntries(object, sortedEntries)});
+                    } else {
+                        frames.push_back(WriteFrame{next, nextIndent, 0, object -> begin(), object -> end(), 0});
+                    }
+                    break;
+                }
+
+                default: {
+                    throw std::runtime_error("Invalid value type in CompactJsonFormatter!");
+                }
+
+            }
+
+            next = nullptr;
         }
 
-        case ValueType::Array : {
-            os << format(static_cast<const JsonArray*>(value), indent);
+        if(frames.empty()) {
             break;
         }
 
-        case ValueType::Object : {
-            os << format(static_cast<const JsonObject*>(value), indent);
-            break;
+        WriteFrame& frame = frames.back();
+        const bool isArray = frame.value -> getType() == ValueType::Array;
+        const JsonObject::Entry* entry = isArray ? nullptr : nextEntry(frame, sortedEntries, options.sortKeys);
+        const bool isDone = isArray ? frame.position == static_cast<const JsonArray*>(frame.value) -> getSize() : entry == nullptr;
+
+        if(isDone) {
+            writer.put('\n');
+            writeIndentation(writer, frame.indent * options.indentWidth);
+            writer.put(isArray ? ']' : '}');
+
+            if(frame.indent == 0)
+                writer.put('\n');
+
+            if(!isArray && options.sortKeys)
+                sortedEntries.resize(frame.sortedBase);
+
+            frames.pop_back();
+            continue;
         }
 
-        default: {
-            throw std::runtime_error("Invalid value type in CompactJsonFormatter!");
+        if(frame.position > 0)
+            writer.write(",\n", 2);
+
+        writeIndentation(writer, (frame.indent + 1) * options.indentWidth);
+        nextIndent = frame.indent + 1;
+
+        if(isArray) {
+            next = (*static_cast<const JsonArray*>(frame.value))[frame.position];
+        } else {
+            writer.put('\"');
+            writer.write(entry -> key.data(), entry -> key.length());
+            writer.write("\" : ", 4);
+            next = entry -> value;
         }
 
+        frame.position++;
     }
 }
 
 /**
- * @brief Writes indentation spaces to the output stream
- * @param os Output stream to write to
- * @param indent Number of indentation levels
+ * @brief Appends indentation spaces to a writer, a block of spaces at a time
+ * @param writer Writer to append to
+ * @param width Number of spaces to append
  */
-void PrettyJsonFormatter::writeIndentationIntoStream(std::ostream& os, const size_t indent) const {
-    for(size_t i = 0; i < indent * 2; i++){
-        os << ' ';
+void PrettyJsonFormatter::writeIndentation(JsonWriter& writer, const size_t width) const {
+    static const char spaces[] = "                                                                ";
+    const size_t blockSize = sizeof(spaces) - 1;
+
+    for(size_t left = width; left > 0; left -= std::min(left, blockSize)) {
+        writer.write(spaces, std::min(left, blockSize));
     }
 }
\ No newline at end of file
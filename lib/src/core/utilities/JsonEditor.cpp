@@ -1,9 +1,22 @@
-#include <sstream>
 #include "JsonEditor.hpp"
 #include "Path.hpp"
 #include "JsonParser.hpp"
 #include "JsonFactory.hpp"
-#include "JsonPrinter.hpp"
+
+/**
+ * @brief Anonymous namespace for building the objects created along a path
+ */
+namespace {
+    /**
+     * @brief Creates an object holding a single key-value pair
+     * @param key Key of the pair
+     * @param value Value of the pair, taken ownership of
+     * @return Pointer to the created JsonObject
+     */
+    JsonValue* createPair(const std::string& key, JsonValue* value) {
+        return JsonFactory::create(JsonObject::Entries(1, JsonObject::Entry{ArenaString(key.data(), key.length()), value}));
+    }
+}
 
 /**
  * @brief Constructor that initializes the root reference
@@ -65,49 +78,98 @@ void JsonEditor::visit(JsonObject& jsonValue) {
  * @param value String representation of the value to set
  */
 void JsonEditor::set(const std::string& path, const std::string& value) {
+    replace(path, JsonParser::parse(value.data(), value.length()));
+}
+
+/**
+ * @brief Creates a new value at the specified path
+ * @param path Path where to create the value
+ * @param value String representation of the value to create
+ */
+void JsonEditor::create(const std::string& path, const std::string& value) {
+    insert(path, JsonParser::parse(value.data(), value.length()));
+}
+
+/**
+ * @brief Erases a value at the specified path
+ * @param path Path to the value to erase
+ */
+void JsonEditor::erase(const std::string& path) {
+    delete detach(path);
+}
+
+/**
+ * @brief Moves a value from one path to another without copying it
+ * @param from Source path
+ * @param to Destination path
+ */
+void JsonEditor::move(const std::string& from, const std::string& to) {
+    JsonValue* value = detach(from);
+
+    if(Path::validatePath(object, to)) {
+        JsonObject* node = const_cast<JsonObject*>(Path::getParent(object, to));
+
+        const std::string key = Path::getKey(to);
+
+        try {
+            node -> adoptKVP(key, value);
+        }
+        catch(...) {
+            delete value;
+            throw;
+        }
 
-    if(object == nullptr) {
-        create(path, value);
         return;
     }
-    
-    if(path == "") {
-        delete rootRef;
 
-        std::istringstream stream(value);
+    insert(to, value);
+}
 
-        rootRef = JsonParser::parse(stream);
-        object = rootRef;
+/**
+ * @brief Sets a value at the specified path, taking ownership of it
+ * @param path Path where to set the value
+ * @param value Value to set, deleted if it cannot be set
+ */
+void JsonEditor::replace(const std::string& path, JsonValue* value) {
 
+    if(object == nullptr) {
+        insert(path, value);
         return;
     }
 
-    JsonObject* node = const_cast<JsonObject*>(Path::getParent(object, path));
+    if(path == "") {
+        delete rootRef;
 
-    const std::string key = Path::getKey(path);
+        rootRef = value;
+        object = rootRef;
 
-    std::istringstream stream(value);
+        return;
+    }
 
-    const JsonValue* newValue = JsonParser::parse(stream);
+    try {
+        JsonObject* node = const_cast<JsonObject*>(Path::getParent(object, path));
 
-    node -> editKVP(key, newValue);
+        const std::string key = Path::getKey(path);
 
-    delete newValue;
+        delete node -> exchangeKVP(key, value);
+    }
+    catch(...) {
+        delete value;
+        throw;
+    }
 }
 
 /**
- * @brief Creates a new value at the specified path
+ * @brief Creates a new value at the specified path, taking ownership of it
  * @param path Path where to create the value
- * @param value String representation of the value to create
+ * @param value Value to create, deleted if it cannot be created
  */
-void JsonEditor::create(const std::string& path, const std::string& value) {
+void JsonEditor::insert(const std::string& path, JsonValue* value) {
 
     if(object == nullptr) {
         const std::string root = Path::getRoot(path);
-        JsonValue* recursiveValue = createFromPath(Path::getChildren(path), value);
-        rootRef = new JsonObject({root}, {{root, recursiveValue}});
+        rootRef = createPair(root, createFromPath(Path::getChildren(path), value));
         object = rootRef;
-        delete recursiveValue;
         return;
     }
 
@@ -116,10 +178,16 @@ void JsonEditor::create(const std::string& path, const std::string& value) {
     const std::string newPath = Path::getLastPath(object, path);
     const std::string& root = Path::getRoot(newPath);
 
-    JsonValue* recursiveValue = createFromPath(Path::getChildren(newPath), value);
-
     if(lastNode -> getType() == ValueType::Object){
-        static_cast<JsonObject*>(lastNode) -> addKVP(root, recursiveValue);
+        JsonValue* recursiveValue = createFromPath(Path::getChildren(newPath), value);
+
+        try {
+            static_cast<JsonObject*>(lastNode) -> adoptKVP(root, recursiveValue);
+        }
+        catch(...) {
+            delete recursiveValue;
+            throw;
+        }
     }
     else {
 
@@ -129,88 +197,45 @@ void JsonEditor::create(const std::string& path, const std::string& value) {
             pos = path.length();
         }
 
-        const JsonValue* setObject = JsonFactory::create({root}, {{root, recursiveValue}});
-
-        const std::string setValue = JsonPrinter::prettyPrint(setObject);
-
-        delete setObject;
-
-        set(path.substr(0, pos), setValue);
+        replace(path.substr(0, pos), createPair(root, createFromPath(Path::getChildren(newPath), value)));
     }
-
-    delete recursiveValue;
-
 }
 
 /**
- * @brief Erases a value at the specified path
- * @param path Path to the value to erase
+ * @brief Detaches the value at the specified path from its parent
+ * @param path Path to the value to detach
+ * @return Detached value, owned by the caller
  */
-void JsonEditor::erase(const std::string& path) {
+JsonValue* JsonEditor::detach(const std::string& path) {
 
     if(path == "") {
-        delete rootRef;
+        JsonValue* value = rootRef;
         rootRef = nullptr;
         object = rootRef;
-        return;
+        return value;
     }
 
     JsonObject* node = const_cast<JsonObject*>(Path::getParent(object, path));
     const std::string key = Path::getKey(path);
 
-    node -> removeKVP(key);
+    return node -> releaseKVP(key);
 }
 
 /**
- * @brief Moves a value from one path to another
- * @param from Source path
- * @param to Destination path
- */
-void JsonEditor::move(const std::string& from, const std::string& to) {
-    const std::string& valueToMove = JsonPrinter::prettyPrint((Path::getValue(object, from)));
-
-    erase(from);
-
-    if(Path::validatePath(object, to)) {
-
-        JsonObject* node = const_cast<JsonObject*>(Path::getParent(object, to));
-
-        const std::string key = Path::getKey(to);
-
-        std::istringstream stream(valueToMove);
-
-        const JsonValue* newValue = JsonParser::parse(stream);
-
-        node -> addKVP(key, newValue);
-
-        delete newValue;
-
-        return;
-    }
-
-    create(to, valueToMove);
-}
-
-/**
- * @brief Creates a JSON value from a path and string value
+ * @brief Nests a value in one object for every segment of a path
  * @param path Path to create the value at
- * @param value String representation of the value
- * @return Pointer to the created JSON value
+ * @param value Value to nest, taken ownership of
+ * @return Pointer to the outermost created JSON value, the value itself if the path is empty
  */
-JsonValue* JsonEditor::createFromPath(const std::string& path, const std::string& value) {
-
-    const std::string root = Path::getRoot(path);
+JsonValue* JsonEditor::createFromPath(const std::string& path, JsonValue* value) {
 
     if(path == "") {
-        std::istringstream stream(value);
-        return JsonParser::parse(stream);
+        return value;
     }
 
-    JsonValue* recursiveValue = createFromPath(Path::getChildren(path), value);
-
-    JsonValue* object = JsonFactory::create({root}, {{root, recursiveValue}});
+    const std::string root = Path::getRoot(path);
 
-    delete recursiveValue;
+    JsonValue* recursiveValue = createFromPath(Path::getChildren(path), value);
 
-    return object;
+    return createPair(root, recursiveValue);
 }
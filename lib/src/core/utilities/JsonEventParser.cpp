@@ -0,0 +1,662 @@
+#include <cctype>
+#include <cstring>
+#include <stdexcept>
+#include "JsonEventParser.hpp"
+#include "JsonArena.hpp"
+#include "JsonGrammar.hpp"
+#include "JsonUtf8.hpp"
+
+/**
+ * @brief Anonymous namespace for internal event parsing helpers
+ */
+namespace {
+    /**
+     * @brief Number of characters read from a stream at a time
+     */
+    const size_t ChunkSize = 64 * 1024;
+
+    /**
+     * @brief Checks if a character is whitespace
+     * @param symbol Character to check
+     * @return True if the character is whitespace, false otherwise
+     */
+    inline bool isWhitespace(const char symbol) {
+        return isspace(static_cast<unsigned char>(symbol)) != 0;
+    }}
+
+/**
+ * @brief Parses JSON content from an input stream chunk by chunk
+ * @param stream Input stream containing JSON data
+ * @param handler Handler to report the tokens to
+ * @param maxDepth Maximum number of arrays and objects enclosing each other
+ * @param isRejectingDuplicates Whether an object holding a key twice is invalid
+ * @throws std::runtime_error with the validator's row/position message if the JSON is invalid
+ */
+void JsonEventParser::parse(std::istream& stream, JsonEventHandler& handler, const size_t maxDepth, const bool isRejectingDuplicates) {
+    JsonEventParser parser(handler, &stream, nullptr, 0, maxDepth, isRejectingDuplicates);
+    parser.run();
+}
+
+/**
+ * @brief Parses JSON content from a contiguous buffer
+ * @param data Pointer to the first character of the JSON text
+ * @param length Number of characters in the buffer
+ * @param handler Handler to report the tokens to
+ * @param maxDepth Maximum number of arrays and objects enclosing each other
+ * @param isRejectingDuplicates Whether an object holding a key twice is invalid
+ * @throws std::runtime_error with the validator's row/position message if the JSON is invalid
+ */
+void JsonEventParser::parse(const char* data, const size_t length, JsonEventHandler& handler, const size_t maxDepth,
+                            const bool isRejectingDuplicates) {
+    JsonEventParser parser(handler, nullptr, data, length, maxDepth, isRejectingDuplicates);
+    parser.run();
+}
+
+/**
+ * @brief Constructs a parser over a stream or a buffer; a stream starts with an empty chunk that the first read fills
+ * @param _handler Handler to report the tokens to
+ * @param _stream Stream to read chunks from, nullptr to parse the buffer
+ * @param data Pointer to the first character of the buffer
+ * @param length Number of characters in the buffer
+ * @param _maxDepth Maximum number of arrays and objects enclosing each other
+ * @param _isRejectingDuplicates Whether an object holding a key twice is invalid
+ */
+JsonEventParser::JsonEventParser(JsonEventHandler& _handler, std::istream* _stream, const char* data, const size_t length,
+                                 const size_t _maxDepth, const bool _isRejectingDuplicates)
+    : handler(_handler), stream(_stream), maxDepth(_maxDepth), isRejectingDuplicates(_isRejectingDuplicates), buffer(_stream != nullptr ? ChunkSize : 0), chunk(data), current(data),
+      chunkEnd(data + length), chunkOffset(0), isInToken(false), tokenStart(data), tokenOffset(0), row(1), lastNewline(0),
+      isNewlineFound(false) {}
+
+/**
+ * @brief Parses the whole input as a single top-level JSON value with an explicit stack
+ * @throws std::runtime_error if the JSON is invalid
+ */
+void JsonEventParser::run() {
+    bool isValueFound = false;
+
+    while(true) {
+        skipWhitespace();
+
+        if(current == chunkEnd) {
+            if(!frames.empty()) {
+                size_t errorRow = 0, position = 0;
+                locate(getOffset(), errorRow, position);
+
+                const std::string errorMessage = "Missing closing bracket on row " + std::to_string(errorRow)+" on position "
+                + std::to_string(position - 1) + ".\n";
+
+                throw std::runtime_error(errorMessage);
+            }
+
+            break;
+        }
+
+        const char symbol = *current;
+        const size_t consumed = getOffset() + 1;
+
+        if(frames.empty()) {
+            if(symbol == '}' || symbol == ']' || isValueFound) {
+                size_t errorRow = 0, position = 0;
+                locate(consumed, errorRow, position);
+
+                const std::string errorMessage = symbol == '}' || symbol == ']' ?
+                "Additional closing bracket on row " + std::to_string(errorRow)+" on position " + std::to_string(position - 1) + ".\n" :
+                "Invalid json value found on row " + std::to_string(errorRow)+" starting on position " + std::to_string(position - 1) + ".\n";
+
+                throw std::runtime_error(errorMessage);
+            }
+
+            isValueFound = true;
+        } else {
+            Frame& frame = frames.back();
+            const bool isObject = frame.brace == '{';
+
+            if(symbol == '}' || symbol == ']') {
+                close(symbol);
+                continue;
+            }
+
+            if(isObject && frame.stateOfReading == 0) {
+                frame.isCommaFound = false;
+                frame.stateOfReading++;
+
+                if(symbol != '\"') {
+                    size_t errorRow = 0, position = 0;
+                    locate(consumed, errorRow, position);
+
+                    const std::string errorMessage = "Invalid key found on row " + std::to_string(errorRow)+" on position "
+                    + std::to_string(position - 1) + ".\n";
+
+                    throw std::runtime_error(errorMessage);
+                }
+
+                readKey();
+                continue;
+            }
+
+            if(isObject && frame.stateOfReading == 1) {
+                frame.stateOfReading++;
+
+                if(symbol != ':') {
+                    size_t errorRow = 0, position = 0;
+                    locate(consumed, errorRow, position);
+
+                    const std::string errorMessage = "Key value pair separator ':' not found on row " + std::to_string(errorRow)+" on position "
+                    + std::to_string(position - 1) + ".\n";
+
+                    throw std::runtime_error(errorMessage);
+                }
+
+                current++;
+                continue;
+            }
+
+            const bool isValueExpected = isObject ? frame.stateOfReading == 2 : frame.stateOfReading == 0;
+
+            if(!isValueExpected) {
+                if(symbol != ',') {
+                    size_t errorRow = 0, position = 0;
+                    locate(consumed, errorRow, position);
+
+                    const std::string errorMessage = "Missing ',' on row " + std::to_string(errorRow)+" before position "
+                    + std::to_string(position - 1) + ".\n";
+
+                    throw std::runtime_error(errorMessage);
+                }
+
+                current++;
+                frame.isCommaFound = true;
+                frame.stateOfReading = 0;
+
+                continue;
+            }
+
+            frame.stateOfReading++;
+            frame.isCommaFound = false;
+        }
+
+        if(symbol == '{' || symbol == '[') {
+            if(frames.size() >= maxDepth) {
+                size_t errorRow = 0, position = 0;
+                locate(consumed, errorRow, position);
+
+                const std::string errorMessage = "Maximum nesting depth of " + std::to_string(maxDepth) + " exceeded on row "
+                + std::to_string(errorRow) + " on position " + std::to_string(position - 1) + ".\n";
+
+                throw std::runtime_error(errorMessage);
+            }
+
+            current++;
+            frames.push_back(Frame{symbol, 0, false, keys.size(), JsonKeyTable::NoTable});
+
+            if(symbol == '{') {
+                handler.startObject();
+            } else {
+                handler.startArray();
+            }
+        } else {
+            readPrimary();
+        }
+    }
+
+    if(!isValueFound) {
+        size_t errorRow = 0, position = 0;
+        locate(getOffset(), errorRow, position);
+
+        const std::string errorMessage = "Invalid json value found on row " + std::to_string(errorRow)+" starting on position "
+        + std::to_string(position - 1) + ".\n";
+
+        throw std::runtime_error(errorMessage);
+    }
+}
+
+/**
+ * @brief Replaces the exhausted chunk with the next one, keeping the part of the current token read so far
+ * @return True if more characters were read, false at the end of the input
+ */
+bool JsonEventParser::fill() {
+    if(stream == nullptr) {
+        return false;
+    }
+
+    if(isInToken) {
+        token.append(tokenStart, chunkEnd);
+    }
+
+    chunkOffset += chunkEnd - chunk;
+
+    stream -> read(buffer.data(), buffer.size());
+    const size_t count = static_cast<size_t>(stream -> gcount());
+
+    chunk = buffer.data();
+    current = chunk;
+    chunkEnd = chunk + count;
+    tokenStart = chunk;
+
+    return count != 0;
+}
+
+/**
+ * @brief Skips whitespace characters, counting the newlines among them
+ */
+void JsonEventParser::skipWhitespace() {
+    while(true) {
+        while(current < chunkEnd && isWhitespace(*current)) {
+            if(*current == '\n') {
+                row++;
+                lastNewline = chunkOffset + (current - chunk);
+                isNewlineFound = true;
+            }
+
+            current++;
+        }
+
+        if(current < chunkEnd || !fill()) {
+            return;
+        }
+    }
+}
+
+/**
+ * @brief Gets the offset of the next character from the beginning of the input
+ * @return Offset of the next character
+ */
+size_t JsonEventParser::getOffset() const {
+    return chunkOffset + (current - chunk);
+}
+
+/**
+ * @brief Starts a token at the next character
+ */
+void JsonEventParser::beginToken() {
+    token.clear();
+    isInToken = true;
+    tokenStart = current;
+    tokenOffset = getOffset();
+}
+
+/**
+ * @brief Ends the current token before the next character
+ * @param length Resulting number of characters in the token
+ * @return Pointer to the first character of the token
+ */
+const char* JsonEventParser::endToken(size_t& length) {
+    isInToken = false;
+
+    if(token.empty()) {
+        length = current - tokenStart;
+        return tokenStart;
+    }
+
+    token.append(tokenStart, current);
+    length = token.length();
+
+    return token.data();
+}
+
+/**
+ * @brief Gets the characters of the current token read so far
+ * @return Copy of the characters
+ */
+std::string JsonEventParser::getTokenText() const {
+    return token + std::string(tokenStart, current);
+}
+
+/**
+ * @brief Reads a value that is not an array or object and reports it
+ * @throws std::runtime_error if the value is invalid
+ */
+void JsonEventParser::readPrimary() {
+    switch(*current) {
+        case 'n' : {
+            readLiteral("null", 4, "null", "null");
+            handler.visitNull();
+            break;
+        }
+        case 't' : {
+            readLiteral("true", 4, "boolean", "true or false");
+            handler.visitBoolean(true);
+            break;
+        }
+        case 'f' : {
+            readLiteral("false", 5, "boolean", "true or false");
+            handler.visitBoolean(false);
+            break;
+        }
+        case '\"' : {
+            size_t length = 0;
+            const char* data = readString(length);
+            handler.visitString(data + 1, length - 2);
+            break;
+        }
+        default : {
+            if(*current != '-' && !JsonGrammar::isDigit(*current)) {
+                size_t errorRow = 0, position = 0;
+                locate(getOffset() + 1, errorRow, position);
+
+                const std::string errorMessage = "Invalid json value found on row " + std::to_string(errorRow)+" starting on position "
+                + std::to_string(position - 1) + ".\n";
+
+                throw std::runtime_error(errorMessage);
+            }
+
+            size_t length = 0;
+            const char* data = readNumber(length);
+            handler.visitNumber(data, length);
+            break;
+        }
+    }
+}
+
+/**
+ * @brief Reads null, true or false: exactly as many characters as the literal has, or the rest of the input
+ * @param literal The expected literal
+ * @param length Number of characters in the literal
+ * @param valueName Name of the value kind used in the error message
+ * @param expected Description of the expected text used in the error message
+ * @throws std::runtime_error if other characters were found instead of the literal
+ */
+void JsonEventParser::readLiteral(const char* literal, const size_t length, const char* valueName, const char* expected) {
+    beginToken();
+
+    size_t counter = 0;
+
+    while(counter < length && (current < chunkEnd || fill())) {
+        current++;
+        counter++;
+    }
+
+    size_t tokenLength = 0;
+    const char* data = endToken(tokenLength);
+
+    if(counter != length || memcmp(data, literal, length) != 0) {
+        size_t errorRow = 0, position = 0;
+        locate(tokenOffset + 1, errorRow, position);
+
+        const std::string errorMessage = "Invalid " + std::string(valueName) + " value!\nGot " + std::string(data, tokenLength) +
+        " instead of " + std::string(expected) + " on row " + std::to_string(errorRow)+" between positions " +
+        std::to_string(position) + " and " + std::to_string(position + counter -1) + ".\n";
+
+        throw std::runtime_error(errorMessage);
+    }
+}
+
+/**
+ * @brief Reads a number up to the next whitespace, ',', '}', ']' or the end of the input
+ * @param length Resulting number of characters in the number
+ * @return Pointer to the first character of the number
+ * @throws std::runtime_error if the number is invalid
+ */
+const char* JsonEventParser::readNumber(size_t& length) {
+    beginToken();
+    current++;
+
+    while(true) {
+        while(current < chunkEnd && !isWhitespace(*current) && *current != ',' && *current != '}' && *current != ']') {
+            current++;
+        }
+
+        if(current < chunkEnd || !fill()) {
+            break;
+        }
+    }
+
+    const char* data = endToken(length);
+
+    if(!JsonGrammar::isValidNumber(data, length)) {
+        size_t errorRow = 0, position = 0;
+        locate(tokenOffset + 1, errorRow, position);
+
+        const std::string errorMessage = "Invalid number value!\nGot this: " + std::string(data, length) +
+        " instead of valid number on row " + std::to_string(errorRow)+" between positions " + std::to_string(position) +
+        " and " + std::to_string(position + length -1) + ".\n";
+
+        throw std::runtime_error(errorMessage);
+    }
+
+    return data;
+}
+
+/**
+ * @brief Reads a string, checking every character; runs of plain characters are skipped in one go
+ * @param length Resulting number of characters in the string including the quotes
+ * @return Pointer to the opening quote
+ * @throws std::runtime_error if the string is unclosed or contains invalid characters or ill-formed UTF-8
+ */
+const char* JsonEventParser::readString(size_t& length) {
+    beginToken();
+    current++;
+
+    size_t hexDigitsLeft = 0;
+    bool isEscaped = false;
+
+    while(true) {
+        if(!isEscaped && hexDigitsLeft == 0) {
+            current = JsonGrammar::skipPlainCharacters(current, chunkEnd);
+        }
+
+        if(current == chunkEnd) {
+            if(fill()) {
+                continue;
+            }
+
+            const std::string text = getTokenText();
+            checkUtf8(text.data(), text.length());
+
+            size_t errorRow = 0, position = 0;
+            locate(tokenOffset + 1, errorRow, position);
+
+            const size_t counter = getOffset() - tokenOffset;
+
+            const std::string errorMessage = "Invalid string value!\nGot unclosed string value: " + text +
+            " on row " + std::to_string(errorRow)+" between positions " + std::to_string(position) +
+            " and " + std::to_string(position + counter -1) + ".\n";
+
+            throw std::runtime_error(errorMessage);
+        }
+
+        const char symbol = *current;
+        const char* errorKind = nullptr;
+
+        if(static_cast<unsigned char>(symbol) < 0x20) {
+            errorKind = "Got control character or \\ in this: ";
+        }
+        else if((isEscaped && !JsonGrammar::isEscapeCharacter(symbol)) || (hexDigitsLeft > 0 && !isxdigit(static_cast<unsigned char>(symbol)))) {
+            errorKind = "Got invalid escape sequence in this: ";
+        }
+
+        if(errorKind != nullptr) {
+            const std::string text = getTokenText();
+            checkUtf8(text.data(), text.length());
+
+            size_t errorRow = 0, position = 0;
+            locate(tokenOffset + 1, errorRow, position);
+
+            const std::string errorMessage = "Invalid string value!\n" + std::string(errorKind) + text +
+            " on row " + std::to_string(errorRow)+" between positions " + std::to_string(position) +
+            " and " + std::to_string(position + (getOffset() - tokenOffset)) + ".\n";
+
+            throw std::runtime_error(errorMessage);
+        }
+
+        current++;
+
+        if(isEscaped) {
+            isEscaped = false;
+            hexDigitsLeft = symbol == 'u' ? 4 : 0;
+        }
+        else if(hexDigitsLeft > 0) {
+            hexDigitsLeft--;
+        }
+        else if(symbol == '\\') {
+            isEscaped = true;
+        }
+        else if(symbol == '\"') {
+            break;
+        }
+    }
+
+    const char* data = endToken(length);
+    checkUtf8(data, length - 1);
+
+    return data;
+}
+
+/**
+ * @brief Checks that the characters of the current string read so far are well-formed UTF-8
+ * @param data Pointer to the opening quote
+ * @param length Number of characters read so far, without the closing quote
+ * @throws std::runtime_error if the characters contain an ill-formed UTF-8 sequence
+ */
+void JsonEventParser::checkUtf8(const char* data, const size_t length) const {
+    const char* invalid = JsonUtf8::findInvalid(data + 1, data + length);
+
+    if(invalid == data + length) {
+        return;
+    }
+
+    size_t errorRow = 0, position = 0;
+    locate(tokenOffset + 1, errorRow, position);
+
+    const std::string errorMessage = "Invalid string value!\nGot invalid UTF-8 sequence in this: " + std::string(data, invalid) +
+    " on row " + std::to_string(errorRow)+" between positions " + std::to_string(position) +
+    " and " + std::to_string(position + (invalid - data)) + ".\n";
+
+    throw std::runtime_error(errorMessage);
+}
+
+/**
+ * @brief Reads a key of the innermost object, rejecting duplicates if asked to, and reports it
+ * @throws std::runtime_error if the key is invalid or already exists in the object
+ */
+void JsonEventParser::readKey() {
+    size_t length = 0;
+    const char* data = readString(length);
+    const char* key = data + 1;
+    const size_t keyLength = length - 2;
+
+    if(!isRejectingDuplicates) {
+        handler.visitKey(key, keyLength);
+        return;
+    }
+
+    Frame& frame = frames.back();
+
+    keys.push_back(Key{keyText.length(), keyLength});
+    keyText.append(key, keyLength);
+
+    if(keyTable.isDuplicate(OpenKeys{keyText, keys}, frame.keysBase, frame.tableBase)) {
+        size_t errorRow = 0, position = 0;
+        locate(getOffset(), errorRow, position);
+
+        const std::string errorMessage = "Dublicate keys in same object found. The dublicate key: " + std::string(data, length) + " is on row " + std::to_string(errorRow)+" on position "
+        + std::to_string(position) + ".\n";
+
+        throw std::runtime_error(errorMessage);
+    }
+
+    handler.visitKey(key, keyLength);
+}
+
+/**
+ * @brief Gets the number of keys of the open objects
+ * @return Number of keys
+ */
+size_t JsonEventParser::OpenKeys::size() const {
+    return keys.size();
+}
+
+/**
+ * @brief Hashes a key of an open object
+ * @param position Position of the key in keys
+ * @return Hash of the key
+ */
+size_t JsonEventParser::OpenKeys::hash(const size_t position) const {
+    return ArenaStringHash()(keyText.data() + keys[position].offset, keys[position].length);
+}
+
+/**
+ * @brief Compares two keys of the open objects
+ * @param first Position of the first key in keys
+ * @param second Position of the second key in keys
+ * @return True if the keys are equal, false otherwise
+ */
+bool JsonEventParser::OpenKeys::isSame(const size_t first, const size_t second) const {
+    return keys[first].length == keys[second].length &&
+           memcmp(keyText.data() + keys[first].offset, keyText.data() + keys[second].offset, keys[first].length) == 0;
+}
+
+/**
+ * @brief Handles a closing brace/bracket inside the innermost array or object, closing it if it is complete
+ * @param symbol The closing character
+ * @throws std::runtime_error if the closing character is not valid here
+ */
+void JsonEventParser::close(const char symbol) {
+    const Frame& frame = frames.back();
+    const bool isObject = frame.brace == '{';
+    const size_t consumed = getOffset() + 1;
+
+    current++;
+
+    const bool isValidClosing = !frame.isCommaFound && symbol - frame.brace == 2 && (!isObject || frame.stateOfReading == 0 || frame.stateOfReading == 3);
+
+    if(isValidClosing) {
+        if(frame.keysBase < keys.size()) {
+            keyText.resize(keys[frame.keysBase].offset);
+            keys.resize(frame.keysBase);
+        }
+
+        keyTable.release(frame.tableBase);
+
+        frames.pop_back();
+
+        if(isObject) {
+            handler.endObject();
+        } else {
+            handler.endArray();
+        }
+
+        return;
+    }
+
+    size_t errorRow = 0, position = 0;
+    locate(consumed, errorRow, position);
+
+    std::string errorMessage = "";
+
+    if(frame.isCommaFound) {
+        errorMessage = "Additional comma found on row " + std::to_string(errorRow)+" on position "
+        + std::to_string(position) + ".\n";
+    }
+    else if(symbol - frame.brace != 2) {
+        errorMessage = "Mismatching closing bracket on row " + std::to_string(errorRow)+" on position "
+        + std::to_string(position - 1) + ".\n";
+    }
+    else if(isObject && frame.stateOfReading == 1) {
+        errorMessage = "Key value pair separator ':' not found on row " + std::to_string(errorRow)+" on position "
+        + std::to_string(position - 1) + ".\n";
+    }
+    else {
+        errorMessage = "Invalid json value found on row " + std::to_string(errorRow)+" starting on position "
+        + std::to_string(position - 1) + ".\n";
+    }
+
+    throw std::runtime_error(errorMessage);
+}
+
+/**
+ * @brief Computes the row and position JsonValidator reports after a number of characters were read
+ * @param consumed Number of characters read from the beginning of the input
+ * @param _row Resulting row number
+ * @param position Resulting position in row
+ */
+void JsonEventParser::locate(const size_t consumed, size_t& _row, size_t& position) const {
+    _row = row;
+
+    if(!isNewlineFound) {
+        position = consumed + 1;
+        return;
+    }
+
+    position = consumed - 1 - lastNewline;
+}
\ No newline at end of file
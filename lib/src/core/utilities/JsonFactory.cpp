@@ -1,4 +1,6 @@
 #include <cctype>
+#include <cstring>
+#include <new>
 #include "JsonFactory.hpp"
 #include "JsonNull.hpp"
 #include "JsonBoolean.hpp"
@@ -12,20 +14,30 @@
  * @return Pointer to the created JsonValue
  */
 JsonValue* JsonFactory::create(const std::string& value) {
-    if(value == "null") {
+    return create(value.data(), value.length());
+}
+
+/**
+ * @brief Creates a JSON value from a range of characters holding its representation
+ * @param data Pointer to the first character of the representation
+ * @param length Number of characters in the representation
+ * @return Pointer to the created JsonValue
+ */
+JsonValue* JsonFactory::create(const char* data, const size_t length) {
+    if(length == 4 && memcmp(data, "null", 4) == 0) {
         return new JsonNull();
     }
-    if(value == "true" || value == "false") {
-        const bool bvalue = value == "true" ? true : false;
+    if((length == 4 && memcmp(data, "true", 4) == 0) || (length == 5 && memcmp(data, "false", 5) == 0)) {
+        const bool bvalue = length == 4 ? true : false;
         return new JsonBoolean(bvalue);
     }
-    if(value[0] == '-' || isdigit(value[0])){
-        return new JsonNumber(value);
+    if(length > 0 && (data[0] == '-' || isdigit(static_cast<unsigned char>(data[0])))){
+        return new JsonNumber(data, length);
     }
-    if(value[0] == '\"'){
-        return new JsonString(value);
+    if(length > 0 && data[0] == '\"'){
+        return new JsonString(data, length);
     }
-    if(value == "[") {
+    if(length == 1 && data[0] == '[') {
         return new JsonArray();
     }
     return new JsonObject();
@@ -48,4 +60,48 @@ JsonValue* JsonFactory::create(const std::vector<JsonValue*>& values) {
  */
 JsonValue* JsonFactory::create(const std::list<std::string>& keys, const std::unordered_map<std::string, JsonValue*>& values) {
     return new JsonObject(keys, values);
+}
+
+/**
+ * @brief Creates a JSON array that takes ownership of the values
+ * @param values Storage of pointers to JSON values to take over
+ * @return Pointer to the created JsonArray
+ */
+JsonValue* JsonFactory::create(JsonArray::Values&& values) {
+    return new JsonArray(std::move(values));
+}
+
+/**
+ * @brief Creates a JSON object that takes ownership of the values, the keys are copied
+ * @param keys List of keys
+ * @param values Map of key-value pairs whose values to take over
+ * @return Pointer to the created JsonObject
+ */
+JsonValue* JsonFactory::create(std::list<std::string>&& keys, std::unordered_map<std::string, JsonValue*>&& values) {
+    return new JsonObject(std::move(keys), std::move(values));
+}
+
+/**
+ * @brief Creates a JSON object that takes ownership of the key-value pairs
+ * @param entries Pairs with unique keys to take over, in insertion order
+ * @return Pointer to the created JsonObject
+ */
+JsonValue* JsonFactory::create(JsonObject::Entries&& entries) {
+    return new JsonObject(std::move(entries));
+}
+
+/**
+ * @brief Creates a JSON array or object whose content is parsed from its source when first accessed
+ * @param brace Opening brace/bracket of the value
+ * @param span Source and position of the value's text
+ * @return Pointer to the created JsonArray or JsonObject
+ */
+JsonValue* JsonFactory::create(const char brace, const JsonSpan& span) {
+    JsonSpan* unparsed = new (JsonArena::allocate(sizeof(JsonSpan))) JsonSpan(span);
+
+    if(brace == '[') {
+        return new JsonArray(unparsed);
+    }
+
+    return new JsonObject(unparsed);
 }
\ No newline at end of file
@@ -0,0 +1,172 @@
+#include <utility>
+#include "JsonFile.hpp"
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <cerrno>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define JSONFILE_POSIX
+#else
+#include <fstream>
+#include <iterator>
+#endif
+
+/**
+ * @brief Anonymous namespace for the buffered read constants
+ */
+namespace {
+    /**
+     * @brief Number of characters requested per read when the file is not mapped
+     */
+    const size_t ReadSize = 64 * 1024;
+}
+
+/**
+ * @brief Constructs a view of no file
+ */
+JsonFile::JsonFile() : data(nullptr), length(0), mapping(nullptr) {}
+
+/**
+ * @brief Destructor, unmaps or frees the content
+ */
+JsonFile::~JsonFile() {
+    close();
+}
+
+/**
+ * @brief Opens a file and makes its whole content available, replacing the previously opened one
+ * @param filename Name of the file to open
+ * @return True if the file was opened, false if it could not be opened or read
+ */
+bool JsonFile::open(const std::string& filename) {
+    close();
+
+#ifdef JSONFILE_POSIX
+    const int descriptor = ::open(filename.c_str(), O_RDONLY);
+
+    if(descriptor < 0) {
+        return false;
+    }
+
+    const bool isLoaded = load(descriptor);
+    ::close(descriptor);
+
+    if(!isLoaded) {
+        return false;
+    }
+#else
+    std::ifstream stream(filename, std::ios::in | std::ios::binary);
+
+    if(!stream.is_open()) {
+        return false;
+    }
+
+    content.assign(std::istreambuf_iterator<char>(stream), std::istreambuf_iterator<char>());
+    data = content.data();
+    length = content.length();
+#endif
+
+    return true;
+}
+
+/**
+ * @brief Releases the content of the opened file
+ */
+void JsonFile::close() {
+#ifdef JSONFILE_POSIX
+    if(mapping != nullptr) {
+        munmap(mapping, length);
+    }
+#endif
+
+    mapping = nullptr;
+    data = nullptr;
+    length = 0;
+    std::string().swap(content);
+}
+
+/**
+ * @brief Exchanges the opened files of two views
+ * @param other View to exchange with
+ */
+void JsonFile::swap(JsonFile& other) {
+    std::swap(length, other.length);
+    std::swap(mapping, other.mapping);
+    content.swap(other.content);
+
+    data = mapping != nullptr ? static_cast<const char*>(mapping) : content.data();
+    other.data = other.mapping != nullptr ? static_cast<const char*>(other.mapping) : other.content.data();
+}
+
+/**
+ * @brief Gets the content of the opened file
+ * @return Pointer to the first character, valid until the file is closed
+ */
+const char* JsonFile::getData() const {
+    return data;
+}
+
+/**
+ * @brief Gets the size of the content of the opened file
+ * @return Number of characters
+ */
+size_t JsonFile::getLength() const {
+    return length;
+}
+
+/**
+ * @brief Checks whether the content is memory-mapped rather than read into a buffer
+ * @return True if the file is mapped, false otherwise
+ */
+bool JsonFile::isMapped() const {
+    return mapping != nullptr;
+}
+
+/**
+ * @brief Maps a regular file read-only, or reads anything that cannot be mapped in chunks
+ * @param descriptor Descriptor of the file opened for reading
+ * @return True if the whole content was mapped or read, false if reading failed
+ */
+bool JsonFile::load(const int descriptor) {
+#ifdef JSONFILE_POSIX
+    struct stat status;
+    const bool isRegular = fstat(descriptor, &status) == 0 && S_ISREG(status.st_mode);
+    const size_t size = isRegular && status.st_size > 0 ? static_cast<size_t>(status.st_size) : 0;
+
+    if(size > 0) {
+        void* address = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, descriptor, 0);
+
+        if(address != MAP_FAILED) {
+            madvise(address, size, MADV_SEQUENTIAL);
+            mapping = address;
+            data = static_cast<const char*>(address);
+            length = size;
+            return true;
+        }
+    }
+
+    content.reserve(size);
+
+    char buffer[ReadSize];
+
+    while(true) {
+        const ssize_t count = read(descriptor, buffer, ReadSize);
+
+        if(count > 0) {
+            content.append(buffer, static_cast<size_t>(count));
+        } else if(count == 0) {
+            break;
+        } else if(errno != EINTR) {
+            std::string().swap(content);
+            return false;
+        }
+    }
+
+    data = content.data();
+    length = content.length();
+#endif
+
+    return true;
+}
@@ -0,0 +1,134 @@
+#include <cstdint>
+#include <cstring>
+#include "JsonGrammar.hpp"
+
+/**
+ * @brief Anonymous namespace for character class helpers
+ */
+namespace {
+    /**
+     * @brief Checks whether any of eight characters read as one word is a quote, a backslash or a control character
+     * @param word Eight characters
+     * @return True if any character needs a closer look, false if all of them can be skipped
+     */
+    inline bool hasStringSpecial(const uint64_t word) {
+        const uint64_t ones = 0x0101010101010101ULL;
+        const uint64_t highs = 0x8080808080808080ULL;
+        const uint64_t quotes = word ^ (ones * '\"');
+        const uint64_t backslashes = word ^ (ones * '\\');
+
+        return (((quotes - ones) & ~quotes) | ((backslashes - ones) & ~backslashes) | ((word - ones * 0x20) & ~word)) & highs;
+    }
+
+    /**
+     * @brief Checks if a character may not appear in a JSON string as it is
+     * @param symbol Character to check
+     * @return True for quotes, backslashes and control characters, false otherwise
+     */
+    inline bool isStringSpecial(const char symbol) {
+        return static_cast<unsigned char>(symbol) < 0x20 || symbol == '\"' || symbol == '\\';
+    }
+}
+
+/**
+ * @brief Checks a number token against the JSON number grammar -?(0|[1-9]\d*)(\.\d+)?([eE][+-]?\d+)?
+ * @param value Pointer to the first character of the token
+ * @param length Length of the token
+ * @return True if the token is a valid JSON number, false otherwise
+ */
+bool JsonGrammar::isValidNumber(const char* value, const size_t length) {
+    size_t i = 0;
+
+    if(i < length && value[i] == '-') {
+        i++;
+    }
+
+    if(i >= length || !isDigit(value[i])) {
+        return false;
+    }
+
+    if(value[i] == '0') {
+        i++;
+    } else {
+        while(i < length && isDigit(value[i])) {
+            i++;
+        }
+    }
+
+    if(i < length && value[i] == '.') {
+        i++;
+
+        if(i >= length || !isDigit(value[i])) {
+            return false;
+        }
+
+        while(i < length && isDigit(value[i])) {
+            i++;
+        }
+    }
+
+    if(i < length && (value[i] == 'e' || value[i] == 'E')) {
+        i++;
+
+        if(i < length && (value[i] == '+' || value[i] == '-')) {
+            i++;
+        }
+
+        if(i >= length || !isDigit(value[i])) {
+            return false;
+        }
+
+        while(i < length && isDigit(value[i])) {
+            i++;
+        }
+    }
+
+    return i == length;
+}
+
+/**
+ * @brief Checks if a character may follow a backslash inside a JSON string
+ * @param symbol Character after the backslash
+ * @return True if the escape sequence is valid, false otherwise
+ */
+bool JsonGrammar::isEscapeCharacter(const char symbol) {
+    switch(symbol) {
+        case '\"':
+        case '\\':
+        case '/':
+        case 'b':
+        case 'f':
+        case 'n':
+        case 'r':
+        case 't':
+        case 'u':
+            return true;
+        default:
+            return false;
+    }
+}
+
+/**
+ * @brief Skips the characters a JSON string may contain as they are, eight at a time
+ * @param begin Pointer to the first character to check
+ * @param end Pointer one past the last character to check
+ * @return Pointer to the first quote, backslash or control character, end if there is none
+ */
+const char* JsonGrammar::skipPlainCharacters(const char* begin, const char* end) {
+    while(end - begin >= static_cast<std::ptrdiff_t>(sizeof(uint64_t))) {
+        uint64_t word;
+        std::memcpy(&word, begin, sizeof(word));
+
+        if(hasStringSpecial(word)) {
+            break;
+        }
+
+        begin += sizeof(word);
+    }
+
+    while(begin < end && !isStringSpecial(*begin)) {
+        begin++;
+    }
+
+    return begin;
+}
\ No newline at end of file
@@ -0,0 +1,45 @@
+#include "JsonInstructionSet.hpp"
+
+#if (defined(__x86_64__) || defined(__i386__)) && (defined(__GNUC__) || defined(__clang__))
+#define JSON_INSTRUCTION_SET_X86 1
+#else
+#define JSON_INSTRUCTION_SET_X86 0
+#endif
+
+/**
+ * @brief Checks whether the scanners can use an instruction set on the running CPU, Sse meaning SSE4.2
+ * @param set Instruction set to check
+ * @return True if the set is compiled in and the CPU supports it, false otherwise
+ */
+bool JsonInstructionSet::isSupported(const InstructionSet set) {
+    switch(set) {
+        case InstructionSet::Scalar:
+            return true;
+#if JSON_INSTRUCTION_SET_X86
+        case InstructionSet::Sse:
+            __builtin_cpu_init();
+            return __builtin_cpu_supports("sse4.2");
+        case InstructionSet::Avx2:
+            __builtin_cpu_init();
+            return __builtin_cpu_supports("avx2");
+#endif
+        default:
+            return false;
+    }
+}
+
+/**
+ * @brief Gets the widest instruction set the scanners can use on the running CPU
+ * @return Widest supported instruction set, Scalar if there is no other
+ */
+InstructionSet JsonInstructionSet::getWidest() {
+    if(isSupported(InstructionSet::Avx2)) {
+        return InstructionSet::Avx2;
+    }
+
+    if(isSupported(InstructionSet::Sse)) {
+        return InstructionSet::Sse;
+    }
+
+    return InstructionSet::Scalar;
+}
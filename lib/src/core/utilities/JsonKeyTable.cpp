@@ -0,0 +1,45 @@
+#include "JsonKeyTable.hpp"
+
+/**
+ * @brief Drops the table of the innermost object as the object is closed
+ * @param tableBase Position of the object's table among the slots, NoTable if it has none
+ */
+void JsonKeyTable::release(const size_t tableBase) {
+    if(tableBase != NoTable) {
+        slots.resize(tableBase);
+    }
+}
+
+/**
+ * @brief Puts a key into a table that has a free slot, probing linearly from its hash
+ * @param tableBase Position of the table among the slots
+ * @param mask Number of slots of the table minus one
+ * @param key Slot of the key
+ */
+void JsonKeyTable::insert(const size_t tableBase, const size_t mask, const Slot& key) {
+    size_t slot = key.hash & mask;
+
+    while(slots[tableBase + slot].position != 0) {
+        slot = (slot + 1) & mask;
+    }
+
+    slots[tableBase + slot] = key;
+}
+
+/**
+ * @brief Doubles the table of the innermost object without hashing the keys again
+ * @param tableBase Position of the object's table among the slots, which must be the last table
+ */
+void JsonKeyTable::grow(const size_t tableBase) {
+    const size_t size = slots.size() - tableBase;
+
+    slots.resize(tableBase + size * 3, Slot{0, 0});
+
+    for(size_t i = tableBase; i < tableBase + size; i++) {
+        if(slots[i].position != 0) {
+            insert(tableBase + size, size * 2 - 1, slots[i]);
+        }
+    }
+
+    slots.erase(slots.begin() + tableBase, slots.begin() + tableBase + size);
+}
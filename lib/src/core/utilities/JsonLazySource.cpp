@@ -0,0 +1,80 @@
+#include <stdexcept>
+#include "JsonLazySource.hpp"
+
+/**
+ * @brief Anonymous namespace for the scratch buffer limits
+ */
+namespace {
+    /**
+     * @brief Number of structural entries above which the index buffer is released after a level
+     */
+    const size_t MaxKeptIndexSize = 64 * 1024;
+}
+
+/**
+ * @brief Constructs a source over the text of a document
+ * @param _data Pointer to the first character of the document, which must outlive the source
+ * @param _length Number of characters in the document
+ * @param _arena Arena the document's values are carved from
+ */
+JsonLazySource::JsonLazySource(const char* _data, const size_t _length, JsonArena& _arena) : data(_data), length(_length), arena(_arena) {}
+
+/**
+ * @brief Parses the elements of an array by moving them out of a freshly parsed array
+ * @param array Array to fill
+ * @param begin Offset of the opening bracket in the document
+ * @param end Offset one past the closing bracket
+ * @throws std::runtime_error with the validator's message if the document is invalid
+ */
+void JsonLazySource::load(JsonArray& array, const size_t begin, const size_t end) {
+    JsonValue* value = parse(begin, end);
+
+    array = std::move(static_cast<JsonArray&>(*value));
+
+    delete value;
+}
+
+/**
+ * @brief Parses the key-value pairs of an object by moving them out of a freshly parsed object
+ * @param object Object to fill
+ * @param begin Offset of the opening brace in the document
+ * @param end Offset one past the closing brace
+ * @throws std::runtime_error with the validator's message if the document is invalid
+ */
+void JsonLazySource::load(JsonObject& object, const size_t begin, const size_t end) {
+    JsonValue* value = parse(begin, end);
+
+    object = std::move(static_cast<JsonObject&>(*value));
+
+    delete value;
+}
+
+/**
+ * @brief Parses one array or object of the document into its arena
+ * @param begin Offset of the opening brace/bracket
+ * @param end Offset one past the end of the value's text
+ * @return Pointer to the parsed JsonArray or JsonObject
+ * @throws std::runtime_error with the validator's message if the document is invalid
+ */
+JsonValue* JsonLazySource::parse(const size_t begin, const size_t end) {
+    std::string spanError;
+
+    try {
+        JsonArena::Scope scope(arena);
+        JsonValue* value = JsonParser::parseLevel(data, begin, end, this, scratch);
+
+        if(scratch.index.structurals.capacity() > MaxKeptIndexSize) {
+            std::vector<uint32_t>().swap(scratch.index.structurals);
+            std::vector<uint32_t>().swap(scratch.index.specials);
+        }
+
+        return value;
+    }
+    catch(const std::runtime_error& error) {
+        spanError = error.what();
+    }
+
+    const std::pair<bool, std::string> result = JsonValidator::validateJson(data, length);
+
+    throw std::runtime_error(result.first ? spanError : result.second);
+}
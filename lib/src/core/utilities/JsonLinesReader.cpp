@@ -0,0 +1,440 @@
+#include <algorithm>
+#include <condition_variable>
+#include <cstring>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+#include "JsonLinesReader.hpp"
+#include "JsonArena.hpp"
+#include "JsonParser.hpp"
+
+/**
+ * @brief Anonymous namespace for the batches shared between the reading thread and the workers
+ */
+namespace {
+    /**
+     * @brief Number of characters a batch is cut at, extended to the end of the line
+     */
+    const size_t BatchSize = 1024 * 1024;
+
+    /**
+     * @brief Number of batches per worker that may be in flight before the reading thread waits for results
+     */
+    const size_t BatchesPerThread = 4;
+
+    /**
+     * @brief Single line of the input and the result of parsing it
+     */
+    struct Record {
+        size_t line;        ///< Line of the record, counting from 1
+        const char* data;   ///< First character of the record
+        size_t length;      ///< Number of characters in the record, without the newline
+        bool isValid;       ///< Whether the record is valid JSON
+        JsonValue* value;   ///< Parsed record, nullptr when invalid or only validating
+        std::string error;  ///< Validator message of an invalid record
+    };
+
+    /**
+     * @brief Run of whole lines parsed by a single worker into a single arena
+     */
+    struct Batch {
+        std::string storage;          ///< Characters of the batch when reading a stream
+        std::vector<Record> records;  ///< Non-blank lines of the batch
+        JsonArena arena;              ///< Arena holding the values of every record of the batch
+        bool isDone;                  ///< Whether a worker finished the batch
+    };
+
+    /**
+     * @brief State shared by the reading thread and the workers, guarded by its mutex
+     */
+    struct WorkQueue {
+        std::mutex mutex;                        ///< Guards every other member
+        std::condition_variable workAvailable;   ///< Signalled when a batch is queued or the queue is closed
+        std::condition_variable batchDone;       ///< Signalled when a worker finishes a batch
+        std::deque<Batch*> pending;              ///< Batches not taken by a worker yet
+        std::deque<Batch*> inFlight;             ///< Batches not delivered yet, in input order
+        bool isClosed;                           ///< Whether no more batches will be queued
+        bool isBuilding;                         ///< Whether JsonValue nodes are created for the records
+        size_t maxDepth;                         ///< Number of arrays and objects allowed to enclose each other in a record
+    };
+
+    /**
+     * @brief Checks if a line holds nothing but whitespace
+     * @param data Pointer to the first character of the line
+     * @param length Number of characters in the line
+     * @return True if the line is blank, false otherwise
+     */
+    bool isBlank(const char* data, const size_t length) {
+        for(size_t i = 0; i < length; i++) {
+            if(data[i] != ' ' && data[i] != '\t' && data[i] != '\r') {
+                return false;
+            }
+        }
+
+        return true;
+    }
+
+    /**
+     * @brief Splits whole lines into the records of a batch, skipping blank lines
+     * @param batch Batch to add the records to
+     * @param begin First character of the lines
+     * @param end One past the last character of the lines
+     * @param line Line of the first character, advanced past the lines
+     */
+    void addRecords(Batch& batch, const char* begin, const char* end, size_t& line) {
+        while(begin < end) {
+            const char* newline = static_cast<const char*>(memchr(begin, '\n', end - begin));
+            const char* lineEnd = newline != nullptr ? newline : end;
+
+            if(!isBlank(begin, lineEnd - begin)) {
+                batch.records.push_back(Record{line, begin, static_cast<size_t>(lineEnd - begin), false, nullptr, ""});
+            }
+
+            line++;
+            begin = newline != nullptr ? newline + 1 : end;
+        }
+    }
+
+    /**
+     * @brief Cuts the next batch of a buffer at the first line end after BatchSize characters
+     * @param position Next unread character, advanced past the batch
+     * @param end One past the last character of the buffer
+     * @param begin Resulting first character of the batch
+     * @return True if a batch was cut, false at the end of the buffer
+     */
+    bool cutBuffer(const char*& position, const char* end, const char*& begin) {
+        if(position >= end) {
+            return false;
+        }
+
+        begin = position;
+
+        if(static_cast<size_t>(end - position) <= BatchSize) {
+            position = end;
+        } else {
+            const char* newline = static_cast<const char*>(memchr(position + BatchSize, '\n', end - position - BatchSize));
+            position = newline != nullptr ? newline + 1 : end;
+        }
+
+        return true;
+    }
+
+    /**
+     * @brief Reads the next batch of a stream, carrying the partial last line over to the next one
+     * @param stream Stream to read from
+     * @param storage Resulting characters of the batch
+     * @param carry Partial line left over by the previous batch, replaced by the one left over by this batch
+     * @return True if any characters were read, false at the end of the stream
+     */
+    bool cutStream(std::istream& stream, std::string& storage, std::string& carry) {
+        storage.swap(carry);
+        carry.clear();
+
+        while(true) {
+            const size_t size = storage.size();
+            storage.resize(size + BatchSize);
+            stream.read(&storage[size], BatchSize);
+            storage.resize(size + static_cast<size_t>(stream.gcount()));
+
+            if(storage.size() == size) {
+                break;
+            }
+
+            const size_t newline = storage.rfind('\n');
+
+            if(newline != std::string::npos) {
+                carry.assign(storage, newline + 1, std::string::npos);
+                storage.resize(newline + 1);
+                break;
+            }
+        }
+
+        return !storage.empty();
+    }
+
+    /**
+     * @brief Parses or validates every record of a batch into the batch's arena
+     * @param batch Batch to parse
+     * @param isBuilding Whether JsonValue nodes are created for the records
+     * @param maxDepth Maximum number of arrays and objects enclosing each other in a record
+     */
+    void parseBatch(Batch& batch, const bool isBuilding, const size_t maxDepth) {
+        JsonArena::Scope scope(batch.arena);
+
+        for(Record& record : batch.records) {
+            if(!isBuilding) {
+                std::pair<bool, std::string> result = JsonValidator::validateJson(record.data, record.length, 1, maxDepth);
+                record.isValid = result.first;
+                record.error.swap(result.second);
+                continue;
+            }
+
+            try {
+                record.value = JsonParser::parseValidated(record.data, record.length, false, maxDepth);
+                record.isValid = true;
+            }
+            catch(const std::runtime_error& error) {
+                record.error = error.what();
+            }
+        }
+    }
+
+    /**
+     * @brief Worker loop taking batches from the queue until it is closed and empty
+     * @param queue Shared queue
+     */
+    void work(WorkQueue& queue) {
+        while(true) {
+            Batch* batch = nullptr;
+
+            {
+                std::unique_lock<std::mutex> lock(queue.mutex);
+                queue.workAvailable.wait(lock, [&queue]() { return !queue.pending.empty() || queue.isClosed; });
+
+                if(queue.pending.empty()) {
+                    return;
+                }
+
+                batch = queue.pending.front();
+                queue.pending.pop_front();
+            }
+
+            parseBatch(*batch, queue.isBuilding, queue.maxDepth);
+
+            {
+                std::lock_guard<std::mutex> lock(queue.mutex);
+                batch -> isDone = true;
+            }
+
+            queue.batchDone.notify_one();
+        }
+    }
+
+    /**
+     * @brief Delivers every finished batch that may be delivered, waiting while too many are in flight
+     * @param queue Shared queue
+     * @param handler Handler to deliver the records to
+     * @param isOrdered Whether batches are delivered in input order
+     * @param limit Number of in-flight batches the call waits at, 1 to wait for all of them
+     */
+    void deliver(WorkQueue& queue, JsonLinesHandler& handler, const bool isOrdered, const size_t limit) {
+        while(true) {
+            Batch* batch = nullptr;
+
+            {
+                std::unique_lock<std::mutex> lock(queue.mutex);
+
+                while(batch == nullptr) {
+                    for(std::deque<Batch*>::iterator it = queue.inFlight.begin(); it != queue.inFlight.end(); ++it) {
+                        if((*it) -> isDone) {
+                            batch = *it;
+                            queue.inFlight.erase(it);
+                            break;
+                        }
+
+                        if(isOrdered) {
+                            break;
+                        }
+                    }
+
+                    if(batch == nullptr) {
+                        if(queue.inFlight.size() < limit) {
+                            return;
+                        }
+
+                        queue.batchDone.wait(lock);
+                    }
+                }
+            }
+
+            std::unique_ptr<Batch> owner(batch);
+
+            for(const Record& record : batch -> records) {
+                if(record.isValid) {
+                    handler.visitRecord(record.line, record.value);
+                } else {
+                    handler.visitError(record.line, record.error);
+                }
+            }
+        }
+    }
+
+    /**
+     * @brief Stops the workers after an error, dropping the batches that were not started
+     * @param queue Shared queue
+     * @param workers Worker threads
+     */
+    void stop(WorkQueue& queue, std::vector<std::thread>& workers) {
+        {
+            std::lock_guard<std::mutex> lock(queue.mutex);
+            queue.isClosed = true;
+
+            for(Batch* batch : queue.pending) {
+                queue.inFlight.erase(std::find(queue.inFlight.begin(), queue.inFlight.end(), batch));
+                delete batch;
+            }
+
+            queue.pending.clear();
+        }
+
+        queue.workAvailable.notify_all();
+
+        for(std::thread& worker : workers) {
+            worker.join();
+        }
+
+        for(Batch* batch : queue.inFlight) {
+            delete batch;
+        }
+
+        queue.inFlight.clear();
+    }
+}
+
+/**
+ * @brief Constructs a reader
+ * @param _threadCount Number of worker threads, 0 to use one per hardware thread
+ * @param _isOrdered Whether records are delivered in input order rather than as soon as they are parsed
+ * @param _maxDepth Maximum number of arrays and objects enclosing each other in a record
+ */
+JsonLinesReader::JsonLinesReader(const size_t _threadCount, const bool _isOrdered, const size_t _maxDepth)
+    : threadCount(_threadCount), isOrdered(_isOrdered), maxDepth(_maxDepth) {
+    if(threadCount == 0) {
+        threadCount = std::thread::hardware_concurrency();
+    }
+
+    if(threadCount == 0) {
+        threadCount = 1;
+    }
+}
+
+/**
+ * @brief Parses every record of a contiguous buffer, such as a memory-mapped file
+ * @param data Pointer to the first character of the input
+ * @param length Number of characters in the input
+ * @param handler Handler to deliver the records to
+ */
+void JsonLinesReader::read(const char* data, const size_t length, JsonLinesHandler& handler) const {
+    run(data, length, nullptr, handler, true);
+}
+
+/**
+ * @brief Parses every record of a stream, holding only the batches in flight in memory
+ * @param stream Input stream with newline-delimited JSON
+ * @param handler Handler to deliver the records to
+ */
+void JsonLinesReader::read(std::istream& stream, JsonLinesHandler& handler) const {
+    run(nullptr, 0, &stream, handler, true);
+}
+
+/**
+ * @brief Validates every record of a contiguous buffer without building any values
+ * @param data Pointer to the first character of the input
+ * @param length Number of characters in the input
+ * @param handler Handler to deliver the results to
+ */
+void JsonLinesReader::validate(const char* data, const size_t length, JsonLinesHandler& handler) const {
+    run(data, length, nullptr, handler, false);
+}
+
+/**
+ * @brief Validates every record of a stream without building any values
+ * @param stream Input stream with newline-delimited JSON
+ * @param handler Handler to deliver the results to
+ */
+void JsonLinesReader::validate(std::istream& stream, JsonLinesHandler& handler) const {
+    run(nullptr, 0, &stream, handler, false);
+}
+
+/**
+ * @brief Gets the number of worker threads
+ * @return Number of worker threads
+ */
+size_t JsonLinesReader::getThreadCount() const {
+    return threadCount;
+}
+
+/**
+ * @brief Cuts the input into batches, feeds them to the workers and delivers the results
+ * @param data Pointer to the first character of the input, ignored when reading a stream
+ * @param length Number of characters in the input, ignored when reading a stream
+ * @param stream Stream to read the input from, nullptr to read the buffer
+ * @param handler Handler to deliver the records to
+ * @param isBuilding Whether JsonValue nodes are created for the records
+ * @throws Any exception thrown by the handler, after the workers have stopped
+ */
+void JsonLinesReader::run(const char* data, const size_t length, std::istream* stream, JsonLinesHandler& handler,
+                          const bool isBuilding) const {
+    WorkQueue queue;
+    queue.isClosed = false;
+    queue.isBuilding = isBuilding;
+    queue.maxDepth = maxDepth;
+
+    std::vector<std::thread> workers;
+    const char* position = data;
+    const char* end = data + length;
+    std::string carry;
+    size_t line = 1;
+
+    try {
+        for(size_t i = 0; i < threadCount; i++) {
+            workers.push_back(std::thread(work, std::ref(queue)));
+        }
+
+        while(true) {
+            std::unique_ptr<Batch> batch(new Batch());
+            batch -> isDone = false;
+
+            if(stream == nullptr) {
+                const char* begin = nullptr;
+
+                if(!cutBuffer(position, end, begin)) {
+                    break;
+                }
+
+                addRecords(*batch, begin, position, line);
+            } else {
+                if(!cutStream(*stream, batch -> storage, carry)) {
+                    break;
+                }
+
+                addRecords(*batch, batch -> storage.data(), batch -> storage.data() + batch -> storage.size(), line);
+            }
+
+            if(batch -> records.empty()) {
+                continue;
+            }
+
+            {
+                std::lock_guard<std::mutex> lock(queue.mutex);
+                queue.pending.push_back(batch.get());
+                queue.inFlight.push_back(batch.release());
+            }
+
+            queue.workAvailable.notify_one();
+
+            deliver(queue, handler, isOrdered, threadCount * BatchesPerThread);
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(queue.mutex);
+            queue.isClosed = true;
+        }
+
+        queue.workAvailable.notify_all();
+
+        deliver(queue, handler, isOrdered, 1);
+    }
+    catch(...) {
+        stop(queue, workers);
+        throw;
+    }
+
+    for(std::thread& worker : workers) {
+        worker.join();
+    }
+}
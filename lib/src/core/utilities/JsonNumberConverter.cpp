@@ -0,0 +1,1947 @@
+#include <cfloat>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include "JsonNumberConverter.hpp"
+#include "JsonGrammar.hpp"
+
+/**
+ * @brief Anonymous namespace for the decimal to binary conversion tables and helpers
+ */
+namespace {
+    /**
+     * @brief Smallest decimal exponent with a nonzero double, anything below rounds to zero
+     */
+    const int64_t SmallestPowerOfTen = -342;
+
+    /**
+     * @brief Largest decimal exponent with a finite double, anything above overflows to infinity
+     */
+    const int64_t LargestPowerOfTen = 308;
+
+    /**
+     * @brief Number of explicitly stored mantissa bits of a double
+     */
+    const int MantissaBits = 52;
+
+    /**
+     * @brief Biased exponent of infinity
+     */
+    const int64_t InfiniteExponent = 0x7FF;
+
+    /**
+     * @brief Most significant decimal digits that fit in a 64-bit significand
+     */
+    const int MaxSignificandDigits = 19;
+
+    /**
+     * @brief Most significant digits a decimal can have and still be the shortest decimal of its nearest double
+     */
+    const int MaxExactDigits = 15;
+
+    /**
+     * @brief Powers of ten that are exact doubles, used by the fast path
+     */
+    const double ExactPowersOfTen[] = {
+        1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+        1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+    };
+
+    /**
+     * @brief Normalized 128-bit truncated powers of five for Eisel-Lemire, high and low 64 bits per row
+     */
+    const uint64_t PowersOfFive[][2] = {
+        {0xeef453d6923bd65aULL, 0x113faa2906a13b3fULL},
+        {0x9558b4661b6565f8ULL, 0x4ac7ca59a424c507ULL},
+        {0xbaaee17fa23ebf76ULL, 0x5d79bcf00d2df649ULL},
+        {0xe95a99df8ace6f53ULL, 0xf4d82c2c107973dcULL},
+        {0x91d8a02bb6c10594ULL, 0x79071b9b8a4be869ULL},
+        {0xb64ec836a47146f9ULL, 0x9748e2826cdee284ULL},
+        {0xe3e27a444d8d98b7ULL, 0xfd1b1b2308169b25ULL},
+        {0x8e6d8c6ab0787f72ULL, 0xfe30f0f5e50e20f7ULL},
+        {0xb208ef855c969f4fULL, 0xbdbd2d335e51a935ULL},
+        {0xde8b2b66b3bc4723ULL, 0xad2c788035e61382ULL},
+        {0x8b16fb203055ac76ULL, 0x4c3bcb5021afcc31ULL},
+        {0xaddcb9e83c6b1793ULL, 0xdf4abe242a1bbf3dULL},
+        {0xd953e8624b85dd78ULL, 0xd71d6dad34a2af0dULL},
+        {0x87d4713d6f33aa6bULL, 0x8672648c40e5ad68ULL},
+        {0xa9c98d8ccb009506ULL, 0x680efdaf511f18c2ULL},
+        {0xd43bf0effdc0ba48ULL, 0x0212bd1b2566def2ULL},
+        {0x84a57695fe98746dULL, 0x014bb630f7604b57ULL},
+        {0xa5ced43b7e3e9188ULL, 0x419ea3bd35385e2dULL},
+        {0xcf42894a5dce35eaULL, 0x52064cac828675b9ULL},
+        {0x818995ce7aa0e1b2ULL, 0x7343efebd1940993ULL},
+        {0xa1ebfb4219491a1fULL, 0x1014ebe6c5f90bf8ULL},
+        {0xca66fa129f9b60a6ULL, 0xd41a26e077774ef6ULL},
+        {0xfd00b897478238d0ULL, 0x8920b098955522b4ULL},
+        {0x9e20735e8cb16382ULL, 0x55b46e5f5d5535b0ULL},
+        {0xc5a890362fddbc62ULL, 0xeb2189f734aa831dULL},
+        {0xf712b443bbd52b7bULL, 0xa5e9ec7501d523e4ULL},
+        {0x9a6bb0aa55653b2dULL, 0x47b233c92125366eULL},
+        {0xc1069cd4eabe89f8ULL, 0x999ec0bb696e840aULL},
+        {0xf148440a256e2c76ULL, 0xc00670ea43ca250dULL},
+        {0x96cd2a865764dbcaULL, 0x380406926a5e5728ULL},
+        {0xbc807527ed3e12bcULL, 0xc605083704f5ecf2ULL},
+        {0xeba09271e88d976bULL, 0xf7864a44c633682eULL},
+        {0x93445b8731587ea3ULL, 0x7ab3ee6afbe0211dULL},
+        {0xb8157268fdae9e4cULL, 0x5960ea05bad82964ULL},
+        {0xe61acf033d1a45dfULL, 0x6fb92487298e33bdULL},
+        {0x8fd0c16206306babULL, 0xa5d3b6d479f8e056ULL},
+        {0xb3c4f1ba87bc8696ULL, 0x8f48a4899877186cULL},
+        {0xe0b62e2929aba83cULL, 0x331acdabfe94de87ULL},
+        {0x8c71dcd9ba0b4925ULL, 0x9ff0c08b7f1d0b14ULL},
+        {0xaf8e5410288e1b6fULL, 0x07ecf0ae5ee44dd9ULL},
+        {0xdb71e91432b1a24aULL, 0xc9e82cd9f69d6150ULL},
+        {0x892731ac9faf056eULL, 0xbe311c083a225cd2ULL},
+        {0xab70fe17c79ac6caULL, 0x6dbd630a48aaf406ULL},
+        {0xd64d3d9db981787dULL, 0x092cbbccdad5b108ULL},
+        {0x85f0468293f0eb4eULL, 0x25bbf56008c58ea5ULL},
+        {0xa76c582338ed2621ULL, 0xaf2af2b80af6f24eULL},
+        {0xd1476e2c07286faaULL, 0x1af5af660db4aee1ULL},
+        {0x82cca4db847945caULL, 0x50d98d9fc890ed4dULL},
+        {0xa37fce126597973cULL, 0xe50ff107bab528a0ULL},
+        {0xcc5fc196fefd7d0cULL, 0x1e53ed49a96272c8ULL},
+        {0xff77b1fcbebcdc4fULL, 0x25e8e89c13bb0f7aULL},
+        {0x9faacf3df73609b1ULL, 0x77b191618c54e9acULL},
+        {0xc795830d75038c1dULL, 0xd59df5b9ef6a2417ULL},
+        {0xf97ae3d0d2446f25ULL, 0x4b0573286b44ad1dULL},
+        {0x9becce62836ac577ULL, 0x4ee367f9430aec32ULL},
+        {0xc2e801fb244576d5ULL, 0x229c41f793cda73fULL},
+        {0xf3a20279ed56d48aULL, 0x6b43527578c1110fULL},
+        {0x9845418c345644d6ULL, 0x830a13896b78aaa9ULL},
+        {0xbe5691ef416bd60cULL, 0x23cc986bc656d553ULL},
+        {0xedec366b11c6cb8fULL, 0x2cbfbe86b7ec8aa8ULL},
+        {0x94b3a202eb1c3f39ULL, 0x7bf7d71432f3d6a9ULL},
+        {0xb9e08a83a5e34f07ULL, 0xdaf5ccd93fb0cc53ULL},
+        {0xe858ad248f5c22c9ULL, 0xd1b3400f8f9cff68ULL},
+        {0x91376c36d99995beULL, 0x23100809b9c21fa1ULL},
+        {0xb58547448ffffb2dULL, 0xabd40a0c2832a78aULL},
+        {0xe2e69915b3fff9f9ULL, 0x16c90c8f323f516cULL},
+        {0x8dd01fad907ffc3bULL, 0xae3da7d97f6792e3ULL},
+        {0xb1442798f49ffb4aULL, 0x99cd11cfdf41779cULL},
+        {0xdd95317f31c7fa1dULL, 0x40405643d711d583ULL},
+        {0x8a7d3eef7f1cfc52ULL, 0x482835ea666b2572ULL},
+        {0xad1c8eab5ee43b66ULL, 0xda3243650005eecfULL},
+        {0xd863b256369d4a40ULL, 0x90bed43e40076a82ULL},
+        {0x873e4f75e2224e68ULL, 0x5a7744a6e804a291ULL},
+        {0xa90de3535aaae202ULL, 0x711515d0a205cb36ULL},
+        {0xd3515c2831559a83ULL, 0x0d5a5b44ca873e03ULL},
+        {0x8412d9991ed58091ULL, 0xe858790afe9486c2ULL},
+        {0xa5178fff668ae0b6ULL, 0x626e974dbe39a872ULL},
+        {0xce5d73ff402d98e3ULL, 0xfb0a3d212dc8128fULL},
+        {0x80fa687f881c7f8eULL, 0x7ce66634bc9d0b99ULL},
+        {0xa139029f6a239f72ULL, 0x1c1fffc1ebc44e80ULL},
+        {0xc987434744ac874eULL, 0xa327ffb266b56220ULL},
+        {0xfbe9141915d7a922ULL, 0x4bf1ff9f0062baa8ULL},
+        {0x9d71ac8fada6c9b5ULL, 0x6f773fc3603db4a9ULL},
+        {0xc4ce17b399107c22ULL, 0xcb550fb4384d21d3ULL},
+        {0xf6019da07f549b2bULL, 0x7e2a53a146606a48ULL},
+        {0x99c102844f94e0fbULL, 0x2eda7444cbfc426dULL},
+        {0xc0314325637a1939ULL, 0xfa911155fefb5308ULL},
+        {0xf03d93eebc589f88ULL, 0x793555ab7eba27caULL},
+        {0x96267c7535b763b5ULL, 0x4bc1558b2f3458deULL},
+        {0xbbb01b9283253ca2ULL, 0x9eb1aaedfb016f16ULL},
+        {0xea9c227723ee8bcbULL, 0x465e15a979c1cadcULL},
+        {0x92a1958a7675175fULL, 0x0bfacd89ec191ec9ULL},
+        {0xb749faed14125d36ULL, 0xcef980ec671f667bULL},
+        {0xe51c79a85916f484ULL, 0x82b7e12780e7401aULL},
+        {0x8f31cc0937ae58d2ULL, 0xd1b2ecb8b0908810ULL},
+        {0xb2fe3f0b8599ef07ULL, 0x861fa7e6dcb4aa15ULL},
+        {0xdfbdcece67006ac9ULL, 0x67a791e093e1d49aULL},
+        {0x8bd6a141006042bdULL, 0xe0c8bb2c5c6d24e0ULL},
+        {0xaecc49914078536dULL, 0x58fae9f773886e18ULL},
+        {0xda7f5bf590966848ULL, 0xaf39a475506a899eULL},
+        {0x888f99797a5e012dULL, 0x6d8406c952429603ULL},
+        {0xaab37fd7d8f58178ULL, 0xc8e5087ba6d33b83ULL},
+        {0xd5605fcdcf32e1d6ULL, 0xfb1e4a9a90880a64ULL},
+        {0x855c3be0a17fcd26ULL, 0x5cf2eea09a55067fULL},
+        {0xa6b34ad8c9dfc06fULL, 0xf42faa48c0ea481eULL},
+        {0xd0601d8efc57b08bULL, 0xf13b94daf124da26ULL},
+        {0x823c12795db6ce57ULL, 0x76c53d08d6b70858ULL},
+        {0xa2cb1717b52481edULL, 0x54768c4b0c64ca6eULL},
+        {0xcb7ddcdda26da268ULL, 0xa9942f5dcf7dfd09ULL},
+        {0xfe5d54150b090b02ULL, 0xd3f93b35435d7c4cULL},
+        {0x9efa548d26e5a6e1ULL, 0xc47bc5014a1a6dafULL},
+        {0xc6b8e9b0709f109aULL, 0x359ab6419ca1091bULL},
+        {0xf867241c8cc6d4c0ULL, 0xc30163d203c94b62ULL},
+        {0x9b407691d7fc44f8ULL, 0x79e0de63425dcf1dULL},
+        {0xc21094364dfb5636ULL, 0x985915fc12f542e4ULL},
+        {0xf294b943e17a2bc4ULL, 0x3e6f5b7b17b2939dULL},
+        {0x979cf3ca6cec5b5aULL, 0xa705992ceecf9c42ULL},
+        {0xbd8430bd08277231ULL, 0x50c6ff782a838353ULL},
+        {0xece53cec4a314ebdULL, 0xa4f8bf5635246428ULL},
+        {0x940f4613ae5ed136ULL, 0x871b7795e136be99ULL},
+        {0xb913179899f68584ULL, 0x28e2557b59846e3fULL},
+        {0xe757dd7ec07426e5ULL, 0x331aeada2fe589cfULL},
+        {0x9096ea6f3848984fULL, 0x3ff0d2c85def7621ULL},
+        {0xb4bca50b065abe63ULL, 0x0fed077a756b53a9ULL},
+        {0xe1ebce4dc7f16dfbULL, 0xd3e8495912c62894ULL},
+        {0x8d3360f09cf6e4bdULL, 0x64712dd7abbbd95cULL},
+        {0xb080392cc4349decULL, 0xbd8d794d96aacfb3ULL},
+        {0xdca04777f541c567ULL, 0xecf0d7a0fc5583a0ULL},
+        {0x89e42caaf9491b60ULL, 0xf41686c49db57244ULL},
+        {0xac5d37d5b79b6239ULL, 0x311c2875c522ced5ULL},
+        {0xd77485cb25823ac7ULL, 0x7d633293366b828bULL},
+        {0x86a8d39ef77164bcULL, 0xae5dff9c02033197ULL},
+        {0xa8530886b54dbdebULL, 0xd9f57f830283fdfcULL},
+        {0xd267caa862a12d66ULL, 0xd072df63c324fd7bULL},
+        {0x8380dea93da4bc60ULL, 0x4247cb9e59f71e6dULL},
+        {0xa46116538d0deb78ULL, 0x52d9be85f074e608ULL},
+        {0xcd795be870516656ULL, 0x67902e276c921f8bULL},
+        {0x806bd9714632dff6ULL, 0x00ba1cd8a3db53b6ULL},
+        {0xa086cfcd97bf97f3ULL, 0x80e8a40eccd228a4ULL},
+        {0xc8a883c0fdaf7df0ULL, 0x6122cd128006b2cdULL},
+        {0xfad2a4b13d1b5d6cULL, 0x796b805720085f81ULL},
+        {0x9cc3a6eec6311a63ULL, 0xcbe3303674053bb0ULL},
+        {0xc3f490aa77bd60fcULL, 0xbedbfc4411068a9cULL},
+        {0xf4f1b4d515acb93bULL, 0xee92fb5515482d44ULL},
+        {0x991711052d8bf3c5ULL, 0x751bdd152d4d1c4aULL},
+        {0xbf5cd54678eef0b6ULL, 0xd262d45a78a0635dULL},
+        {0xef340a98172aace4ULL, 0x86fb897116c87c34ULL},
+        {0x9580869f0e7aac0eULL, 0xd45d35e6ae3d4da0ULL},
+        {0xbae0a846d2195712ULL, 0x8974836059cca109ULL},
+        {0xe998d258869facd7ULL, 0x2bd1a438703fc94bULL},
+        {0x91ff83775423cc06ULL, 0x7b6306a34627ddcfULL},
+        {0xb67f6455292cbf08ULL, 0x1a3bc84c17b1d542ULL},
+        {0xe41f3d6a7377eecaULL, 0x20caba5f1d9e4a93ULL},
+        {0x8e938662882af53eULL, 0x547eb47b7282ee9cULL},
+        {0xb23867fb2a35b28dULL, 0xe99e619a4f23aa43ULL},
+        {0xdec681f9f4c31f31ULL, 0x6405fa00e2ec94d4ULL},
+        {0x8b3c113c38f9f37eULL, 0xde83bc408dd3dd04ULL},
+        {0xae0b158b4738705eULL, 0x9624ab50b148d445ULL},
+        {0xd98ddaee19068c76ULL, 0x3badd624dd9b0957ULL},
+        {0x87f8a8d4cfa417c9ULL, 0xe54ca5d70a80e5d6ULL},
+        {0xa9f6d30a038d1dbcULL, 0x5e9fcf4ccd211f4cULL},
+        {0xd47487cc8470652bULL, 0x7647c3200069671fULL},
+        {0x84c8d4dfd2c63f3bULL, 0x29ecd9f40041e073ULL},
+        {0xa5fb0a17c777cf09ULL, 0xf468107100525890ULL},
+        {0xcf79cc9db955c2ccULL, 0x7182148d4066eeb4ULL},
+        {0x81ac1fe293d599bfULL, 0xc6f14cd848405530ULL},
+        {0xa21727db38cb002fULL, 0xb8ada00e5a506a7cULL},
+        {0xca9cf1d206fdc03bULL, 0xa6d90811f0e4851cULL},
+        {0xfd442e4688bd304aULL, 0x908f4a166d1da663ULL},
+        {0x9e4a9cec15763e2eULL, 0x9a598e4e043287feULL},
+        {0xc5dd44271ad3cdbaULL, 0x40eff1e1853f29fdULL},
+        {0xf7549530e188c128ULL, 0xd12bee59e68ef47cULL},
+        {0x9a94dd3e8cf578b9ULL, 0x82bb74f8301958ceULL},
+        {0xc13a148e3032d6e7ULL, 0xe36a52363c1faf01ULL},
+        {0xf18899b1bc3f8ca1ULL, 0xdc44e6c3cb279ac1ULL},
+        {0x96f5600f15a7b7e5ULL, 0x29ab103a5ef8c0b9ULL},
+        {0xbcb2b812db11a5deULL, 0x7415d448f6b6f0e7ULL},
+        {0xebdf661791d60f56ULL, 0x111b495b3464ad21ULL},
+        {0x936b9fcebb25c995ULL, 0xcab10dd900beec34ULL},
+        {0xb84687c269ef3bfbULL, 0x3d5d514f40eea742ULL},
+        {0xe65829b3046b0afaULL, 0x0cb4a5a3112a5112ULL},
+        {0x8ff71a0fe2c2e6dcULL, 0x47f0e785eaba72abULL},
+        {0xb3f4e093db73a093ULL, 0x59ed216765690f56ULL},
+        {0xe0f218b8d25088b8ULL, 0x306869c13ec3532cULL},
+        {0x8c974f7383725573ULL, 0x1e414218c73a13fbULL},
+        {0xafbd2350644eeacfULL, 0xe5d1929ef90898faULL},
+        {0xdbac6c247d62a583ULL, 0xdf45f746b74abf39ULL},
+        {0x894bc396ce5da772ULL, 0x6b8bba8c328eb783ULL},
+        {0xab9eb47c81f5114fULL, 0x066ea92f3f326564ULL},
+        {0xd686619ba27255a2ULL, 0xc80a537b0efefebdULL},
+        {0x8613fd0145877585ULL, 0xbd06742ce95f5f36ULL},
+        {0xa798fc4196e952e7ULL, 0x2c48113823b73704ULL},
+        {0xd17f3b51fca3a7a0ULL, 0xf75a15862ca504c5ULL},
+        {0x82ef85133de648c4ULL, 0x9a984d73dbe722fbULL},
+        {0xa3ab66580d5fdaf5ULL, 0xc13e60d0d2e0ebbaULL},
+        {0xcc963fee10b7d1b3ULL, 0x318df905079926a8ULL},
+        {0xffbbcfe994e5c61fULL, 0xfdf17746497f7052ULL},
+        {0x9fd561f1fd0f9bd3ULL, 0xfeb6ea8bedefa633ULL},
+        {0xc7caba6e7c5382c8ULL, 0xfe64a52ee96b8fc0ULL},
+        {0xf9bd690a1b68637bULL, 0x3dfdce7aa3c673b0ULL},
+        {0x9c1661a651213e2dULL, 0x06bea10ca65c084eULL},
+        {0xc31bfa0fe5698db8ULL, 0x486e494fcff30a62ULL},
+        {0xf3e2f893dec3f126ULL, 0x5a89dba3c3efccfaULL},
+        {0x986ddb5c6b3a76b7ULL, 0xf89629465a75e01cULL},
+        {0xbe89523386091465ULL, 0xf6bbb397f1135823ULL},
+        {0xee2ba6c0678b597fULL, 0x746aa07ded582e2cULL},
+        {0x94db483840b717efULL, 0xa8c2a44eb4571cdcULL},
+        {0xba121a4650e4ddebULL, 0x92f34d62616ce413ULL},
+        {0xe896a0d7e51e1566ULL, 0x77b020baf9c81d17ULL},
+        {0x915e2486ef32cd60ULL, 0x0ace1474dc1d122eULL},
+        {0xb5b5ada8aaff80b8ULL, 0x0d819992132456baULL},
+        {0xe3231912d5bf60e6ULL, 0x10e1fff697ed6c69ULL},
+        {0x8df5efabc5979c8fULL, 0xca8d3ffa1ef463c1ULL},
+        {0xb1736b96b6fd83b3ULL, 0xbd308ff8a6b17cb2ULL},
+        {0xddd0467c64bce4a0ULL, 0xac7cb3f6d05ddbdeULL},
+        {0x8aa22c0dbef60ee4ULL, 0x6bcdf07a423aa96bULL},
+        {0xad4ab7112eb3929dULL, 0x86c16c98d2c953c6ULL},
+        {0xd89d64d57a607744ULL, 0xe871c7bf077ba8b7ULL},
+        {0x87625f056c7c4a8bULL, 0x11471cd764ad4972ULL},
+        {0xa93af6c6c79b5d2dULL, 0xd598e40d3dd89bcfULL},
+        {0xd389b47879823479ULL, 0x4aff1d108d4ec2c3ULL},
+        {0x843610cb4bf160cbULL, 0xcedf722a585139baULL},
+        {0xa54394fe1eedb8feULL, 0xc2974eb4ee658828ULL},
+        {0xce947a3da6a9273eULL, 0x733d226229feea32ULL},
+        {0x811ccc668829b887ULL, 0x0806357d5a3f525fULL},
+        {0xa163ff802a3426a8ULL, 0xca07c2dcb0cf26f7ULL},
+        {0xc9bcff6034c13052ULL, 0xfc89b393dd02f0b5ULL},
+        {0xfc2c3f3841f17c67ULL, 0xbbac2078d443ace2ULL},
+        {0x9d9ba7832936edc0ULL, 0xd54b944b84aa4c0dULL},
+        {0xc5029163f384a931ULL, 0x0a9e795e65d4df11ULL},
+        {0xf64335bcf065d37dULL, 0x4d4617b5ff4a16d5ULL},
+        {0x99ea0196163fa42eULL, 0x504bced1bf8e4e45ULL},
+        {0xc06481fb9bcf8d39ULL, 0xe45ec2862f71e1d6ULL},
+        {0xf07da27a82c37088ULL, 0x5d767327bb4e5a4cULL},
+        {0x964e858c91ba2655ULL, 0x3a6a07f8d510f86fULL},
+        {0xbbe226efb628afeaULL, 0x890489f70a55368bULL},
+        {0xeadab0aba3b2dbe5ULL, 0x2b45ac74ccea842eULL},
+        {0x92c8ae6b464fc96fULL, 0x3b0b8bc90012929dULL},
+        {0xb77ada0617e3bbcbULL, 0x09ce6ebb40173744ULL},
+        {0xe55990879ddcaabdULL, 0xcc420a6a101d0515ULL},
+        {0x8f57fa54c2a9eab6ULL, 0x9fa946824a12232dULL},
+        {0xb32df8e9f3546564ULL, 0x47939822dc96abf9ULL},
+        {0xdff9772470297ebdULL, 0x59787e2b93bc56f7ULL},
+        {0x8bfbea76c619ef36ULL, 0x57eb4edb3c55b65aULL},
+        {0xaefae51477a06b03ULL, 0xede622920b6b23f1ULL},
+        {0xdab99e59958885c4ULL, 0xe95fab368e45ecedULL},
+        {0x88b402f7fd75539bULL, 0x11dbcb0218ebb414ULL},
+        {0xaae103b5fcd2a881ULL, 0xd652bdc29f26a119ULL},
+        {0xd59944a37c0752a2ULL, 0x4be76d3346f0495fULL},
+        {0x857fcae62d8493a5ULL, 0x6f70a4400c562ddbULL},
+        {0xa6dfbd9fb8e5b88eULL, 0xcb4ccd500f6bb952ULL},
+        {0xd097ad07a71f26b2ULL, 0x7e2000a41346a7a7ULL},
+        {0x825ecc24c873782fULL, 0x8ed400668c0c28c8ULL},
+        {0xa2f67f2dfa90563bULL, 0x728900802f0f32faULL},
+        {0xcbb41ef979346bcaULL, 0x4f2b40a03ad2ffb9ULL},
+        {0xfea126b7d78186bcULL, 0xe2f610c84987bfa8ULL},
+        {0x9f24b832e6b0f436ULL, 0x0dd9ca7d2df4d7c9ULL},
+        {0xc6ede63fa05d3143ULL, 0x91503d1c79720dbbULL},
+        {0xf8a95fcf88747d94ULL, 0x75a44c6397ce912aULL},
+        {0x9b69dbe1b548ce7cULL, 0xc986afbe3ee11abaULL},
+        {0xc24452da229b021bULL, 0xfbe85badce996168ULL},
+        {0xf2d56790ab41c2a2ULL, 0xfae27299423fb9c3ULL},
+        {0x97c560ba6b0919a5ULL, 0xdccd879fc967d41aULL},
+        {0xbdb6b8e905cb600fULL, 0x5400e987bbc1c920ULL},
+        {0xed246723473e3813ULL, 0x290123e9aab23b68ULL},
+        {0x9436c0760c86e30bULL, 0xf9a0b6720aaf6521ULL},
+        {0xb94470938fa89bceULL, 0xf808e40e8d5b3e69ULL},
+        {0xe7958cb87392c2c2ULL, 0xb60b1d1230b20e04ULL},
+        {0x90bd77f3483bb9b9ULL, 0xb1c6f22b5e6f48c2ULL},
+        {0xb4ecd5f01a4aa828ULL, 0x1e38aeb6360b1af3ULL},
+        {0xe2280b6c20dd5232ULL, 0x25c6da63c38de1b0ULL},
+        {0x8d590723948a535fULL, 0x579c487e5a38ad0eULL},
+        {0xb0af48ec79ace837ULL, 0x2d835a9df0c6d851ULL},
+        {0xdcdb1b2798182244ULL, 0xf8e431456cf88e65ULL},
+        {0x8a08f0f8bf0f156bULL, 0x1b8e9ecb641b58ffULL},
+        {0xac8b2d36eed2dac5ULL, 0xe272467e3d222f3fULL},
+        {0xd7adf884aa879177ULL, 0x5b0ed81dcc6abb0fULL},
+        {0x86ccbb52ea94baeaULL, 0x98e947129fc2b4e9ULL},
+        {0xa87fea27a539e9a5ULL, 0x3f2398d747b36224ULL},
+        {0xd29fe4b18e88640eULL, 0x8eec7f0d19a03aadULL},
+        {0x83a3eeeef9153e89ULL, 0x1953cf68300424acULL},
+        {0xa48ceaaab75a8e2bULL, 0x5fa8c3423c052dd7ULL},
+        {0xcdb02555653131b6ULL, 0x3792f412cb06794dULL},
+        {0x808e17555f3ebf11ULL, 0xe2bbd88bbee40bd0ULL},
+        {0xa0b19d2ab70e6ed6ULL, 0x5b6aceaeae9d0ec4ULL},
+        {0xc8de047564d20a8bULL, 0xf245825a5a445275ULL},
+        {0xfb158592be068d2eULL, 0xeed6e2f0f0d56712ULL},
+        {0x9ced737bb6c4183dULL, 0x55464dd69685606bULL},
+        {0xc428d05aa4751e4cULL, 0xaa97e14c3c26b886ULL},
+        {0xf53304714d9265dfULL, 0xd53dd99f4b3066a8ULL},
+        {0x993fe2c6d07b7fabULL, 0xe546a8038efe4029ULL},
+        {0xbf8fdb78849a5f96ULL, 0xde98520472bdd033ULL},
+        {0xef73d256a5c0f77cULL, 0x963e66858f6d4440ULL},
+        {0x95a8637627989aadULL, 0xdde7001379a44aa8ULL},
+        {0xbb127c53b17ec159ULL, 0x5560c018580d5d52ULL},
+        {0xe9d71b689dde71afULL, 0xaab8f01e6e10b4a6ULL},
+        {0x9226712162ab070dULL, 0xcab3961304ca70e8ULL},
+        {0xb6b00d69bb55c8d1ULL, 0x3d607b97c5fd0d22ULL},
+        {0xe45c10c42a2b3b05ULL, 0x8cb89a7db77c506aULL},
+        {0x8eb98a7a9a5b04e3ULL, 0x77f3608e92adb242ULL},
+        {0xb267ed1940f1c61cULL, 0x55f038b237591ed3ULL},
+        {0xdf01e85f912e37a3ULL, 0x6b6c46dec52f6688ULL},
+        {0x8b61313bbabce2c6ULL, 0x2323ac4b3b3da015ULL},
+        {0xae397d8aa96c1b77ULL, 0xabec975e0a0d081aULL},
+        {0xd9c7dced53c72255ULL, 0x96e7bd358c904a21ULL},
+        {0x881cea14545c7575ULL, 0x7e50d64177da2e54ULL},
+        {0xaa242499697392d2ULL, 0xdde50bd1d5d0b9e9ULL},
+        {0xd4ad2dbfc3d07787ULL, 0x955e4ec64b44e864ULL},
+        {0x84ec3c97da624ab4ULL, 0xbd5af13bef0b113eULL},
+        {0xa6274bbdd0fadd61ULL, 0xecb1ad8aeacdd58eULL},
+        {0xcfb11ead453994baULL, 0x67de18eda5814af2ULL},
+        {0x81ceb32c4b43fcf4ULL, 0x80eacf948770ced7ULL},
+        {0xa2425ff75e14fc31ULL, 0xa1258379a94d028dULL},
+        {0xcad2f7f5359a3b3eULL, 0x096ee45813a04330ULL},
+        {0xfd87b5f28300ca0dULL, 0x8bca9d6e188853fcULL},
+        {0x9e74d1b791e07e48ULL, 0x775ea264cf55347eULL},
+        {0xc612062576589ddaULL, 0x95364afe032a819eULL},
+        {0xf79687aed3eec551ULL, 0x3a83ddbd83f52205ULL},
+        {0x9abe14cd44753b52ULL, 0xc4926a9672793543ULL},
+        {0xc16d9a0095928a27ULL, 0x75b7053c0f178294ULL},
+        {0xf1c90080baf72cb1ULL, 0x5324c68b12dd6339ULL},
+        {0x971da05074da7beeULL, 0xd3f6fc16ebca5e04ULL},
+        {0xbce5086492111aeaULL, 0x88f4bb1ca6bcf585ULL},
+        {0xec1e4a7db69561a5ULL, 0x2b31e9e3d06c32e6ULL},
+        {0x9392ee8e921d5d07ULL, 0x3aff322e62439fd0ULL},
+        {0xb877aa3236a4b449ULL, 0x09befeb9fad487c3ULL},
+        {0xe69594bec44de15bULL, 0x4c2ebe687989a9b4ULL},
+        {0x901d7cf73ab0acd9ULL, 0x0f9d37014bf60a11ULL},
+        {0xb424dc35095cd80fULL, 0x538484c19ef38c95ULL},
+        {0xe12e13424bb40e13ULL, 0x2865a5f206b06fbaULL},
+        {0x8cbccc096f5088cbULL, 0xf93f87b7442e45d4ULL},
+        {0xafebff0bcb24aafeULL, 0xf78f69a51539d749ULL},
+        {0xdbe6fecebdedd5beULL, 0xb573440e5a884d1cULL},
+        {0x89705f4136b4a597ULL, 0x31680a88f8953031ULL},
+        {0xabcc77118461cefcULL, 0xfdc20d2b36ba7c3eULL},
+        {0xd6bf94d5e57a42bcULL, 0x3d32907604691b4dULL},
+        {0x8637bd05af6c69b5ULL, 0xa63f9a49c2c1b110ULL},
+        {0xa7c5ac471b478423ULL, 0x0fcf80dc33721d54ULL},
+        {0xd1b71758e219652bULL, 0xd3c36113404ea4a9ULL},
+        {0x83126e978d4fdf3bULL, 0x645a1cac083126eaULL},
+        {0xa3d70a3d70a3d70aULL, 0x3d70a3d70a3d70a4ULL},
+        {0xccccccccccccccccULL, 0xcccccccccccccccdULL},
+        {0x8000000000000000ULL, 0x0000000000000000ULL},
+        {0xa000000000000000ULL, 0x0000000000000000ULL},
+        {0xc800000000000000ULL, 0x0000000000000000ULL},
+        {0xfa00000000000000ULL, 0x0000000000000000ULL},
+        {0x9c40000000000000ULL, 0x0000000000000000ULL},
+        {0xc350000000000000ULL, 0x0000000000000000ULL},
+        {0xf424000000000000ULL, 0x0000000000000000ULL},
+        {0x9896800000000000ULL, 0x0000000000000000ULL},
+        {0xbebc200000000000ULL, 0x0000000000000000ULL},
+        {0xee6b280000000000ULL, 0x0000000000000000ULL},
+        {0x9502f90000000000ULL, 0x0000000000000000ULL},
+        {0xba43b74000000000ULL, 0x0000000000000000ULL},
+        {0xe8d4a51000000000ULL, 0x0000000000000000ULL},
+        {0x9184e72a00000000ULL, 0x0000000000000000ULL},
+        {0xb5e620f480000000ULL, 0x0000000000000000ULL},
+        {0xe35fa931a0000000ULL, 0x0000000000000000ULL},
+        {0x8e1bc9bf04000000ULL, 0x0000000000000000ULL},
+        {0xb1a2bc2ec5000000ULL, 0x0000000000000000ULL},
+        {0xde0b6b3a76400000ULL, 0x0000000000000000ULL},
+        {0x8ac7230489e80000ULL, 0x0000000000000000ULL},
+        {0xad78ebc5ac620000ULL, 0x0000000000000000ULL},
+        {0xd8d726b7177a8000ULL, 0x0000000000000000ULL},
+        {0x878678326eac9000ULL, 0x0000000000000000ULL},
+        {0xa968163f0a57b400ULL, 0x0000000000000000ULL},
+        {0xd3c21bcecceda100ULL, 0x0000000000000000ULL},
+        {0x84595161401484a0ULL, 0x0000000000000000ULL},
+        {0xa56fa5b99019a5c8ULL, 0x0000000000000000ULL},
+        {0xcecb8f27f4200f3aULL, 0x0000000000000000ULL},
+        {0x813f3978f8940984ULL, 0x4000000000000000ULL},
+        {0xa18f07d736b90be5ULL, 0x5000000000000000ULL},
+        {0xc9f2c9cd04674edeULL, 0xa400000000000000ULL},
+        {0xfc6f7c4045812296ULL, 0x4d00000000000000ULL},
+        {0x9dc5ada82b70b59dULL, 0xf020000000000000ULL},
+        {0xc5371912364ce305ULL, 0x6c28000000000000ULL},
+        {0xf684df56c3e01bc6ULL, 0xc732000000000000ULL},
+        {0x9a130b963a6c115cULL, 0x3c7f400000000000ULL},
+        {0xc097ce7bc90715b3ULL, 0x4b9f100000000000ULL},
+        {0xf0bdc21abb48db20ULL, 0x1e86d40000000000ULL},
+        {0x96769950b50d88f4ULL, 0x1314448000000000ULL},
+        {0xbc143fa4e250eb31ULL, 0x17d955a000000000ULL},
+        {0xeb194f8e1ae525fdULL, 0x5dcfab0800000000ULL},
+        {0x92efd1b8d0cf37beULL, 0x5aa1cae500000000ULL},
+        {0xb7abc627050305adULL, 0xf14a3d9e40000000ULL},
+        {0xe596b7b0c643c719ULL, 0x6d9ccd05d0000000ULL},
+        {0x8f7e32ce7bea5c6fULL, 0xe4820023a2000000ULL},
+        {0xb35dbf821ae4f38bULL, 0xdda2802c8a800000ULL},
+        {0xe0352f62a19e306eULL, 0xd50b2037ad200000ULL},
+        {0x8c213d9da502de45ULL, 0x4526f422cc340000ULL},
+        {0xaf298d050e4395d6ULL, 0x9670b12b7f410000ULL},
+        {0xdaf3f04651d47b4cULL, 0x3c0cdd765f114000ULL},
+        {0x88d8762bf324cd0fULL, 0xa5880a69fb6ac800ULL},
+        {0xab0e93b6efee0053ULL, 0x8eea0d047a457a00ULL},
+        {0xd5d238a4abe98068ULL, 0x72a4904598d6d880ULL},
+        {0x85a36366eb71f041ULL, 0x47a6da2b7f864750ULL},
+        {0xa70c3c40a64e6c51ULL, 0x999090b65f67d924ULL},
+        {0xd0cf4b50cfe20765ULL, 0xfff4b4e3f741cf6dULL},
+        {0x82818f1281ed449fULL, 0xbff8f10e7a8921a4ULL},
+        {0xa321f2d7226895c7ULL, 0xaff72d52192b6a0dULL},
+        {0xcbea6f8ceb02bb39ULL, 0x9bf4f8a69f764490ULL},
+        {0xfee50b7025c36a08ULL, 0x02f236d04753d5b4ULL},
+        {0x9f4f2726179a2245ULL, 0x01d762422c946590ULL},
+        {0xc722f0ef9d80aad6ULL, 0x424d3ad2b7b97ef5ULL},
+        {0xf8ebad2b84e0d58bULL, 0xd2e0898765a7deb2ULL},
+        {0x9b934c3b330c8577ULL, 0x63cc55f49f88eb2fULL},
+        {0xc2781f49ffcfa6d5ULL, 0x3cbf6b71c76b25fbULL},
+        {0xf316271c7fc3908aULL, 0x8bef464e3945ef7aULL},
+        {0x97edd871cfda3a56ULL, 0x97758bf0e3cbb5acULL},
+        {0xbde94e8e43d0c8ecULL, 0x3d52eeed1cbea317ULL},
+        {0xed63a231d4c4fb27ULL, 0x4ca7aaa863ee4bddULL},
+        {0x945e455f24fb1cf8ULL, 0x8fe8caa93e74ef6aULL},
+        {0xb975d6b6ee39e436ULL, 0xb3e2fd538e122b44ULL},
+        {0xe7d34c64a9c85d44ULL, 0x60dbbca87196b616ULL},
+        {0x90e40fbeea1d3a4aULL, 0xbc8955e946fe31cdULL},
+        {0xb51d13aea4a488ddULL, 0x6babab6398bdbe41ULL},
+        {0xe264589a4dcdab14ULL, 0xc696963c7eed2dd1ULL},
+        {0x8d7eb76070a08aecULL, 0xfc1e1de5cf543ca2ULL},
+        {0xb0de65388cc8ada8ULL, 0x3b25a55f43294bcbULL},
+        {0xdd15fe86affad912ULL, 0x49ef0eb713f39ebeULL},
+        {0x8a2dbf142dfcc7abULL, 0x6e3569326c784337ULL},
+        {0xacb92ed9397bf996ULL, 0x49c2c37f07965404ULL},
+        {0xd7e77a8f87daf7fbULL, 0xdc33745ec97be906ULL},
+        {0x86f0ac99b4e8dafdULL, 0x69a028bb3ded71a3ULL},
+        {0xa8acd7c0222311bcULL, 0xc40832ea0d68ce0cULL},
+        {0xd2d80db02aabd62bULL, 0xf50a3fa490c30190ULL},
+        {0x83c7088e1aab65dbULL, 0x792667c6da79e0faULL},
+        {0xa4b8cab1a1563f52ULL, 0x577001b891185938ULL},
+        {0xcde6fd5e09abcf26ULL, 0xed4c0226b55e6f86ULL},
+        {0x80b05e5ac60b6178ULL, 0x544f8158315b05b4ULL},
+        {0xa0dc75f1778e39d6ULL, 0x696361ae3db1c721ULL},
+        {0xc913936dd571c84cULL, 0x03bc3a19cd1e38e9ULL},
+        {0xfb5878494ace3a5fULL, 0x04ab48a04065c723ULL},
+        {0x9d174b2dcec0e47bULL, 0x62eb0d64283f9c76ULL},
+        {0xc45d1df942711d9aULL, 0x3ba5d0bd324f8394ULL},
+        {0xf5746577930d6500ULL, 0xca8f44ec7ee36479ULL},
+        {0x9968bf6abbe85f20ULL, 0x7e998b13cf4e1ecbULL},
+        {0xbfc2ef456ae276e8ULL, 0x9e3fedd8c321a67eULL},
+        {0xefb3ab16c59b14a2ULL, 0xc5cfe94ef3ea101eULL},
+        {0x95d04aee3b80ece5ULL, 0xbba1f1d158724a12ULL},
+        {0xbb445da9ca61281fULL, 0x2a8a6e45ae8edc97ULL},
+        {0xea1575143cf97226ULL, 0xf52d09d71a3293bdULL},
+        {0x924d692ca61be758ULL, 0x593c2626705f9c56ULL},
+        {0xb6e0c377cfa2e12eULL, 0x6f8b2fb00c77836cULL},
+        {0xe498f455c38b997aULL, 0x0b6dfb9c0f956447ULL},
+        {0x8edf98b59a373fecULL, 0x4724bd4189bd5eacULL},
+        {0xb2977ee300c50fe7ULL, 0x58edec91ec2cb657ULL},
+        {0xdf3d5e9bc0f653e1ULL, 0x2f2967b66737e3edULL},
+        {0x8b865b215899f46cULL, 0xbd79e0d20082ee74ULL},
+        {0xae67f1e9aec07187ULL, 0xecd8590680a3aa11ULL},
+        {0xda01ee641a708de9ULL, 0xe80e6f4820cc9495ULL},
+        {0x884134fe908658b2ULL, 0x3109058d147fdcddULL},
+        {0xaa51823e34a7eedeULL, 0xbd4b46f0599fd415ULL},
+        {0xd4e5e2cdc1d1ea96ULL, 0x6c9e18ac7007c91aULL},
+        {0x850fadc09923329eULL, 0x03e2cf6bc604ddb0ULL},
+        {0xa6539930bf6bff45ULL, 0x84db8346b786151cULL},
+        {0xcfe87f7cef46ff16ULL, 0xe612641865679a63ULL},
+        {0x81f14fae158c5f6eULL, 0x4fcb7e8f3f60c07eULL},
+        {0xa26da3999aef7749ULL, 0xe3be5e330f38f09dULL},
+        {0xcb090c8001ab551cULL, 0x5cadf5bfd3072cc5ULL},
+        {0xfdcb4fa002162a63ULL, 0x73d9732fc7c8f7f6ULL},
+        {0x9e9f11c4014dda7eULL, 0x2867e7fddcdd9afaULL},
+        {0xc646d63501a1511dULL, 0xb281e1fd541501b8ULL},
+        {0xf7d88bc24209a565ULL, 0x1f225a7ca91a4226ULL},
+        {0x9ae757596946075fULL, 0x3375788de9b06958ULL},
+        {0xc1a12d2fc3978937ULL, 0x0052d6b1641c83aeULL},
+        {0xf209787bb47d6b84ULL, 0xc0678c5dbd23a49aULL},
+        {0x9745eb4d50ce6332ULL, 0xf840b7ba963646e0ULL},
+        {0xbd176620a501fbffULL, 0xb650e5a93bc3d898ULL},
+        {0xec5d3fa8ce427affULL, 0xa3e51f138ab4cebeULL},
+        {0x93ba47c980e98cdfULL, 0xc66f336c36b10137ULL},
+        {0xb8a8d9bbe123f017ULL, 0xb80b0047445d4184ULL},
+        {0xe6d3102ad96cec1dULL, 0xa60dc059157491e5ULL},
+        {0x9043ea1ac7e41392ULL, 0x87c89837ad68db2fULL},
+        {0xb454e4a179dd1877ULL, 0x29babe4598c311fbULL},
+        {0xe16a1dc9d8545e94ULL, 0xf4296dd6fef3d67aULL},
+        {0x8ce2529e2734bb1dULL, 0x1899e4a65f58660cULL},
+        {0xb01ae745b101e9e4ULL, 0x5ec05dcff72e7f8fULL},
+        {0xdc21a1171d42645dULL, 0x76707543f4fa1f73ULL},
+        {0x899504ae72497ebaULL, 0x6a06494a791c53a8ULL},
+        {0xabfa45da0edbde69ULL, 0x0487db9d17636892ULL},
+        {0xd6f8d7509292d603ULL, 0x45a9d2845d3c42b6ULL},
+        {0x865b86925b9bc5c2ULL, 0x0b8a2392ba45a9b2ULL},
+        {0xa7f26836f282b732ULL, 0x8e6cac7768d7141eULL},
+        {0xd1ef0244af2364ffULL, 0x3207d795430cd926ULL},
+        {0x8335616aed761f1fULL, 0x7f44e6bd49e807b8ULL},
+        {0xa402b9c5a8d3a6e7ULL, 0x5f16206c9c6209a6ULL},
+        {0xcd036837130890a1ULL, 0x36dba887c37a8c0fULL},
+        {0x802221226be55a64ULL, 0xc2494954da2c9789ULL},
+        {0xa02aa96b06deb0fdULL, 0xf2db9baa10b7bd6cULL},
+        {0xc83553c5c8965d3dULL, 0x6f92829494e5acc7ULL},
+        {0xfa42a8b73abbf48cULL, 0xcb772339ba1f17f9ULL},
+        {0x9c69a97284b578d7ULL, 0xff2a760414536efbULL},
+        {0xc38413cf25e2d70dULL, 0xfef5138519684abaULL},
+        {0xf46518c2ef5b8cd1ULL, 0x7eb258665fc25d69ULL},
+        {0x98bf2f79d5993802ULL, 0xef2f773ffbd97a61ULL},
+        {0xbeeefb584aff8603ULL, 0xaafb550ffacfd8faULL},
+        {0xeeaaba2e5dbf6784ULL, 0x95ba2a53f983cf38ULL},
+        {0x952ab45cfa97a0b2ULL, 0xdd945a747bf26183ULL},
+        {0xba756174393d88dfULL, 0x94f971119aeef9e4ULL},
+        {0xe912b9d1478ceb17ULL, 0x7a37cd5601aab85dULL},
+        {0x91abb422ccb812eeULL, 0xac62e055c10ab33aULL},
+        {0xb616a12b7fe617aaULL, 0x577b986b314d6009ULL},
+        {0xe39c49765fdf9d94ULL, 0xed5a7e85fda0b80bULL},
+        {0x8e41ade9fbebc27dULL, 0x14588f13be847307ULL},
+        {0xb1d219647ae6b31cULL, 0x596eb2d8ae258fc8ULL},
+        {0xde469fbd99a05fe3ULL, 0x6fca5f8ed9aef3bbULL},
+        {0x8aec23d680043beeULL, 0x25de7bb9480d5854ULL},
+        {0xada72ccc20054ae9ULL, 0xaf561aa79a10ae6aULL},
+        {0xd910f7ff28069da4ULL, 0x1b2ba1518094da04ULL},
+        {0x87aa9aff79042286ULL, 0x90fb44d2f05d0842ULL},
+        {0xa99541bf57452b28ULL, 0x353a1607ac744a53ULL},
+        {0xd3fa922f2d1675f2ULL, 0x42889b8997915ce8ULL},
+        {0x847c9b5d7c2e09b7ULL, 0x69956135febada11ULL},
+        {0xa59bc234db398c25ULL, 0x43fab9837e699095ULL},
+        {0xcf02b2c21207ef2eULL, 0x94f967e45e03f4bbULL},
+        {0x8161afb94b44f57dULL, 0x1d1be0eebac278f5ULL},
+        {0xa1ba1ba79e1632dcULL, 0x6462d92a69731732ULL},
+        {0xca28a291859bbf93ULL, 0x7d7b8f7503cfdcfeULL},
+        {0xfcb2cb35e702af78ULL, 0x5cda735244c3d43eULL},
+        {0x9defbf01b061adabULL, 0x3a0888136afa64a7ULL},
+        {0xc56baec21c7a1916ULL, 0x088aaa1845b8fdd0ULL},
+        {0xf6c69a72a3989f5bULL, 0x8aad549e57273d45ULL},
+        {0x9a3c2087a63f6399ULL, 0x36ac54e2f678864bULL},
+        {0xc0cb28a98fcf3c7fULL, 0x84576a1bb416a7ddULL},
+        {0xf0fdf2d3f3c30b9fULL, 0x656d44a2a11c51d5ULL},
+        {0x969eb7c47859e743ULL, 0x9f644ae5a4b1b325ULL},
+        {0xbc4665b596706114ULL, 0x873d5d9f0dde1feeULL},
+        {0xeb57ff22fc0c7959ULL, 0xa90cb506d155a7eaULL},
+        {0x9316ff75dd87cbd8ULL, 0x09a7f12442d588f2ULL},
+        {0xb7dcbf5354e9beceULL, 0x0c11ed6d538aeb2fULL},
+        {0xe5d3ef282a242e81ULL, 0x8f1668c8a86da5faULL},
+        {0x8fa475791a569d10ULL, 0xf96e017d694487bcULL},
+        {0xb38d92d760ec4455ULL, 0x37c981dcc395a9acULL},
+        {0xe070f78d3927556aULL, 0x85bbe253f47b1417ULL},
+        {0x8c469ab843b89562ULL, 0x93956d7478ccec8eULL},
+        {0xaf58416654a6babbULL, 0x387ac8d1970027b2ULL},
+        {0xdb2e51bfe9d0696aULL, 0x06997b05fcc0319eULL},
+        {0x88fcf317f22241e2ULL, 0x441fece3bdf81f03ULL},
+        {0xab3c2fddeeaad25aULL, 0xd527e81cad7626c3ULL},
+        {0xd60b3bd56a5586f1ULL, 0x8a71e223d8d3b074ULL},
+        {0x85c7056562757456ULL, 0xf6872d5667844e49ULL},
+        {0xa738c6bebb12d16cULL, 0xb428f8ac016561dbULL},
+        {0xd106f86e69d785c7ULL, 0xe13336d701beba52ULL},
+        {0x82a45b450226b39cULL, 0xecc0024661173473ULL},
+        {0xa34d721642b06084ULL, 0x27f002d7f95d0190ULL},
+        {0xcc20ce9bd35c78a5ULL, 0x31ec038df7b441f4ULL},
+        {0xff290242c83396ceULL, 0x7e67047175a15271ULL},
+        {0x9f79a169bd203e41ULL, 0x0f0062c6e984d386ULL},
+        {0xc75809c42c684dd1ULL, 0x52c07b78a3e60868ULL},
+        {0xf92e0c3537826145ULL, 0xa7709a56ccdf8a82ULL},
+        {0x9bbcc7a142b17ccbULL, 0x88a66076400bb691ULL},
+        {0xc2abf989935ddbfeULL, 0x6acff893d00ea435ULL},
+        {0xf356f7ebf83552feULL, 0x0583f6b8c4124d43ULL},
+        {0x98165af37b2153deULL, 0xc3727a337a8b704aULL},
+        {0xbe1bf1b059e9a8d6ULL, 0x744f18c0592e4c5cULL},
+        {0xeda2ee1c7064130cULL, 0x1162def06f79df73ULL},
+        {0x9485d4d1c63e8be7ULL, 0x8addcb5645ac2ba8ULL},
+        {0xb9a74a0637ce2ee1ULL, 0x6d953e2bd7173692ULL},
+        {0xe8111c87c5c1ba99ULL, 0xc8fa8db6ccdd0437ULL},
+        {0x910ab1d4db9914a0ULL, 0x1d9c9892400a22a2ULL},
+        {0xb54d5e4a127f59c8ULL, 0x2503beb6d00cab4bULL},
+        {0xe2a0b5dc971f303aULL, 0x2e44ae64840fd61dULL},
+        {0x8da471a9de737e24ULL, 0x5ceaecfed289e5d2ULL},
+        {0xb10d8e1456105dadULL, 0x7425a83e872c5f47ULL},
+        {0xdd50f1996b947518ULL, 0xd12f124e28f77719ULL},
+        {0x8a5296ffe33cc92fULL, 0x82bd6b70d99aaa6fULL},
+        {0xace73cbfdc0bfb7bULL, 0x636cc64d1001550bULL},
+        {0xd8210befd30efa5aULL, 0x3c47f7e05401aa4eULL},
+        {0x8714a775e3e95c78ULL, 0x65acfaec34810a71ULL},
+        {0xa8d9d1535ce3b396ULL, 0x7f1839a741a14d0dULL},
+        {0xd31045a8341ca07cULL, 0x1ede48111209a050ULL},
+        {0x83ea2b892091e44dULL, 0x934aed0aab460432ULL},
+        {0xa4e4b66b68b65d60ULL, 0xf81da84d5617853fULL},
+        {0xce1de40642e3f4b9ULL, 0x36251260ab9d668eULL},
+        {0x80d2ae83e9ce78f3ULL, 0xc1d72b7c6b426019ULL},
+        {0xa1075a24e4421730ULL, 0xb24cf65b8612f81fULL},
+        {0xc94930ae1d529cfcULL, 0xdee033f26797b627ULL},
+        {0xfb9b7cd9a4a7443cULL, 0x169840ef017da3b1ULL},
+        {0x9d412e0806e88aa5ULL, 0x8e1f289560ee864eULL},
+        {0xc491798a08a2ad4eULL, 0xf1a6f2bab92a27e2ULL},
+        {0xf5b5d7ec8acb58a2ULL, 0xae10af696774b1dbULL},
+        {0x9991a6f3d6bf1765ULL, 0xacca6da1e0a8ef29ULL},
+        {0xbff610b0cc6edd3fULL, 0x17fd090a58d32af3ULL},
+        {0xeff394dcff8a948eULL, 0xddfc4b4cef07f5b0ULL},
+        {0x95f83d0a1fb69cd9ULL, 0x4abdaf101564f98eULL},
+        {0xbb764c4ca7a4440fULL, 0x9d6d1ad41abe37f1ULL},
+        {0xea53df5fd18d5513ULL, 0x84c86189216dc5edULL},
+        {0x92746b9be2f8552cULL, 0x32fd3cf5b4e49bb4ULL},
+        {0xb7118682dbb66a77ULL, 0x3fbc8c33221dc2a1ULL},
+        {0xe4d5e82392a40515ULL, 0x0fabaf3feaa5334aULL},
+        {0x8f05b1163ba6832dULL, 0x29cb4d87f2a7400eULL},
+        {0xb2c71d5bca9023f8ULL, 0x743e20e9ef511012ULL},
+        {0xdf78e4b2bd342cf6ULL, 0x914da9246b255416ULL},
+        {0x8bab8eefb6409c1aULL, 0x1ad089b6c2f7548eULL},
+        {0xae9672aba3d0c320ULL, 0xa184ac2473b529b1ULL},
+        {0xda3c0f568cc4f3e8ULL, 0xc9e5d72d90a2741eULL},
+        {0x8865899617fb1871ULL, 0x7e2fa67c7a658892ULL},
+        {0xaa7eebfb9df9de8dULL, 0xddbb901b98feeab7ULL},
+        {0xd51ea6fa85785631ULL, 0x552a74227f3ea565ULL},
+        {0x8533285c936b35deULL, 0xd53a88958f87275fULL},
+        {0xa67ff273b8460356ULL, 0x8a892abaf368f137ULL},
+        {0xd01fef10a657842cULL, 0x2d2b7569b0432d85ULL},
+        {0x8213f56a67f6b29bULL, 0x9c3b29620e29fc73ULL},
+        {0xa298f2c501f45f42ULL, 0x8349f3ba91b47b8fULL},
+        {0xcb3f2f7642717713ULL, 0x241c70a936219a73ULL},
+        {0xfe0efb53d30dd4d7ULL, 0xed238cd383aa0110ULL},
+        {0x9ec95d1463e8a506ULL, 0xf4363804324a40aaULL},
+        {0xc67bb4597ce2ce48ULL, 0xb143c6053edcd0d5ULL},
+        {0xf81aa16fdc1b81daULL, 0xdd94b7868e94050aULL},
+        {0x9b10a4e5e9913128ULL, 0xca7cf2b4191c8326ULL},
+        {0xc1d4ce1f63f57d72ULL, 0xfd1c2f611f63a3f0ULL},
+        {0xf24a01a73cf2dccfULL, 0xbc633b39673c8cecULL},
+        {0x976e41088617ca01ULL, 0xd5be0503e085d813ULL},
+        {0xbd49d14aa79dbc82ULL, 0x4b2d8644d8a74e18ULL},
+        {0xec9c459d51852ba2ULL, 0xddf8e7d60ed1219eULL},
+        {0x93e1ab8252f33b45ULL, 0xcabb90e5c942b503ULL},
+        {0xb8da1662e7b00a17ULL, 0x3d6a751f3b936243ULL},
+        {0xe7109bfba19c0c9dULL, 0x0cc512670a783ad4ULL},
+        {0x906a617d450187e2ULL, 0x27fb2b80668b24c5ULL},
+        {0xb484f9dc9641e9daULL, 0xb1f9f660802dedf6ULL},
+        {0xe1a63853bbd26451ULL, 0x5e7873f8a0396973ULL},
+        {0x8d07e33455637eb2ULL, 0xdb0b487b6423e1e8ULL},
+        {0xb049dc016abc5e5fULL, 0x91ce1a9a3d2cda62ULL},
+        {0xdc5c5301c56b75f7ULL, 0x7641a140cc7810fbULL},
+        {0x89b9b3e11b6329baULL, 0xa9e904c87fcb0a9dULL},
+        {0xac2820d9623bf429ULL, 0x546345fa9fbdcd44ULL},
+        {0xd732290fbacaf133ULL, 0xa97c177947ad4095ULL},
+        {0x867f59a9d4bed6c0ULL, 0x49ed8eabcccc485dULL},
+        {0xa81f301449ee8c70ULL, 0x5c68f256bfff5a74ULL},
+        {0xd226fc195c6a2f8cULL, 0x73832eec6fff3111ULL},
+        {0x83585d8fd9c25db7ULL, 0xc831fd53c5ff7eabULL},
+        {0xa42e74f3d032f525ULL, 0xba3e7ca8b77f5e55ULL},
+        {0xcd3a1230c43fb26fULL, 0x28ce1bd2e55f35ebULL},
+        {0x80444b5e7aa7cf85ULL, 0x7980d163cf5b81b3ULL},
+        {0xa0555e361951c366ULL, 0xd7e105bcc332621fULL},
+        {0xc86ab5c39fa63440ULL, 0x8dd9472bf3fefaa7ULL},
+        {0xfa856334878fc150ULL, 0xb14f98f6f0feb951ULL},
+        {0x9c935e00d4b9d8d2ULL, 0x6ed1bf9a569f33d3ULL},
+        {0xc3b8358109e84f07ULL, 0x0a862f80ec4700c8ULL},
+        {0xf4a642e14c6262c8ULL, 0xcd27bb612758c0faULL},
+        {0x98e7e9cccfbd7dbdULL, 0x8038d51cb897789cULL},
+        {0xbf21e44003acdd2cULL, 0xe0470a63e6bd56c3ULL},
+        {0xeeea5d5004981478ULL, 0x1858ccfce06cac74ULL},
+        {0x95527a5202df0ccbULL, 0x0f37801e0c43ebc8ULL},
+        {0xbaa718e68396cffdULL, 0xd30560258f54e6baULL},
+        {0xe950df20247c83fdULL, 0x47c6b82ef32a2069ULL},
+        {0x91d28b7416cdd27eULL, 0x4cdc331d57fa5441ULL},
+        {0xb6472e511c81471dULL, 0xe0133fe4adf8e952ULL},
+        {0xe3d8f9e563a198e5ULL, 0x58180fddd97723a6ULL},
+        {0x8e679c2f5e44ff8fULL, 0x570f09eaa7ea7648ULL}
+
+    };
+
+    /**
+     * @brief 128-bit result of a 64-bit multiplication
+     */
+    struct Product {
+        uint64_t high;  ///< Upper 64 bits
+        uint64_t low;   ///< Lower 64 bits
+    };
+
+    /**
+     * @brief Multiplies two 64-bit numbers into a 128-bit result
+     * @param left First factor
+     * @param right Second factor
+     * @return Full product
+     */
+    inline Product multiply(const uint64_t left, const uint64_t right) {
+#if defined(__SIZEOF_INT128__)
+        const unsigned __int128 product = static_cast<unsigned __int128>(left) * right;
+        return {static_cast<uint64_t>(product >> 64), static_cast<uint64_t>(product)};
+#else
+        const uint64_t leftLow = left & 0xFFFFFFFFULL, leftHigh = left >> 32;
+        const uint64_t rightLow = right & 0xFFFFFFFFULL, rightHigh = right >> 32;
+        const uint64_t lowLow = leftLow * rightLow, lowHigh = leftLow * rightHigh;
+        const uint64_t highLow = leftHigh * rightLow, highHigh = leftHigh * rightHigh;
+        const uint64_t middle = (lowLow >> 32) + (lowHigh & 0xFFFFFFFFULL) + (highLow & 0xFFFFFFFFULL);
+        return {highHigh + (lowHigh >> 32) + (highLow >> 32) + (middle >> 32), (middle << 32) | (lowLow & 0xFFFFFFFFULL)};
+#endif
+    }
+
+    /**
+     * @brief Counts the leading zero bits of a nonzero number
+     * @param value Number to inspect
+     * @return Number of leading zero bits
+     */
+    inline int countLeadingZeros(uint64_t value) {
+#if defined(__GNUC__) || defined(__clang__)
+        return __builtin_clzll(value);
+#else
+        int count = 0;
+
+        while((value & (1ULL << 63)) == 0) {
+            value <<= 1;
+            count++;
+        }
+
+        return count;
+#endif
+    }
+
+    /**
+     * @brief Converts w * 10^q to the bits of the nearest double using the Eisel-Lemire algorithm
+     * @param significand Decimal significand w
+     * @param exponent Decimal exponent q
+     * @return Bits of the nearest positive double
+     */
+    uint64_t computeDouble(uint64_t significand, const int64_t exponent) {
+        if(significand == 0 || exponent < SmallestPowerOfTen) {
+            return 0;
+        }
+
+        if(exponent > LargestPowerOfTen) {
+            return static_cast<uint64_t>(InfiniteExponent) << MantissaBits;
+        }
+
+        const int leadingZeros = countLeadingZeros(significand);
+        significand <<= leadingZeros;
+
+        const uint64_t* power = PowersOfFive[exponent - SmallestPowerOfTen];
+        Product product = multiply(significand, power[0]);
+
+        // Only the top 55 bits matter; the low half of the power is needed when the bits below them are all ones
+        const uint64_t precisionMask = 0xFFFFFFFFFFFFFFFFULL >> (MantissaBits + 3);
+
+        if((product.high & precisionMask) == precisionMask) {
+            const Product correction = multiply(significand, power[1]);
+            product.low += correction.high;
+
+            if(correction.high > product.low) {
+                product.high++;
+            }
+        }
+
+        const int upperBit = static_cast<int>(product.high >> 63);
+        const int shift = upperBit + 64 - MantissaBits - 3;
+        uint64_t mantissa = product.high >> shift;
+        int64_t binaryExponent = (((152170 + 65536) * exponent) >> 16) + 63 + upperBit - leadingZeros + 1023;
+
+        if(binaryExponent <= 0) {
+            // Subnormal result
+            if(-binaryExponent + 1 >= 64) {
+                return 0;
+            }
+
+            mantissa >>= -binaryExponent + 1;
+            mantissa += mantissa & 1;
+            mantissa >>= 1;
+            binaryExponent = mantissa < (1ULL << MantissaBits) ? 0 : 1;
+
+            return mantissa | (static_cast<uint64_t>(binaryExponent) << MantissaBits);
+        }
+
+        // Exactly halfway between two doubles, which only happens for small exponents: round to even
+        if(product.low <= 1 && exponent >= -4 && exponent <= 23 && (mantissa & 3) == 1 && (mantissa << shift) == product.high) {
+            mantissa &= ~1ULL;
+        }
+
+        mantissa += mantissa & 1;
+        mantissa >>= 1;
+
+        if(mantissa >= (2ULL << MantissaBits)) {
+            mantissa = 1ULL << MantissaBits;
+            binaryExponent++;
+        }
+
+        mantissa &= ~(1ULL << MantissaBits);
+
+        if(binaryExponent >= InfiniteExponent) {
+            return static_cast<uint64_t>(InfiniteExponent) << MantissaBits;
+        }
+
+        return mantissa | (static_cast<uint64_t>(binaryExponent) << MantissaBits);
+    }
+
+    /**
+     * @brief Skips a run of digits
+     * @param current Pointer to the first character to inspect
+     * @param end Pointer one past the last character of the token
+     * @return Pointer to the first character that is not a digit
+     */
+    inline const char* skipDigits(const char* current, const char* end) {
+        while(current < end && JsonGrammar::isDigit(*current)) {
+            current++;
+        }
+
+        return current;
+    }
+
+    /**
+     * @brief Decimal digits of every number below 100, two characters each
+     */
+    const char DigitPairs[] =
+        "00010203040506070809101112131415161718192021222324252627282930313233343536373839"
+        "40414243444546474849505152535455565758596061626364656667686970717273747576777879"
+        "8081828384858687888990919293949596979899";
+
+    /**
+     * @brief Writes the decimal digits of a number, two digits per division
+     * @param value Number to write
+     * @param buffer Buffer to write to
+     * @return Number of characters written
+     */
+    size_t writeDigits(uint64_t value, char* buffer) {
+        char digits[20];
+        char* start = digits + sizeof(digits);
+
+        while(value >= 100) {
+            const size_t pair = static_cast<size_t>(value % 100) * 2;
+            value /= 100;
+            start -= 2;
+            start[0] = DigitPairs[pair];
+            start[1] = DigitPairs[pair + 1];
+        }
+
+        if(value >= 10) {
+            start -= 2;
+            start[0] = DigitPairs[value * 2];
+            start[1] = DigitPairs[value * 2 + 1];
+        } else {
+            *--start = static_cast<char>('0' + value);
+        }
+
+        const size_t count = static_cast<size_t>(digits + sizeof(digits) - start);
+        std::memcpy(buffer, start, count);
+
+        return count;
+    }
+
+    /**
+     * @brief Smallest decimal exponent k of the shortest decimal of a double, reached by the smallest subnormal
+     */
+    const int SmallestShortestPowerOfTen = -324;
+
+    /**
+     * @brief Largest decimal exponent k of the shortest decimal of a double
+     */
+    const int LargestShortestPowerOfTen = 292;
+
+    /**
+     * @brief Smallest decimal exponent written in fixed notation, the same bound %.15g uses
+     */
+    const int SmallestFixedExponent = -4;
+
+    /**
+     * @brief Decimal exponent from which numbers are written in exponential notation, the same bound %.15g uses
+     */
+    const int LargestFixedExponent = 15;
+
+    /**
+     * @brief 126-bit scaled powers of ten for Schubfach, g = floor(b) + 1 in upper and lower 63 bits per row
+     */
+    const uint64_t ScaledPowersOfTen[][2] = {
+        {0x4f0cedc95a718dd4ULL, 0x5b01e8b09aa0d1b5ULL},
+        {0x7e7b160ef71c1621ULL, 0x119ca780f767b5eeULL},
+        {0x652f44d8c5b011b4ULL, 0x0e16ec672c52f7f2ULL},
+        {0x50f29d7a37c00e29ULL, 0x581256b8f0425ff5ULL},
+        {0x40c21794f96671baULL, 0x79a84560c0351991ULL},
+        {0x679cf287f570b5f7ULL, 0x75da089acd21c281ULL},
+        {0x52e3f5399126f7f9ULL, 0x44ae6d48a41b0201ULL},
+        {0x424ff76140ebf994ULL, 0x36f1f106e9af34cdULL},
+        {0x6a198bcece465c20ULL, 0x57e981a4a918547bULL},
+        {0x54e13ca571d1e34dULL, 0x2cbace1d541376c9ULL},
+        {0x43e763b78e4182a4ULL, 0x23c8a4e44342c56eULL},
+        {0x6ca56c58e39c043aULL, 0x060dd4a06b9e08b0ULL},
+        {0x56eabd13e9499cfbULL, 0x1e7176e6bc7e6d59ULL},
+        {0x458897432107b0c8ULL, 0x7ec12bebc9febde1ULL},
+        {0x6f40f20501a5e7a7ULL, 0x7e01dfdfa9979635ULL},
+        {0x5900c19d9aeb1fb9ULL, 0x4b34b319547944f7ULL},
+        {0x4733ce17af227fc7ULL, 0x55c3c27aa9fa9d93ULL},
+        {0x71ec7cf2b1d0cc72ULL, 0x560603f7765dc8eaULL},
+        {0x5b2397288e40a38eULL, 0x7804cff92b7e3a55ULL},
+        {0x48e945ba0b66e93fULL, 0x13370cc755fe9511ULL},
+        {0x74a86f90123e41feULL, 0x51f1ae0bbcca881bULL},
+        {0x5d538c7341cb67feULL, 0x74c1580963d539afULL},
+        {0x4aa93d29016f8665ULL, 0x43cde0078310faf3ULL},
+        {0x77752ea8024c0a3cULL, 0x0616333f381b2b1eULL},
+        {0x5f90f22001d66e96ULL, 0x3811c298f9af55b1ULL},
+        {0x4c73f4e667debedeULL, 0x600e35472e25de28ULL},
+        {0x7a532170a6313164ULL, 0x3349eed849d6303fULL},
+        {0x61dc1ac084f42783ULL, 0x42a18be03b11c033ULL},
+        {0x4e49af006a5cec69ULL, 0x1bb46fe695a7ccf5ULL},
+        {0x7d42b19a43c7e0a8ULL, 0x2c53e63dbc3fae55ULL},
+        {0x64355ae1cfd31a20ULL, 0x237651cafcffbeaaULL},
+        {0x502aaf1b0ca8e1b3ULL, 0x35f8416f30cc9888ULL},
+        {0x402225af3d53e7c2ULL, 0x5e603458f3d6e06dULL},
+        {0x669d0918621fd937ULL, 0x4a3386f4b957cd7bULL},
+        {0x52173a79e8197a92ULL, 0x6e8f9f2a2ddfd796ULL},
+        {0x41ac2ec7ece12edbULL, 0x720c7f54f17fdfabULL},
+        {0x69137e0cae3517c6ULL, 0x1ce0cbbb1bffcc45ULL},
+        {0x540f980a24f74638ULL, 0x171a3c95afffd69eULL},
+        {0x433facd4ea5f6b60ULL, 0x127b63aaf3331218ULL},
+        {0x6b991487dd657899ULL, 0x6a5f05de51eb5026ULL},
+        {0x5614106cb11dfa14ULL, 0x5518d17ea7ef7352ULL},
+        {0x44dcd9f08db194ddULL, 0x2a7a41321ff2c2a8ULL},
+        {0x6e2e2980e2b5bafbULL, 0x5d906850331e043fULL},
+        {0x5824ee00b55e2f2fULL, 0x647386a68f4b3699ULL},
+        {0x4683f19a2ab1bf59ULL, 0x36c2d21ed908f87bULL},
+        {0x70d31c29dde93228ULL, 0x579e1cfe280e5a5dULL},
+        {0x5a427cee4b20f4edULL, 0x2c7e7d98200b7b7eULL},
+        {0x483530bea280c3f1ULL, 0x09fecae019a2c932ULL},
+        {0x73884dfdd0ce064eULL, 0x43314499c29e0eb6ULL},
+        {0x5c6d0b3173d8050bULL, 0x4f5a9d47cee4d891ULL},
+        {0x49f0d5c129799da2ULL, 0x72aee4397250ad41ULL},
+        {0x764e22cea8c295d1ULL, 0x377e39f583b44868ULL},
+        {0x5ea4e8a553cede41ULL, 0x12cb61913629d387ULL},
+        {0x4bb72084430be500ULL, 0x756f8140f8217605ULL},
+        {0x792500d39e796e67ULL, 0x6f18cece59cf233cULL},
+        {0x60ea670fb1fabeb9ULL, 0x3f470bd847d8e8fdULL},
+        {0x4d885272f4c89894ULL, 0x329f3cad064720caULL},
+        {0x7c0d50b7ee0dc0edULL, 0x37652de1a3a50143ULL},
+        {0x633dda2cbe716724ULL, 0x2c50f1814fb73436ULL},
+        {0x4f64ae8a31f45283ULL, 0x3d0d8e010c92902bULL},
+        {0x7f077da9e986ea6bULL, 0x7b48e334e0ea8045ULL},
+        {0x659f97bb2138bb89ULL, 0x49071c2a4d88669dULL},
+        {0x514c796280fa2fa1ULL, 0x20d27ceea46d1ee4ULL},
+        {0x4109fab533fb594dULL, 0x670eca58838a7f1dULL},
+        {0x680ff788532bc216ULL, 0x0b4add5a6c10cb62ULL},
+        {0x533ff939dc2301abULL, 0x22a24aaebcda3c4eULL},
+        {0x4299942e49b59aefULL, 0x354ea22563e1c9d8ULL},
+        {0x6a8f537d42bc2b18ULL, 0x554a9d089fcfa95aULL},
+        {0x553f75fdcefcef46ULL, 0x776ee406e63fbaaeULL},
+        {0x4432c4cb0bfd8c38ULL, 0x5f8be99f1e996225ULL},
+        {0x6d1e07ab466279f4ULL, 0x327975cb64289d08ULL},
+        {0x574b3955d1e86190ULL, 0x28612b091ced4a6dULL},
+        {0x45d5c777db204e0dULL, 0x06b4226db0bdd524ULL},
+        {0x6fbc72595e9a167bULL, 0x24536a491ac95506ULL},
+        {0x59638eade54811fcULL, 0x1d0f883a7bd44405ULL},
+        {0x4782d88b1dd34196ULL, 0x4a72d361fca9d004ULL},
+        {0x726af411c952028aULL, 0x43eaebcffaa94cd3ULL},
+        {0x5b88c3416ddb353bULL, 0x4fef230cc88770a9ULL},
+        {0x493a35cdf17c2a96ULL, 0x0cbf4f3d6d3926eeULL},
+        {0x7529efafe8c6aa89ULL, 0x61321862485b717cULL},
+        {0x5dbb262653d22207ULL, 0x675b46b506af8dfdULL},
+        {0x4afc1e850fdb4e6cULL, 0x52af6bc405593e64ULL},
+        {0x77f9ca6e7fc54a47ULL, 0x377f12d33bc1fd6dULL},
+        {0x5ffb085866376e9fULL, 0x45ff42429634cabdULL},
+        {0x4cc8d379eb5f8bb2ULL, 0x6b329b68782a3bcbULL},
+        {0x7adaebf64565ac51ULL, 0x2b842bda59dd2c77ULL},
+        {0x6248bcc5045156a7ULL, 0x3c69bcaeae4a89f9ULL},
+        {0x4ea0970403744552ULL, 0x6387ca25583ba194ULL},
+        {0x7dcdbe6cd253a21eULL, 0x05a6103bc05f68edULL},
+        {0x64a498570ea94e7eULL, 0x37b80cfc99e5ed8aULL},
+        {0x5083ad1272210b98ULL, 0x2c933d96e184be08ULL},
+        {0x40695741f4e73c79ULL, 0x7075cadf1ad09807ULL},
+        {0x670ef2032171fa5cULL, 0x4d8944982ae759a4ULL},
+        {0x52725b35b45b2eb0ULL, 0x3e076a135585e150ULL},
+        {0x41f515c49048f226ULL, 0x64d2bb42aad1810dULL},
+        {0x698822d41a0e503eULL, 0x07b7920444826815ULL},
+        {0x546ce8a9ae71d9cbULL, 0x1fc60e69d0685344ULL},
+        {0x438a53baf1f4ae3cULL, 0x196b3ebb0d20429dULL},
+        {0x6c1085f7e9877d2dULL, 0x0f11fdf815006a94ULL},
+        {0x56739e5fee05fdbdULL, 0x58db319344005543ULL},
+        {0x45294b7ff19e6497ULL, 0x60af5adc3666aa9cULL},
+        {0x6ea878ccb5ca3a8cULL, 0x344bc4938a3dddc7ULL},
+        {0x5886c70a2b082ed6ULL, 0x5d096a0fa1cb17d2ULL},
+        {0x46d238d4ef39bf12ULL, 0x173abb3fb4a27975ULL},
+        {0x71505aee4b8f981dULL, 0x0b912b992103f588ULL},
+        {0x5aa6af25093face4ULL, 0x0940efadb4032ad3ULL},
+        {0x488558ea6dcc8a50ULL, 0x07672624900288a9ULL},
+        {0x74088e43e2e0dd4cULL, 0x723ea36db337410eULL},
+        {0x5cd3a5031be71770ULL, 0x5b654f8af5c5cda5ULL},
+        {0x4a42ea68e31f45f3ULL, 0x62b772d5916b0aebULL},
+        {0x76d1770e38320986ULL, 0x0458b7bc1bde77ddULL},
+        {0x5f0df8d82cf4d46bULL, 0x1d13c630164b9318ULL},
+        {0x4c0b2d79bd90a9efULL, 0x30dc9e8cdea2dc13ULL},
+        {0x79ab7bf5fc1aa97fULL, 0x0160fdae31049351ULL},
+        {0x6155fcc4c9aeedffULL, 0x1ab3fe24f403a90eULL},
+        {0x4dde63d0a158be65ULL, 0x6229981d9002eda5ULL},
+        {0x7c97061a9bc130a2ULL, 0x69dc2695b337e2a1ULL},
+        {0x63ac04e2163426e8ULL, 0x54b01ede28f9821bULL},
+        {0x4fbcd0b4de901f20ULL, 0x43c018b1ba6134e2ULL},
+        {0x7f9481216419cb67ULL, 0x1f99c11c5d68549dULL},
+        {0x6610674de9ae3c52ULL, 0x4c7b00e37ded107eULL},
+        {0x51a6b90b21583042ULL, 0x09fc00b5fe574065ULL},
+        {0x41522da2811359ceULL, 0x3b3000919845cd1dULL},
+        {0x68837c3734ebc2e3ULL, 0x784ccdb5c06fae95ULL},
+        {0x539c635f5d8968b6ULL, 0x2d0a3e2b00595877ULL},
+        {0x42e382b2b13aba2bULL, 0x3da1cb5599e11393ULL},
+        {0x6b059deab52ac378ULL, 0x629c7888f634ec1eULL},
+        {0x559e17eef755692dULL, 0x3549fa072b5d89b1ULL},
+        {0x447e798bf91120f1ULL, 0x1107fb38ef7e07c1ULL},
+        {0x6d9728dff4e834b5ULL, 0x01a65ec17f300c68ULL},
+        {0x57ac20b32a535d5dULL, 0x4e1eb23465c009edULL},
+        {0x46234d5c21dc4ab1ULL, 0x24e55b5d1e333b24ULL},
+        {0x70387bc69c93aab5ULL, 0x216ef894fd1ec506ULL},
+        {0x59c6c96bb076222aULL, 0x4df2607730e56a6cULL},
+        {0x47d23abc8d2b4e88ULL, 0x3e5b805f5a5121f0ULL},
+        {0x72e9f79415121740ULL, 0x63c59a322a1b697fULL},
+        {0x5bee5fa9aa74df67ULL, 0x03047b5b54e2baccULL},
+        {0x498b7fbaeec3e5ecULL, 0x0269fc4910b5623dULL},
+        {0x75abff917e063cacULL, 0x6a432d41b45569fbULL},
+        {0x5e2332dacb38308aULL, 0x21cf5767c37787fcULL},
+        {0x4b4f5be23c2cf3a1ULL, 0x67d912b9692c6ccaULL},
+        {0x787ef969f9e185cfULL, 0x595b5128a8471476ULL},
+        {0x60659454c7e79e3fULL, 0x6115da86ed05a9f8ULL},
+        {0x4d1e1043d31fb1ccULL, 0x4dab1538bd9e2193ULL},
+        {0x7b634d3951cc4fadULL, 0x62ab552795c9cf52ULL},
+        {0x62b5d7610e3d0c8bULL, 0x0222aa86116e3f75ULL},
+        {0x4ef7df80d830d6d5ULL, 0x4e822204dabe992aULL},
+        {0x7e59659af38157bcULL, 0x17369cd49130f510ULL},
+        {0x65145148c2cddfc9ULL, 0x5f5ee3dd40f3f740ULL},
+        {0x50dd0dd3cf0b196eULL, 0x1918b64a9a5cc5cdULL},
+        {0x40b0d7dca5a27abeULL, 0x4746f83baeb09e3eULL},
+        {0x678159610903f797ULL, 0x253e59f91780fd2fULL},
+        {0x52cde11a6d9cc612ULL, 0x50feae60df9a6426ULL},
+        {0x423e4daebe1704dbULL, 0x5a65584d7faeb685ULL},
+        {0x69fd4917968b3af9ULL, 0x10a226e265e4573bULL},
+        {0x54caa0dfaba29594ULL, 0x0d4e8581eb1d1295ULL},
+        {0x43d54d7fbc821143ULL, 0x243ed134bc174211ULL},
+        {0x6c887bff94034ed2ULL, 0x06cae85460253682ULL},
+        {0x56d396661002a574ULL, 0x6bd586a9e6842b9bULL},
+        {0x457611eb40021df7ULL, 0x09779eee52035616ULL},
+        {0x6f234fdeccd02ff1ULL, 0x5bf297e3b66bbcefULL},
+        {0x58e90cb23d73598eULL, 0x165bacb62b8963f3ULL},
+        {0x4720d6f4fdf5e13eULL, 0x451623c4efa11cc2ULL},
+        {0x71ce24bb2fefcecaULL, 0x3b569fa17f682e03ULL},
+        {0x5b0b5095bff30bd5ULL, 0x15dee61acc535803ULL},
+        {0x48d5da11665c0977ULL, 0x2b18b8157042accfULL},
+        {0x74895ce8a3c6758bULL, 0x5e8df355806aae18ULL},
+        {0x5d3ab0ba1c9ec46fULL, 0x653e5c4466bbbe7aULL},
+        {0x4a955a2e7d4bd059ULL, 0x3765169d1efc9861ULL},
+        {0x77555d172edfb3c2ULL, 0x256e8a94fe60f3cfULL},
+        {0x5f777dac257fc301ULL, 0x6abed543feb3f63fULL},
+        {0x4c5f97bceacc9c01ULL, 0x3bcbddcffef65e99ULL},
+        {0x7a328c6177adc668ULL, 0x5fac961997f0975bULL},
+        {0x61c209e792f16b86ULL, 0x7fbd44e1465a12afULL},
+        {0x4e34d4b9425abc6bULL, 0x7fca9d810514dbbfULL},
+        {0x7d21545b9d5dfa46ULL, 0x32ddc8ce6e87c5ffULL},
+        {0x641aa9e2e44b2e9eULL, 0x5be4a0a525396b32ULL},
+        {0x501554b5836f587eULL, 0x7cb6e6ea842def5cULL},
+        {0x4011109135f2ad32ULL, 0x30925255368b25e3ULL},
+        {0x6681b41b89844850ULL, 0x4db6ea21f0dea304ULL},
+        {0x52015ce2d469d373ULL, 0x57c5881b2718826aULL},
+        {0x419ab0b576bb0f8fULL, 0x5fd139af527a01efULL},
+        {0x68f781225791b27fULL, 0x4c81f5e550c3364aULL},
+        {0x53f9341b79415b99ULL, 0x239b2b1dda35c508ULL},
+        {0x432dc3492dcde2e1ULL, 0x02e288e4ae916a6dULL},
+        {0x6b7c6ba849496b01ULL, 0x516a74a1174f10aeULL},
+        {0x55fd22ed076def34ULL, 0x4121f6e745d8da25ULL},
+        {0x44ca82573924bf5dULL, 0x1a8192529e4714ebULL},
+        {0x6e10d08b8ea1322eULL, 0x5d9c1d50fd3e87ddULL},
+        {0x580d73a2d880f4f2ULL, 0x17b01773fdcb9fe4ULL},
+        {0x4671294f139a5d8eULL, 0x4626792997d61984ULL},
+        {0x70b50ee4ec2a2f4aULL, 0x3d0a5b75bfbcf59fULL},
+        {0x5a2a7250bcee8c3bULL, 0x4a6eaf916630c47fULL},
+        {0x4821f50d63f209c9ULL, 0x21f2260deb5a36ccULL},
+        {0x736988156cb6760eULL, 0x69837016455d247aULL},
+        {0x5c546cddf091f80bULL, 0x6e02c011d1175062ULL},
+        {0x49dd23e4c074c66fULL, 0x719bccdb0dac404eULL},
+        {0x762e9fd467213d7fULL, 0x68f947c4e2ad33b0ULL},
+        {0x5e8bb3105280fdffULL, 0x6d94396a4ef0f627ULL},
+        {0x4ba2f5a6a8673199ULL, 0x3e102deea58d91b9ULL},
+        {0x7904bc3dda3eb5c2ULL, 0x3019e3176f48e927ULL},
+        {0x60d09697e1cbc49bULL, 0x4014b5ac590720ecULL},
+        {0x4d73abacb4a303afULL, 0x4cdd5e237a6c1a57ULL},
+        {0x7bec45e12104d2b2ULL, 0x47c8969f2a46908aULL},
+        {0x63236b1a80d0a88eULL, 0x6ca0787f5505406fULL},
+        {0x4f4f88e200a6ed3fULL, 0x0a19f9ff773766bfULL},
+        {0x7ee5a7d0010b1531ULL, 0x5cf65ccbf1f23dfeULL},
+        {0x6584864000d5aa8eULL, 0x172b7d6ff4c1cb32ULL},
+        {0x5136d1cccd77bba4ULL, 0x78ef978cc3ce3c28ULL},
+        {0x40f8a7d70ac62fb7ULL, 0x13f2dfa3cfd83020ULL},
+        {0x67f43fbe77a37f8bULL, 0x398499061959e699ULL},
+        {0x5329cc985fb5ffa2ULL, 0x6136e0d1ade18548ULL},
+        {0x4287d6e04c91994fULL, 0x00f8b3daf181376dULL},
+        {0x6a72f166e0e8f54bULL, 0x1b27862b1c01f247ULL},
+        {0x5528c11f1a53f76fULL, 0x2f52d1bc1667f506ULL},
+        {0x44209a7f48432c59ULL, 0x0c424163451ff738ULL},
+        {0x6d00f7320d3846f4ULL, 0x7a039bd208332526ULL},
+        {0x5733f8f4d76038c3ULL, 0x7b361641a028ea85ULL},
+        {0x45c32d90ac4cfa36ULL, 0x2f5e78348020bb9eULL},
+        {0x6f9eaf4de07b29f0ULL, 0x4bca59ed99cdf8fcULL},
+        {0x594bbf71806287f3ULL, 0x563b7b247b0b2d96ULL},
+        {0x476fcc5acd1b9ff6ULL, 0x11c92f50626f57acULL},
+        {0x724c7a2ae1c5ccbdULL, 0x02db7ee703e55912ULL},
+        {0x5b7061bbe7d17097ULL, 0x1be2cbec031de0dcULL},
+        {0x4926b496530df3acULL, 0x164f09899c17e716ULL},
+        {0x750aba8a1e7cb913ULL, 0x3d4b4275c68ca4f0ULL},
+        {0x5da22ed4e530940fULL, 0x4aa29b916ba3b726ULL},
+        {0x4ae825771dc07672ULL, 0x6ee87c74561c9285ULL},
+        {0x77d9d58b62cd8a51ULL, 0x3173fa53bcfa8408ULL},
+        {0x5fe177a2b5713b74ULL, 0x278ffb7630c869a0ULL},
+        {0x4cb45fb55df42f90ULL, 0x1fa662c4f3d387b3ULL},
+        {0x7aba32bbc986b280ULL, 0x32a3d13b1fb8d91fULL},
+        {0x622e8efca1388ecdULL, 0x0ee9742f4c93e0e6ULL},
+        {0x4e8ba596e760723dULL, 0x58bac3590a0fe71eULL},
+        {0x7dac3c24a5671d2fULL, 0x412ad228101971c9ULL},
+        {0x6489c9b6eab8e426ULL, 0x00ef0e8673478e3bULL},
+        {0x506e3af8bbc71cebULL, 0x1a58d86b8f6c71c9ULL},
+        {0x40582f2d6305b0bcULL, 0x1513e0560c56c16eULL},
+        {0x66f37eaf04d5e793ULL, 0x3b530089ad579be2ULL},
+        {0x525c6558d0ab1fa9ULL, 0x15dc006e2446164fULL},
+        {0x41e384470d55b2edULL, 0x5e4999f1b69e783fULL},
+        {0x696c06d81555eb15ULL, 0x7d428fe92430c065ULL},
+        {0x54566be0111188deULL, 0x31020cba835a3384ULL},
+        {0x4378564cda746d7eULL, 0x5a680a2ecf7b5c69ULL},
+        {0x6bf3bd47c3ed7bfdULL, 0x770cdd17b25efa42ULL},
+        {0x565c976c9cbdfccbULL, 0x1270b0dfc1e59502ULL},
+        {0x4516df8a16fe63d5ULL, 0x5b8d5a4c9b1e10ceULL},
+        {0x6e8aff4357fd6c89ULL, 0x127bc3adc4fce7b0ULL},
+        {0x586f329c466456d4ULL, 0x0ec96957d0ca52f3ULL},
+        {0x46bf5bb038504576ULL, 0x3f07877973d50f29ULL},
+        {0x71322c4d26e6d58aULL, 0x31a5a58f1fbb4b75ULL},
+        {0x5a8e89d75252446eULL, 0x5aeaead8e62f6f91ULL},
+        {0x487207df750e9d25ULL, 0x2f22557a51bf8c74ULL},
+        {0x73e9a63254e42ea2ULL, 0x1836ef2a1c65ad86ULL},
+        {0x5cbaeb5b771cf21bULL, 0x2cf8bf54e3848ad2ULL},
+        {0x4a2f22af927d8e7cULL, 0x23fa32aa4f9d3bdbULL},
+        {0x76b1d118ea627d93ULL, 0x5329eaaa18fb92f8ULL},
+        {0x5ef4a74721e86476ULL, 0x0f54bbbb472fa8c6ULL},
+        {0x4bf6ec38e7ed1d2bULL, 0x25dd62fc38f2ed6cULL},
+        {0x798b138e3fe1c845ULL, 0x22fbd1938e517bdfULL},
+        {0x613c0fa4ffe7d36aULL, 0x4f2fdadc71dac97fULL},
+        {0x4dc9a61d998642bbULL, 0x58f3157d27e23accULL},
+        {0x7c75d695c2706ac5ULL, 0x74b82261d969f7adULL},
+        {0x63917877cec0556bULL, 0x10934eb4adee5fbeULL},
+        {0x4fa793930bcd1122ULL, 0x4075d8908b251965ULL},
+        {0x7f7285b812e1b504ULL, 0x00bc8db411d4f56eULL},
+        {0x65f537c675815d9cULL, 0x66fd3e29a7dd9125ULL},
+        {0x5190f96b91344ae3ULL, 0x6bfdcb54864ada84ULL},
+        {0x4140c78940f6a24fULL, 0x6ffe3c439ea2486aULL},
+        {0x6867a5a867f103b2ULL, 0x7ffd2d38fdd073dcULL},
+        {0x53861e2053273628ULL, 0x6664242d97d9f64aULL},
+        {0x42d1b1b375b8f820ULL, 0x51e9b68adfe191d5ULL},
+        {0x6ae91c5255f4c034ULL, 0x1ca924116635b621ULL},
+        {0x558749db77f70029ULL, 0x63ba83411e915e81ULL},
+        {0x446c3b15f9926687ULL, 0x6962029a7edab201ULL},
+        {0x6d79f82328ea3da6ULL, 0x0f03375d97c45001ULL},
+        {0x5794c6828721caebULL, 0x259c2c4adfd04001ULL},
+        {0x46109eced2816f22ULL, 0x5149bd08b30d0001ULL},
+        {0x701a97b150cf1837ULL, 0x3542c80deb480001ULL},
+        {0x59aedfc10d7279c5ULL, 0x7768a00b22a00001ULL},
+        {0x47bf19673df52e37ULL, 0x79208008e8800001ULL},
+        {0x72cb5bd86321e38cULL, 0x5b67334174000001ULL},
+        {0x5bd5e313828182d6ULL, 0x7c528f6790000001ULL},
+        {0x4977e8dc68679bdfULL, 0x16a872b940000001ULL},
+        {0x758ca7c70d7292feULL, 0x5773eac200000001ULL},
+        {0x5e0a1fd271287598ULL, 0x45f6556800000001ULL},
+        {0x4b3b4ca85a86c47aULL, 0x04c5112000000001ULL},
+        {0x785ee10d5da46d90ULL, 0x07a1b50000000001ULL},
+        {0x604be73de4838ad9ULL, 0x52e7c40000000001ULL},
+        {0x4d0985cb1d3608aeULL, 0x0f1fd00000000001ULL},
+        {0x7b426fab61f00de3ULL, 0x31cc800000000001ULL},
+        {0x629b8c891b267182ULL, 0x5b0a000000000001ULL},
+        {0x4ee2d6d415b85aceULL, 0x7c08000000000001ULL},
+        {0x7e37be2022c0914bULL, 0x1340000000000001ULL},
+        {0x64f964e68233a76fULL, 0x2900000000000001ULL},
+        {0x50c783eb9b5c85f2ULL, 0x5400000000000001ULL},
+        {0x409f9cbc7c4a04c2ULL, 0x1000000000000001ULL},
+        {0x6765c793fa10079dULL, 0x0000000000000001ULL},
+        {0x52b7d2dcc80cd2e4ULL, 0x0000000000000001ULL},
+        {0x422ca8b0a00a4250ULL, 0x0000000000000001ULL},
+        {0x69e10de76676d080ULL, 0x0000000000000001ULL},
+        {0x54b40b1f852bda00ULL, 0x0000000000000001ULL},
+        {0x43c33c1937564800ULL, 0x0000000000000001ULL},
+        {0x6c6b935b8bbd4000ULL, 0x0000000000000001ULL},
+        {0x56bc75e2d6310000ULL, 0x0000000000000001ULL},
+        {0x4563918244f40000ULL, 0x0000000000000001ULL},
+        {0x6f05b59d3b200000ULL, 0x0000000000000001ULL},
+        {0x58d15e1762800000ULL, 0x0000000000000001ULL},
+        {0x470de4df82000000ULL, 0x0000000000000001ULL},
+        {0x71afd498d0000000ULL, 0x0000000000000001ULL},
+        {0x5af3107a40000000ULL, 0x0000000000000001ULL},
+        {0x48c2739500000000ULL, 0x0000000000000001ULL},
+        {0x746a528800000000ULL, 0x0000000000000001ULL},
+        {0x5d21dba000000000ULL, 0x0000000000000001ULL},
+        {0x4a817c8000000000ULL, 0x0000000000000001ULL},
+        {0x7735940000000000ULL, 0x0000000000000001ULL},
+        {0x5f5e100000000000ULL, 0x0000000000000001ULL},
+        {0x4c4b400000000000ULL, 0x0000000000000001ULL},
+        {0x7a12000000000000ULL, 0x0000000000000001ULL},
+        {0x61a8000000000000ULL, 0x0000000000000001ULL},
+        {0x4e20000000000000ULL, 0x0000000000000001ULL},
+        {0x7d00000000000000ULL, 0x0000000000000001ULL},
+        {0x6400000000000000ULL, 0x0000000000000001ULL},
+        {0x5000000000000000ULL, 0x0000000000000001ULL},
+        {0x4000000000000000ULL, 0x0000000000000001ULL},
+        {0x6666666666666666ULL, 0x3333333333333334ULL},
+        {0x51eb851eb851eb85ULL, 0x0f5c28f5c28f5c29ULL},
+        {0x4189374bc6a7ef9dULL, 0x5916872b020c49bbULL},
+        {0x68db8bac710cb295ULL, 0x74f0d844d013a92bULL},
+        {0x53e2d6238da3c211ULL, 0x43f3e0370cdc8755ULL},
+        {0x431bde82d7b634daULL, 0x698fe69270b06c44ULL},
+        {0x6b5fca6af2bd215eULL, 0x0f4ca41d811a46d4ULL},
+        {0x55e63b88c230e77eULL, 0x3f70834acdae9f10ULL},
+        {0x44b82fa09b5a52cbULL, 0x4c5a02a23e254c0dULL},
+        {0x6df37f675ef6eadfULL, 0x2d5cd10396a21347ULL},
+        {0x57f5ff85e592557fULL, 0x3de3da69454e75d3ULL},
+        {0x465e6604b7a84465ULL, 0x7e4fe1edd10b9175ULL},
+        {0x709709a125da0709ULL, 0x4a19697c81ac1befULL},
+        {0x5a126e1a84ae6c07ULL, 0x54e1213067bce326ULL},
+        {0x480ebe7b9d58566cULL, 0x43e74dc052fd8285ULL},
+        {0x734aca5f6226f0adULL, 0x530baf9a1e626a6dULL},
+        {0x5c3bd5191b525a24ULL, 0x426fbfae7eb521f1ULL},
+        {0x49c97747490eae83ULL, 0x4ebfcc8b9890e7f4ULL},
+        {0x760f253edb4ab0d2ULL, 0x4acc7a78f41b0cbaULL},
+        {0x5e72843249088d75ULL, 0x223d2ec729af3d62ULL},
+        {0x4b8ed0283a6d3df7ULL, 0x34fdbf05baf29781ULL},
+        {0x78e480405d7b9658ULL, 0x54c931a2c4b758cfULL},
+        {0x60b6cd004ac94513ULL, 0x5d6dc14f03c5e0a5ULL},
+        {0x4d5f0a66a23a9da9ULL, 0x31249aa59c9e4d51ULL},
+        {0x7bcb43d769f762a8ULL, 0x4ea0f76f60fd4882ULL},
+        {0x63090312bb2c4eedULL, 0x254d92bf80caa068ULL},
+        {0x4f3a68dbc8f03f24ULL, 0x1dd7a89933d54d20ULL},
+        {0x7ec3daf941806506ULL, 0x62f2a75b86221500ULL},
+        {0x65697bfa9acd1d9fULL, 0x025bb91604e810cdULL},
+        {0x51212ffbaf0a7e18ULL, 0x684960de6a5340a4ULL},
+        {0x40e7599625a1fe7aULL, 0x203ab3e521dc33b6ULL},
+        {0x67d88f56a29cca5dULL, 0x19f7863b696052bdULL},
+        {0x5313a5dee87d6eb0ULL, 0x7b2c6b62bab37564ULL},
+        {0x42761e4bed31255aULL, 0x2f56bc4efbc2c450ULL},
+        {0x6a5696dfe1e83bc3ULL, 0x655793b192d13a1aULL},
+        {0x5512124cb4b9c969ULL, 0x377942f475742e7bULL},
+        {0x440e750a2a2e3abaULL, 0x5f9435905df68b96ULL},
+        {0x6ce3ee76a9e3912aULL, 0x65b9ef4d63241289ULL},
+        {0x571cbec554b60dbbULL, 0x6afb25d782834207ULL},
+        {0x45b0989ddd5e7163ULL, 0x08c8eb12cecf6806ULL},
+        {0x6f80f42fc8971bd1ULL, 0x5adb11b7b14bd9a3ULL},
+        {0x5933f68ca078e30eULL, 0x157c0e2c8dd647b5ULL},
+        {0x475cc53d4d2d8271ULL, 0x5dfcd823a4ab6c91ULL},
+        {0x722e086215159d82ULL, 0x632e269f6ddf141bULL},
+        {0x5b5806b4ddaae468ULL, 0x4f581ee5f17f4349ULL},
+        {0x49133890b1558386ULL, 0x72ace584c1329c3bULL},
+        {0x74eb8db44eef38d7ULL, 0x6aae3c079b842d2aULL},
+        {0x5d893e29d8bf60acULL, 0x5558300616035755ULL},
+        {0x4ad431bb13cc4d56ULL, 0x7779c004de6912abULL},
+        {0x77b9e92b52e07bbeULL, 0x258f99a163db5111ULL},
+        {0x5fc7edbc424d2fcbULL, 0x37a614811caf740dULL},
+        {0x4c9ff163683dbfd5ULL, 0x7951aa00e3bf900bULL},
+        {0x7a998238a6c932efULL, 0x754f7667d2cc19abULL},
+        {0x6214682d523a8f26ULL, 0x2aa5f8530f09ae22ULL},
+        {0x4e76b9bddb620c1eULL, 0x55519375a5a1581bULL},
+        {0x7d8ac2c95f034697ULL, 0x3bb5b8bc3c3559c5ULL},
+        {0x646f023ab2690545ULL, 0x7c9160969691149eULL},
+        {0x5058ce955b87376bULL, 0x16dab3ababa743b2ULL},
+        {0x40470baaaf9f5f88ULL, 0x78aef622efb902f5ULL},
+        {0x66d812aab29898dbULL, 0x0de4bd04b2c19e54ULL},
+        {0x524675555bad4715ULL, 0x57ea30d08f014b76ULL},
+        {0x41d1f7777c8a9f44ULL, 0x4654f3da0c01092cULL},
+        {0x694ff258c7443207ULL, 0x23bb1fc346680eacULL},
+        {0x543ff513d29cf4d2ULL, 0x4fc8e635d1ecd88aULL},
+        {0x43665da9754a5d75ULL, 0x263a51c4a7f0ad3bULL},
+        {0x6bd6fc425543c8bbULL, 0x56c3b607731aaec4ULL},
+        {0x5645969b77696d62ULL, 0x789c919f8f488bd0ULL},
+        {0x4504787c5f878ab5ULL, 0x46e3a7b2d906d640ULL},
+        {0x6e6d8d93cc0c1122ULL, 0x3e390c515b3e239aULL},
+        {0x5857a4763cd6741bULL, 0x4b60d6a77c31b615ULL},
+        {0x46ac8391ca4529afULL, 0x55e7121f968e2b44ULL},
+        {0x711405b6106ea919ULL, 0x0971b698f0e3786dULL},
+        {0x5a766af80d255414ULL, 0x078e2bad8d82c6bdULL},
+        {0x485ebbf9a41ddcdcULL, 0x6c71bc8ad79bd231ULL},
+        {0x73cac65c39c96161ULL, 0x2d82c7448c2c8382ULL},
+        {0x5ca23849c7d44de7ULL, 0x3e023903a356cf9bULL},
+        {0x4a1b603b06437185ULL, 0x7e682d9c82abd949ULL},
+        {0x76923391a39f1c09ULL, 0x4a4048fa6aac8edbULL},
+        {0x5edb5c7482e5b007ULL, 0x55003a61eef07249ULL},
+        {0x4be2b05d35848cd2ULL, 0x773361e7f259f507ULL},
+        {0x796ab3c855a0e151ULL, 0x3eb89ca6508fee71ULL},
+        {0x6122296d114d810dULL, 0x7efa16eb73a6585bULL},
+        {0x4db4edf0daa4673eULL, 0x3261abef8fb846afULL},
+        {0x7c54afe7c43a3ecaULL, 0x1d691318e5f3a44bULL},
+        {0x6376f31fd02e98a1ULL, 0x64540f471e5c836fULL},
+        {0x4f925c1973587a1bULL, 0x0376729f4b7d35f3ULL},
+        {0x7f50935bebc0c35eULL, 0x38bd84321261efebULL},
+        {0x65da0f7cbc9a35e5ULL, 0x13cad0280eb4bfefULL},
+        {0x517b3f96fd482b1dULL, 0x5ca240200bc3ccbfULL},
+        {0x412f66126439bc17ULL, 0x63b50019a3030a33ULL},
+        {0x684bd683d38f9359ULL, 0x1f88002904d1a9eaULL},
+        {0x536fdecfdc72dc47ULL, 0x32d3335403daee55ULL},
+        {0x42bfe57316c249d2ULL, 0x5bdc291003158b77ULL},
+        {0x6acca251be03a951ULL, 0x12f9db4cd1bc1258ULL},
+        {0x557081dafe695440ULL, 0x7594af70a7c9a847ULL},
+        {0x445a017bfebaa9cdULL, 0x4476f2c0863aed06ULL},
+        {0x6d5ccf2ccac442e2ULL, 0x3a57eacda3917b3cULL},
+        {0x577d728a3bd03581ULL, 0x7b7988a482dac8fdULL},
+        {0x45fdf53b630cf79bULL, 0x15fad3b6cf156d97ULL},
+        {0x6ffcbb923814bf5eULL, 0x565e1f8ae4ef15beULL},
+        {0x5996fc74f9aa32b2ULL, 0x11e4e608b725aaffULL},
+        {0x47abfd2a6154f55bULL, 0x27ea51a0928488ccULL},
+        {0x72acc843ceee555eULL, 0x7310829a84074146ULL},
+        {0x5bbd6d030bf1dde5ULL, 0x42739baed005cdd2ULL},
+        {0x49645735a327e4b7ULL, 0x4ec2e2f24004a4a8ULL},
+        {0x756d5855d1d96df2ULL, 0x4ad16b1d333aa10cULL},
+        {0x5df11377db1457f5ULL, 0x2241227dc2954da3ULL},
+        {0x4b2742c648dd132aULL, 0x4e9a81fe35443e1cULL},
+        {0x783ed13d4161b844ULL, 0x175d9cc9eed39694ULL},
+        {0x603240fdcde7c69cULL, 0x7917b0a18bdc7876ULL},
+        {0x4cf500cb0b1fd217ULL, 0x1412f3b46fe39392ULL},
+        {0x7b219ade7832e9beULL, 0x535185ed7fd285b6ULL},
+        {0x628148b1f9c25498ULL, 0x42a79e57997537c5ULL},
+        {0x4ecdd3c1949b76e0ULL, 0x3552e512e12a9304ULL},
+        {0x7e161f9c20f8be33ULL, 0x6eeb081e3510eb39ULL},
+        {0x64de7fb01a609829ULL, 0x3f226ce4f740bc2eULL},
+        {0x50b1ffc0151a1354ULL, 0x3281f0b72c33c9beULL},
+        {0x408e66334414dc43ULL, 0x42018d5f568fd498ULL},
+        {0x674a3d1ed354939fULL, 0x1ccf48988a7fba8dULL},
+        {0x52a1ca7f0f76dc7fULL, 0x30a5d3ad3b99620bULL},
+        {0x421b0865a5f8b065ULL, 0x73b7dc8a96144e6fULL},
+        {0x69c4da3c3cc11a3cULL, 0x52bfc7442353b0b1ULL},
+        {0x549d7b6363cdae96ULL, 0x756639034f7626f4ULL},
+        {0x43b12f82b63e2545ULL, 0x4451c735d92b525dULL},
+        {0x6c4eb26abd303ba2ULL, 0x3a1c71efc1deea2eULL},
+        {0x56a55b889759c94eULL, 0x61b05b2634b254f2ULL},
+        {0x45511606df7b0772ULL, 0x1af37c1e908eaa5bULL},
+        {0x6ee8233e325e7250ULL, 0x2b1f2cfdb41776f8ULL},
+        {0x58b9b5cb5b7ec1d9ULL, 0x6f4c23fe29ac5f2dULL},
+        {0x46faf7d5e2cbce47ULL, 0x72a34ffe87bd18f1ULL},
+        {0x71918c896adfb073ULL, 0x04387ffda5fb5b1bULL},
+        {0x5adad6d4557fc05cULL, 0x0360666484c915afULL},
+        {0x48af1243779966b0ULL, 0x02b3851d3707448cULL},
+        {0x744b506bf28f0ab3ULL, 0x1dec082ebe720746ULL},
+        {0x5d090d2328726ef5ULL, 0x64bcd358985b3905ULL},
+        {0x4a6da41c205b8bf7ULL, 0x6a30a913ad15c738ULL},
+        {0x7715d36033c5acbfULL, 0x5d1aa81f7b560b8cULL},
+        {0x5f44a919c3048a32ULL, 0x7daeece5fc44d609ULL},
+        {0x4c36edae359d3b5bULL, 0x7e258a51969d7808ULL},
+        {0x79f17c49ef61f893ULL, 0x16a276e8f0fbf33fULL},
+        {0x618dfd07f2b4c6dcULL, 0x121b9253f3fcc299ULL},
+        {0x4e0b30d328909f16ULL, 0x41afa84329970214ULL},
+        {0x7cdeb4850db431bdULL, 0x4f7f739ea8f19cedULL},
+        {0x63e55d373e29c164ULL, 0x3f99294bba5ae3f1ULL},
+        {0x4feab0f8fe87cde9ULL, 0x7fadbaa2fb7be98dULL},
+        {0x7fdde7f4ca72e30fULL, 0x7f7c5dd1925fdc15ULL},
+        {0x664b1ff7085be8d9ULL, 0x4c637e4141e649abULL},
+        {0x51d5b32c06afed7aULL, 0x704f983434b83aefULL},
+        {0x4177c2899ef32462ULL, 0x26a6135cf6f9c8bfULL},
+        {0x68bf9da8fe51d3d0ULL, 0x3dd685618b294132ULL},
+        {0x53cc7e20cb74a973ULL, 0x4b12044e08edcdc2ULL},
+        {0x4309fe80a2c3bac2ULL, 0x6f419d0b3a57d7ceULL},
+        {0x6b4330cdd1392ad1ULL, 0x320294dec3bfbfb0ULL},
+        {0x55cf5a3e40fa88a7ULL, 0x419baa4bcfcc995aULL},
+        {0x44a5e1cb672ed3b9ULL, 0x1ae2eea30ca3ade1ULL},
+        {0x6dd636123eb152c1ULL, 0x77d17dd1add2afcfULL},
+        {0x57de91a832277567ULL, 0x797464a7be42263fULL},
+        {0x464ba7b9c1b92ab9ULL, 0x4790508631ce84ffULL},
+        {0x70790c5c6928445cULL, 0x0c1a1a704fb0d4ccULL},
+        {0x59fa7049edb9d049ULL, 0x567b4859d95a43d6ULL},
+        {0x47fb8d07f161736eULL, 0x11fc39e17aae9cabULL},
+        {0x732c14d98235857dULL, 0x032d2968c44a9445ULL},
+        {0x5c2343e134f79dfdULL, 0x4f575453d03ba9d1ULL},
+        {0x49b5cfe75d92e4caULL, 0x72ac4376402fbb0eULL},
+        {0x75efb30bc8eb07abULL, 0x0446d256cd192b49ULL},
+        {0x5e595c096d88d2efULL, 0x1d0575123dadbc3aULL},
+        {0x4b7ab0078ad3dbf2ULL, 0x4a6ac40e97be302fULL},
+        {0x78c44cd8de1fc650ULL, 0x771139b0f2c9e6b1ULL},
+        {0x609d0a4718196b73ULL, 0x78da948d8f07ebc1ULL},
+        {0x4d4a6e9f467abc5cULL, 0x60aedd3e0c065634ULL},
+        {0x7baa4a9870c46094ULL, 0x344afb9679a3bd20ULL},
+        {0x62eea2138d69e6ddULL, 0x103bfc78614fca80ULL},
+        {0x4f254e760abb1f17ULL, 0x26966393810ca200ULL},
+        {0x7ea21723445e9825ULL, 0x2423d2859b476999ULL},
+        {0x654e78e9037ee01dULL, 0x69b642047c392148ULL},
+        {0x510b93ed9c658017ULL, 0x6e2b680396941aa0ULL},
+        {0x40d60ff149eaccdfULL, 0x71bc53361210154dULL},
+        {0x67bce64edcaae166ULL, 0x1c6085235019bbaeULL},
+        {0x52fd850be3bbe784ULL, 0x7d1a041c40149625ULL},
+        {0x42646a6fe9631f9dULL, 0x4a7b367d0010781dULL},
+        {0x6a3a43e642383295ULL, 0x5d91f0c8001a59c8ULL},
+        {0x54fb698501c68edeULL, 0x17a7f3d3334847d4ULL},
+        {0x43fc546a67d20be4ULL, 0x79532975c2a03976ULL},
+        {0x6cc6ed770c83463bULL, 0x0eeb75893766c256ULL},
+        {0x57058ac5a39c382fULL, 0x25892ad42c523512ULL},
+        {0x459e089e1c7cf9bfULL, 0x37a0ef102374f742ULL},
+        {0x6f6340fcfa618f98ULL, 0x59017e8038bb2536ULL},
+        {0x591c33fd951ad946ULL, 0x7a67986693c8ea91ULL},
+        {0x4749c33144157a9fULL, 0x151fad1edca0bba8ULL},
+        {0x720f9eb539bbf765ULL, 0x0832ae97c76792a5ULL},
+        {0x5b3fb22a94965f84ULL, 0x068ef21305ec7551ULL},
+        {0x48ffc1bbaa11e603ULL, 0x1ed8c1a8d189f774ULL},
+        {0x74cc692c434fd66bULL, 0x4af4690e1c0ff253ULL},
+        {0x5d705423690cab89ULL, 0x225d20d816732843ULL},
+        {0x4ac0434f873d5607ULL, 0x35174d79ab8f5369ULL},
+        {0x779a054c0b955672ULL, 0x21bee25c45b21f0eULL},
+        {0x5fae6aa33c77785bULL, 0x3498b5169e2818d8ULL},
+        {0x4c8b888296c5f9e2ULL, 0x5d46f7454b534713ULL},
+        {0x7a78da6a8ad65c9dULL, 0x7ba4bed545520b52ULL},
+        {0x61fa48553bdeb07eULL, 0x2fb6ff110441a2a8ULL},
+        {0x4e61d37763188d31ULL, 0x72f8cc0d9d014eedULL},
+        {0x7d6952589e8daeb6ULL, 0x1e5ae015c80217e1ULL},
+        {0x645441e07ed7bef8ULL, 0x1848b344a001acb4ULL},
+        {0x504367e6cbdfcbf9ULL, 0x603a2903b3348a2aULL},
+        {0x4035ecb8a3196ffbULL, 0x002e873628f6d4eeULL},
+        {0x66bcadf43828b32bULL, 0x19e40b89db2487e3ULL},
+        {0x52308b29c686f5bcULL, 0x14b66fa17c1d3983ULL},
+        {0x41c06f549ed25e30ULL, 0x1091f2e7967dc79cULL},
+        {0x6933e554315096b3ULL, 0x341cb7d8f0c93f5fULL},
+        {0x542984435aa6def5ULL, 0x767d5fe0c0a0ff80ULL},
+        {0x435469cf7bb8b25eULL, 0x2b977fe70080cc66ULL},
+        {0x6bba42e592c11d63ULL, 0x5f58cca4cd9ae0a3ULL},
+        {0x562e9beadbcdb11cULL, 0x4c470a1d7148b3b6ULL},
+        {0x44f216557ca48db0ULL, 0x3d05a1b1276d5c92ULL},
+        {0x6e5023bbfaa0e2b3ULL, 0x7b3c35e83f1560e9ULL},
+        {0x58401c96621a4ef6ULL, 0x2f635e5365aab3edULL},
+        {0x4699b0784e7b725eULL, 0x591c4b75eaeef658ULL},
+        {0x70f5e726e3f8b6fdULL, 0x74fa125644b18a26ULL},
+        {0x5a5e5285832d5f31ULL, 0x43fb41de9d5ad4ebULL},
+        {0x484b75379c244c27ULL, 0x4ffc34b2177bdd89ULL},
+        {0x73abeebf603a1372ULL, 0x4cc6bab68bf96274ULL},
+        {0x5c898bcc4cfb42c2ULL, 0x0a38955ed6611b90ULL},
+        {0x4a07a309d72f689bULL, 0x21c6dde5784dafa7ULL},
+        {0x76729e762518a75eULL, 0x693e2fd58d49190bULL},
+        {0x5ec2185e8413b918ULL, 0x5431bfde0aa0e0d5ULL},
+        {0x4bce79e536762dadULL, 0x29c1664b3bb3e711ULL},
+        {0x794a5ca1f0bd15e2ULL, 0x0f9bd6dec5eca4e8ULL},
+        {0x61084a1b26fdab1bULL, 0x2616457f04bd50baULL},
+        {0x4da03b48ebfe227cULL, 0x1e783798d09773c8ULL},
+        {0x7c33920e46636a60ULL, 0x30c058f480f252d9ULL},
+        {0x635c74d8384f884dULL, 0x0d66ad9067284247ULL},
+        {0x4f7d2a469372d370ULL, 0x711ef14052869b6cULL},
+        {0x7f2eaa0a85848581ULL, 0x34fe4ecd50d75f14ULL},
+        {0x65beee6ed136d134ULL, 0x2a650bd773df7f43ULL},
+        {0x51658b8bda9240f6ULL, 0x551da312c319329cULL},
+        {0x411e093caedb672bULL, 0x5db14f4235adc217ULL},
+        {0x68300ec77e2bd845ULL, 0x7c4ee536bc49368aULL},
+        {0x5359a56c64efe037ULL, 0x7d0bea92303a9208ULL},
+        {0x42ae1df050bfe693ULL, 0x173cbba8269541a0ULL},
+        {0x6ab02fe6e79970ebULL, 0x3ec792a6a422029aULL},
+        {0x5559bfebec7ac0bcULL, 0x3239421ee9b4cee1ULL},
+        {0x4447ccbcbd2f0096ULL, 0x5b6101b25490a581ULL},
+        {0x6d3fadfac84b3424ULL, 0x2bce691d541aa268ULL},
+        {0x576624c8a03c29b6ULL, 0x563eba7ddce21b87ULL},
+        {0x45eb50a08030215eULL, 0x78322ecb171b4939ULL},
+        {0x6fdee76733803564ULL, 0x59e9e47824f87527ULL},
+        {0x597f1f85c2ccf783ULL, 0x6187e9f9b72d2a86ULL},
+        {0x4798e6049bd72c69ULL, 0x346cbb2e2c242205ULL},
+        {0x728e3cd42c8b7a42ULL, 0x20adf849e039d007ULL},
+        {0x5ba4fd768a092e9bULL, 0x33be603b19c7d99fULL},
+        {0x4950cac53b3a8bafULL, 0x42feb3627b0647b3ULL},
+        {0x754e113b91f745e5ULL, 0x5197856a5e7072b8ULL},
+        {0x5dd80dc941929e51ULL, 0x27ac6abb7ec05bc6ULL},
+        {0x4b133e3a9adbb1daULL, 0x52f05562cbcd1638ULL},
+        {0x781ec9f75e2c4fc4ULL, 0x1e4d556adfae89f3ULL},
+        {0x6018a192b1bd0c9cULL, 0x7ea444557fbed4c3ULL},
+        {0x4ce0814227ca707dULL, 0x4bb69d1132ff109cULL},
+        {0x7b00ced03faa4d95ULL, 0x5f8a94e851981a93ULL},
+        {0x62670bd9cc883e11ULL, 0x32d543ed0e134875ULL},
+        {0x4eb8d647d6d364daULL, 0x5bddcff0d80f6d2bULL},
+        {0x7df48a0c8aebd491ULL, 0x12fc7fe7c018aeabULL},
+        {0x64c3a1a3a25643a7ULL, 0x28c9ffec99ad5889ULL},
+        {0x509c814fb511cfb9ULL, 0x0707fff07af113a1ULL},
+        {0x407d343fc40e3fc7ULL, 0x1f39998d2f2742e7ULL},
+        {0x672eb9ffa016cc71ULL, 0x7ec28f484b7204a4ULL},
+        {0x528bc7ffb345705bULL, 0x189ba5d36f8e6a1dULL},
+        {0x42096ccc8f6ac048ULL, 0x7a161e42bfa521b1ULL},
+        {0x69a8ae1418aacd41ULL, 0x435696d132a1cf81ULL},
+        {0x5486f1a9ad557101ULL, 0x1c454574288172ceULL},
+        {0x439f27baf1112734ULL, 0x169dd129ba0128a5ULL},
+        {0x6c31d92b1b4ea520ULL, 0x242fb50f9001daa1ULL},
+        {0x568e4755af721db3ULL, 0x368c90d940017bb4ULL},
+        {0x453e9f77bf8e7e29ULL, 0x120a0d7a999ac95dULL},
+        {0x6eca98bf98e3fd0eULL, 0x50101590f5c47561ULL},
+        {0x58a213cc7a4ffda5ULL, 0x26734473f7d05de8ULL},
+        {0x46e80fd6c83ffe1dULL, 0x6b8f69f65fd9e4b9ULL},
+        {0x71734c8ad9fffcfcULL, 0x45b24323cc8fd45cULL},
+        {0x5ac2a3a247fffd96ULL, 0x6af502830a0ca9e3ULL},
+        {0x489bb61b6ccccadfULL, 0x08c402026e7087e9ULL},
+        {0x742c569247ae1164ULL, 0x746cd003e3e73fdbULL},
+        {0x5cf04541d2f1a783ULL, 0x76bd73364fec3315ULL},
+        {0x4a59d101758e1f9cULL, 0x5efdf5c50cbcf5abULL},
+        {0x76f61b3588e365c7ULL, 0x4b2fefa1adfb22abULL},
+        {0x5f2b48f7a0b5eb06ULL, 0x08f3261af195b555ULL},
+        {0x4c22a0c61a2b226bULL, 0x20c284e25ade2aabULL},
+        {0x79d1013cf6ab6a45ULL, 0x1ad0d49d5e304444ULL},
+        {0x617400fd9222bb6aULL, 0x48a7107de4f369d0ULL},
+        {0x4df6673141b562bbULL, 0x53b8d9fe50c2bb0dULL},
+        {0x7cbd71e869223792ULL, 0x52c15cca1ad12b48ULL},
+        {0x63cac186ba81c60eULL, 0x75677d6e7bda8906ULL},
+        {0x4fd5679efb9b04d8ULL, 0x5dec645863153a6cULL},
+        {0x7fbbd8fe5f5e6e27ULL, 0x497a3a2704eec3dfULL}
+    };
+
+    /**
+     * @brief Computes floor(log10(2^q)) for q in [-1126, 1126] without floating point
+     * @param q Binary exponent
+     * @return Decimal exponent
+     */
+    inline int floorLog10Pow2(const int q) {
+        return static_cast<int>((q * 661971961083LL) >> 41);
+    }
+
+    /**
+     * @brief Computes floor(log10(3/4 * 2^q)) for q in [-1126, 1126] without floating point
+     * @param q Binary exponent
+     * @return Decimal exponent
+     */
+    inline int floorLog10ThreeQuartersPow2(const int q) {
+        return static_cast<int>((q * 661971961083LL - 274743187321LL) >> 41);
+    }
+
+    /**
+     * @brief Computes floor(log2(10^e)) for e in [-1233, 1233] without floating point
+     * @param e Decimal exponent
+     * @return Binary exponent
+     */
+    inline int floorLog2Pow10(const int e) {
+        return static_cast<int>((e * 913124641741LL) >> 38);
+    }
+
+    /**
+     * @brief Multiplies a scaled power of ten by a number, rounding the 64-bit result to odd
+     * @param power Row of ScaledPowersOfTen
+     * @param factor Number below 2^63 to multiply by
+     * @return Upper bits of the product, with the lowest bit set if any dropped bit was set
+     */
+    inline uint64_t multiplyRoundToOdd(const uint64_t* power, const uint64_t factor) {
+        const uint64_t mask = (1ULL << 63) - 1;
+        const uint64_t lowProduct = multiply(power[1], factor).high;
+        const Product highProduct = multiply(power[0], factor);
+        const uint64_t middle = (highProduct.low >> 1) + lowProduct;
+        const uint64_t upper = highProduct.high + (middle >> 63);
+
+        return upper | (((middle & mask) + mask) >> 63);
+    }
+
+    /**
+     * @brief Finds the shortest decimal closest to c * 2^q using the Schubfach algorithm
+     * @param q Binary exponent of the double
+     * @param c Binary significand of the double, possibly scaled by 10 for the tiniest subnormals
+     * @param exponentCorrection Amount added to the decimal exponent to undo the scaling of c
+     * @param significand Receives the decimal significand
+     * @param exponent Receives the power of ten the decimal significand is scaled by
+     */
+    void toShortestDecimal(const int q, const uint64_t c, const int exponentCorrection, uint64_t& significand, int& exponent) {
+        const uint64_t isOdd = c & 1;
+        const uint64_t scaled = c << 2;
+        const uint64_t upper = scaled + 2;
+        uint64_t lower;
+        int k;
+
+        // The gap below a power of two is half the gap above it, except at the smallest exponent
+        if(c != (1ULL << MantissaBits) || q == -1074) {
+            lower = scaled - 2;
+            k = floorLog10Pow2(q);
+        } else {
+            lower = scaled - 1;
+            k = floorLog10ThreeQuartersPow2(q);
+        }
+
+        const int shift = q + floorLog2Pow10(-k) + 2;
+        const uint64_t* power = ScaledPowersOfTen[k - SmallestShortestPowerOfTen];
+        const uint64_t value = multiplyRoundToOdd(power, scaled << shift);
+        const uint64_t lowerBound = multiplyRoundToOdd(power, lower << shift);
+        const uint64_t upperBound = multiplyRoundToOdd(power, upper << shift);
+        const uint64_t candidate = value >> 2;
+
+        exponent = k + exponentCorrection;
+
+        // A multiple of ten inside the rounding interval has one digit less than any other candidate. Only the
+        // wide intervals of the smallest subnormals can hold both, then the closer one is taken
+        if(candidate >= 10) {
+            const uint64_t below = candidate / 10 * 10;
+            const uint64_t above = below + 10;
+            const bool isBelowInside = lowerBound + isOdd <= below << 2;
+            const bool isAboveInside = (above << 2) + isOdd <= upperBound;
+
+            if(isBelowInside != isAboveInside) {
+                significand = isBelowInside ? below : above;
+                return;
+            }
+
+            if(isBelowInside) {
+                const int64_t comparison = static_cast<int64_t>(value - ((below + above) << 1));
+                significand = comparison < 0 || (comparison == 0 && (below / 10 & 1) == 0) ? below : above;
+                return;
+            }
+        }
+
+        const uint64_t next = candidate + 1;
+        const bool isCandidateInside = lowerBound + isOdd <= candidate << 2;
+        const bool isNextInside = (next << 2) + isOdd <= upperBound;
+
+        if(isCandidateInside != isNextInside) {
+            significand = isCandidateInside ? candidate : next;
+            return;
+        }
+
+        // Both are inside: take the closer one, the even one on a tie
+        const int64_t comparison = static_cast<int64_t>(value - ((candidate + next) << 1));
+        significand = comparison < 0 || (comparison == 0 && (candidate & 1) == 0) ? candidate : next;
+    }
+
+    /**
+     * @brief Writes the shortest decimal that reads back as a finite double, laid out like %.15g
+     * @param value Double to write
+     * @param buffer Buffer of at least MaxTextLength characters to write to
+     * @return Number of characters written
+     */
+    size_t writeShortest(const double value, char* buffer) {
+        uint64_t bits;
+        std::memcpy(&bits, &value, sizeof(bits));
+
+        char* current = buffer;
+
+        if(bits >> 63) {
+            *current++ = '-';
+        }
+
+        const uint64_t mantissa = bits & ((1ULL << MantissaBits) - 1);
+        const int biasedExponent = static_cast<int>((bits >> MantissaBits) & InfiniteExponent);
+        uint64_t significand = 0;
+        int exponent = 0;
+
+        if(biasedExponent == 0 && mantissa == 0) {
+            *current++ = '0';
+            return static_cast<size_t>(current - buffer);
+        }
+
+        if(biasedExponent != 0) {
+            const int shift = 1075 - biasedExponent;
+            const uint64_t c = (1ULL << MantissaBits) | mantissa;
+
+            // Integers below 2^53 are their own shortest decimal
+            if(shift > 0 && shift <= MantissaBits && ((c >> shift) << shift) == c) {
+                significand = c >> shift;
+            } else {
+                toShortestDecimal(-shift, c, 0, significand, exponent);
+            }
+        } else {
+            // The two smallest subnormals need an extra digit of precision to be told apart
+            if(mantissa < 3) {
+                toShortestDecimal(-1074, mantissa * 10, -1, significand, exponent);
+            } else {
+                toShortestDecimal(-1074, mantissa, 0, significand, exponent);
+            }
+        }
+
+        while(significand % 10 == 0) {
+            significand /= 10;
+            exponent++;
+        }
+
+        char digits[20];
+        const int count = static_cast<int>(writeDigits(significand, digits));
+        const int decimalExponent = exponent + count - 1;
+
+        if(decimalExponent < SmallestFixedExponent || decimalExponent >= LargestFixedExponent) {
+            *current++ = digits[0];
+
+            if(count > 1) {
+                *current++ = '.';
+                std::memcpy(current, digits + 1, count - 1);
+                current += count - 1;
+            }
+
+            *current++ = 'e';
+            *current++ = decimalExponent < 0 ? '-' : '+';
+
+            const int magnitude = decimalExponent < 0 ? -decimalExponent : decimalExponent;
+
+            if(magnitude < 10) {
+                *current++ = '0';
+            }
+
+            return static_cast<size_t>(current - buffer) + writeDigits(static_cast<uint64_t>(magnitude), current);
+        }
+
+        if(decimalExponent < 0) {
+            *current++ = '0';
+            *current++ = '.';
+            std::memset(current, '0', -decimalExponent - 1);
+            current += -decimalExponent - 1;
+            std::memcpy(current, digits, count);
+            current += count;
+        } else if(decimalExponent >= count - 1) {
+            std::memcpy(current, digits, count);
+            current += count;
+            std::memset(current, '0', decimalExponent - count + 1);
+            current += decimalExponent - count + 1;
+        } else {
+            std::memcpy(current, digits, decimalExponent + 1);
+            current += decimalExponent + 1;
+            *current++ = '.';
+            std::memcpy(current, digits + decimalExponent + 1, count - decimalExponent - 1);
+            current += count - decimalExponent - 1;
+        }
+
+        return static_cast<size_t>(current - buffer);
+    }
+}
+
+/**
+ * @brief Converts a number token to a 64-bit integer if it fits, to the nearest double otherwise
+ * @param data Pointer to the first character of the token
+ * @param length Number of characters in the token
+ * @return Binary value of the token
+ */
+NumberValue JsonNumberConverter::parse(const char* data, const size_t length) {
+    NumberValue result;
+    result.type = NumberType::Double;
+    result.floating = 0;
+    result.isTextNeeded = true;
+
+    const char* end = data + length;
+    const char* current = data;
+    const bool isNegative = current < end && *current == '-';
+
+    if(isNegative) {
+        current++;
+    }
+
+    const char* integerStart = current;
+    const char* integerEnd = skipDigits(integerStart, end);
+    const char* fractionStart = integerEnd;
+    const char* fractionEnd = integerEnd;
+    bool hasFraction = false;
+    bool hasExponent = false;
+    bool isMalformed = integerStart == integerEnd;
+    int64_t explicitExponent = 0;
+    current = integerEnd;
+
+    if(current < end && *current == '.') {
+        hasFraction = true;
+        fractionStart = current + 1;
+        fractionEnd = skipDigits(fractionStart, end);
+        isMalformed = isMalformed || fractionStart == fractionEnd;
+        current = fractionEnd;
+    }
+
+    if(current < end && (*current == 'e' || *current == 'E')) {
+        hasExponent = true;
+        current++;
+
+        const bool isExponentNegative = current < end && *current == '-';
+
+        if(current < end && (*current == '-' || *current == '+')) {
+            current++;
+        }
+
+        const char* exponentStart = current;
+
+        for(; current < end && JsonGrammar::isDigit(*current); current++) {
+            // Larger exponents over- or underflow anyway, clamping keeps the arithmetic below from overflowing
+            if(explicitExponent < 0x10000000) {
+                explicitExponent = explicitExponent * 10 + (*current - '0');
+            }
+        }
+
+        isMalformed = isMalformed || exponentStart == current;
+        explicitExponent = isExponentNegative ? -explicitExponent : explicitExponent;
+    }
+
+    if(isMalformed || current != end) {
+        result.floating = std::strtod(std::string(data, length).c_str(), nullptr);
+        return result;
+    }
+
+    const bool hasLeadingZero = *integerStart == '0' && integerEnd - integerStart > 1;
+
+    if(!hasFraction && !hasExponent) {
+        uint64_t magnitude = 0;
+        bool isOverflow = false;
+
+        for(const char* digit = integerStart; digit < integerEnd && !isOverflow; digit++) {
+            const uint64_t value = static_cast<uint64_t>(*digit - '0');
+            isOverflow = magnitude > (UINT64_MAX - value) / 10;
+            magnitude = magnitude * 10 + value;
+        }
+
+        if(!isOverflow && !isNegative) {
+            if(magnitude <= static_cast<uint64_t>(INT64_MAX)) {
+                result.type = NumberType::Integer;
+                result.integer = static_cast<int64_t>(magnitude);
+            } else {
+                result.type = NumberType::UnsignedInteger;
+                result.unsignedInteger = magnitude;
+            }
+
+            result.isTextNeeded = hasLeadingZero;
+            return result;
+        }
+
+        // -0 is kept as a double so its sign survives
+        if(!isOverflow && magnitude != 0 && magnitude <= (1ULL << 63)) {
+            result.type = NumberType::Integer;
+            result.integer = magnitude == (1ULL << 63) ? INT64_MIN : -static_cast<int64_t>(magnitude);
+            result.isTextNeeded = hasLeadingZero;
+            return result;
+        }
+    }
+
+    uint64_t significand = 0;
+    int significantDigits = 0;
+    int64_t droppedDigits = 0;
+    bool isTruncated = false;
+    const char* ranges[2][2] = {{integerStart, integerEnd}, {fractionStart, fractionEnd}};
+
+    for(const auto& range : ranges) {
+        for(const char* digit = range[0]; digit < range[1]; digit++) {
+            const int value = *digit - '0';
+
+            if(significantDigits == 0 && value == 0) {
+                continue;
+            }
+
+            if(significantDigits < MaxSignificandDigits) {
+                significand = significand * 10 + static_cast<uint64_t>(value);
+                significantDigits++;
+            } else {
+                droppedDigits++;
+                isTruncated = isTruncated || value != 0;
+            }
+        }
+    }
+
+    const int64_t exponent = explicitExponent - (fractionEnd - fractionStart) + droppedDigits;
+    result.floating = toDouble(significand, exponent, isTruncated, isNegative, data, length);
+
+    // The token can be dropped when format prints it back unchanged: a token of up to 15 significant digits is
+    // the shortest decimal of its double, and format strips trailing fractional zeros and uses fixed notation
+    // for decimal exponents in [SmallestFixedExponent, LargestFixedExponent)
+    if(hasFraction && !hasExponent && !hasLeadingZero && significand != 0 && significantDigits + droppedDigits <= MaxExactDigits
+       && *(fractionEnd - 1) != '0') {
+        int64_t decimalExponent = integerEnd - integerStart - 1;
+
+        if(*integerStart == '0') {
+            decimalExponent = -1;
+
+            for(const char* digit = fractionStart; *digit == '0'; digit++) {
+                decimalExponent--;
+            }
+        }
+
+        result.isTextNeeded = decimalExponent < SmallestFixedExponent || decimalExponent >= LargestFixedExponent;
+    }
+
+    return result;
+}
+
+/**
+ * @brief Writes the shortest text that reads back as a binary value, null for infinities and NaN
+ * @param value Binary value with isTextNeeded false
+ * @param buffer Buffer of at least MaxTextLength characters to write to
+ * @return Number of characters written
+ */
+size_t JsonNumberConverter::format(const NumberValue& value, char* buffer) {
+    switch(value.type) {
+        case NumberType::Integer:
+            if(value.integer < 0) {
+                buffer[0] = '-';
+                return 1 + writeDigits(0 - static_cast<uint64_t>(value.integer), buffer + 1);
+            }
+
+            return writeDigits(static_cast<uint64_t>(value.integer), buffer);
+        case NumberType::UnsignedInteger:
+            return writeDigits(value.unsignedInteger, buffer);
+        case NumberType::Double:
+        default:
+            if(!std::isfinite(value.floating)) {
+                std::memcpy(buffer, "null", 4);
+                return 4;
+            }
+
+            return writeShortest(value.floating, buffer);
+    }
+}
+
+/**
+ * @brief Converts a decimal significand and exponent to the nearest double
+ * @param significand Up to 19 leading significant digits of the number
+ * @param exponent Power of ten the significand is scaled by
+ * @param isTruncated Whether nonzero digits after the first 19 were dropped from the significand
+ * @param isNegative Whether the number has a minus sign
+ * @param data Pointer to the first character of the token, used by the fallback
+ * @param length Number of characters in the token
+ * @return Nearest double
+ */
+double JsonNumberConverter::toDouble(const uint64_t significand, const int64_t exponent, const bool isTruncated, const bool isNegative,
+                                     const char* data, const size_t length) {
+    double result = 0;
+
+#if defined(FLT_EVAL_METHOD) && FLT_EVAL_METHOD == 0
+    if(!isTruncated && exponent >= -22 && exponent <= 22 && significand <= (1ULL << 53)) {
+        // Both operands are exact doubles, so the single rounding of the operation is correct
+        result = static_cast<double>(significand);
+        result = exponent < 0 ? result / ExactPowersOfTen[-exponent] : result * ExactPowersOfTen[exponent];
+
+        return isNegative ? -result : result;
+    }
+#endif
+
+    const uint64_t bits = computeDouble(significand, exponent);
+
+    // The dropped digits put the exact value between w and w + 1; if both round the same way so does the value
+    if(isTruncated && computeDouble(significand + 1, exponent) != bits) {
+        return std::strtod(std::string(data, length).c_str(), nullptr);
+    }
+
+    std::memcpy(&result, &bits, sizeof(result));
+
+    return isNegative ? -result : result;
+}
\ No newline at end of file
@@ -0,0 +1,341 @@
+#include <algorithm>
+#include <atomic>
+#include <cctype>
+#include <functional>
+#include <stdexcept>
+#include <system_error>
+#include <thread>
+#include "JsonParallelParser.hpp"
+#include "JsonArena.hpp"
+#include "JsonArray.hpp"
+
+/**
+ * @brief Anonymous namespace for the pieces shared between the calling thread and the workers
+ */
+namespace {
+    /**
+     * @brief Number of characters below which a document is parsed on the calling thread alone
+     */
+    const size_t MinimumDocumentSize = 1024 * 1024;
+
+    /**
+     * @brief Number of characters below which an array or object is never split further
+     */
+    const size_t MinimumPieceSize = 64 * 1024;
+
+    /**
+     * @brief Number of pieces per thread a document is split into, so threads finishing early can take more
+     */
+    const size_t PiecesPerThread = 8;
+
+    /**
+     * @brief Pieces of a document handed out to the threads, largest first
+     */
+    struct PieceQueue {
+        const char* data;                          ///< First character of the document
+        const std::vector<UnparsedValue>& pieces;  ///< Unparsed values to parse in full
+        std::atomic<size_t> next;                  ///< Position of the next piece not taken by a thread
+        std::atomic<bool> isFailed;                ///< Whether any piece was invalid
+
+        /**
+         * @brief Constructs a queue of no piece taken
+         * @param _data First character of the document
+         * @param _pieces Unparsed values to parse in full
+         */
+        PieceQueue(const char* _data, const std::vector<UnparsedValue>& _pieces) : data(_data), pieces(_pieces), next(0), isFailed(false) {}
+    };
+
+    /**
+     * @brief Parser stacks of the current thread, kept between the many small pieces it parses
+     */
+    thread_local ParserScratch scratch;
+
+    /**
+     * @brief Checks if a character is whitespace
+     * @param symbol Character to check
+     * @return True if the character is whitespace, false otherwise
+     */
+    inline bool isWhitespace(const char symbol) {
+        return isspace(static_cast<unsigned char>(symbol)) != 0;
+    }
+
+    /**
+     * @brief Checks whether brackets are nested deeper than the parser allows anywhere in a document
+     * @param data First character of the document
+     * @param index Structural index of the document
+     * @param maxDepth Maximum number of arrays and objects enclosing each other
+     * @return True if the nesting is deeper than maxDepth, false otherwise
+     */
+    bool isTooDeep(const char* data, const StructuralIndex& index, const size_t maxDepth) {
+        size_t depth = 0;
+
+        for(const uint32_t offset : index.structurals) {
+            const char symbol = data[offset];
+
+            if(symbol == '{' || symbol == '[') {
+                if(++depth > maxDepth) {
+                    return true;
+                }
+            } else if((symbol == '}' || symbol == ']') && depth > 0) {
+                depth--;
+            }
+        }
+
+        return false;
+    }
+
+    /**
+     * @brief Parses an unparsed array or object through its own load, so it forgets its span
+     * @param data First character of the document
+     * @param piece Unparsed value to parse
+     * @throws std::runtime_error if the value is invalid
+     */
+    void loadPiece(const char* data, const UnparsedValue& piece) {
+        if(data[piece.span.begin] == '[') {
+            static_cast<JsonArray*>(piece.value) -> load();
+        } else {
+            static_cast<JsonObject*>(piece.value) -> load();
+        }
+    }
+
+    /**
+     * @brief Takes pieces until none are left or any piece was invalid
+     * @param queue Queue to take the pieces from
+     */
+    void drain(PieceQueue& queue) {
+        while(!queue.isFailed) {
+            const size_t position = queue.next++;
+
+            if(position >= queue.pieces.size()) {
+                return;
+            }
+
+            try {
+                loadPiece(queue.data, queue.pieces[position]);
+            }
+            catch(...) {
+                queue.isFailed = true;
+            }
+        }
+    }
+
+    /**
+     * @brief Worker loop, allocating the parsed values from its own arena when one is given
+     * @param queue Queue to take the pieces from
+     * @param arena Arena of the worker, nullptr to allocate from the heap
+     */
+    void work(PieceQueue& queue, JsonArena* arena) {
+        if(arena == nullptr) {
+            drain(queue);
+            return;
+        }
+
+        JsonArena::Scope scope(*arena);
+        drain(queue);
+    }
+}
+
+/**
+ * @brief Constructs a parser
+ * @param _threadCount Number of threads parsing a document including the calling one, 0 to use one per hardware thread
+ * @param _isBorrowing Whether string values refer to the document instead of copying it; it must then outlive them
+ * @param _maxDepth Maximum number of arrays and objects enclosing each other
+ */
+JsonParallelParser::JsonParallelParser(const size_t _threadCount, const bool _isBorrowing, const size_t _maxDepth)
+    : threadCount(_threadCount), isBorrowing(_isBorrowing), maxDepth(_maxDepth), pieceCount(0), data(nullptr), length(0), pending(nullptr) {
+    if(threadCount == 0) {
+        threadCount = std::thread::hardware_concurrency();
+    }
+
+    if(threadCount == 0) {
+        threadCount = 1;
+    }
+}
+
+/**
+ * @brief Parses JSON content from a contiguous buffer on several threads, validating it
+ * @param _data Pointer to the first character of the JSON text
+ * @param _length Number of characters in the buffer
+ * @return Pointer to the parsed JsonValue
+ * @throws std::runtime_error if the JSON is invalid
+ */
+JsonValue* JsonParallelParser::parse(const char* _data, const size_t _length) {
+    size_t begin = 0, end = _length;
+
+    while(begin < end && isWhitespace(_data[begin])) {
+        begin++;
+    }
+
+    while(end > begin && isWhitespace(_data[end - 1])) {
+        end--;
+    }
+
+    pieceCount = 0;
+
+    const bool isSplittable = threadCount > 1 && _length >= MinimumDocumentSize && begin < end &&
+                              (_data[begin] == '{' || _data[begin] == '[') && JsonStructuralIndexer::canIndex(_length);
+
+    if(!isSplittable) {
+        return JsonParser::parseValidated(_data, _length, isBorrowing, maxDepth);
+    }
+
+    data = _data;
+    length = _length;
+    JsonStructuralIndexer::index(data, length, index);
+
+    if(isTooDeep(data, index, maxDepth)) {
+        std::vector<uint32_t>().swap(index.structurals);
+        std::vector<uint32_t>().swap(index.specials);
+
+        return JsonParser::parseValidated(data, length, isBorrowing, maxDepth);
+    }
+
+    const size_t pieceSize = std::max(MinimumPieceSize, length / (threadCount * PiecesPerThread));
+    std::vector<UnparsedValue> found;
+    std::vector<UnparsedValue> pieces;
+    JsonValue* value = nullptr;
+    bool isValid = true;
+
+    pending = &found;
+
+    try {
+        value = parseValue(begin, end);
+
+        while(!found.empty()) {
+            const UnparsedValue piece = found.back();
+            found.pop_back();
+
+            if(piece.span.end - piece.span.begin > pieceSize) {
+                loadPiece(data, piece);
+            } else {
+                pieces.push_back(piece);
+            }
+        }
+    }
+    catch(const std::runtime_error&) {
+        isValid = false;
+    }
+    catch(...) {
+        pending = nullptr;
+        delete value;
+        throw;
+    }
+
+    pending = nullptr;
+
+    if(isValid) {
+        std::sort(pieces.begin(), pieces.end(), [](const UnparsedValue& left, const UnparsedValue& right) {
+            return left.span.end - left.span.begin > right.span.end - right.span.begin;
+        });
+
+        isValid = parsePieces(pieces);
+    }
+
+    std::vector<uint32_t>().swap(index.structurals);
+    std::vector<uint32_t>().swap(index.specials);
+
+    if(!isValid) {
+        delete value;
+        return JsonParser::parseValidated(data, length, isBorrowing, maxDepth);
+    }
+
+    pieceCount = pieces.size();
+
+    return value;
+}
+
+/**
+ * @brief Gets the number of threads parsing a document
+ * @return Number of threads, including the calling one
+ */
+size_t JsonParallelParser::getThreadCount() const {
+    return threadCount;
+}
+
+/**
+ * @brief Gets the number of pieces the last document was split into
+ * @return Number of pieces parsed by the threads, 0 if the document was parsed on the calling thread alone
+ */
+size_t JsonParallelParser::getPieceCount() const {
+    return pieceCount;
+}
+
+/**
+ * @brief Parses the elements of an array by moving them out of a freshly parsed array
+ * @param array Array to fill
+ * @param begin Offset of the opening bracket in the document
+ * @param end Offset one past the closing bracket
+ * @throws std::runtime_error if the array is invalid
+ */
+void JsonParallelParser::load(JsonArray& array, const size_t begin, const size_t end) {
+    JsonValue* value = parseValue(begin, end);
+
+    array = std::move(static_cast<JsonArray&>(*value));
+
+    delete value;
+}
+
+/**
+ * @brief Parses the key-value pairs of an object by moving them out of a freshly parsed object
+ * @param object Object to fill
+ * @param begin Offset of the opening brace in the document
+ * @param end Offset one past the closing brace
+ * @throws std::runtime_error if the object is invalid
+ */
+void JsonParallelParser::load(JsonObject& object, const size_t begin, const size_t end) {
+    JsonValue* value = parseValue(begin, end);
+
+    object = std::move(static_cast<JsonObject&>(*value));
+
+    delete value;
+}
+
+/**
+ * @brief Parses one array or object of the document, one level deep while splitting and in full otherwise
+ * @param begin Offset of the opening brace/bracket
+ * @param end Offset one past the closing brace/bracket
+ * @return Pointer to the parsed JsonArray or JsonObject
+ * @throws std::runtime_error if the value is invalid
+ */
+JsonValue* JsonParallelParser::parseValue(const size_t begin, const size_t end) {
+    return JsonParser::parseIndexed(data, length, index, begin, end, pending != nullptr ? this : nullptr, pending, isBorrowing, maxDepth, scratch);
+}
+
+/**
+ * @brief Parses the pieces of the document on the worker threads and the calling thread
+ * @param pieces Unparsed values to parse in full, largest first
+ * @return True if every piece was parsed, false if any was invalid
+ */
+bool JsonParallelParser::parsePieces(const std::vector<UnparsedValue>& pieces) {
+    if(pieces.empty()) {
+        return true;
+    }
+
+    JsonArena* arena = JsonArena::getActive();
+    const size_t workerCount = std::min(threadCount, pieces.size()) - 1;
+
+    PieceQueue queue(data, pieces);
+    std::vector<JsonArena> arenas(arena != nullptr ? workerCount : 0);
+    std::vector<std::thread> workers;
+
+    for(size_t i = 0; i < workerCount; i++) {
+        try {
+            workers.push_back(std::thread(work, std::ref(queue), arena != nullptr ? &arenas[i] : nullptr));
+        }
+        catch(const std::system_error&) {
+            break;
+        }
+    }
+
+    drain(queue);
+
+    for(std::thread& worker : workers) {
+        worker.join();
+    }
+
+    for(JsonArena& workerArena : arenas) {
+        arena -> adopt(workerArena);
+    }
+
+    return !queue.isFailed;
+}
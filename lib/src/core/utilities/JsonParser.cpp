@@ -1,223 +1,772 @@
+#include <algorithm>
+#include <cctype>
+#include <cstring>
+#include <iterator>
 #include "JsonParser.hpp"
 #include "JsonFactory.hpp"
+#include "JsonGrammar.hpp"
+#include "JsonKeyTable.hpp"
+#include "JsonString.hpp"
+#include "JsonUtf8.hpp"
+#include "JsonValidator.hpp"
 
 /**
- * @brief Parses a JSON null value from input stream
- * @param stream Input stream to parse from
- * @return String "null"
+ * @brief Anonymous namespace for internal parsing helpers
  */
-std::string JsonParser::parseNull(std::istream& stream){
-    char symbol = '\0';
-    size_t counter = 1;
-    
-    while(stream >> symbol){
-        counter++;
+namespace {
+    /**
+     * @brief Keys of the entry stack as JsonKeyTable reaches them
+     */
+    struct EntryKeys {
+        const std::vector<JsonObject::Entry>& entries;  ///< Key-value pairs of the objects being parsed
+
+        /**
+         * @brief Gets the number of keys on the stack
+         * @return Number of keys
+         */
+        size_t size() const {
+            return entries.size();
+        }
 
-        if(counter == 4){
-            break;
+        /**
+         * @brief Hashes a key of the stack
+         * @param position Position of the key
+         * @return Hash of the key
+         */
+        size_t hash(const size_t position) const {
+            return ArenaStringHash()(entries[position].key);
+        }
+
+        /**
+         * @brief Compares two keys of the stack
+         * @param first Position of the first key
+         * @param second Position of the second key
+         * @return True if the keys are equal, false otherwise
+         */
+        bool isSame(const size_t first, const size_t second) const {
+            return entries[first].key == entries[second].key;
         }
+    };
+
+    /**
+     * @brief Checks if a character is whitespace
+     * @param symbol Character to check
+     * @return True if the character is whitespace, false otherwise
+     */
+    inline bool isWhitespace(const char symbol) {
+        return isspace(static_cast<unsigned char>(symbol)) != 0;
     }
 
-    return "null";
+    /**
+     * @brief Moves an index entry pointer to the first entry not before an offset
+     * @param entry Entry pointer to advance
+     * @param entryEnd One past the last entry
+     * @param offset Offset to seek
+     */
+    inline void seek(const uint32_t*& entry, const uint32_t* entryEnd, const size_t offset) {
+        while(entry < entryEnd && *entry < offset) {
+            entry++;
+        }
+    }
 
+    /**
+     * @brief Skips whitespace characters, jumping straight to the next structural entry when there is an index
+     * @param cursor Cursor to advance
+     */
+    inline void skipWhitespace(ParserCursor& cursor) {
+        if(cursor.current >= cursor.end || !isWhitespace(*cursor.current)) {
+            return;
+        }
+
+        if(cursor.structural == nullptr) {
+            while(cursor.current < cursor.end && isWhitespace(*cursor.current)) {
+                cursor.current++;
+            }
+
+            return;
+        }
+
+        seek(cursor.structural, cursor.structuralEnd, cursor.current - cursor.begin);
+        cursor.current = cursor.structural < cursor.structuralEnd ? cursor.begin + *cursor.structural : cursor.end;
+    }
 }
 
 /**
- * @brief Parses a JSON boolean value from input stream
- * @param stream Input stream to parse from
- * @param lastSymbol Last character read ('t' or 'f')
- * @return String "true" or "false"
+ * @brief Reads a JSON null value from the buffer
+ * @param cursor Cursor positioned on 'n'
+ * @throws std::runtime_error if the value is not null
  */
-std::string JsonParser::parseBoolean(std::istream& stream, const char lastSymbol) {
+void JsonParser::parseNull(ParserCursor& cursor) {
+    const char* start = cursor.current;
+    const size_t available = cursor.end - start;
+    const size_t counter = available < 4 ? available : 4;
 
-    char symbol = '\0';
-    size_t counter = 1;
-    
-    const size_t maxReadSymbols = lastSymbol == 't' ? 4 : 5;
+    cursor.current += counter;
 
-    while(stream >> symbol){
-        counter++;
-
-        if(counter == maxReadSymbols){
-            break;
-        }
+    if(counter != 4 || memcmp(start, "null", 4) != 0) {
+        fail(cursor, ValidationError::InvalidNull, start - cursor.begin, counter);
     }
-
-    return maxReadSymbols == 4 ? "true" : "false";
 }
 
 /**
- * @brief Parses a JSON number value from input stream
- * @param stream Input stream to parse from
- * @param lastSymbol Last character read (digit or minus)
- * @return String representation of the number
+ * @brief Reads a JSON boolean value from the buffer
+ * @param cursor Cursor positioned on 't' or 'f'
+ * @throws std::runtime_error if the value is not a boolean
  */
-std::string JsonParser::parseNumber(std::istream& stream, const char lastSymbol) {
-    std::string value(1, lastSymbol);
-    char symbol = '\0';
-    while(stream >> symbol){
+void JsonParser::parseBoolean(ParserCursor& cursor) {
+    const char* start = cursor.current;
+    const bool isTrue = *start == 't';
+    const size_t maxReadSymbols = isTrue ? 4 : 5;
+    const size_t available = cursor.end - start;
+    const size_t counter = available < maxReadSymbols ? available : maxReadSymbols;
 
-        if(isspace(symbol) || symbol == ',' || symbol == '}' || symbol == ']'){
-            stream.seekg(-1, std::ios::cur);
-            break;
-        }
+    cursor.current += counter;
 
-        value.append(1, symbol);
+    if(counter != maxReadSymbols || memcmp(start, isTrue ? "true" : "false", maxReadSymbols) != 0) {
+        fail(cursor, ValidationError::InvalidBoolean, start - cursor.begin, counter);
     }
+}
 
-    return value;
+/**
+ * @brief Reads a JSON number value from the buffer
+ * @param cursor Cursor positioned on the first digit or minus
+ * @throws std::runtime_error if validating and the value is not a valid number
+ */
+void JsonParser::parseNumber(ParserCursor& cursor) {
+    const char* start = cursor.current;
+    const char* symbol = start + 1;
+
+    while(symbol < cursor.end && !isWhitespace(*symbol) && *symbol != ',' && *symbol != '}' && *symbol != ']') {
+        symbol++;
+    }
+
+    cursor.current = symbol;
+
+    const size_t counter = symbol - start;
+
+    if(cursor.isValidating && !JsonGrammar::isValidNumber(start, counter)) {
+        fail(cursor, ValidationError::InvalidNumber, start - cursor.begin, counter);
+    }
 }
 
 /**
- * @brief Parses a JSON string value from input stream
- * @param stream Input stream to parse from
- * @param lastSymbol Last character read (quote)
- * @return Parsed string including quotes
+ * @brief Reads a JSON string value from the buffer, checking characters one by one only where needed
+ * @param cursor Cursor positioned on the opening quote
+ * @throws std::runtime_error if the string is unclosed or, when validating, contains invalid characters
  */
-std::string JsonParser::parseString(std::istream& stream, const char lastSymbol) {
-    std::string value(1, lastSymbol);
-    char symbol = '\0';
+void JsonParser::parseString(ParserCursor& cursor) {
+    const char* start = cursor.current;
+    const char* symbol = start + 1;
 
-    while(stream.get(symbol)){
-        if(symbol == '\"' && value[value.length() - 1] != '\\'){
-            value.append(1, symbol);
-            break;
+    if(cursor.structural != nullptr) {
+        const size_t offset = start - cursor.begin;
+
+        seek(cursor.structural, cursor.structuralEnd, offset);
+
+        if(cursor.structuralEnd - cursor.structural >= 2 && *cursor.structural == offset && cursor.begin[cursor.structural[1]] == '\"') {
+            const size_t closingOffset = cursor.structural[1];
+
+            seek(cursor.special, cursor.specialEnd, offset);
+
+            if(!cursor.isValidating || cursor.special == cursor.specialEnd || *cursor.special > closingOffset) {
+                cursor.structural += 2;
+                cursor.current = cursor.begin + closingOffset + 1;
+                return;
+            }
         }
+    }
+
+    if(!cursor.isValidating) {
+        while(symbol < cursor.end && *symbol != '\"') {
+            if(*symbol == '\\' && symbol + 1 < cursor.end) {
+                symbol++;
+            }
 
-        value.append(1, symbol);
+            symbol++;
+        }
     }
+    else {
+        size_t hexDigitsLeft = 0;
+        bool isEscaped = false;
+
+        for(; symbol < cursor.end; symbol++) {
+            if(static_cast<unsigned char>(*symbol) < 0x20) {
+                checkUtf8(cursor, start, symbol);
+                fail(cursor, ValidationError::ControlCharacter, start - cursor.begin, symbol - start);
+            }
 
-    return value;
+            if((isEscaped && !JsonGrammar::isEscapeCharacter(*symbol)) || (hexDigitsLeft > 0 && !isxdigit(static_cast<unsigned char>(*symbol)))) {
+                checkUtf8(cursor, start, symbol);
+                fail(cursor, ValidationError::InvalidEscape, start - cursor.begin, symbol - start);
+            }
+
+            if(isEscaped) {
+                isEscaped = false;
+                hexDigitsLeft = *symbol == 'u' ? 4 : 0;
+            }
+            else if(hexDigitsLeft > 0) {
+                hexDigitsLeft--;
+            }
+            else if(*symbol == '\\') {
+                isEscaped = true;
+            }
+            else if(*symbol == '\"') {
+                break;
+            }
+        }
+    }
+
+    if(cursor.isValidating) {
+        checkUtf8(cursor, start, symbol < cursor.end ? symbol : cursor.end);
+    }
+
+    if(symbol >= cursor.end) {
+        cursor.current = cursor.end;
+
+        fail(cursor, ValidationError::UnclosedString, start - cursor.begin, cursor.end - start);
+    }
+
+    cursor.current = symbol + 1;
+}
+
+/**
+ * @brief Checks that the characters of a string read so far are well-formed UTF-8
+ * @param cursor Cursor over the parsed buffer
+ * @param start Opening quote of the string
+ * @param symbol Character the string was read up to
+ * @throws std::runtime_error if an ill-formed UTF-8 sequence starts before symbol
+ */
+void JsonParser::checkUtf8(const ParserCursor& cursor, const char* start, const char* symbol) {
+    const char* invalid = JsonUtf8::findInvalid(start + 1, symbol);
+
+    if(invalid != symbol) {
+        fail(cursor, ValidationError::InvalidUtf8, start - cursor.begin, invalid - start);
+    }
 }
 
 /**
  * @brief Parses a primary JSON value (null, boolean, number, or string)
- * @param stream Input stream to parse from
- * @param lastSymbol Last character read
+ * @param cursor Cursor positioned on the first character of the value
  * @return Pointer to created JsonValue
+ * @throws std::runtime_error if the value is invalid
  */
-JsonValue* JsonParser::parsePrimary(std::istream& stream, const char lastSymbol) {
+JsonValue* JsonParser::parsePrimary(ParserCursor& cursor) {
 
-    std::string value = "";
+    const char* start = cursor.current;
 
-    switch (lastSymbol)
+    switch (*cursor.current)
     {
         case 'n' : {
-            value = parseNull(stream);
+            parseNull(cursor);
             break;
         }
         case 't' :
         case 'f' : {
-            value = parseBoolean(stream, lastSymbol);
+            parseBoolean(cursor);
             break;
         }
         case '\"' : {
-            value = parseString(stream, lastSymbol);
+            parseString(cursor);
             break;
         }
         default : {
-            value = parseNumber(stream, lastSymbol);
+            if(*cursor.current != '-' && !JsonGrammar::isDigit(*cursor.current)) {
+                fail(cursor, ValidationError::InvalidValue, cursor.current - cursor.begin, 0);
+            }
+
+            parseNumber(cursor);
             break;
         }
     }
 
-    return JsonFactory::create(value);
+    if(cursor.isBorrowing && *start == '\"') {
+        return new JsonString(start, cursor.current - start, true);
+    }
+
+    return JsonFactory::create(start, cursor.current - start);
 }
 
 /**
- * @brief Parses a JSON array or object
- * @param stream Input stream to parse from
+ * @brief Parses a JSON array or object, suspending the enclosing ones on the cursor's frame stack
+ * @param cursor Cursor positioned right after the opening brace/bracket
  * @param lastBrace Opening brace/bracket character
  * @return Pointer to created JsonValue (array or object)
+ * @throws std::runtime_error with the same message JsonValidator reports if the JSON is invalid
  */
-JsonValue* JsonParser::parseJson(std::istream& stream, const char lastBrace) {
+JsonValue* JsonParser::parseJson(ParserCursor& cursor, const char lastBrace) {
+
+    const size_t framesBase = cursor.frames.size();
+    const size_t valuesRoot = cursor.values.size();
+    const size_t entriesRoot = cursor.entries.size();
+    const size_t depthLimit = cursor.maxDepth;
+    JsonKeyTable keyTable;
+
+    char brace = lastBrace;
+    bool isObject = brace == '{';
+    bool isCommaFound = false;
+    size_t stateOfReading = 0;
+    size_t valuesBase = valuesRoot;
+    size_t entriesBase = entriesRoot;
+    size_t tableBase = JsonKeyTable::NoTable;
+
+    JsonValue* result = nullptr;
+
+    try {
+        while(true) {
+            skipWhitespace(cursor);
+
+            if(cursor.current >= cursor.end) {
+                fail(cursor, ValidationError::MissingClosingBracket, cursor.end - cursor.begin, 0);
+            }
 
-    char symbol = '\0';
+            const char symbol = *cursor.current;
+            const size_t offset = cursor.current - cursor.begin;
 
-    if(lastBrace != '[' && lastBrace != '{') {
-        return parsePrimary(stream, lastBrace);    
-    }
+            if(symbol == '}' || symbol == ']') {
+                cursor.current++;
 
-    if(lastBrace == '[') {
-        std::vector<JsonValue*> arrayValues;
+                const bool isValidClosing = !isCommaFound && symbol - brace == 2 && (!isObject || stateOfReading == 0 || stateOfReading == 3);
+
+                if(!isValidClosing) {
+                    const ValidationError error = isCommaFound ? ValidationError::AdditionalComma :
+                                                  symbol - brace != 2 ? ValidationError::MismatchingClosingBracket :
+                                                  isObject && stateOfReading == 1 ? ValidationError::MissingKeySeparator :
+                                                  ValidationError::InvalidValue;
+
+                    fail(cursor, error, offset, 0);
+                }
+
+                // The children are copied off the shared stacks into storage of the exact size
+                JsonValue* value = nullptr;
+
+                if(!isObject) {
+                    value = JsonFactory::create(JsonArray::Values(cursor.values.begin() + valuesBase, cursor.values.end()));
+                    cursor.values.resize(valuesBase);
+                } else {
+                    value = JsonFactory::create(JsonObject::Entries(std::make_move_iterator(cursor.entries.begin() + entriesBase),
+                                                                    std::make_move_iterator(cursor.entries.end())));
+                    cursor.entries.erase(cursor.entries.begin() + entriesBase, cursor.entries.end());
+                }
+
+                keyTable.release(tableBase);
+
+                if(cursor.frames.size() == framesBase) {
+                    result = value;
+                    break;
+                }
+
+                const ParserFrame& parent = cursor.frames.back();
+
+                brace = parent.brace;
+                isObject = brace == '{';
+                valuesBase = parent.valuesBase;
+                entriesBase = parent.entriesBase;
+                tableBase = parent.tableBase;
+                stateOfReading = parent.stateOfReading + 1;
+                isCommaFound = false;
+
+                cursor.frames.pop_back();
+
+                if(isObject) {
+                    cursor.entries.back().value = value;
+                } else {
+                    cursor.values.push_back(value);
+                }
+
+                continue;
+            }
+
+            if(isObject && stateOfReading == 0) {
+                isCommaFound = false;
+                stateOfReading++;
+
+                if(symbol != '\"') {
+                    fail(cursor, ValidationError::InvalidKey, offset, 0);
+                }
+
+                const char* keyStart = cursor.current;
+                parseString(cursor);
+                cursor.entries.push_back(JsonObject::Entry{ArenaString(keyStart + 1, cursor.current - 1), nullptr});
+
+                if(cursor.isValidating && keyTable.isDuplicate(EntryKeys{cursor.entries}, entriesBase, tableBase)) {
+                    fail(cursor, ValidationError::DuplicateKey, keyStart - cursor.begin, cursor.current - keyStart);
+                }
+
+                continue;
+            }
+
+            if(isObject && stateOfReading == 1) {
+                stateOfReading++;
+
+                if(symbol != ':') {
+                    fail(cursor, ValidationError::MissingKeySeparator, offset, 0);
+                }
+
+                cursor.current++;
+                continue;
+            }
+
+            const bool isValueExpected = isObject ? stateOfReading == 2 : stateOfReading == 0;
+
+            if(!isValueExpected) {
+                if(symbol != ',') {
+                    fail(cursor, ValidationError::MissingComma, offset, 0);
+                }
+
+                cursor.current++;
+                isCommaFound = true;
+                stateOfReading = 0;
+
+                continue;
+            }
+
+            if((symbol == '{' || symbol == '[') && cursor.source == nullptr) {
+                if(cursor.frames.size() - framesBase + 1 >= depthLimit) {
+                    fail(cursor, ValidationError::MaximumDepthExceeded, offset, 0);
+                }
+
+                cursor.frames.push_back(ParserFrame{brace, isCommaFound, stateOfReading, valuesBase, entriesBase, tableBase});
+                cursor.current++;
+
+                brace = symbol;
+                isObject = brace == '{';
+                isCommaFound = false;
+                stateOfReading = 0;
+                valuesBase = cursor.values.size();
+                entriesBase = cursor.entries.size();
+                tableBase = JsonKeyTable::NoTable;
 
-        while(stream >> symbol) {
-            if(symbol == ']')
-                break;
-            
-            if(symbol == ',') {
                 continue;
             }
 
-            JsonValue* value = nullptr;
+            JsonValue* value = symbol == '{' || symbol == '[' ? skipJson(cursor, symbol) : parsePrimary(cursor);
 
-            if(symbol == '[' || symbol == '{'){
-                value = parseJson(stream, symbol);
+            if(isObject) {
+                cursor.entries.back().value = value;
             } else {
-                value = parsePrimary(stream, symbol);
+                cursor.values.push_back(value);
             }
 
-            arrayValues.push_back(value);
+            stateOfReading++;
+            isCommaFound = false;
         }
+    }
+    catch(...) {
+        for(size_t i = valuesRoot; i < cursor.values.size(); i++)
+            delete cursor.values[i];
 
-        JsonValue* value = JsonFactory::create(arrayValues);
+        for(size_t i = entriesRoot; i < cursor.entries.size(); i++)
+            delete cursor.entries[i].value;
 
-        for(JsonValue* arrayValue : arrayValues)
-            delete arrayValue;
+        cursor.values.resize(valuesRoot);
+        cursor.entries.erase(cursor.entries.begin() + entriesRoot, cursor.entries.end());
+        cursor.frames.resize(framesBase);
 
-        return value;
+        throw;
     }
 
+    return result;
+}
 
-    std::list<std::string> objectKeys;
-    std::unordered_map<std::string, JsonValue*> objectValues;
+/**
+ * @brief Skips a nested JSON object or array of a lazily parsed document by counting structural brackets
+ * @param cursor Cursor positioned on the opening brace/bracket, with a structural index
+ * @param brace Opening brace/bracket character
+ * @return Pointer to the unparsed JsonArray or JsonObject
+ * @throws std::runtime_error if the brace/bracket is never closed
+ */
+JsonValue* JsonParser::skipJson(ParserCursor& cursor, const char brace) {
+    const size_t openingOffset = cursor.current - cursor.begin;
+    size_t depth = 0;
 
-    while(stream >> symbol) {
+    seek(cursor.structural, cursor.structuralEnd, openingOffset);
 
-        if(symbol == '}')
-            break;
+    for(; cursor.structural < cursor.structuralEnd; cursor.structural++) {
+        const char symbol = cursor.begin[*cursor.structural];
 
-        if(symbol == ',') {
-            continue;
+        if(symbol == '{' || symbol == '[') {
+            depth++;
+        } else if((symbol == '}' || symbol == ']') && --depth == 0) {
+            break;
         }
+    }
 
-        std::string key = parseString(stream, symbol);
-        key = key.substr(1, key.length()-2);
-        objectKeys.push_back(key);
+    if(cursor.structural == cursor.structuralEnd) {
+        cursor.current = cursor.end;
 
-        stream >> symbol;
+        fail(cursor, ValidationError::MissingClosingBracket, cursor.end - cursor.begin, 0);
+    }
 
-        stream >> symbol;
+    const size_t closingOffset = *cursor.structural;
+
+    cursor.structural++;
+    cursor.special = std::lower_bound(cursor.special, cursor.specialEnd, closingOffset);
+    cursor.current = cursor.begin + closingOffset + 1;
+
+    const JsonSpan span = {cursor.source, cursor.sourceOffset + openingOffset, cursor.sourceOffset + closingOffset + 1};
+    JsonValue* value = JsonFactory::create(brace, span);
+
+    if(cursor.unparsed != nullptr) {
+        cursor.unparsed -> push_back(UnparsedValue{value, span});
+    }
+
+    return value;
+}
+
+/**
+ * @brief Parses a whole buffer as a single top-level JSON value
+ * @param data Pointer to the first character of the JSON text
+ * @param length Number of characters in the buffer
+ * @param isValidating Whether the grammar is fully checked while parsing
+ * @param isBorrowing Whether string values refer to the buffer instead of copying it
+ * @param maxDepth Maximum number of arrays and objects enclosing each other
+ * @return Pointer to parsed JsonValue
+ * @throws std::runtime_error if the JSON is invalid
+ */
+JsonValue* JsonParser::parseBuffer(const char* data, const size_t length, const bool isValidating, const bool isBorrowing,
+                                   const size_t maxDepth) {
+    ParserCursor cursor = {data, data, data + length, isValidating, isBorrowing, maxDepth, nullptr, nullptr, nullptr, nullptr, nullptr, 0, nullptr, {}, {}, {}};
+    StructuralIndex index;
+
+    if(JsonStructuralIndexer::canIndex(length)) {
+        JsonStructuralIndexer::index(data, length, index);
+
+        cursor.structural = index.structurals.data();
+        cursor.structuralEnd = cursor.structural + index.structurals.size();
+        cursor.special = index.specials.data();
+        cursor.specialEnd = cursor.special + index.specials.size();
+    }
 
-        JsonValue* value = nullptr;
+    JsonValue* value = nullptr;
+    bool isValueFound = false;
 
-        if(symbol == '[' || symbol == '{'){
-            value = parseJson(stream, symbol);
-        } else {
-            value = parsePrimary(stream, symbol);
+    try {
+        while(true) {
+            skipWhitespace(cursor);
+
+            if(cursor.current >= cursor.end) {
+                break;
+            }
+
+            const char symbol = *cursor.current;
+
+            if(symbol == '}' || symbol == ']' || isValueFound) {
+                fail(cursor, symbol == '}' || symbol == ']' ? ValidationError::AdditionalClosingBracket : ValidationError::InvalidValue,
+                     cursor.current - cursor.begin, 0);
+            }
+
+            if(symbol == '{' || symbol == '[') {
+                cursor.current++;
+                value = parseJson(cursor, symbol);
+            } else {
+                value = parsePrimary(cursor);
+            }
+
+            isValueFound = true;
         }
+    }
+    catch(...) {
+        delete value;
+        throw;
+    }
 
-        objectValues.emplace(key, value);
+    if(!isValueFound) {
+        fail(cursor, ValidationError::InvalidValue, length, 0);
     }
 
-    JsonValue* value = JsonFactory::create(objectKeys, objectValues);
-    
-    for(auto& kvp : objectValues)
-        delete kvp.second;
-    
     return value;
-    
+}
+
+/**
+ * @brief Main entry point for parsing JSON from a contiguous buffer
+ * @param data Pointer to the first character of the JSON text
+ * @param length Number of characters in the buffer
+ * @param maxDepth Maximum number of arrays and objects enclosing each other
+ * @return Pointer to parsed JsonValue
+ */
+JsonValue* JsonParser::parse(const char* data, const size_t length, const size_t maxDepth) {
+    return parseBuffer(data, length, false, false, maxDepth);
 }
 
 /**
  * @brief Main entry point for parsing JSON from input stream
  * @param stream Input stream containing JSON data
+ * @param maxDepth Maximum number of arrays and objects enclosing each other
+ * @return Pointer to parsed JsonValue
+ */
+JsonValue* JsonParser::parse(std::istream& stream, const size_t maxDepth) {
+    const std::string content = readStreamContent(stream);
+    return parse(content.data(), content.length(), maxDepth);
+}
+
+/**
+ * @brief Entry point for parsing JSON from a contiguous buffer while validating it in the same pass
+ * @param data Pointer to the first character of the JSON text
+ * @param length Number of characters in the buffer
+ * @param isBorrowing Whether string values refer to the buffer instead of copying it; it must then outlive them
+ * @param maxDepth Maximum number of arrays and objects enclosing each other
+ * @return Pointer to parsed JsonValue
+ * @throws std::runtime_error if the JSON is invalid
+ */
+JsonValue* JsonParser::parseValidated(const char* data, const size_t length, const bool isBorrowing, const size_t maxDepth) {
+    return parseBuffer(data, length, true, isBorrowing, maxDepth);
+}
+
+/**
+ * @brief Entry point for parsing JSON from input stream while validating it in the same pass
+ * @param stream Input stream containing JSON data
+ * @param maxDepth Maximum number of arrays and objects enclosing each other
  * @return Pointer to parsed JsonValue
+ * @throws std::runtime_error if the JSON is invalid
  */
-JsonValue* JsonParser::parse(std::istream& stream) {
-    char symbol = '\0';
+JsonValue* JsonParser::parseValidated(std::istream& stream, const size_t maxDepth) {
+    const std::string content = readStreamContent(stream);
+    return parseValidated(content.data(), content.length(), false, maxDepth);
+}
+
+/**
+ * @brief Parses the top-level value of a document lazily
+ * @param data Pointer to the first character of the document, which must outlive the value
+ * @param length Number of characters in the document
+ * @param source Source the document's arrays and objects are parsed by
+ * @return Pointer to the top-level JsonValue
+ * @throws std::runtime_error if a top-level primitive is invalid
+ */
+JsonValue* JsonParser::parseLazy(const char* data, const size_t length, JsonSource* source) {
+    size_t begin = 0, end = length;
+
+    while(begin < end && isWhitespace(data[begin])) {
+        begin++;
+    }
+
+    while(end > begin && isWhitespace(data[end - 1])) {
+        end--;
+    }
+
+    if(begin == end || (data[begin] != '{' && data[begin] != '[') || !JsonStructuralIndexer::canIndex(length)) {
+        return parseValidated(data, length, true);
+    }
+
+    const JsonSpan span = {source, begin, end};
+
+    return JsonFactory::create(data[begin], span);
+}
+
+/**
+ * @brief Parses one array or object of a lazily parsed document, indexing only its span
+ * @param data Pointer to the first character of the document
+ * @param begin Offset of the opening brace/bracket
+ * @param end Offset one past the end of the value's text
+ * @param source Source the nested arrays and objects are parsed by
+ * @param scratch Buffers reused from the previous level
+ * @return Pointer to the parsed JsonArray or JsonObject
+ * @throws std::runtime_error if the level is invalid
+ */
+JsonValue* JsonParser::parseLevel(const char* data, const size_t begin, const size_t end, JsonSource* source,
+                                  ParserScratch& scratch) {
+    const char* span = data + begin;
+    const size_t length = end - begin;
+
+    ParserCursor cursor = {span, span + 1, span + length, true, true, JsonValidator::DefaultMaxDepth, nullptr, nullptr, nullptr, nullptr, source, begin, nullptr, {}, {}, {}};
+    StructuralIndex& index = scratch.index;
+
+    JsonStructuralIndexer::index(span, length, index);
+
+    cursor.structural = index.structurals.data();
+    cursor.structuralEnd = cursor.structural + index.structurals.size();
+    cursor.special = index.specials.data();
+    cursor.specialEnd = cursor.special + index.specials.size();
+    cursor.values.swap(scratch.values);
+    cursor.entries.swap(scratch.entries);
+    cursor.frames.swap(scratch.frames);
+
+    JsonValue* value = parseJson(cursor, *span);
+
+    cursor.values.swap(scratch.values);
+    cursor.entries.swap(scratch.entries);
+    cursor.frames.swap(scratch.frames);
 
-    stream >> symbol;
+    if(cursor.current != cursor.end) {
+        delete value;
 
-    return parseJson(stream, symbol);
+        fail(cursor, ValidationError::InvalidValue, cursor.current - cursor.begin, 0);
+    }
+
+    return value;
+}
+
+/**
+ * @brief Parses one array or object of a document whose structural index was built beforehand
+ * @param data Pointer to the first character of the document
+ * @param length Number of characters in the document
+ * @param index Structural index of the whole document
+ * @param begin Offset of the opening brace/bracket
+ * @param end Offset one past the end of the value's text
+ * @param source Source the nested arrays and objects are left unparsed in, nullptr to parse them too
+ * @param unparsed Collects the nested arrays and objects left unparsed, may be nullptr
+ * @param isBorrowing Whether string values refer to the document instead of copying it
+ * @param maxDepth Maximum number of arrays and objects enclosing each other inside the value
+ * @param scratch Stacks reused from the previous value parsed by the calling thread
+ * @return Pointer to the parsed JsonArray or JsonObject
+ * @throws std::runtime_error if the value is invalid
+ */
+JsonValue* JsonParser::parseIndexed(const char* data, const size_t length, const StructuralIndex& index, const size_t begin,
+                                    const size_t end, JsonSource* source, std::vector<UnparsedValue>* unparsed,
+                                    const bool isBorrowing, const size_t maxDepth, ParserScratch& scratch) {
+    ParserCursor cursor = {data, data + begin + 1, data + length, true, isBorrowing, maxDepth, nullptr, nullptr, nullptr, nullptr, source, 0, unparsed, {}, {}, {}};
+
+    cursor.structural = std::lower_bound(index.structurals.data(), index.structurals.data() + index.structurals.size(), begin + 1);
+    cursor.structuralEnd = index.structurals.data() + index.structurals.size();
+    cursor.special = std::lower_bound(index.specials.data(), index.specials.data() + index.specials.size(), begin + 1);
+    cursor.specialEnd = index.specials.data() + index.specials.size();
+    cursor.values.swap(scratch.values);
+    cursor.entries.swap(scratch.entries);
+    cursor.frames.swap(scratch.frames);
+
+    JsonValue* value = nullptr;
+
+    try {
+        value = parseJson(cursor, data[begin]);
+    }
+    catch(...) {
+        cursor.values.swap(scratch.values);
+        cursor.entries.swap(scratch.entries);
+        cursor.frames.swap(scratch.frames);
+        throw;
+    }
+
+    cursor.values.swap(scratch.values);
+    cursor.entries.swap(scratch.entries);
+    cursor.frames.swap(scratch.frames);
+
+    if(cursor.current != data + end) {
+        delete value;
+
+        fail(cursor, ValidationError::InvalidValue, cursor.current - cursor.begin, 0);
+    }
+
+    return value;
+}
+
+/**
+ * @brief Throws the message the validator gives for an error, located relative to the cursor's buffer
+ * @param cursor Cursor over the parsed buffer
+ * @param error Kind of the error
+ * @param offset Offset from the beginning of the buffer the error is reported at
+ * @param length Number of characters of the offending token
+ * @throws std::runtime_error always
+ */
+void JsonParser::fail(const ParserCursor& cursor, const ValidationError error, const size_t offset, const size_t length) {
+    const ValidationResult result = {error, offset, length, 0};
+
+    throw std::runtime_error(JsonValidator::describe(cursor.begin, cursor.end - cursor.begin, result, cursor.maxDepth));
+}
+
+/**
+ * @brief Helper method to read entire stream content
+ * @param stream Input stream to read from
+ * @return String containing stream content
+ */
+std::string JsonParser::readStreamContent(std::istream& stream) {
+    return std::string((std::istreambuf_iterator<char>(stream)), std::istreambuf_iterator<char>());
 }
\ No newline at end of file
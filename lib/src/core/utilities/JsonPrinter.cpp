@@ -1,5 +1,7 @@
-#include <sstream>
 #include "JsonPrinter.hpp"
+#include "CompactJsonFormatter.hpp"
+#include "PrettyJsonFormatter.hpp"
+#include "JsonStringWriter.hpp"
 
 /**
  * @brief Prints a JSON value in compact format
@@ -7,16 +9,13 @@
  * @return String representation of the JSON value
  */
 std::string JsonPrinter::print(const JsonValue* const jsonValue){
+    std::string output;
+    JsonStringWriter writer(output);
 
-    JsonFormatConfig::setFormatterType(FormatterType::Compact);
+    print(writer, jsonValue);
+    writer.flush();
 
-    std::ostringstream os;
-
-    os << jsonValue;
-
-    JsonFormatConfig::setFormatterType(FormatterType::Pretty);
-
-    return os.str();
+    return output;
 }
 
 /**
@@ -25,12 +24,55 @@ std::string JsonPrinter::print(const JsonValue* const jsonValue){
  * @return Formatted string representation of the JSON value
  */
 std::string JsonPrinter::prettyPrint(const JsonValue* const jsonValue) {
+    std::string output;
+    JsonStringWriter writer(output);
+
+    prettyPrint(writer, jsonValue);
+    writer.flush();
+
+    return output;
+}
+
+/**
+ * @brief Appends a JSON value in compact format to a writer with the default formatting options
+ * @param writer Writer to append to
+ * @param jsonValue Pointer to the constant JSON value to print
+ */
+void JsonPrinter::print(JsonWriter& writer, const JsonValue* const jsonValue) {
+    CompactJsonFormatter::getInstance().writeJson(writer, jsonValue);
+}
+
+/**
+ * @brief Appends a JSON value in pretty-printed format to a writer with the default formatting options
+ * @param writer Writer to append to
+ * @param jsonValue Pointer to the constant JSON value to print
+ */
+void JsonPrinter::prettyPrint(JsonWriter& writer, const JsonValue* const jsonValue) {
+    PrettyJsonFormatter::getInstance().writeJson(writer, jsonValue);
+}
 
-    JsonFormatConfig::setFormatterType(FormatterType::Pretty);
+/**
+ * @brief Prints a JSON value with the formatter and options of the call
+ * @param jsonValue Pointer to the constant JSON value to print
+ * @param options Formatter type, indentation width and key order to print with
+ * @return Formatted string representation of the JSON value
+ */
+std::string JsonPrinter::print(const JsonValue* const jsonValue, const JsonFormatOptions& options) {
+    std::string output;
+    JsonStringWriter writer(output);
 
-    std::ostringstream os;
+    print(writer, jsonValue, options);
+    writer.flush();
 
-    os << jsonValue;
+    return output;
+}
 
-    return os.str();
+/**
+ * @brief Appends a JSON value to a writer with the formatter and options of the call
+ * @param writer Writer to append to
+ * @param jsonValue Pointer to the constant JSON value to print
+ * @param options Formatter type, indentation width and key order to print with
+ */
+void JsonPrinter::print(JsonWriter& writer, const JsonValue* const jsonValue, const JsonFormatOptions& options) {
+    JsonFormatConfig::writeJson(writer, jsonValue, options);
 }
\ No newline at end of file
@@ -0,0 +1,1812 @@
+#include <algorithm>
+#include <cctype>
+#include <cmath>
+#include <cstdio>
+#include <regex>
+#include <stdexcept>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+#include "JsonSchema.hpp"
+#include "JsonArena.hpp"
+#include "JsonEscaper.hpp"
+#include "JsonParser.hpp"
+#include "JsonValueVisitor.hpp"
+
+/**
+ * @brief Anonymous namespace for the compiled form of a schema
+ */
+namespace {
+    const size_t NoNode = static_cast<size_t>(-1);  ///< Marks an absent subschema
+    const size_t MaximumEvaluationDepth = 1024;     ///< Nested subschema evaluations allowed before a $ref cycle is assumed
+    const size_t TypeCount = 6;                     ///< Number of ValueType values, each node keeps a check list per type
+    const unsigned IntegerBit = 1u << TypeCount;    ///< Bit of the "integer" type next to one bit per ValueType
+
+    /**
+     * @brief Keywords a check implements, several keywords sharing one check where they only make sense together
+     */
+    enum class SchemaKeyword {
+        Type,               ///< "type", only present in the lists of the types it rejects
+        Const,              ///< "const"
+        Enum,               ///< "enum"
+        MultipleOf,         ///< "multipleOf"
+        Minimum,            ///< "minimum"
+        ExclusiveMinimum,   ///< "exclusiveMinimum"
+        Maximum,            ///< "maximum"
+        ExclusiveMaximum,   ///< "exclusiveMaximum"
+        MinLength,          ///< "minLength"
+        MaxLength,          ///< "maxLength"
+        Pattern,            ///< "pattern"
+        MinItems,           ///< "minItems"
+        MaxItems,           ///< "maxItems"
+        UniqueItems,        ///< "uniqueItems"
+        PrefixItems,        ///< "prefixItems"
+        Items,              ///< "items"
+        Contains,           ///< "contains" with "minContains" and "maxContains"
+        MinProperties,      ///< "minProperties"
+        MaxProperties,      ///< "maxProperties"
+        Required,           ///< "required"
+        DependentRequired,  ///< "dependentRequired"
+        Properties,         ///< "properties" with "patternProperties" and "additionalProperties"
+        PropertyNames,      ///< "propertyNames"
+        DependentSchemas,   ///< "dependentSchemas"
+        AllOf,              ///< "allOf"
+        AnyOf,              ///< "anyOf"
+        OneOf,              ///< "oneOf"
+        Not,                ///< "not"
+        If,                 ///< "if" with "then" and "else"
+        Ref                 ///< "$ref"
+    };
+
+    /**
+     * @brief Names of the keywords in the order of SchemaKeyword, used in messages
+     */
+    const char* const KeywordNames[] = {
+        "type", "const", "enum", "multipleOf", "minimum", "exclusiveMinimum", "maximum", "exclusiveMaximum",
+        "minLength", "maxLength", "pattern", "minItems", "maxItems", "uniqueItems", "prefixItems", "items", "contains",
+        "minProperties", "maxProperties", "required", "dependentRequired", "properties", "propertyNames",
+        "dependentSchemas", "allOf", "anyOf", "oneOf", "not", "if", "$ref"
+    };
+
+    /**
+     * @brief Limit of a numeric keyword, kept in the representation it was read in so integers compare exactly
+     */
+    struct SchemaNumber {
+        NumberType type;           ///< Representation of the limit
+        int64_t integer;           ///< Value of a NumberType::Integer limit
+        uint64_t unsignedInteger;  ///< Value of a NumberType::UnsignedInteger limit
+        double floating;           ///< Value of the limit as the nearest double
+    };
+
+    /**
+     * @brief One keyword of a compiled subschema; what the operands mean depends on the keyword
+     */
+    struct SchemaCheck {
+        SchemaKeyword keyword;  ///< Keyword the check implements
+        size_t first;           ///< Count limit, type mask, subschema, or first entry of a range of a program table
+        size_t count;           ///< Number of entries of the range, or a second subschema
+        size_t extra;           ///< Third operand, the upper bound of "contains" or the subschema of "else"
+    };
+
+    /**
+     * @brief Compiled subschema
+     */
+    struct SchemaNode {
+        bool isFalse;                                ///< Whether the subschema is false and rejects every value
+        std::string location;                        ///< JSON pointer of the subschema, used in messages
+        std::vector<SchemaCheck> checks[TypeCount];  ///< Checks that apply to values of each ValueType, in evaluation order
+    };
+
+    /**
+     * @brief Subschemas applying to the members of an object
+     */
+    struct PropertyRules {
+        std::unordered_map<std::string, size_t> properties;  ///< Subschema of each key named by "properties"
+        std::vector<std::pair<size_t, size_t>> patterns;     ///< Regex and subschema of each "patternProperties" entry
+        size_t additional;                                   ///< Subschema of "additionalProperties", NoNode when absent
+    };
+
+    /**
+     * @brief Entry of "dependentRequired" or "dependentSchemas"
+     */
+    struct Dependency {
+        std::string key;  ///< Key whose presence triggers the dependency
+        size_t first;     ///< First required name, or the subschema to apply
+        size_t count;     ///< Number of required names
+    };
+}
+
+/**
+ * @brief Compiled schema: its subschemas and the tables their checks refer to. The root is the first node
+ */
+struct SchemaProgram {
+    std::vector<SchemaNode> nodes;                          ///< Compiled subschemas
+    std::vector<size_t> children;                           ///< Subschemas of "allOf", "anyOf", "oneOf" and "prefixItems"
+    std::vector<size_t> references;                         ///< Subschema each $ref was resolved to
+    std::vector<SchemaNumber> numbers;                      ///< Limits of the numeric keywords
+    std::vector<std::string> names;                         ///< Required keys and canonical forms of "const" values
+    std::vector<std::unordered_set<std::string>> sets;      ///< Canonical forms of the values of each "enum"
+    std::vector<std::regex> regexes;                        ///< Compiled "pattern" and "patternProperties" regexes
+    std::vector<PropertyRules> rules;                       ///< Member subschemas of objects
+    std::vector<Dependency> dependencies;                   ///< Entries of "dependentRequired" and "dependentSchemas"
+};
+
+/**
+ * @brief Anonymous namespace for the passes compiling a schema and running the compiled program
+ */
+namespace {
+    /**
+     * @brief Gets the bit of a type in a type mask
+     * @param type Type of value
+     * @return Bit of the type
+     */
+    unsigned typeBit(const ValueType type) {
+        return 1u << static_cast<unsigned>(type);
+    }
+
+    /**
+     * @brief Reads the four hexadecimal digits of a \\u escape
+     * @param data Pointer to the first digit
+     * @return Value of the digits
+     */
+    unsigned readHex(const char* data) {
+        unsigned value = 0;
+
+        for(size_t i = 0; i < 4; i++) {
+            const char symbol = data[i];
+            const unsigned digit = symbol <= '9' ? symbol - '0' : (symbol | 0x20) - 'a' + 10;
+
+            value = value * 16 + digit;
+        }
+
+        return value;
+    }
+
+    /**
+     * @brief Counts the code points of validated string content without decoding it
+     * @param begin Pointer to the first character after the opening quote
+     * @param end Pointer to the closing quote
+     * @return Number of code points, a surrogate pair counting as one
+     */
+    size_t countCodePoints(const char* begin, const char* end) {
+        size_t count = 0;
+
+        for(const char* symbol = begin; symbol < end; symbol++) {
+            if(*symbol == '\\') {
+                symbol++;
+
+                if(*symbol == 'u') {
+                    const unsigned codePoint = readHex(symbol + 1);
+
+                    symbol += 4;
+
+                    if(codePoint >= 0xD800 && codePoint < 0xDC00 && end - symbol > 6 && symbol[1] == '\\' && symbol[2] == 'u') {
+                        const unsigned low = readHex(symbol + 3);
+
+                        if(low >= 0xDC00 && low < 0xE000) {
+                            symbol += 6;
+                        }
+                    }
+                }
+
+                count++;
+            }
+            else if((static_cast<unsigned char>(*symbol) & 0xC0) != 0x80) {
+                count++;
+            }
+        }
+
+        return count;
+    }
+
+    /**
+     * @brief Decodes a string value
+     * @param value String to decode
+     * @param result String receiving the decoded text
+     */
+    void decodeString(const JsonString& value, std::string& result) {
+        JsonEscaper::decode(value.getText() + 1, value.getText() + value.getLength() - 1, result);
+    }
+
+    /**
+     * @brief Decodes a key of an object, which is stored as written between its quotes
+     * @param key Raw key
+     * @param result String receiving the decoded key
+     */
+    void decodeKey(const ArenaString& key, std::string& result) {
+        if(key.find('\\') == ArenaString::npos) {
+            result.assign(key.data(), key.length());
+        }
+        else {
+            JsonEscaper::decode(key.data(), key.data() + key.length(), result);
+        }
+    }
+
+    /**
+     * @brief Finds a member of an object by its decoded key
+     * @param object Object to search
+     * @param key Decoded key to find
+     * @return Value of the member, nullptr if the object has no such key
+     */
+    const JsonValue* findMember(const JsonObject& object, const std::string& key) {
+        std::string decoded;
+
+        for(JsonObject::ConstIterator entry = object.begin(); entry != object.end(); ++entry) {
+            decodeKey(entry -> key, decoded);
+
+            if(decoded == key) {
+                return entry -> value;
+            }
+        }
+
+        return nullptr;
+    }
+
+    /**
+     * @brief Checks whether an object has a decoded key, looking the raw key up first
+     * @param object Object to search
+     * @param key Decoded key to find
+     * @return True if the object has the key, false otherwise
+     */
+    bool hasKey(const JsonObject& object, const std::string& key) {
+        return object.containsKey(key) || findMember(object, key) != nullptr;
+    }
+
+    /**
+     * @brief Checks whether a number has no fractional part
+     * @param number Number to check
+     * @return True if the number is an integer, false otherwise
+     */
+    bool isIntegral(const JsonNumber& number) {
+        if(number.getNumberType() != NumberType::Double) {
+            return true;
+        }
+
+        const double value = number.getDouble();
+
+        return std::isfinite(value) && std::trunc(value) == value;
+    }
+
+    /**
+     * @brief Copies a number in the representation it is stored in
+     * @param number Number to copy
+     * @return The number as a numeric keyword limit
+     */
+    SchemaNumber toSchemaNumber(const JsonNumber& number) {
+        SchemaNumber result = {number.getNumberType(), 0, 0, number.getDouble()};
+
+        if(result.type == NumberType::Integer) {
+            result.integer = number.getInt64();
+        } else if(result.type == NumberType::UnsignedInteger) {
+            result.unsignedInteger = number.getUint64();
+        }
+
+        return result;
+    }
+
+    /**
+     * @brief Compares a double with an integer exactly
+     * @param floating Double to compare
+     * @param integer Integer to compare, of NumberType::Integer or NumberType::UnsignedInteger
+     * @return Negative if the double is smaller, 0 if equal, positive if greater
+     */
+    int compareWithInteger(const double floating, const SchemaNumber& integer) {
+        const bool isUnsigned = integer.type == NumberType::UnsignedInteger;
+        const double rounded = isUnsigned ? static_cast<double>(integer.unsignedInteger) : static_cast<double>(integer.integer);
+
+        if(floating != rounded) {
+            return floating < rounded ? -1 : 1;
+        }
+
+        if(floating >= 9223372036854775808.0) {
+            if(!isUnsigned || floating >= 18446744073709551616.0) {
+                return 1;
+            }
+
+            const uint64_t value = static_cast<uint64_t>(floating);
+
+            return value < integer.unsignedInteger ? -1 : value > integer.unsignedInteger ? 1 : 0;
+        }
+
+        if(isUnsigned) {
+            return -1;
+        }
+
+        const int64_t value = static_cast<int64_t>(floating);
+
+        return value < integer.integer ? -1 : value > integer.integer ? 1 : 0;
+    }
+
+    /**
+     * @brief Compares two numbers exactly, whatever representation each is stored in
+     * @param first First number
+     * @param second Second number
+     * @return Negative if the first is smaller, 0 if equal, positive if greater
+     */
+    int compareNumbers(const SchemaNumber& first, const SchemaNumber& second) {
+        if(first.type == NumberType::Double && second.type == NumberType::Double) {
+            return first.floating < second.floating ? -1 : first.floating > second.floating ? 1 : 0;
+        }
+
+        if(first.type == NumberType::Double) {
+            return compareWithInteger(first.floating, second);
+        }
+
+        if(second.type == NumberType::Double) {
+            return -compareWithInteger(second.floating, first);
+        }
+
+        if(first.type != second.type) {
+            return first.type == NumberType::UnsignedInteger ? 1 : -1;
+        }
+
+        if(first.type == NumberType::UnsignedInteger) {
+            return first.unsignedInteger < second.unsignedInteger ? -1 : first.unsignedInteger > second.unsignedInteger ? 1 : 0;
+        }
+
+        return first.integer < second.integer ? -1 : first.integer > second.integer ? 1 : 0;
+    }
+
+    /**
+     * @brief Checks whether a number is a multiple of a positive divisor
+     * @param number Number to check
+     * @param divisor Value of "multipleOf"
+     * @return True if dividing the number by the divisor gives an integer, false otherwise
+     */
+    bool isMultipleOf(const JsonNumber& number, const SchemaNumber& divisor) {
+        const bool isIntegerDivisor = divisor.type != NumberType::Double
+            || (std::trunc(divisor.floating) == divisor.floating && divisor.floating < 18446744073709551616.0);
+
+        if(number.getNumberType() != NumberType::Double && isIntegerDivisor) {
+            const uint64_t magnitude = number.getNumberType() == NumberType::UnsignedInteger ? number.getUint64()
+                : number.getInt64() < 0 ? 0 - static_cast<uint64_t>(number.getInt64()) : static_cast<uint64_t>(number.getInt64());
+            const uint64_t divisorMagnitude = divisor.type == NumberType::Integer ? static_cast<uint64_t>(divisor.integer)
+                : divisor.type == NumberType::UnsignedInteger ? divisor.unsignedInteger : static_cast<uint64_t>(divisor.floating);
+
+            return magnitude % divisorMagnitude == 0;
+        }
+
+        const double quotient = number.getDouble() / divisor.floating;
+
+        return std::isfinite(quotient) && std::fabs(quotient - std::nearbyint(quotient)) < 1e-9;
+    }
+
+    /**
+     * @brief Appends the canonical form of a value, equal for exactly the values JSON Schema considers equal
+     * @param value Value to encode
+     * @param result String to append to
+     */
+    void appendCanonical(const JsonValue& value, std::string& result) {
+        switch(value.getType()) {
+            case ValueType::Null:
+                result += 'n';
+                break;
+            case ValueType::Boolean:
+                result += static_cast<const JsonBoolean&>(value).getValue() ? 't' : 'f';
+                break;
+            case ValueType::Number: {
+                const JsonNumber& number = static_cast<const JsonNumber&>(value);
+                const double floating = number.getDouble();
+
+                if(number.getNumberType() == NumberType::Integer) {
+                    result += 'i' + std::to_string(number.getInt64());
+                }
+                else if(number.getNumberType() == NumberType::UnsignedInteger) {
+                    result += 'i' + std::to_string(number.getUint64());
+                }
+                else if(std::trunc(floating) == floating && floating >= -9223372036854775808.0 && floating < 9223372036854775808.0) {
+                    result += 'i' + std::to_string(static_cast<long long>(floating));
+                }
+                else if(std::trunc(floating) == floating && floating >= 0 && floating < 18446744073709551616.0) {
+                    result += 'i' + std::to_string(static_cast<unsigned long long>(floating));
+                }
+                else {
+                    char buffer[32];
+
+                    snprintf(buffer, sizeof(buffer), "d%.17g", floating);
+                    result += buffer;
+                }
+
+                result += ';';
+                break;
+            }
+            case ValueType::String: {
+                std::string text;
+
+                decodeString(static_cast<const JsonString&>(value), text);
+                result += 's' + std::to_string(text.length()) + ':' + text;
+                break;
+            }
+            case ValueType::Array: {
+                const JsonArray& array = static_cast<const JsonArray&>(value);
+
+                result += '[';
+
+                for(size_t i = 0; i < array.getSize(); i++) {
+                    appendCanonical(*array[i], result);
+                }
+
+                result += ']';
+                break;
+            }
+            case ValueType::Object:
+            default: {
+                const JsonObject& object = static_cast<const JsonObject&>(value);
+                std::vector<std::pair<std::string, const JsonValue*>> members;
+
+                for(JsonObject::ConstIterator entry = object.begin(); entry != object.end(); ++entry) {
+                    members.push_back(std::make_pair(std::string(), entry -> value));
+                    decodeKey(entry -> key, members.back().first);
+                }
+
+                std::sort(members.begin(), members.end(), [](const std::pair<std::string, const JsonValue*>& left,
+                    const std::pair<std::string, const JsonValue*>& right) {
+                    return left.first < right.first;
+                });
+
+                result += '{';
+
+                for(const std::pair<std::string, const JsonValue*>& member : members) {
+                    result += 's' + std::to_string(member.first.length()) + ':' + member.first;
+                    appendCanonical(*member.second, result);
+                }
+
+                result += '}';
+                break;
+            }
+        }
+    }
+
+    /**
+     * @brief Escapes a key or index as a JSON pointer token
+     * @param token Token to escape
+     * @return Token with '~' written as "~0" and '/' as "~1"
+     */
+    std::string escapeToken(const std::string& token) {
+        std::string result;
+
+        for(const char symbol : token) {
+            if(symbol == '~') {
+                result += "~0";
+            }
+            else if(symbol == '/') {
+                result += "~1";
+            }
+            else {
+                result += symbol;
+            }
+        }
+
+        return result;
+    }
+
+    /**
+     * @brief Decodes the percent-escapes of the fragment of a URI
+     * @param fragment Fragment to decode
+     * @return Decoded fragment
+     */
+    std::string percentDecode(const std::string& fragment) {
+        std::string result;
+
+        for(size_t i = 0; i < fragment.length(); i++) {
+            if(fragment[i] == '%' && i + 2 < fragment.length() && std::isxdigit(static_cast<unsigned char>(fragment[i + 1]))
+                && std::isxdigit(static_cast<unsigned char>(fragment[i + 2]))) {
+                result += static_cast<char>(std::stoi(fragment.substr(i + 1, 2), nullptr, 16));
+                i += 2;
+            }
+            else {
+                result += fragment[i];
+            }
+        }
+
+        return result;
+    }
+
+    /**
+     * @brief Resolves a URI reference against a base URI. Dot segments are not normalized
+     * @param base Base URI without a fragment, empty for a schema without $id
+     * @param reference Reference without a fragment
+     * @return Resolved URI
+     */
+    std::string resolveUri(const std::string& base, const std::string& reference) {
+        const size_t colon = reference.find(':');
+        const size_t slash = reference.find('/');
+
+        if(reference.empty()) {
+            return base;
+        }
+
+        if(colon != std::string::npos && (slash == std::string::npos || colon < slash)) {
+            return reference;
+        }
+
+        if(reference[0] == '/') {
+            const size_t scheme = base.find("://");
+            const size_t root = scheme == std::string::npos ? std::string::npos : base.find('/', scheme + 3);
+
+            return scheme == std::string::npos ? reference : base.substr(0, root) + reference;
+        }
+
+        const size_t last = base.rfind('/');
+
+        return last == std::string::npos ? reference : base.substr(0, last + 1) + reference;
+    }
+
+    /**
+     * @brief Schema resource or anchor a $ref can point to
+     */
+    struct SchemaResource {
+        const JsonValue* schema;  ///< Subschema identified
+        std::string base;         ///< Base URI inside the subschema
+        std::string location;     ///< JSON pointer of the subschema from the root
+    };
+
+    /**
+     * @brief $ref waiting for the whole schema to be indexed
+     */
+    struct PendingReference {
+        size_t slot;            ///< Entry of SchemaProgram::references receiving the subschema
+        std::string reference;  ///< Value of the keyword
+        std::string base;       ///< Base URI of the subschema holding the keyword
+        std::string location;   ///< JSON pointer of the keyword
+    };
+
+    /**
+     * @brief Builds the program of a schema, resolving every $ref ahead of time
+     */
+    class SchemaCompiler {
+        public:
+            /**
+             * @brief Constructor that initializes the program to fill
+             * @param _program Empty program
+             */
+            SchemaCompiler(SchemaProgram& _program) : program(_program) {}
+
+            /**
+             * @brief Compiles a whole schema into the program
+             * @param schema Root of the schema
+             * @throws std::runtime_error if the schema cannot be compiled
+             */
+            void compileRoot(const JsonValue& schema) {
+                resources[""] = SchemaResource{&schema, "", "#"};
+                index(schema, "", "#");
+                compile(schema, "", "#");
+
+                for(size_t i = 0; i < pending.size(); i++) {
+                    const PendingReference reference = pending[i];
+                    const size_t node = resolve(reference);
+
+                    program.references[reference.slot] = node;
+                }
+            }
+        private:
+            SchemaProgram& program;                                    ///< Program being built
+            std::unordered_map<std::string, SchemaResource> resources;  ///< Subschemas by URI, anchors by URI#anchor
+            std::unordered_map<const JsonValue*, size_t> compiled;      ///< Node of each subschema compiled so far
+            std::unordered_map<std::string, size_t> patterns;           ///< Regex of each pattern compiled so far
+            std::vector<PendingReference> pending;                      ///< References to resolve once the root is compiled
+
+            /**
+             * @brief Gets a member of a subschema, which must be an object
+             * @param schema Subschema
+             * @param keyword Name of the member
+             * @return Value of the member, nullptr if absent
+             */
+            static const JsonValue* member(const JsonValue& schema, const std::string& keyword) {
+                return findMember(static_cast<const JsonObject&>(schema), keyword);
+            }
+
+            /**
+             * @brief Reports a keyword whose value has the wrong form
+             * @param keyword Name of the keyword
+             * @param location JSON pointer of the subschema
+             * @param expected What the value should have been
+             * @throws std::runtime_error always
+             */
+            [[noreturn]] static void malformed(const std::string& keyword, const std::string& location, const std::string& expected) {
+                throw std::runtime_error("Keyword \"" + keyword + "\" of the schema at " + location + " must be " + expected + ".\n");
+            }
+
+            /**
+             * @brief Rejects the keywords of the vocabularies the program does not implement
+             * @param schema Subschema, an object
+             * @param location JSON pointer of the subschema
+             * @throws std::runtime_error if the subschema uses an unsupported keyword
+             */
+            static void rejectUnsupported(const JsonValue& schema, const std::string& location) {
+                static const char* const UnevaluatedKeywords[] = {"unevaluatedItems", "unevaluatedProperties"};
+
+                if(member(schema, "$dynamicRef") != nullptr) {
+                    unsupported("$dynamicRef", location);
+                }
+
+                for(const char* keyword : UnevaluatedKeywords) {
+                    const JsonValue* value = member(schema, keyword);
+
+                    if(value != nullptr && !(value -> getType() == ValueType::Boolean && static_cast<const JsonBoolean&>(*value).getValue())) {
+                        unsupported(keyword, location);
+                    }
+                }
+            }
+
+            /**
+             * @brief Reports a keyword the program does not implement
+             * @param keyword Name of the keyword
+             * @param location JSON pointer of the subschema
+             * @throws std::runtime_error always
+             */
+            [[noreturn]] static void unsupported(const std::string& keyword, const std::string& location) {
+                throw std::runtime_error("Keyword \"" + keyword + "\" of the schema at " + location + " is not supported.\n");
+            }
+
+            /**
+             * @brief Reads a string keyword
+             * @param value Value of the keyword
+             * @param keyword Name of the keyword
+             * @param location JSON pointer of the subschema
+             * @return Decoded string
+             * @throws std::runtime_error if the value is not a string
+             */
+            static std::string readString(const JsonValue& value, const std::string& keyword, const std::string& location) {
+                std::string result;
+
+                if(value.getType() != ValueType::String) {
+                    malformed(keyword, location, "a string");
+                }
+
+                decodeString(static_cast<const JsonString&>(value), result);
+                return result;
+            }
+
+            /**
+             * @brief Reads a numeric keyword
+             * @param value Value of the keyword
+             * @param keyword Name of the keyword
+             * @param location JSON pointer of the subschema
+             * @return The number in the representation it was read in
+             * @throws std::runtime_error if the value is not a number
+             */
+            static SchemaNumber readNumber(const JsonValue& value, const std::string& keyword, const std::string& location) {
+                if(value.getType() != ValueType::Number) {
+                    malformed(keyword, location, "a number");
+                }
+
+                return toSchemaNumber(static_cast<const JsonNumber&>(value));
+            }
+
+            /**
+             * @brief Reads a keyword holding a count
+             * @param value Value of the keyword
+             * @param keyword Name of the keyword
+             * @param location JSON pointer of the subschema
+             * @return The count
+             * @throws std::runtime_error if the value is not a non-negative integer
+             */
+            static size_t readCount(const JsonValue& value, const std::string& keyword, const std::string& location) {
+                if(value.getType() != ValueType::Number || !isIntegral(static_cast<const JsonNumber&>(value))
+                    || static_cast<const JsonNumber&>(value).getDouble() < 0) {
+                    malformed(keyword, location, "a non-negative integer");
+                }
+
+                const double count = static_cast<const JsonNumber&>(value).getDouble();
+
+                return count < 18446744073709551616.0 ? static_cast<size_t>(count) : NoNode;
+            }
+
+            /**
+             * @brief Reads a keyword holding a list of unique strings into the names table
+             * @param value Value of the keyword
+             * @param keyword Name of the keyword
+             * @param location JSON pointer of the subschema
+             * @return Index of the first name, the count being the array's size
+             * @throws std::runtime_error if the value is not an array of strings
+             */
+            size_t readNames(const JsonValue& value, const std::string& keyword, const std::string& location) {
+                const size_t first = program.names.size();
+
+                if(value.getType() != ValueType::Array) {
+                    malformed(keyword, location, "an array of strings");
+                }
+
+                const JsonArray& array = static_cast<const JsonArray&>(value);
+
+                for(size_t i = 0; i < array.getSize(); i++) {
+                    program.names.push_back(readString(*array[i], keyword, location));
+                }
+
+                return first;
+            }
+
+            /**
+             * @brief Compiles a pattern once, sharing the regex between every keyword using it
+             * @param pattern ECMA-262 regular expression
+             * @param location JSON pointer of the subschema
+             * @return Index of the regex
+             * @throws std::runtime_error if the pattern is not a valid regex
+             */
+            size_t addRegex(const std::string& pattern, const std::string& location) {
+                std::unordered_map<std::string, size_t>::const_iterator found = patterns.find(pattern);
+
+                if(found != patterns.end()) {
+                    return found -> second;
+                }
+
+                try {
+                    program.regexes.push_back(std::regex(pattern, std::regex::ECMAScript));
+                }
+                catch(const std::regex_error& error) {
+                    throw std::runtime_error("Pattern \"" + pattern + "\" of the schema at " + location + " is not a valid regex.\n");
+                }
+
+                patterns[pattern] = program.regexes.size() - 1;
+                return program.regexes.size() - 1;
+            }
+
+            /**
+             * @brief Records the resources and anchors of a subschema and of every subschema inside it
+             * @param schema Subschema
+             * @param base Base URI of the enclosing subschema
+             * @param location JSON pointer of the subschema
+             */
+            void index(const JsonValue& schema, const std::string& base, const std::string& location) {
+                static const char* const SingleKeywords[] = {"additionalProperties", "propertyNames", "items", "contains",
+                    "not", "if", "then", "else", "unevaluatedItems", "unevaluatedProperties"};
+                static const char* const MapKeywords[] = {"$defs", "properties", "patternProperties", "dependentSchemas"};
+                static const char* const ListKeywords[] = {"prefixItems", "allOf", "anyOf", "oneOf"};
+
+                if(schema.getType() != ValueType::Object) {
+                    return;
+                }
+
+                const std::string current = rebase(schema, base);
+                const JsonValue* anchors[] = {member(schema, "$anchor"), member(schema, "$dynamicAnchor")};
+
+                if(current != base) {
+                    resources[current] = SchemaResource{&schema, current, location};
+                }
+
+                for(const JsonValue* anchor : anchors) {
+                    if(anchor != nullptr && anchor -> getType() == ValueType::String) {
+                        resources[current + "#" + readString(*anchor, "$anchor", location)] = SchemaResource{&schema, current, location};
+                    }
+                }
+
+                for(const char* keyword : SingleKeywords) {
+                    const JsonValue* value = member(schema, keyword);
+
+                    if(value != nullptr) {
+                        index(*value, current, location + "/" + keyword);
+                    }
+                }
+
+                for(const char* keyword : MapKeywords) {
+                    const JsonValue* value = member(schema, keyword);
+
+                    if(value != nullptr && value -> getType() == ValueType::Object) {
+                        const JsonObject& object = static_cast<const JsonObject&>(*value);
+                        std::string key;
+
+                        for(JsonObject::ConstIterator entry = object.begin(); entry != object.end(); ++entry) {
+                            decodeKey(entry -> key, key);
+                            index(*entry -> value, current, location + "/" + keyword + "/" + escapeToken(key));
+                        }
+                    }
+                }
+
+                for(const char* keyword : ListKeywords) {
+                    const JsonValue* value = member(schema, keyword);
+
+                    if(value != nullptr && value -> getType() == ValueType::Array) {
+                        const JsonArray& array = static_cast<const JsonArray&>(*value);
+
+                        for(size_t i = 0; i < array.getSize(); i++) {
+                            index(*array[i], current, location + "/" + keyword + "/" + std::to_string(i));
+                        }
+                    }
+                }
+            }
+
+            /**
+             * @brief Gets the base URI inside a subschema
+             * @param schema Subschema, an object
+             * @param base Base URI of the enclosing subschema
+             * @return Base changed by the subschema's $id, or the enclosing one
+             */
+            static std::string rebase(const JsonValue& schema, const std::string& base) {
+                const JsonValue* id = member(schema, "$id");
+
+                if(id == nullptr || id -> getType() != ValueType::String) {
+                    return base;
+                }
+
+                const std::string address = readString(*id, "$id", "");
+
+                return resolveUri(base, address.substr(0, address.find('#')));
+            }
+
+            /**
+             * @brief Compiles a list of subschemas into the children table
+             * @param value Value of the keyword
+             * @param keyword Name of the keyword
+             * @param base Base URI of the subschema holding the keyword
+             * @param location JSON pointer of the subschema holding the keyword
+             * @param isEmptyAllowed Whether the list may be empty
+             * @return Index of the first child, the count being the array's size
+             * @throws std::runtime_error if the value is not an array of schemas
+             */
+            size_t compileList(const JsonValue& value, const std::string& keyword, const std::string& base,
+                const std::string& location, const bool isEmptyAllowed) {
+                if(value.getType() != ValueType::Array || (!isEmptyAllowed && static_cast<const JsonArray&>(value).getSize() == 0)) {
+                    malformed(keyword, location, "a non-empty array of schemas");
+                }
+
+                const JsonArray& array = static_cast<const JsonArray&>(value);
+                std::vector<size_t> nodes;
+
+                for(size_t i = 0; i < array.getSize(); i++) {
+                    nodes.push_back(compile(*array[i], base, location + "/" + keyword + "/" + std::to_string(i)));
+                }
+
+                const size_t first = program.children.size();
+
+                program.children.insert(program.children.end(), nodes.begin(), nodes.end());
+                return first;
+            }
+
+            /**
+             * @brief Compiles a subschema and every subschema inside it, once per subschema
+             * @param schema Subschema
+             * @param base Base URI of the enclosing subschema
+             * @param location JSON pointer of the subschema
+             * @return Node of the subschema
+             * @throws std::runtime_error if the subschema cannot be compiled
+             */
+            size_t compile(const JsonValue& schema, const std::string& base, const std::string& location) {
+                std::unordered_map<const JsonValue*, size_t>::const_iterator found = compiled.find(&schema);
+
+                if(found != compiled.end()) {
+                    return found -> second;
+                }
+
+                const size_t node = program.nodes.size();
+
+                program.nodes.push_back(SchemaNode());
+                program.nodes[node].isFalse = false;
+                program.nodes[node].location = location;
+                compiled[&schema] = node;
+
+                if(schema.getType() == ValueType::Boolean) {
+                    program.nodes[node].isFalse = !static_cast<const JsonBoolean&>(schema).getValue();
+                    return node;
+                }
+
+                if(schema.getType() != ValueType::Object) {
+                    throw std::runtime_error("The schema at " + location + " must be an object or a boolean.\n");
+                }
+
+                std::vector<SchemaCheck> checks[TypeCount];
+
+                compileKeywords(schema, rebase(schema, base), location, checks);
+
+                for(size_t type = 0; type < TypeCount; type++) {
+                    program.nodes[node].checks[type].swap(checks[type]);
+                }
+
+                return node;
+            }
+
+            /**
+             * @brief Adds a check to the lists of the types it applies to
+             * @param checks Check list of each type
+             * @param types Mask of the types
+             * @param check Check to add
+             */
+            static void add(std::vector<SchemaCheck>* checks, const unsigned types, const SchemaCheck& check) {
+                for(size_t type = 0; type < TypeCount; type++) {
+                    if(types & (1u << type)) {
+                        checks[type].push_back(check);
+                    }
+                }
+            }
+
+            /**
+             * @brief Compiles the keywords of an object subschema, cheapest checks first
+             * @param schema Subschema
+             * @param base Base URI inside the subschema
+             * @param location JSON pointer of the subschema
+             * @param checks Check list of each type receiving the checks
+             * @throws std::runtime_error if a keyword is malformed
+             */
+            void compileKeywords(const JsonValue& schema, const std::string& base, const std::string& location,
+                std::vector<SchemaCheck>* checks) {
+                const unsigned anyType = (1u << TypeCount) - 1;
+                const unsigned numberType = typeBit(ValueType::Number);
+                const unsigned stringType = typeBit(ValueType::String);
+                const unsigned arrayType = typeBit(ValueType::Array);
+                const unsigned objectType = typeBit(ValueType::Object);
+                const JsonValue* value = nullptr;
+
+                rejectUnsupported(schema, location);
+
+                if((value = member(schema, "type")) != nullptr) {
+                    compileType(*value, location, checks);
+                }
+
+                if((value = member(schema, "const")) != nullptr) {
+                    program.names.push_back(std::string());
+                    appendCanonical(*value, program.names.back());
+                    add(checks, anyType, SchemaCheck{SchemaKeyword::Const, program.names.size() - 1, 0, 0});
+                }
+
+                if((value = member(schema, "enum")) != nullptr) {
+                    if(value -> getType() != ValueType::Array) {
+                        malformed("enum", location, "an array");
+                    }
+
+                    const JsonArray& array = static_cast<const JsonArray&>(*value);
+
+                    program.sets.push_back(std::unordered_set<std::string>());
+
+                    for(size_t i = 0; i < array.getSize(); i++) {
+                        std::string canonical;
+
+                        appendCanonical(*array[i], canonical);
+                        program.sets.back().insert(canonical);
+                    }
+
+                    add(checks, anyType, SchemaCheck{SchemaKeyword::Enum, program.sets.size() - 1, 0, 0});
+                }
+
+                static const SchemaKeyword NumberKeywords[] = {SchemaKeyword::Minimum, SchemaKeyword::ExclusiveMinimum,
+                    SchemaKeyword::Maximum, SchemaKeyword::ExclusiveMaximum, SchemaKeyword::MultipleOf};
+
+                for(const SchemaKeyword keyword : NumberKeywords) {
+                    const std::string name = KeywordNames[static_cast<size_t>(keyword)];
+
+                    if((value = member(schema, name)) != nullptr) {
+                        const SchemaNumber limit = readNumber(*value, name, location);
+
+                        if(keyword == SchemaKeyword::MultipleOf && !(limit.floating > 0)) {
+                            malformed(name, location, "greater than 0");
+                        }
+
+                        program.numbers.push_back(limit);
+                        add(checks, numberType, SchemaCheck{keyword, program.numbers.size() - 1, 0, 0});
+                    }
+                }
+
+                static const SchemaKeyword CountKeywords[] = {SchemaKeyword::MinLength, SchemaKeyword::MaxLength,
+                    SchemaKeyword::MinItems, SchemaKeyword::MaxItems, SchemaKeyword::MinProperties, SchemaKeyword::MaxProperties};
+                const unsigned countTypes[] = {stringType, stringType, arrayType, arrayType, objectType, objectType};
+
+                for(size_t i = 0; i < sizeof(CountKeywords) / sizeof(CountKeywords[0]); i++) {
+                    const std::string name = KeywordNames[static_cast<size_t>(CountKeywords[i])];
+
+                    if((value = member(schema, name)) != nullptr) {
+                        add(checks, countTypes[i], SchemaCheck{CountKeywords[i], readCount(*value, name, location), 0, 0});
+                    }
+                }
+
+                if((value = member(schema, "required")) != nullptr) {
+                    const size_t first = readNames(*value, "required", location);
+
+                    add(checks, objectType, SchemaCheck{SchemaKeyword::Required, first, program.names.size() - first, 0});
+                }
+
+                if((value = member(schema, "dependentRequired")) != nullptr) {
+                    compileDependencies(*value, "dependentRequired", base, location, checks);
+                }
+
+                if((value = member(schema, "pattern")) != nullptr) {
+                    const size_t regex = addRegex(readString(*value, "pattern", location), location);
+
+                    add(checks, stringType, SchemaCheck{SchemaKeyword::Pattern, regex, 0, 0});
+                }
+
+                if((value = member(schema, "uniqueItems")) != nullptr) {
+                    if(value -> getType() != ValueType::Boolean) {
+                        malformed("uniqueItems", location, "a boolean");
+                    }
+
+                    if(static_cast<const JsonBoolean&>(*value).getValue()) {
+                        add(checks, arrayType, SchemaCheck{SchemaKeyword::UniqueItems, 0, 0, 0});
+                    }
+                }
+
+                compileArrayKeywords(schema, base, location, checks);
+                compileObjectKeywords(schema, base, location, checks);
+
+                static const SchemaKeyword ListKeywords[] = {SchemaKeyword::AllOf, SchemaKeyword::AnyOf, SchemaKeyword::OneOf};
+
+                for(const SchemaKeyword keyword : ListKeywords) {
+                    const std::string name = KeywordNames[static_cast<size_t>(keyword)];
+
+                    if((value = member(schema, name)) != nullptr) {
+                        const size_t first = compileList(*value, name, base, location, false);
+
+                        add(checks, anyType, SchemaCheck{keyword, first, program.children.size() - first, 0});
+                    }
+                }
+
+                if((value = member(schema, "not")) != nullptr) {
+                    add(checks, anyType, SchemaCheck{SchemaKeyword::Not, compile(*value, base, location + "/not"), 0, 0});
+                }
+
+                if((value = member(schema, "if")) != nullptr) {
+                    const JsonValue* then = member(schema, "then");
+                    const JsonValue* otherwise = member(schema, "else");
+                    const size_t condition = compile(*value, base, location + "/if");
+                    const size_t thenNode = then != nullptr ? compile(*then, base, location + "/then") : NoNode;
+                    const size_t elseNode = otherwise != nullptr ? compile(*otherwise, base, location + "/else") : NoNode;
+
+                    add(checks, anyType, SchemaCheck{SchemaKeyword::If, condition, thenNode, elseNode});
+                }
+
+                if((value = member(schema, "$ref")) != nullptr) {
+                    pending.push_back(PendingReference{program.references.size(), readString(*value, "$ref", location), base,
+                        location + "/$ref"});
+                    program.references.push_back(NoNode);
+                    add(checks, anyType, SchemaCheck{SchemaKeyword::Ref, program.references.size() - 1, 0, 0});
+                }
+            }
+
+            /**
+             * @brief Compiles "type" into a check for each type it rejects, so accepted types pay nothing for it
+             * @param value Value of the keyword
+             * @param location JSON pointer of the subschema
+             * @param checks Check list of each type
+             * @throws std::runtime_error if the value is not a type name or an array of them
+             */
+            static void compileType(const JsonValue& value, const std::string& location, std::vector<SchemaCheck>* checks) {
+                static const char* const TypeNames[] = {"null", "boolean", "number", "string", "array", "object", "integer"};
+                std::vector<const JsonValue*> names;
+                unsigned mask = 0;
+
+                if(value.getType() == ValueType::Array) {
+                    const JsonArray& array = static_cast<const JsonArray&>(value);
+
+                    for(size_t i = 0; i < array.getSize(); i++) {
+                        names.push_back(array[i]);
+                    }
+                }
+                else {
+                    names.push_back(&value);
+                }
+
+                for(const JsonValue* name : names) {
+                    const std::string type = name -> getType() == ValueType::String ? readString(*name, "type", location) : "";
+                    const size_t bit = std::find(TypeNames, TypeNames + TypeCount + 1, type) - TypeNames;
+
+                    if(bit > TypeCount) {
+                        malformed("type", location, "a type name or an array of them");
+                    }
+
+                    mask |= 1u << bit;
+                }
+
+                if(mask & typeBit(ValueType::Number)) {
+                    mask |= IntegerBit;
+                }
+
+                add(checks, ~mask & ((1u << TypeCount) - 1), SchemaCheck{SchemaKeyword::Type, mask, 0, 0});
+            }
+
+            /**
+             * @brief Compiles "dependentRequired" or "dependentSchemas"
+             * @param value Value of the keyword
+             * @param keyword Name of the keyword
+             * @param base Base URI inside the subschema
+             * @param location JSON pointer of the subschema
+             * @param checks Check list of each type
+             * @throws std::runtime_error if the value is malformed
+             */
+            void compileDependencies(const JsonValue& value, const std::string& keyword, const std::string& base,
+                const std::string& location, std::vector<SchemaCheck>* checks) {
+                const bool isRequired = keyword == "dependentRequired";
+
+                if(value.getType() != ValueType::Object) {
+                    malformed(keyword, location, "an object");
+                }
+
+                const JsonObject& object = static_cast<const JsonObject&>(value);
+                std::vector<Dependency> dependencies;
+
+                for(JsonObject::ConstIterator entry = object.begin(); entry != object.end(); ++entry) {
+                    Dependency dependency{std::string(), 0, 0};
+
+                    decodeKey(entry -> key, dependency.key);
+
+                    if(isRequired) {
+                        dependency.first = readNames(*entry -> value, keyword, location);
+                        dependency.count = program.names.size() - dependency.first;
+                    }
+                    else {
+                        dependency.first = compile(*entry -> value, base, location + "/" + keyword + "/" + escapeToken(dependency.key));
+                    }
+
+                    dependencies.push_back(dependency);
+                }
+
+                const size_t first = program.dependencies.size();
+                const SchemaKeyword check = isRequired ? SchemaKeyword::DependentRequired : SchemaKeyword::DependentSchemas;
+
+                program.dependencies.insert(program.dependencies.end(), dependencies.begin(), dependencies.end());
+                add(checks, typeBit(ValueType::Object), SchemaCheck{check, first, dependencies.size(), 0});
+            }
+
+            /**
+             * @brief Compiles "prefixItems", "items" and "contains" with its bounds
+             * @param schema Subschema
+             * @param base Base URI inside the subschema
+             * @param location JSON pointer of the subschema
+             * @param checks Check list of each type
+             * @throws std::runtime_error if a keyword is malformed
+             */
+            void compileArrayKeywords(const JsonValue& schema, const std::string& base, const std::string& location,
+                std::vector<SchemaCheck>* checks) {
+                const unsigned arrayType = typeBit(ValueType::Array);
+                const JsonValue* value = member(schema, "prefixItems");
+                size_t prefixCount = 0;
+
+                if(value != nullptr) {
+                    const size_t first = compileList(*value, "prefixItems", base, location, false);
+
+                    prefixCount = program.children.size() - first;
+                    add(checks, arrayType, SchemaCheck{SchemaKeyword::PrefixItems, first, prefixCount, 0});
+                }
+
+                if((value = member(schema, "items")) != nullptr) {
+                    add(checks, arrayType, SchemaCheck{SchemaKeyword::Items, compile(*value, base, location + "/items"), prefixCount, 0});
+                }
+
+                if((value = member(schema, "contains")) != nullptr) {
+                    const JsonValue* minimum = member(schema, "minContains");
+                    const JsonValue* maximum = member(schema, "maxContains");
+                    const size_t node = compile(*value, base, location + "/contains");
+                    const size_t lower = minimum != nullptr ? readCount(*minimum, "minContains", location) : 1;
+                    const size_t upper = maximum != nullptr ? readCount(*maximum, "maxContains", location) : NoNode;
+
+                    add(checks, arrayType, SchemaCheck{SchemaKeyword::Contains, node, lower, upper});
+                }
+            }
+
+            /**
+             * @brief Compiles the keywords applying subschemas to the members of objects
+             * @param schema Subschema
+             * @param base Base URI inside the subschema
+             * @param location JSON pointer of the subschema
+             * @param checks Check list of each type
+             * @throws std::runtime_error if a keyword is malformed
+             */
+            void compileObjectKeywords(const JsonValue& schema, const std::string& base, const std::string& location,
+                std::vector<SchemaCheck>* checks) {
+                const unsigned objectType = typeBit(ValueType::Object);
+                const JsonValue* properties = member(schema, "properties");
+                const JsonValue* patternProperties = member(schema, "patternProperties");
+                const JsonValue* additional = member(schema, "additionalProperties");
+                const JsonValue* value = nullptr;
+
+                if(properties != nullptr || patternProperties != nullptr || additional != nullptr) {
+                    PropertyRules rules{std::unordered_map<std::string, size_t>(), std::vector<std::pair<size_t, size_t>>(), NoNode};
+                    const JsonValue* maps[] = {properties, patternProperties};
+                    const char* const names[] = {"properties", "patternProperties"};
+
+                    for(size_t i = 0; i < 2; i++) {
+                        if(maps[i] == nullptr) {
+                            continue;
+                        }
+
+                        if(maps[i] -> getType() != ValueType::Object) {
+                            malformed(names[i], location, "an object");
+                        }
+
+                        const JsonObject& object = static_cast<const JsonObject&>(*maps[i]);
+                        std::string key;
+
+                        for(JsonObject::ConstIterator entry = object.begin(); entry != object.end(); ++entry) {
+                            decodeKey(entry -> key, key);
+
+                            const size_t node = compile(*entry -> value, base, location + "/" + names[i] + "/" + escapeToken(key));
+
+                            if(i == 0) {
+                                rules.properties[key] = node;
+                            }
+                            else {
+                                rules.patterns.push_back(std::make_pair(addRegex(key, location), node));
+                            }
+                        }
+                    }
+
+                    if(additional != nullptr) {
+                        rules.additional = compile(*additional, base, location + "/additionalProperties");
+                    }
+
+                    program.rules.push_back(rules);
+                    add(checks, objectType, SchemaCheck{SchemaKeyword::Properties, program.rules.size() - 1, 0, 0});
+                }
+
+                if((value = member(schema, "propertyNames")) != nullptr) {
+                    add(checks, objectType, SchemaCheck{SchemaKeyword::PropertyNames, compile(*value, base, location + "/propertyNames"), 0, 0});
+                }
+
+                if((value = member(schema, "dependentSchemas")) != nullptr) {
+                    compileDependencies(*value, "dependentSchemas", base, location, checks);
+                }
+            }
+
+            /**
+             * @brief Resolves a $ref to a node, compiling its target if no other keyword reached it
+             * @param reference Reference to resolve
+             * @return Node of the target
+             * @throws std::runtime_error if the reference points outside the schema or to nothing
+             */
+            size_t resolve(const PendingReference& reference) {
+                const size_t hash = reference.reference.find('#');
+                const std::string address = reference.reference.substr(0, hash);
+                const std::string fragment = hash == std::string::npos ? "" : percentDecode(reference.reference.substr(hash + 1));
+                const std::string uri = resolveUri(reference.base, address);
+                const std::string message = "Reference \"" + reference.reference + "\" at " + reference.location + " cannot be resolved.\n";
+                std::unordered_map<std::string, SchemaResource>::const_iterator resource = resources.find(uri);
+
+                if(resource == resources.end()) {
+                    throw std::runtime_error(message);
+                }
+
+                if(fragment.empty()) {
+                    return compile(*resource -> second.schema, resource -> second.base, resource -> second.location);
+                }
+
+                if(fragment[0] != '/') {
+                    resource = resources.find(uri + "#" + fragment);
+
+                    if(resource == resources.end()) {
+                        throw std::runtime_error(message);
+                    }
+
+                    return compile(*resource -> second.schema, resource -> second.base, resource -> second.location);
+                }
+
+                const JsonValue* target = resource -> second.schema;
+                size_t position = 1;
+
+                while(target != nullptr && position <= fragment.length()) {
+                    const size_t next = std::min(fragment.find('/', position), fragment.length());
+                    std::string token;
+
+                    for(size_t i = position; i < next; i++) {
+                        if(fragment[i] == '~' && i + 1 < next && (fragment[i + 1] == '0' || fragment[i + 1] == '1')) {
+                            token += fragment[++i] == '0' ? '~' : '/';
+                        }
+                        else {
+                            token += fragment[i];
+                        }
+                    }
+
+                    if(target -> getType() == ValueType::Object) {
+                        target = findMember(static_cast<const JsonObject&>(*target), token);
+                    }
+                    else if(target -> getType() == ValueType::Array && !token.empty() && token.length() < 20
+                        && token.find_first_not_of("0123456789") == std::string::npos
+                        && std::stoull(token) < static_cast<const JsonArray&>(*target).getSize()) {
+                        target = (static_cast<const JsonArray&>(*target))[std::stoull(token)];
+                    }
+                    else {
+                        target = nullptr;
+                    }
+
+                    position = next + 1;
+                }
+
+                if(target == nullptr) {
+                    throw std::runtime_error(message);
+                }
+
+                return compile(*target, resource -> second.base, resource -> second.location + fragment);
+            }
+    };
+
+    /**
+     * @brief Location and message of the first failure, collected while explaining why a value is invalid
+     */
+    struct SchemaTrace {
+        std::vector<std::string> path;  ///< Escaped tokens of the instance location being checked
+        std::string message;            ///< Message of the first failure, empty while none was found
+    };
+
+    /**
+     * @brief Runs a program against a value tree, stopping at the first failing check
+     */
+    class SchemaEvaluator {
+        public:
+            /**
+             * @brief Constructor that initializes the program to run
+             * @param _program Compiled schema
+             * @param _trace Trace receiving the first failure, nullptr to only compute the verdict
+             */
+            SchemaEvaluator(const SchemaProgram& _program, SchemaTrace* _trace) : program(_program), trace(_trace), depth(0) {}
+
+            /**
+             * @brief Checks a value against a node
+             * @param node Node to check against
+             * @param value Value to check
+             * @return True if the value is valid against the node, false otherwise
+             */
+            bool matches(const size_t node, const JsonValue& value) {
+                const SchemaNode& schema = program.nodes[node];
+
+                if(schema.isFalse) {
+                    return fail(schema, nullptr);
+                }
+
+                if(++depth > MaximumEvaluationDepth) {
+                    depth--;
+
+                    if(trace != nullptr && trace -> message.empty()) {
+                        trace -> message = "Subschemas are nested deeper than " + std::to_string(MaximumEvaluationDepth)
+                            + " levels while checking the value at " + pointer() + ", the schema may reference itself endlessly.\n";
+                    }
+
+                    return false;
+                }
+
+                const std::vector<SchemaCheck>& checks = schema.checks[static_cast<size_t>(value.getType())];
+                bool isValid = true;
+
+                for(size_t i = 0; i < checks.size() && isValid; i++) {
+                    isValid = run(checks[i], value) || fail(schema, &checks[i]);
+                }
+
+                depth--;
+                return isValid;
+            }
+        private:
+            const SchemaProgram& program;  ///< Program being run
+            SchemaTrace* trace;            ///< Trace of the current evaluation, nullptr when only the verdict matters
+            size_t depth;                  ///< Number of nested node evaluations
+
+            /**
+             * @brief Gets the JSON pointer of the value being checked
+             * @return Pointer, "the root" for the whole document
+             */
+            std::string pointer() const {
+                std::string result;
+
+                for(const std::string& token : trace -> path) {
+                    result += "/" + token;
+                }
+
+                return result.empty() ? "the root" : result;
+            }
+
+            /**
+             * @brief Records a failure in the trace unless an earlier, deeper one is already there
+             * @param schema Node that failed
+             * @param check Check that failed, nullptr for the false schema
+             * @return False
+             */
+            bool fail(const SchemaNode& schema, const SchemaCheck* check) {
+                if(trace != nullptr && trace -> message.empty()) {
+                    if(check == nullptr) {
+                        trace -> message = "The value at " + pointer() + " is rejected by the false schema at " + schema.location + ".\n";
+                    }
+                    else {
+                        trace -> message = "The value at " + pointer() + " does not satisfy \"" + KeywordNames[static_cast<size_t>(check -> keyword)]
+                            + "\" of the schema at " + schema.location + ".\n";
+                    }
+                }
+
+                return false;
+            }
+
+            /**
+             * @brief Checks a value against a node without tracing, for keywords where failing is part of passing
+             * @param node Node to check against
+             * @param value Value to check
+             * @return True if the value is valid against the node, false otherwise
+             */
+            bool test(const size_t node, const JsonValue& value) {
+                SchemaTrace* const saved = trace;
+
+                trace = nullptr;
+
+                const bool isValid = matches(node, value);
+
+                trace = saved;
+                return isValid;
+            }
+
+            /**
+             * @brief Checks a member against a node, extending the traced location by its key
+             * @param node Node to check against
+             * @param value Member to check
+             * @param key Decoded key of the member
+             * @return True if the value is valid against the node, false otherwise
+             */
+            bool matchesChild(const size_t node, const JsonValue& value, const std::string& key) {
+                if(trace == nullptr) {
+                    return matches(node, value);
+                }
+
+                trace -> path.push_back(escapeToken(key));
+
+                const bool isValid = matches(node, value);
+
+                if(isValid) {
+                    trace -> path.pop_back();
+                }
+
+                return isValid;
+            }
+
+            /**
+             * @brief Checks an element against a node, extending the traced location by its index
+             * @param node Node to check against
+             * @param value Element to check
+             * @param index Index of the element
+             * @return True if the value is valid against the node, false otherwise
+             */
+            bool matchesChild(const size_t node, const JsonValue& value, const size_t index) {
+                return trace == nullptr ? matches(node, value) : matchesChild(node, value, std::to_string(index));
+            }
+
+            /**
+             * @brief Runs one check
+             * @param check Check to run, applicable to the type of the value
+             * @param value Value to check
+             * @return True if the value passes the check, false otherwise
+             */
+            bool run(const SchemaCheck& check, const JsonValue& value) {
+                switch(check.keyword) {
+                    case SchemaKeyword::Type:
+                        return value.getType() == ValueType::Number && (check.first & IntegerBit)
+                            && isIntegral(static_cast<const JsonNumber&>(value));
+                    case SchemaKeyword::Const:
+                    case SchemaKeyword::Enum: {
+                        std::string canonical;
+
+                        appendCanonical(value, canonical);
+
+                        return check.keyword == SchemaKeyword::Const ? canonical == program.names[check.first]
+                            : program.sets[check.first].count(canonical) != 0;
+                    }
+                    case SchemaKeyword::MultipleOf:
+                        return isMultipleOf(static_cast<const JsonNumber&>(value), program.numbers[check.first]);
+                    case SchemaKeyword::Minimum:
+                        return compareNumbers(toSchemaNumber(static_cast<const JsonNumber&>(value)), program.numbers[check.first]) >= 0;
+                    case SchemaKeyword::ExclusiveMinimum:
+                        return compareNumbers(toSchemaNumber(static_cast<const JsonNumber&>(value)), program.numbers[check.first]) > 0;
+                    case SchemaKeyword::Maximum:
+                        return compareNumbers(toSchemaNumber(static_cast<const JsonNumber&>(value)), program.numbers[check.first]) <= 0;
+                    case SchemaKeyword::ExclusiveMaximum:
+                        return compareNumbers(toSchemaNumber(static_cast<const JsonNumber&>(value)), program.numbers[check.first]) < 0;
+                    case SchemaKeyword::MinLength:
+                    case SchemaKeyword::MaxLength: {
+                        const JsonString& string = static_cast<const JsonString&>(value);
+                        const size_t length = countCodePoints(string.getText() + 1, string.getText() + string.getLength() - 1);
+
+                        return check.keyword == SchemaKeyword::MinLength ? length >= check.first : length <= check.first;
+                    }
+                    case SchemaKeyword::Pattern: {
+                        std::string text;
+
+                        decodeString(static_cast<const JsonString&>(value), text);
+                        return std::regex_search(text, program.regexes[check.first]);
+                    }
+                    case SchemaKeyword::MinItems:
+                        return static_cast<const JsonArray&>(value).getSize() >= check.first;
+                    case SchemaKeyword::MaxItems:
+                        return static_cast<const JsonArray&>(value).getSize() <= check.first;
+                    case SchemaKeyword::MinProperties:
+                        return static_cast<const JsonObject&>(value).getSize() >= check.first;
+                    case SchemaKeyword::MaxProperties:
+                        return static_cast<const JsonObject&>(value).getSize() <= check.first;
+                    case SchemaKeyword::UniqueItems:
+                        return hasUniqueItems(static_cast<const JsonArray&>(value));
+                    case SchemaKeyword::PrefixItems:
+                    case SchemaKeyword::Items:
+                    case SchemaKeyword::Contains:
+                        return runArray(check, static_cast<const JsonArray&>(value));
+                    case SchemaKeyword::Required:
+                        for(size_t i = check.first; i < check.first + check.count; i++) {
+                            if(!hasKey(static_cast<const JsonObject&>(value), program.names[i])) {
+                                return false;
+                            }
+                        }
+
+                        return true;
+                    case SchemaKeyword::DependentRequired:
+                    case SchemaKeyword::DependentSchemas:
+                        return runDependencies(check, static_cast<const JsonObject&>(value));
+                    case SchemaKeyword::Properties:
+                        return runProperties(program.rules[check.first], static_cast<const JsonObject&>(value));
+                    case SchemaKeyword::PropertyNames:
+                        return runPropertyNames(check.first, static_cast<const JsonObject&>(value));
+                    case SchemaKeyword::AllOf:
+                        for(size_t i = check.first; i < check.first + check.count; i++) {
+                            if(!matches(program.children[i], value)) {
+                                return false;
+                            }
+                        }
+
+                        return true;
+                    case SchemaKeyword::AnyOf:
+                        for(size_t i = check.first; i < check.first + check.count; i++) {
+                            if(test(program.children[i], value)) {
+                                return true;
+                            }
+                        }
+
+                        return false;
+                    case SchemaKeyword::OneOf: {
+                        size_t matched = 0;
+
+                        for(size_t i = check.first; i < check.first + check.count && matched < 2; i++) {
+                            matched += test(program.children[i], value) ? 1 : 0;
+                        }
+
+                        return matched == 1;
+                    }
+                    case SchemaKeyword::Not:
+                        return !test(check.first, value);
+                    case SchemaKeyword::If:
+                        if(test(check.first, value)) {
+                            return check.count == NoNode || matches(check.count, value);
+                        }
+
+                        return check.extra == NoNode || matches(check.extra, value);
+                    case SchemaKeyword::Ref:
+                    default:
+                        return matches(program.references[check.first], value);
+                }
+            }
+
+            /**
+             * @brief Checks that no two elements of an array are equal
+             * @param array Array to check
+             * @return True if all elements differ, false otherwise
+             */
+            static bool hasUniqueItems(const JsonArray& array) {
+                std::unordered_set<std::string> seen;
+
+                for(size_t i = 0; i < array.getSize(); i++) {
+                    std::string canonical;
+
+                    appendCanonical(*array[i], canonical);
+
+                    if(!seen.insert(canonical).second) {
+                        return false;
+                    }
+                }
+
+                return true;
+            }
+
+            /**
+             * @brief Runs "prefixItems", "items" or "contains"
+             * @param check Check to run
+             * @param array Array to check
+             * @return True if the array passes the check, false otherwise
+             */
+            bool runArray(const SchemaCheck& check, const JsonArray& array) {
+                const size_t size = array.getSize();
+
+                if(check.keyword == SchemaKeyword::PrefixItems) {
+                    for(size_t i = 0; i < size && i < check.count; i++) {
+                        if(!matchesChild(program.children[check.first + i], *array[i], i)) {
+                            return false;
+                        }
+                    }
+
+                    return true;
+                }
+
+                if(check.keyword == SchemaKeyword::Items) {
+                    for(size_t i = check.count; i < size; i++) {
+                        if(!matchesChild(check.first, *array[i], i)) {
+                            return false;
+                        }
+                    }
+
+                    return true;
+                }
+
+                size_t matched = 0;
+
+                for(size_t i = 0; i < size; i++) {
+                    matched += test(check.first, *array[i]) ? 1 : 0;
+
+                    if(check.extra == NoNode ? matched >= check.count : matched > check.extra) {
+                        break;
+                    }
+                }
+
+                return matched >= check.count && (check.extra == NoNode || matched <= check.extra);
+            }
+
+            /**
+             * @brief Runs "dependentRequired" or "dependentSchemas"
+             * @param check Check to run
+             * @param object Object to check
+             * @return True if every triggered dependency holds, false otherwise
+             */
+            bool runDependencies(const SchemaCheck& check, const JsonObject& object) {
+                for(size_t i = check.first; i < check.first + check.count; i++) {
+                    const Dependency& dependency = program.dependencies[i];
+
+                    if(!hasKey(object, dependency.key)) {
+                        continue;
+                    }
+
+                    if(check.keyword == SchemaKeyword::DependentSchemas) {
+                        if(!matches(dependency.first, object)) {
+                            return false;
+                        }
+
+                        continue;
+                    }
+
+                    for(size_t name = dependency.first; name < dependency.first + dependency.count; name++) {
+                        if(!hasKey(object, program.names[name])) {
+                            return false;
+                        }
+                    }
+                }
+
+                return true;
+            }
+
+            /**
+             * @brief Checks every member of an object against the subschemas its key selects
+             * @param rules Member subschemas
+             * @param object Object to check
+             * @return True if every member is valid, false otherwise
+             */
+            bool runProperties(const PropertyRules& rules, const JsonObject& object) {
+                std::string key;
+
+                for(JsonObject::ConstIterator entry = object.begin(); entry != object.end(); ++entry) {
+                    std::unordered_map<std::string, size_t>::const_iterator named = rules.properties.end();
+                    bool isMatched = false;
+
+                    decodeKey(entry -> key, key);
+
+                    if(!rules.properties.empty() && (named = rules.properties.find(key)) != rules.properties.end()) {
+                        isMatched = true;
+
+                        if(!matchesChild(named -> second, *entry -> value, key)) {
+                            return false;
+                        }
+                    }
+
+                    for(const std::pair<size_t, size_t>& pattern : rules.patterns) {
+                        if(std::regex_search(key, program.regexes[pattern.first])) {
+                            isMatched = true;
+
+                            if(!matchesChild(pattern.second, *entry -> value, key)) {
+                                return false;
+                            }
+                        }
+                    }
+
+                    if(!isMatched && rules.additional != NoNode && !matchesChild(rules.additional, *entry -> value, key)) {
+                        return false;
+                    }
+                }
+
+                return true;
+            }
+
+            /**
+             * @brief Checks every key of an object as a string value
+             * @param node Subschema of "propertyNames"
+             * @param object Object to check
+             * @return True if every key is valid, false otherwise
+             */
+            bool runPropertyNames(const size_t node, const JsonObject& object) {
+                std::string token;
+                std::string key;
+
+                for(JsonObject::ConstIterator entry = object.begin(); entry != object.end(); ++entry) {
+                    token = "\"" + std::string(entry -> key.data(), entry -> key.length()) + "\"";
+
+                    const JsonString name(token.data(), token.length(), true);
+
+                    decodeKey(entry -> key, key);
+
+                    if(!matchesChild(node, name, key)) {
+                        return false;
+                    }
+                }
+
+                return true;
+            }
+    };
+}
+
+/**
+ * @brief Compiles a parsed schema
+ * @param schema Root of the schema, an object or a boolean
+ * @throws std::runtime_error if the schema is malformed or uses an unsupported keyword, a pattern is not a valid regex
+ * or a $ref cannot be resolved
+ */
+JsonSchema::JsonSchema(const JsonValue& schema) : program(new SchemaProgram()) {
+    try {
+        SchemaCompiler(*program).compileRoot(schema);
+    }
+    catch(...) {
+        delete program;
+        throw;
+    }
+}
+
+/**
+ * @brief Parses and compiles the text of a schema
+ * @param data Pointer to the first character of the schema's text
+ * @param length Number of characters in the text
+ * @throws std::runtime_error if the text is not valid JSON or the schema cannot be compiled
+ */
+JsonSchema::JsonSchema(const char* data, const size_t length) : program(new SchemaProgram()) {
+    try {
+        JsonArena arena;
+        JsonArena::Scope scope(arena);
+
+        SchemaCompiler(*program).compileRoot(*JsonParser::parseValidated(data, length, true));
+    }
+    catch(...) {
+        delete program;
+        throw;
+    }
+}
+
+/**
+ * @brief Destructor that frees the program
+ */
+JsonSchema::~JsonSchema() {
+    delete program;
+}
+
+/**
+ * @brief Checks a value against the schema, stopping at the first failing keyword
+ * @param value Value to check
+ * @return True if the value is valid against the schema, false otherwise
+ */
+bool JsonSchema::isValid(const JsonValue& value) const {
+    return SchemaEvaluator(*program, nullptr).matches(0, value);
+}
+
+/**
+ * @brief Validates a value against the schema, tracing only an invalid value to locate the failure
+ * @param value Value to validate
+ * @return Pair of boolean (valid/invalid) and a message naming the failing keyword and where it failed
+ */
+std::pair<bool, std::string> JsonSchema::validate(const JsonValue& value) const {
+    SchemaTrace trace;
+
+    if(isValid(value)) {
+        return std::make_pair(true, std::string(""));
+    }
+
+    SchemaEvaluator(*program, &trace).matches(0, value);
+    return std::make_pair(false, trace.message);
+}
+
+/**
+ * @brief Parses JSON text into a scratch arena and validates it against the schema
+ * @param data Pointer to the first character of the JSON text
+ * @param length Number of characters in the text
+ * @return Pair of boolean (valid/invalid) and error message string, the syntax error if the text is not valid JSON
+ */
+std::pair<bool, std::string> JsonSchema::validate(const char* data, const size_t length) const {
+    JsonArena arena;
+    JsonArena::Scope scope(arena);
+    const JsonValue* value = nullptr;
+
+    try {
+        value = JsonParser::parseValidated(data, length, true);
+    }
+    catch(const std::runtime_error& error) {
+        return std::make_pair(false, std::string(error.what()));
+    }
+
+    return validate(*value);
+}
@@ -1,5 +1,35 @@
 #include "JsonSearcher.hpp"
 
+/**
+ * @brief Anonymous namespace for the traversal state of the searcher
+ */
+namespace {
+    /**
+     * @brief Array or object whose children are being searched
+     */
+    struct SearchFrame {
+        const JsonValue* value;             ///< Array or object being searched
+        size_t position;                    ///< Next element of an array
+        JsonObject::ConstIterator current;  ///< Next key-value pair of an object
+        JsonObject::ConstIterator end;      ///< One past the last key-value pair of an object
+    };
+
+    /**
+     * @brief Creates the frame of an array or object about to be searched
+     * @param value Array or object to search
+     * @return Frame positioned on its first child
+     */
+    SearchFrame makeFrame(const JsonValue* value) {
+        if(value -> getType() == ValueType::Array) {
+            return SearchFrame{value, 0, JsonObject::ConstIterator(nullptr, nullptr), JsonObject::ConstIterator(nullptr, nullptr)};
+        }
+
+        const JsonObject* object = static_cast<const JsonObject*>(value);
+
+        return SearchFrame{value, 0, object -> begin(), object -> end()};
+    }
+}
+
 /**
  * @brief Visit method for JsonNull values
  * @param jsonValue Reference to JsonNull value
@@ -33,47 +63,19 @@ void JsonSearcher::visit(JsonString& jsonValue) {
 }
 
 /**
- * @brief Visit method for JsonArray values, recursively searches nested arrays and objects
+ * @brief Visit method for JsonArray values, searches the keys of every object nested in the array
  * @param jsonValue Reference to JsonArray value
  */
 void JsonSearcher::visit(JsonArray& jsonValue) {
-    const size_t size = jsonValue.getSize();
-
-    for(size_t i = 0; i < size; i++) {
-
-        const JsonValue* value = jsonValue[i];
-
-        if(value -> getType() == ValueType::Object || value -> getType() == ValueType::Array) {
-            JsonValue* objValue = value -> clone();
-            objValue -> accept(*this);
-            delete objValue;
-        }
-
-    }
-
+    search(&jsonValue);
 }
 
 /**
- * @brief Visit method for JsonObject values, searches keys and recursively searches nested objects
+ * @brief Visit method for JsonObject values, searches its keys and the keys of every object nested in it
  * @param jsonValue Reference to JsonObject value
  */
 void JsonSearcher::visit(JsonObject& jsonValue) {
-    std::vector<std::string> keys = jsonValue.getKeys();
-    const size_t size = jsonValue.getSize();
-
-    for(size_t i = 0; i < size; i++) {
-
-        const JsonValue* value = jsonValue.getValue(keys[i]);
-
-        if(std::regex_match(keys[i], regex)){
-            searchResults.push_back(value -> clone());
-        }
-
-        if(value -> getType() == ValueType::Object || value -> getType() == ValueType::Array) {
-            JsonValue* pcopy = const_cast<JsonValue*>(value);
-            pcopy -> accept(*this);
-        }
-    }
+    search(&jsonValue);
 }
 
 /**
@@ -97,4 +99,47 @@ JsonSearcher::~JsonSearcher() {
     for(JsonValue* value : searchResults) {
         delete value;
     }
+}
+
+/**
+ * @brief Searches an array or object depth first with an explicit stack
+ * @param root Array or object to search
+ */
+void JsonSearcher::search(const JsonValue* root) {
+    std::vector<SearchFrame> frames;
+    frames.push_back(makeFrame(root));
+
+    while(!frames.empty()) {
+        SearchFrame& frame = frames.back();
+        const JsonValue* value = nullptr;
+
+        if(frame.value -> getType() == ValueType::Array) {
+            const JsonArray* array = static_cast<const JsonArray*>(frame.value);
+
+            if(frame.position == array -> getSize()) {
+                frames.pop_back();
+                continue;
+            }
+
+            value = (*array)[frame.position++];
+        } else {
+            if(frame.current == frame.end) {
+                frames.pop_back();
+                continue;
+            }
+
+            const JsonObject::Entry& entry = *frame.current;
+            ++frame.current;
+
+            value = entry.value;
+
+            if(std::regex_match(entry.key.begin(), entry.key.end(), regex)) {
+                searchResults.push_back(value -> clone());
+            }
+        }
+
+        if(value -> getType() == ValueType::Object || value -> getType() == ValueType::Array) {
+            frames.push_back(makeFrame(value));
+        }
+    }
 }
\ No newline at end of file
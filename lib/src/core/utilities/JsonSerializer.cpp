@@ -1,13 +1,29 @@
 #include "JsonSerializer.hpp"
 #include "Path.hpp"
+#include "JsonStreamWriter.hpp"
 
 /**
- * @brief Saves a JSON value to an output stream
+ * @brief Saves a JSON value to an output stream, streaming it through a buffered writer
  * @param json Pointer to the constant JSON value to save
  * @param stream Output stream to write to
  * @param path Optional path within the JSON to save specific part
+ * @param options Formatter type, indentation width and key order to save with
  */
-void JsonSerializer::save(const JsonValue* const json, std::ostream& stream, const std::string& path) {
+void JsonSerializer::save(const JsonValue* const json, std::ostream& stream, const std::string& path, const JsonFormatOptions& options) {
+    JsonStreamWriter writer(stream);
+
+    save(json, writer, path, options);
+}
+
+/**
+ * @brief Saves a JSON value to a writer
+ * @param json Pointer to the constant JSON value to save
+ * @param writer Writer to append to
+ * @param path Optional path within the JSON to save specific part
+ * @param options Formatter type, indentation width and key order to save with
+ */
+void JsonSerializer::save(const JsonValue* const json, JsonWriter& writer, const std::string& path, const JsonFormatOptions& options) {
     const JsonValue* value = Path::getValue(json, path);
-    stream << value;
+
+    JsonFormatConfig::writeJson(writer, value, options);
 }
\ No newline at end of file
@@ -0,0 +1,479 @@
+#include <algorithm>
+#include <cstring>
+#include <limits>
+#include "JsonStructuralIndexer.hpp"
+#include "JsonUtf8.hpp"
+#include "JsonInstructionSet.hpp"
+
+#if (defined(__x86_64__) || defined(__i386__)) && (defined(__GNUC__) || defined(__clang__))
+#define JSON_STRUCTURAL_X86 1
+#include <immintrin.h>
+#else
+#define JSON_STRUCTURAL_X86 0
+#endif
+
+/**
+ * @brief Anonymous namespace for the block classifiers and bit manipulation helpers
+ */
+namespace {
+    /**
+     * @brief Number of characters classified at once
+     */
+    const size_t BlockSize = 64;
+
+    /**
+     * @brief Bit masks of one block, bit i describes the i-th character of the block
+     */
+    struct BlockMasks {
+        uint64_t quote;       ///< '"' characters
+        uint64_t backslash;   ///< '\' characters
+        uint64_t structural;  ///< '{', '}', '[', ']', ':' and ',' characters
+        uint64_t whitespace;  ///< Characters isspace accepts
+        uint64_t control;     ///< Characters below 0x20
+    };
+
+    /**
+     * @brief Signature of a function classifying one block
+     */
+    typedef void (*BlockClassifier)(const char* block, BlockMasks& masks);
+
+    /**
+     * @brief Classifies one block one character at a time
+     * @param block Pointer to 64 readable characters
+     * @param masks Resulting masks
+     */
+    void classifyScalar(const char* block, BlockMasks& masks) {
+        masks = BlockMasks();
+
+        for(size_t i = 0; i < BlockSize; i++) {
+            const unsigned char symbol = static_cast<unsigned char>(block[i]);
+            const uint64_t bit = uint64_t(1) << i;
+
+            switch(symbol) {
+                case '\"': masks.quote |= bit; break;
+                case '\\': masks.backslash |= bit; break;
+                case '{': case '}': case '[': case ']': case ':': case ',': masks.structural |= bit; break;
+                case ' ': case '\t': case '\n': case '\v': case '\f': case '\r': masks.whitespace |= bit; break;
+                default: break;
+            }
+
+            if(symbol < 0x20) {
+                masks.control |= bit;
+            }
+        }
+    }
+
+#if JSON_STRUCTURAL_X86
+    /**
+     * @brief Collects the top bits of four 16-character comparisons into one mask
+     */
+    __attribute__((target("sse4.2")))
+    inline uint64_t collectSse42(const __m128i first, const __m128i second, const __m128i third, const __m128i fourth) {
+        return uint64_t(uint16_t(_mm_movemask_epi8(first))) |
+        (uint64_t(uint16_t(_mm_movemask_epi8(second))) << 16) |
+        (uint64_t(uint16_t(_mm_movemask_epi8(third))) << 32) |
+        (uint64_t(uint16_t(_mm_movemask_epi8(fourth))) << 48);
+    }
+
+    /**
+     * @brief Classifies 16 characters with SSE instructions
+     * @param chunk Characters to classify
+     * @param quote Resulting quote lanes
+     * @param backslash Resulting backslash lanes
+     * @param structural Resulting structural lanes
+     * @param whitespace Resulting whitespace lanes
+     * @param control Resulting control character lanes
+     */
+    __attribute__((target("sse4.2")))
+    inline void classifySse42Chunk(const __m128i chunk, __m128i& quote, __m128i& backslash, __m128i& structural, __m128i& whitespace, __m128i& control) {
+        const __m128i lowered = _mm_or_si128(chunk, _mm_set1_epi8(0x20));
+        const __m128i shifted = _mm_sub_epi8(chunk, _mm_set1_epi8(0x09));
+
+        quote = _mm_cmpeq_epi8(chunk, _mm_set1_epi8('\"'));
+        backslash = _mm_cmpeq_epi8(chunk, _mm_set1_epi8('\\'));
+        structural = _mm_or_si128(
+            _mm_or_si128(_mm_cmpeq_epi8(lowered, _mm_set1_epi8('{')), _mm_cmpeq_epi8(lowered, _mm_set1_epi8('}'))),
+            _mm_or_si128(_mm_cmpeq_epi8(chunk, _mm_set1_epi8(':')), _mm_cmpeq_epi8(chunk, _mm_set1_epi8(','))));
+        whitespace = _mm_or_si128(_mm_cmpeq_epi8(chunk, _mm_set1_epi8(' ')),
+            _mm_cmpeq_epi8(_mm_min_epu8(shifted, _mm_set1_epi8(0x04)), shifted));
+        control = _mm_cmpeq_epi8(_mm_min_epu8(chunk, _mm_set1_epi8(0x1F)), chunk);
+    }
+
+    /**
+     * @brief Classifies one block with SSE4.2 instructions, 16 characters per step
+     * @param block Pointer to 64 readable characters
+     * @param masks Resulting masks
+     */
+    __attribute__((target("sse4.2")))
+    void classifySse42(const char* block, BlockMasks& masks) {
+        __m128i quote[4], backslash[4], structural[4], whitespace[4], control[4];
+
+        for(size_t i = 0; i < 4; i++) {
+            const __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(block + 16 * i));
+            classifySse42Chunk(chunk, quote[i], backslash[i], structural[i], whitespace[i], control[i]);
+        }
+
+        masks.quote = collectSse42(quote[0], quote[1], quote[2], quote[3]);
+        masks.backslash = collectSse42(backslash[0], backslash[1], backslash[2], backslash[3]);
+        masks.structural = collectSse42(structural[0], structural[1], structural[2], structural[3]);
+        masks.whitespace = collectSse42(whitespace[0], whitespace[1], whitespace[2], whitespace[3]);
+        masks.control = collectSse42(control[0], control[1], control[2], control[3]);
+    }
+
+    /**
+     * @brief Collects the top bits of two 32-character comparisons into one mask
+     */
+    __attribute__((target("avx2")))
+    inline uint64_t collectAvx2(const __m256i low, const __m256i high) {
+        return uint64_t(uint32_t(_mm256_movemask_epi8(low))) | (uint64_t(uint32_t(_mm256_movemask_epi8(high))) << 32);
+    }
+
+    /**
+     * @brief Classifies 32 characters with AVX2 instructions
+     * @param chunk Characters to classify
+     * @param quote Resulting quote lanes
+     * @param backslash Resulting backslash lanes
+     * @param structural Resulting structural lanes
+     * @param whitespace Resulting whitespace lanes
+     * @param control Resulting control character lanes
+     */
+    __attribute__((target("avx2")))
+    inline void classifyAvx2Chunk(const __m256i chunk, __m256i& quote, __m256i& backslash, __m256i& structural, __m256i& whitespace, __m256i& control) {
+        const __m256i lowered = _mm256_or_si256(chunk, _mm256_set1_epi8(0x20));
+        const __m256i shifted = _mm256_sub_epi8(chunk, _mm256_set1_epi8(0x09));
+
+        quote = _mm256_cmpeq_epi8(chunk, _mm256_set1_epi8('\"'));
+        backslash = _mm256_cmpeq_epi8(chunk, _mm256_set1_epi8('\\'));
+        structural = _mm256_or_si256(
+            _mm256_or_si256(_mm256_cmpeq_epi8(lowered, _mm256_set1_epi8('{')), _mm256_cmpeq_epi8(lowered, _mm256_set1_epi8('}'))),
+            _mm256_or_si256(_mm256_cmpeq_epi8(chunk, _mm256_set1_epi8(':')), _mm256_cmpeq_epi8(chunk, _mm256_set1_epi8(','))));
+        whitespace = _mm256_or_si256(_mm256_cmpeq_epi8(chunk, _mm256_set1_epi8(' ')),
+            _mm256_cmpeq_epi8(_mm256_min_epu8(shifted, _mm256_set1_epi8(0x04)), shifted));
+        control = _mm256_cmpeq_epi8(_mm256_min_epu8(chunk, _mm256_set1_epi8(0x1F)), chunk);
+    }
+
+    /**
+     * @brief Classifies one block with AVX2 instructions, 32 characters per step
+     * @param block Pointer to 64 readable characters
+     * @param masks Resulting masks
+     */
+    __attribute__((target("avx2")))
+    void classifyAvx2(const char* block, BlockMasks& masks) {
+        __m256i quote[2], backslash[2], structural[2], whitespace[2], control[2];
+
+        for(size_t i = 0; i < 2; i++) {
+            const __m256i chunk = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(block + 32 * i));
+            classifyAvx2Chunk(chunk, quote[i], backslash[i], structural[i], whitespace[i], control[i]);
+        }
+
+        masks.quote = collectAvx2(quote[0], quote[1]);
+        masks.backslash = collectAvx2(backslash[0], backslash[1]);
+        masks.structural = collectAvx2(structural[0], structural[1]);
+        masks.whitespace = collectAvx2(whitespace[0], whitespace[1]);
+        masks.control = collectAvx2(control[0], control[1]);
+    }
+#endif
+
+    /**
+     * @brief Picks the block classifier of an instruction set
+     * @param set Instruction set to use, the scalar classifier is picked if the running CPU does not support it
+     * @return Pointer to the classifier
+     */
+    BlockClassifier selectClassifier(const InstructionSet set) {
+#if JSON_STRUCTURAL_X86
+        if(JsonInstructionSet::isSupported(set)) {
+            switch(set) {
+                case InstructionSet::Avx2: return classifyAvx2;
+                case InstructionSet::Sse: return classifySse42;
+                default: break;
+            }
+        }
+#endif
+        return classifyScalar;
+    }
+
+    /**
+     * @brief Computes for every bit the xor of it and all lower bits, turning quote bits into in-string bits
+     * @param bits Mask to transform
+     * @return Prefix xor of the mask
+     */
+    inline uint64_t prefixXor(uint64_t bits) {
+        bits ^= bits << 1;
+        bits ^= bits << 2;
+        bits ^= bits << 4;
+        bits ^= bits << 8;
+        bits ^= bits << 16;
+        bits ^= bits << 32;
+        return bits;
+    }
+
+    /**
+     * @brief Finds the characters escaped by an odd run of backslashes
+     * @param backslash Backslash mask of the block
+     * @param isPreviousEscaped Whether the first character of the block is escaped, updated for the next block
+     * @return Mask of escaped characters
+     */
+    inline uint64_t findEscaped(uint64_t backslash, uint64_t& isPreviousEscaped) {
+        const uint64_t evenBits = 0x5555555555555555ULL;
+
+        backslash &= ~isPreviousEscaped;
+
+        const uint64_t followsEscape = (backslash << 1) | isPreviousEscaped;
+        const uint64_t oddSequenceStarts = backslash & ~evenBits & ~followsEscape;
+        const uint64_t sequencesStartingOnEvenBits = oddSequenceStarts + backslash;
+
+        isPreviousEscaped = sequencesStartingOnEvenBits < oddSequenceStarts ? 1 : 0;
+
+        const uint64_t invertMask = sequencesStartingOnEvenBits << 1;
+
+        return (evenBits ^ invertMask) & followsEscape;
+    }
+
+    /**
+     * @brief Gets the index of the lowest set bit
+     * @param bits Non-zero mask
+     * @return Index of the lowest set bit
+     */
+    inline uint32_t lowestBit(const uint64_t bits) {
+#if defined(__GNUC__) || defined(__clang__)
+        return static_cast<uint32_t>(__builtin_ctzll(bits));
+#else
+        uint32_t index = 0;
+
+        while(((bits >> index) & 1) == 0) {
+            index++;
+        }
+
+        return index;
+#endif
+    }
+
+    /**
+     * @brief Counts the set bits of a mask
+     * @param bits Mask to count
+     * @return Number of set bits
+     */
+    inline size_t countBits(uint64_t bits) {
+#if defined(__GNUC__) || defined(__clang__)
+        return static_cast<size_t>(__builtin_popcountll(bits));
+#else
+        size_t count = 0;
+
+        for(; bits != 0; bits &= bits - 1) {
+            count++;
+        }
+
+        return count;
+#endif
+    }
+
+    /**
+     * @brief Adds a bracket to a profile, cancelling a closing one against the last opening one left
+     * @param profile Profile to add to
+     * @param symbol Bracket character
+     * @param offset Offset of the character in the buffer
+     * @param depthLimit Number of unmatched brackets after which the profile is broken
+     */
+    void addBracket(BracketProfile& profile, const char symbol, const size_t offset, const size_t depthLimit) {
+        if(symbol == '{' || symbol == '[') {
+            if(profile.openers.size() >= depthLimit) {
+                profile.isBroken = true;
+                return;
+            }
+
+            profile.openers.push_back(OpenBracket{symbol, offset});
+            return;
+        }
+
+        if(!profile.openers.empty()) {
+            profile.isBroken = profile.isBroken || symbol - profile.openers.back().brace != 2;
+            profile.openers.pop_back();
+            return;
+        }
+
+        if(profile.closers.size() >= depthLimit) {
+            profile.isBroken = true;
+            return;
+        }
+
+        profile.closers.push_back(symbol);
+    }
+
+    /**
+     * @brief Appends the offsets of all set bits of a block mask
+     * @param offsets Vector to append to
+     * @param base Offset of the first character of the block
+     * @param bits Mask of the block
+     */
+    inline void appendOffsets(std::vector<uint32_t>& offsets, const uint32_t base, uint64_t bits) {
+        if(bits == 0) {
+            return;
+        }
+
+        size_t size = offsets.size();
+        offsets.resize(size + countBits(bits));
+
+        for(; bits != 0; bits &= bits - 1) {
+            offsets[size++] = base + lowestBit(bits);
+        }
+    }
+}
+
+/**
+ * @brief Checks whether a buffer is small enough for its offsets to fit in the index
+ * @param length Number of characters in the buffer
+ * @return True if the buffer can be indexed, false otherwise
+ */
+bool JsonStructuralIndexer::canIndex(const size_t length) {
+    return length < std::numeric_limits<uint32_t>::max();
+}
+
+/**
+ * @brief Builds the structural index of a buffer using the widest instruction set the CPU supports
+ * @param data Pointer to the first character of the JSON text
+ * @param length Number of characters in the buffer
+ * @param result Index to fill, previous content is discarded
+ */
+void JsonStructuralIndexer::index(const char* data, const size_t length, StructuralIndex& result) {
+    static const InstructionSet widest = JsonInstructionSet::getWidest();
+
+    index(data, length, result, widest);
+}
+
+/**
+ * @brief Builds the structural index of a buffer block by block
+ * @param data Pointer to the first character of the JSON text
+ * @param length Number of characters in the buffer
+ * @param result Index to fill, previous content is discarded
+ * @param set Instruction set to use, the scalar code is used if the running CPU does not support it
+ */
+void JsonStructuralIndexer::index(const char* data, const size_t length, StructuralIndex& result, const InstructionSet set) {
+    const BlockClassifier classify = selectClassifier(set);
+
+    result.structurals.clear();
+    result.specials.clear();
+    result.structurals.reserve(length / 8 + 16);
+
+    uint64_t isPreviousEscaped = 0;
+    uint64_t previousInString = 0;
+    uint64_t previousScalar = 0;
+
+    char lastBlock[BlockSize];
+
+    for(size_t offset = 0; offset < length; offset += BlockSize) {
+        const char* block = data + offset;
+
+        if(length - offset < BlockSize) {
+            memset(lastBlock, ' ', BlockSize);
+            memcpy(lastBlock, block, length - offset);
+            block = lastBlock;
+        }
+
+        BlockMasks masks;
+        classify(block, masks);
+
+        const uint64_t escaped = findEscaped(masks.backslash, isPreviousEscaped);
+        const uint64_t quote = masks.quote & ~escaped;
+        const uint64_t inString = prefixXor(quote) ^ previousInString;
+
+        previousInString = static_cast<uint64_t>(-static_cast<int64_t>(inString >> 63));
+
+        const uint64_t scalar = ~(masks.structural | masks.whitespace | quote | inString);
+        const uint64_t scalarStart = scalar & ~((scalar << 1) | previousScalar);
+
+        previousScalar = scalar >> 63;
+
+        const uint32_t base = static_cast<uint32_t>(offset);
+
+        appendOffsets(result.structurals, base, (masks.structural & ~inString) | quote | scalarStart);
+        appendOffsets(result.specials, base, (masks.backslash | masks.control) & inString);
+    }
+
+    const size_t invalidUtf8 = JsonUtf8::findInvalid(data, data + length, set) - data;
+
+    if(invalidUtf8 < length) {
+        const uint32_t offset = static_cast<uint32_t>(invalidUtf8);
+
+        result.specials.insert(std::upper_bound(result.specials.begin(), result.specials.end(), offset), offset);
+    }
+}
+
+/**
+ * @brief Scans a chunk of a buffer for its quotes, commas and brackets using the widest instruction set the CPU supports
+ * @param data Pointer to the first character of the JSON text
+ * @param begin Offset of the chunk's first character
+ * @param end Offset one past the chunk's last character
+ * @param depthLimit Number of unmatched brackets after which a profile is broken
+ * @param result Scan to fill
+ */
+void JsonStructuralIndexer::scanChunk(const char* data, const size_t begin, const size_t end, const size_t depthLimit, ChunkScan& result) {
+    static const InstructionSet widest = JsonInstructionSet::getWidest();
+
+    scanChunk(data, begin, end, depthLimit, result, widest);
+}
+
+/**
+ * @brief Scans a chunk block by block with the same classifiers as index
+ * @param data Pointer to the first character of the JSON text
+ * @param begin Offset of the chunk's first character
+ * @param end Offset one past the chunk's last character
+ * @param depthLimit Number of unmatched brackets after which a profile is broken
+ * @param result Scan to fill
+ * @param set Instruction set to use, the scalar code is used if the running CPU does not support it
+ */
+void JsonStructuralIndexer::scanChunk(const char* data, const size_t begin, const size_t end, const size_t depthLimit, ChunkScan& result,
+                                      const InstructionSet set) {
+    const BlockClassifier classify = selectClassifier(set);
+
+    size_t backslashes = 0;
+
+    while(backslashes < begin && data[begin - backslashes - 1] == '\\') {
+        backslashes++;
+    }
+
+    result.hasComma[0] = false;
+    result.hasComma[1] = false;
+
+    uint64_t isPreviousEscaped = backslashes % 2;
+    uint64_t previousInString = 0;
+
+    char lastBlock[BlockSize];
+
+    for(size_t offset = begin; offset < end; offset += BlockSize) {
+        const char* block = data + offset;
+
+        if(end - offset < BlockSize) {
+            memset(lastBlock, ' ', BlockSize);
+            memcpy(lastBlock, block, end - offset);
+            block = lastBlock;
+        }
+
+        BlockMasks masks;
+        classify(block, masks);
+
+        const uint64_t escaped = findEscaped(masks.backslash, isPreviousEscaped);
+        const uint64_t quote = masks.quote & ~escaped;
+        const uint64_t inString = prefixXor(quote) ^ previousInString;
+
+        previousInString = static_cast<uint64_t>(-static_cast<int64_t>(inString >> 63));
+
+        for(uint64_t bits = masks.structural & ~escaped; bits != 0; bits &= bits - 1) {
+            const uint32_t bit = lowestBit(bits);
+            const char symbol = block[bit];
+            const size_t guess = static_cast<size_t>((inString >> bit) & 1);
+
+            if(symbol == ':') {
+                continue;
+            }
+
+            if(symbol != ',') {
+                addBracket(result.hasComma[guess] ? result.tails[guess] : result.heads[guess], symbol, offset + bit, depthLimit);
+            } else if(!result.hasComma[guess]) {
+                result.hasComma[guess] = true;
+                result.commas[guess] = offset + bit;
+            }
+        }
+    }
+
+    result.isQuoteCountOdd = previousInString != 0;
+}
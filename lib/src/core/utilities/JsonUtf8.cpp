@@ -0,0 +1,387 @@
+#include <cstdint>
+#include <cstring>
+#include "JsonUtf8.hpp"
+#include "JsonInstructionSet.hpp"
+
+#if (defined(__x86_64__) || defined(__i386__)) && (defined(__GNUC__) || defined(__clang__))
+#define JSON_UTF8_X86 1
+#include <immintrin.h>
+#else
+#define JSON_UTF8_X86 0
+#endif
+
+/**
+ * @brief Anonymous namespace for the UTF-8 checkers of each instruction set
+ */
+namespace {
+    /**
+     * @brief Number of characters checked at once
+     */
+    const size_t BlockSize = 64;
+
+    /**
+     * @brief Signature of a function finding the first ill-formed UTF-8 sequence in a range
+     */
+    typedef const char* (*InvalidFinder)(const char* begin, const char* end);
+
+    /**
+     * @brief Finds the first ill-formed UTF-8 sequence one sequence at a time, skipping eight ASCII characters at once
+     * @param begin Pointer to the first character to check, which must start a sequence
+     * @param end Pointer one past the last character to check
+     * @return Pointer to the first byte of the first ill-formed sequence, end if there is none
+     */
+    const char* findInvalidScalar(const char* begin, const char* end) {
+        const unsigned char* symbol = reinterpret_cast<const unsigned char*>(begin);
+        const unsigned char* last = reinterpret_cast<const unsigned char*>(end);
+
+        while(symbol < last) {
+            if(last - symbol >= static_cast<std::ptrdiff_t>(sizeof(uint64_t))) {
+                uint64_t word;
+                std::memcpy(&word, symbol, sizeof(word));
+
+                if((word & 0x8080808080808080ULL) == 0) {
+                    symbol += sizeof(word);
+                    continue;
+                }
+            }
+
+            const unsigned char lead = *symbol;
+
+            if(lead < 0x80) {
+                symbol++;
+                continue;
+            }
+
+            size_t length = 0;
+            unsigned char low = 0x80, high = 0xBF;
+
+            if(lead >= 0xC2 && lead <= 0xDF) {
+                length = 2;
+            }
+            else if(lead >= 0xE0 && lead <= 0xEF) {
+                length = 3;
+                low = lead == 0xE0 ? 0xA0 : 0x80;
+                high = lead == 0xED ? 0x9F : 0xBF;
+            }
+            else if(lead >= 0xF0 && lead <= 0xF4) {
+                length = 4;
+                low = lead == 0xF0 ? 0x90 : 0x80;
+                high = lead == 0xF4 ? 0x8F : 0xBF;
+            }
+            else {
+                return reinterpret_cast<const char*>(symbol);
+            }
+
+            if(static_cast<size_t>(last - symbol) < length || symbol[1] < low || symbol[1] > high) {
+                return reinterpret_cast<const char*>(symbol);
+            }
+
+            for(size_t i = 2; i < length; i++) {
+                if((symbol[i] & 0xC0) != 0x80) {
+                    return reinterpret_cast<const char*>(symbol);
+                }
+            }
+
+            symbol += length;
+        }
+
+        return end;
+    }
+
+    /**
+     * @brief Finds the first ill-formed sequence exactly once a vectorized checker flagged a block
+     * @param begin Pointer to the first character of the range
+     * @param block Pointer to the first character of the flagged block
+     * @param end Pointer one past the last character of the range
+     * @return Pointer to the first byte of the first ill-formed sequence
+     */
+    const char* locateInvalid(const char* begin, const char* block, const char* end) {
+        if(block == begin) {
+            return findInvalidScalar(begin, end);
+        }
+
+        const char* start = block - BlockSize;
+
+        for(size_t i = 0; i < 3 && (static_cast<unsigned char>(*start) & 0xC0) == 0x80; i++) {
+            start++;
+        }
+
+        return findInvalidScalar(start, end);
+    }
+
+#if JSON_UTF8_X86
+    /**
+     * @brief Error flags of a pair of bytes, each selected by the nibbles of the pair it depends on
+     */
+    const unsigned char TooShort = 1 << 0;          ///< Lead byte not followed by a continuation
+    const unsigned char TooLong = 1 << 1;           ///< Continuation after an ASCII character
+    const unsigned char Overlong3 = 1 << 2;         ///< 0xE0 followed by less than 0xA0
+    const unsigned char TooLarge = 1 << 3;          ///< Code point above U+10FFFF
+    const unsigned char Surrogate = 1 << 4;         ///< 0xED followed by 0xA0 or more
+    const unsigned char Overlong2 = 1 << 5;         ///< 0xC0 or 0xC1
+    const unsigned char TooLarge1000 = 1 << 6;      ///< 0xF5 or more followed by 0x80 to 0x8F
+    const unsigned char Overlong4 = 1 << 6;         ///< 0xF0 followed by less than 0x90
+    const unsigned char TwoContinuations = 1 << 7;  ///< Continuation after a continuation, allowed by the third or fourth byte check
+    const unsigned char Carry = TooShort | TooLong | TwoContinuations;  ///< Errors decided by the high nibbles alone
+
+    /**
+     * @brief Errors selected by the high nibble of the first byte of a pair
+     */
+    const unsigned char FirstHighNibble[16] = {
+        TooLong, TooLong, TooLong, TooLong, TooLong, TooLong, TooLong, TooLong,
+        TwoContinuations, TwoContinuations, TwoContinuations, TwoContinuations,
+        TooShort | Overlong2,
+        TooShort,
+        TooShort | Overlong3 | Surrogate,
+        TooShort | TooLarge | TooLarge1000 | Overlong4
+    };
+
+    /**
+     * @brief Errors selected by the low nibble of the first byte of a pair
+     */
+    const unsigned char FirstLowNibble[16] = {
+        Carry | Overlong3 | Overlong2 | Overlong4,
+        Carry | Overlong2,
+        Carry,
+        Carry,
+        Carry | TooLarge,
+        Carry | TooLarge | TooLarge1000,
+        Carry | TooLarge | TooLarge1000,
+        Carry | TooLarge | TooLarge1000,
+        Carry | TooLarge | TooLarge1000,
+        Carry | TooLarge | TooLarge1000,
+        Carry | TooLarge | TooLarge1000,
+        Carry | TooLarge | TooLarge1000,
+        Carry | TooLarge | TooLarge1000,
+        Carry | TooLarge | TooLarge1000 | Surrogate,
+        Carry | TooLarge | TooLarge1000,
+        Carry | TooLarge | TooLarge1000
+    };
+
+    /**
+     * @brief Errors selected by the high nibble of the second byte of a pair
+     */
+    const unsigned char SecondHighNibble[16] = {
+        TooShort, TooShort, TooShort, TooShort, TooShort, TooShort, TooShort, TooShort,
+        TooLong | Overlong2 | TwoContinuations | Overlong3 | TooLarge1000 | Overlong4,
+        TooLong | Overlong2 | TwoContinuations | Overlong3 | TooLarge,
+        TooLong | Overlong2 | TwoContinuations | Surrogate | TooLarge,
+        TooLong | Overlong2 | TwoContinuations | Surrogate | TooLarge,
+        TooShort, TooShort, TooShort, TooShort
+    };
+
+    /**
+     * @brief Largest values of the last three bytes of a block that do not leave a sequence unfinished
+     */
+    const unsigned char IncompleteLimits[16] = {
+        0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xF0 - 1, 0xE0 - 1, 0xC0 - 1
+    };
+
+    /**
+     * @brief Checks 16 characters with SSE instructions
+     * @param input Characters to check
+     * @param previous The 16 characters before them
+     * @return Non-zero lanes where a sequence is ill-formed
+     */
+    __attribute__((target("sse4.2")))
+    inline __m128i checkSse42(const __m128i input, const __m128i previous) {
+        const __m128i nibble = _mm_set1_epi8(0x0F);
+        const __m128i previous1 = _mm_alignr_epi8(input, previous, 15);
+        const __m128i previous2 = _mm_alignr_epi8(input, previous, 14);
+        const __m128i previous3 = _mm_alignr_epi8(input, previous, 13);
+
+        const __m128i firstHigh = _mm_shuffle_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(FirstHighNibble)),
+                                                   _mm_and_si128(_mm_srli_epi16(previous1, 4), nibble));
+        const __m128i firstLow = _mm_shuffle_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(FirstLowNibble)),
+                                                  _mm_and_si128(previous1, nibble));
+        const __m128i secondHigh = _mm_shuffle_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(SecondHighNibble)),
+                                                    _mm_and_si128(_mm_srli_epi16(input, 4), nibble));
+        const __m128i special = _mm_and_si128(_mm_and_si128(firstHigh, firstLow), secondHigh);
+
+        const __m128i third = _mm_subs_epu8(previous2, _mm_set1_epi8(static_cast<char>(0xE0 - 0x80)));
+        const __m128i fourth = _mm_subs_epu8(previous3, _mm_set1_epi8(static_cast<char>(0xF0 - 0x80)));
+        const __m128i mustContinue = _mm_and_si128(_mm_or_si128(third, fourth), _mm_set1_epi8(static_cast<char>(0x80)));
+
+        return _mm_xor_si128(mustContinue, special);
+    }
+
+    /**
+     * @brief Finds the first ill-formed UTF-8 sequence with SSE4.2 instructions, 16 characters per step
+     * @param begin Pointer to the first character to check
+     * @param end Pointer one past the last character to check
+     * @return Pointer to the first byte of the first ill-formed sequence, end if there is none
+     */
+    __attribute__((target("sse4.2")))
+    const char* findInvalidSse42(const char* begin, const char* end) {
+        const __m128i limits = _mm_loadu_si128(reinterpret_cast<const __m128i*>(IncompleteLimits));
+
+        __m128i previous = _mm_setzero_si128();
+        __m128i incomplete = _mm_setzero_si128();
+        char lastBlock[BlockSize];
+
+        const size_t length = end - begin;
+
+        for(size_t offset = 0; offset <= length; offset += BlockSize) {
+            const char* symbols = begin + offset;
+
+            if(length - offset < BlockSize) {
+                memset(lastBlock, 0, BlockSize);
+                memcpy(lastBlock, symbols, length - offset);
+                symbols = lastBlock;
+            }
+
+            __m128i input[4];
+            __m128i error = _mm_setzero_si128();
+
+            for(size_t i = 0; i < 4; i++) {
+                input[i] = _mm_loadu_si128(reinterpret_cast<const __m128i*>(symbols + 16 * i));
+            }
+
+            const __m128i any = _mm_or_si128(_mm_or_si128(input[0], input[1]), _mm_or_si128(input[2], input[3]));
+
+            if(_mm_movemask_epi8(any) == 0) {
+                error = incomplete;
+            } else {
+                error = _mm_or_si128(error, checkSse42(input[0], previous));
+                error = _mm_or_si128(error, checkSse42(input[1], input[0]));
+                error = _mm_or_si128(error, checkSse42(input[2], input[1]));
+                error = _mm_or_si128(error, checkSse42(input[3], input[2]));
+
+                incomplete = _mm_subs_epu8(input[3], limits);
+                previous = input[3];
+            }
+
+            if(_mm_movemask_epi8(_mm_cmpeq_epi8(error, _mm_setzero_si128())) != 0xFFFF) {
+                return locateInvalid(begin, begin + offset, end);
+            }
+        }
+
+        return end;
+    }
+
+    /**
+     * @brief Checks 32 characters with AVX2 instructions
+     * @param input Characters to check
+     * @param previous The 32 characters before them
+     * @return Non-zero lanes where a sequence is ill-formed
+     */
+    __attribute__((target("avx2")))
+    inline __m256i checkAvx2(const __m256i input, const __m256i previous) {
+        const __m256i nibble = _mm256_set1_epi8(0x0F);
+        const __m256i carried = _mm256_permute2x128_si256(previous, input, 0x21);
+        const __m256i previous1 = _mm256_alignr_epi8(input, carried, 15);
+        const __m256i previous2 = _mm256_alignr_epi8(input, carried, 14);
+        const __m256i previous3 = _mm256_alignr_epi8(input, carried, 13);
+
+        const __m256i firstHigh = _mm256_shuffle_epi8(_mm256_broadcastsi128_si256(_mm_loadu_si128(reinterpret_cast<const __m128i*>(FirstHighNibble))),
+                                                      _mm256_and_si256(_mm256_srli_epi16(previous1, 4), nibble));
+        const __m256i firstLow = _mm256_shuffle_epi8(_mm256_broadcastsi128_si256(_mm_loadu_si128(reinterpret_cast<const __m128i*>(FirstLowNibble))),
+                                                     _mm256_and_si256(previous1, nibble));
+        const __m256i secondHigh = _mm256_shuffle_epi8(_mm256_broadcastsi128_si256(_mm_loadu_si128(reinterpret_cast<const __m128i*>(SecondHighNibble))),
+                                                       _mm256_and_si256(_mm256_srli_epi16(input, 4), nibble));
+        const __m256i special = _mm256_and_si256(_mm256_and_si256(firstHigh, firstLow), secondHigh);
+
+        const __m256i third = _mm256_subs_epu8(previous2, _mm256_set1_epi8(static_cast<char>(0xE0 - 0x80)));
+        const __m256i fourth = _mm256_subs_epu8(previous3, _mm256_set1_epi8(static_cast<char>(0xF0 - 0x80)));
+        const __m256i mustContinue = _mm256_and_si256(_mm256_or_si256(third, fourth), _mm256_set1_epi8(static_cast<char>(0x80)));
+
+        return _mm256_xor_si256(mustContinue, special);
+    }
+
+    /**
+     * @brief Finds the first ill-formed UTF-8 sequence with AVX2 instructions, 32 characters per step
+     * @param begin Pointer to the first character to check
+     * @param end Pointer one past the last character to check
+     * @return Pointer to the first byte of the first ill-formed sequence, end if there is none
+     */
+    __attribute__((target("avx2")))
+    const char* findInvalidAvx2(const char* begin, const char* end) {
+        const __m256i limits = _mm256_inserti128_si256(_mm256_set1_epi8(static_cast<char>(0xFF)),
+                                                       _mm_loadu_si128(reinterpret_cast<const __m128i*>(IncompleteLimits)), 1);
+
+        __m256i previous = _mm256_setzero_si256();
+        __m256i incomplete = _mm256_setzero_si256();
+        char lastBlock[BlockSize];
+
+        const size_t length = end - begin;
+
+        for(size_t offset = 0; offset <= length; offset += BlockSize) {
+            const char* symbols = begin + offset;
+
+            if(length - offset < BlockSize) {
+                memset(lastBlock, 0, BlockSize);
+                memcpy(lastBlock, symbols, length - offset);
+                symbols = lastBlock;
+            }
+
+            const __m256i low = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(symbols));
+            const __m256i high = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(symbols + 32));
+            __m256i error;
+
+            if(_mm256_movemask_epi8(_mm256_or_si256(low, high)) == 0) {
+                error = incomplete;
+            } else {
+                error = _mm256_or_si256(checkAvx2(low, previous), checkAvx2(high, low));
+
+                incomplete = _mm256_subs_epu8(high, limits);
+                previous = high;
+            }
+
+            if(!_mm256_testz_si256(error, error)) {
+                return locateInvalid(begin, begin + offset, end);
+            }
+        }
+
+        return end;
+    }
+#endif
+
+    /**
+     * @brief Picks the checker of an instruction set
+     * @param set Instruction set to use, the scalar checker is picked if the running CPU does not support it
+     * @return Pointer to the checker
+     */
+    InvalidFinder selectFinder(const InstructionSet set) {
+#if JSON_UTF8_X86
+        if(JsonInstructionSet::isSupported(set)) {
+            switch(set) {
+                case InstructionSet::Avx2: return findInvalidAvx2;
+                case InstructionSet::Sse: return findInvalidSse42;
+                default: break;
+            }
+        }
+#endif
+        return findInvalidScalar;
+    }
+}
+
+/**
+ * @brief Finds the first ill-formed UTF-8 sequence in a range, block by block when it is long enough
+ * @param begin Pointer to the first character to check
+ * @param end Pointer one past the last character to check
+ * @return Pointer to the first byte of the first ill-formed sequence, end if the whole range is well-formed
+ */
+const char* JsonUtf8::findInvalid(const char* begin, const char* end) {
+    static const InvalidFinder find = selectFinder(JsonInstructionSet::getWidest());
+
+    if(end - begin < static_cast<std::ptrdiff_t>(BlockSize)) {
+        return findInvalidScalar(begin, end);
+    }
+
+    return find(begin, end);
+}
+
+/**
+ * @brief Finds the first ill-formed UTF-8 sequence in a range with the checker of a given instruction set
+ * @param begin Pointer to the first character to check
+ * @param end Pointer one past the last character to check
+ * @param set Instruction set to use, the scalar checker is used if the running CPU does not support it
+ * @return Pointer to the first byte of the first ill-formed sequence, end if the whole range is well-formed
+ */
+const char* JsonUtf8::findInvalid(const char* begin, const char* end, const InstructionSet set) {
+    if(end - begin < static_cast<std::ptrdiff_t>(BlockSize)) {
+        return findInvalidScalar(begin, end);
+    }
+
+    return selectFinder(set)(begin, end);
+}
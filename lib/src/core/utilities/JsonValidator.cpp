@@ -1,432 +1,1066 @@
-#include <regex>
+#include <algorithm>
+#include <atomic>
+#include <cctype>
+#include <cstring>
+#include <functional>
+#include <stdexcept>
+#include <system_error>
+#include <thread>
+#include <vector>
 #include "JsonValidator.hpp"
+#include "JsonEventParser.hpp"
+#include "JsonGrammar.hpp"
+#include "JsonKeyTable.hpp"
+#include "JsonParser.hpp"
+#include "JsonStructuralIndexer.hpp"
+#include "JsonUtf8.hpp"
 
 /**
- * @brief Validates a JSON null value
- * @param stream Input stream to validate
- * @param lastSymbol Last character read
- * @param row Current row number
- * @param lastRowPosition Position in current row
- * @return Pair of validation result and error/success message
+ * @brief Anonymous namespace for the validator's state machine and the threads running it on parts of a buffer
  */
-std::pair<bool, std::string> JsonValidator::validateNull(std::istream& stream, const char lastSymbol, const size_t row, size_t& lastRowPosition){
-    std::string value(1, lastSymbol);
-    char symbol = '\0';
-    size_t counter = 1;
-    
-    while(stream.get(symbol)){
-        counter++;
-        value.append(1, symbol);
-
-        if(counter == 4){
-            break;
+namespace {
+    /**
+     * @brief Flag of characters skipped between tokens
+     */
+    const unsigned char WhitespaceFlag = 1;
+
+    /**
+     * @brief Flag of characters ending a number token: whitespace, ',', '}' and ']'
+     */
+    const unsigned char NumberEndFlag = 2;
+
+    /**
+     * @brief Flags of every character, looked up instead of comparing a character against each class
+     */
+    struct CharacterFlags {
+        unsigned char flags[256];  ///< Flags of each character
+
+        /**
+         * @brief Fills in the flags of every character
+         */
+        CharacterFlags() {
+            for(size_t symbol = 0; symbol < 256; symbol++) {
+                flags[symbol] = 0;
+
+                if(isspace(static_cast<int>(symbol))) {
+                    flags[symbol] |= WhitespaceFlag | NumberEndFlag;
+                }
+            }
+
+            flags[static_cast<unsigned char>(',')] |= NumberEndFlag;
+            flags[static_cast<unsigned char>('}')] |= NumberEndFlag;
+            flags[static_cast<unsigned char>(']')] |= NumberEndFlag;
         }
+
+        /**
+         * @brief Checks whether a character has a flag
+         * @param symbol Character to check
+         * @param flag Flag to look for
+         * @return True if the character has the flag, false otherwise
+         */
+        bool has(const char symbol, const unsigned char flag) const {
+            return (flags[static_cast<unsigned char>(symbol)] & flag) != 0;
+        }
+    };
+
+    /**
+     * @brief Flags of every character
+     */
+    const CharacterFlags characterFlags;
+
+    /**
+     * @brief Characters between the quotes of a key, located in the validated buffer
+     */
+    struct KeySpan {
+        size_t offset;  ///< Offset of the first character after the opening quote
+        size_t length;  ///< Number of characters between the quotes
+    };
+
+    /**
+     * @brief Array or object enclosing the one being validated
+     */
+    struct ValidatorFrame {
+        char brace;        ///< Opening brace/bracket character
+        size_t keysBase;   ///< Position of the object's first key on the key stack
+        size_t tableBase;  ///< Position of the object's hash table among the slots, JsonKeyTable::NoTable while it has none
+    };
+
+    /**
+     * @brief Reading state of the innermost array or object being validated
+     */
+    struct ValidatorState {
+        char brace;             ///< Opening brace/bracket character, '\0' once the outermost array or object is closed
+        bool isCommaFound;      ///< Whether the last token read is a comma
+        size_t stateOfReading;  ///< Tokens read of the current element: key, ':' and value in an object, value in an array
+        size_t keysBase;        ///< Position of the object's first key on the key stack
+        size_t tableBase;       ///< Position of the object's hash table among the slots, JsonKeyTable::NoTable while it has none
+    };
+
+    /**
+     * @brief Key of an object that a region of a parallel validation shares with the regions around it
+     */
+    struct SharedKey {
+        size_t object;  ///< Depth of the object while its region is checked, offset of its opening brace afterwards
+        KeySpan key;    ///< Characters of the key
+    };
+
+    /**
+     * @brief Stacks of the arrays and objects being validated and of the keys of the open objects
+     */
+    struct ValidatorStacks {
+        std::vector<ValidatorFrame> frames;  ///< Arrays and objects enclosing the one being validated, innermost last
+        std::vector<KeySpan> keys;           ///< Keys of the open objects
+        JsonKeyTable keyTable;               ///< Hash tables of the open objects
+        size_t sharedLevels = 0;             ///< Number of outermost levels opened before the region being checked, 0 for a whole buffer
+        size_t maxDepth = JsonValidator::DefaultMaxDepth;  ///< Number of arrays and objects allowed to enclose each other
+        std::vector<SharedKey> sharedKeys;   ///< Keys of the levels opened before the region, collected as they are closed
+    };
+
+    /**
+     * @brief Event handler ignoring every token, used when a stream only has to be checked
+     */
+    class IgnoringEventHandler : public JsonEventHandler {
+        public:
+            /**
+             * @brief Ignores an opened object
+             */
+            void startObject() override {}
+
+            /**
+             * @brief Ignores a closed object
+             */
+            void endObject() override {}
+
+            /**
+             * @brief Ignores an opened array
+             */
+            void startArray() override {}
+
+            /**
+             * @brief Ignores a closed array
+             */
+            void endArray() override {}
+
+            /**
+             * @brief Ignores a key
+             */
+            void visitKey(const char*, const size_t) override {}
+
+            /**
+             * @brief Ignores a null value
+             */
+            void visitNull() override {}
+
+            /**
+             * @brief Ignores a boolean value
+             */
+            void visitBoolean(const bool) override {}
+
+            /**
+             * @brief Ignores a number value
+             */
+            void visitNumber(const char*, const size_t) override {}
+
+            /**
+             * @brief Ignores a string value
+             */
+            void visitString(const char*, const size_t) override {}
+    };
+
+    /**
+     * @brief Records an error
+     * @param result Result to fill
+     * @param error Kind of the error
+     * @param offset Offset the error is reported at
+     * @param length Number of characters of the offending token
+     * @return Always false, so a failing check can return it directly
+     */
+    inline bool fail(ValidationResult& result, const ValidationError error, const size_t offset, const size_t length) {
+        result.error = error;
+        result.offset = offset;
+        result.length = length;
+        return false;
     }
 
-    if(!std::regex_match(value, std::regex("^null$"))){
-        const std::string errorMessage = "Invalid null value!\nGot " + value + 
-        " instead of null on row " + std::to_string(row)+" between positions " +
-        std::to_string(lastRowPosition) + " and " + std::to_string(lastRowPosition + counter -1) + ".\n";
-        return std::make_pair(false, errorMessage);
+    /**
+     * @brief Skips whitespace
+     * @param data Validated buffer
+     * @param length Number of characters in the buffer
+     * @param position Offset to start from
+     * @return Offset of the first character that is not whitespace, length if there is none
+     */
+    inline size_t skipWhitespace(const char* data, const size_t length, size_t position) {
+        while(position < length && characterFlags.has(data[position], WhitespaceFlag)) {
+            position++;
+        }
+
+        return position;
     }
 
+    /**
+     * @brief Records an error found inside a string unless an ill-formed UTF-8 sequence starts before it
+     * @param result Result to fill
+     * @param error Kind of the error
+     * @param start Offset of the opening quote
+     * @param symbol Offset of the character the error was found at
+     * @param length Number of characters of the offending token
+     * @param invalidUtf8 Offset of the first ill-formed UTF-8 sequence of the buffer
+     * @return Always false, so a failing check can return it directly
+     */
+    inline bool failString(ValidationResult& result, const ValidationError error, const size_t start, const size_t symbol, const size_t length,
+                           const size_t invalidUtf8) {
+        if(invalidUtf8 < symbol) {
+            return fail(result, ValidationError::InvalidUtf8, start, invalidUtf8 - start);
+        }
 
-    lastRowPosition += counter - 1;
+        return fail(result, error, start, length);
+    }
 
-    return  std::make_pair(true, value);
+    /**
+     * @brief Checks a string, skipping runs of plain characters in one go
+     * @param data Validated buffer
+     * @param length Number of characters in the buffer
+     * @param invalidUtf8 Offset of the first ill-formed UTF-8 sequence of the buffer, length if there is none
+     * @param position Offset of the opening quote, moved past the closing quote
+     * @param result Result filled in on error
+     * @return True if the string is valid, false otherwise
+     */
+    bool checkString(const char* data, const size_t length, const size_t invalidUtf8, size_t& position, ValidationResult& result) {
+        const size_t start = position;
+        size_t symbol = start + 1;
+
+        while(true) {
+            symbol = JsonGrammar::skipPlainCharacters(data + symbol, data + length) - data;
+
+            if(symbol >= length) {
+                return failString(result, ValidationError::UnclosedString, start, length, length - start, invalidUtf8);
+            }
 
-}
+            if(data[symbol] == '\"') {
+                if(invalidUtf8 < symbol) {
+                    return fail(result, ValidationError::InvalidUtf8, start, invalidUtf8 - start);
+                }
 
-/**
- * @brief Validates a JSON boolean value
- * @param stream Input stream to validate
- * @param lastSymbol Last character read
- * @param row Current row number
- * @param lastRowPosition Position in current row
- * @return Pair of validation result and error/success message
- */
-std::pair<bool, std::string> JsonValidator::validateBoolean(std::istream& stream, const char lastSymbol, const size_t row, size_t& lastRowPosition){
-    std::string value(1, lastSymbol);
-    char symbol = '\0';
-    size_t counter = 1;
-    
-    const size_t maxReadSymbols = lastSymbol == 't' ? 4 : 5;
+                position = symbol + 1;
+                return true;
+            }
+
+            if(data[symbol] != '\\') {
+                return failString(result, ValidationError::ControlCharacter, start, symbol, symbol - start, invalidUtf8);
+            }
+
+            symbol++;
+
+            const size_t hexDigits = symbol < length && data[symbol] == 'u' ? 4 : 0;
+
+            for(size_t i = 0; i <= hexDigits; i++, symbol++) {
+                if(symbol >= length) {
+                    return failString(result, ValidationError::UnclosedString, start, length, length - start, invalidUtf8);
+                }
+
+                if(static_cast<unsigned char>(data[symbol]) < 0x20) {
+                    return failString(result, ValidationError::ControlCharacter, start, symbol, symbol - start, invalidUtf8);
+                }
 
-    while(stream.get(symbol)){
-        counter++;
-        value.append(1, symbol);
+                const bool isValid = i == 0 ? JsonGrammar::isEscapeCharacter(data[symbol]) : isxdigit(static_cast<unsigned char>(data[symbol])) != 0;
 
-        if(counter == maxReadSymbols){
-            break;
+                if(!isValid) {
+                    return failString(result, ValidationError::InvalidEscape, start, symbol, symbol - start, invalidUtf8);
+                }
+            }
         }
     }
 
-    if(!std::regex_match(value, std::regex("^(true|false)$"))){
-        const std::string errorMessage = "Invalid boolean value!\nGot " + value + 
-        " instead of true or false on row " + std::to_string(row)+" between positions " +
-        std::to_string(lastRowPosition) + " and " + std::to_string(lastRowPosition + counter -1) + ".\n";
+    /**
+     * @brief Checks a null, true or false literal; as many characters as the literal has are read whatever they are
+     * @param data Validated buffer
+     * @param length Number of characters in the buffer
+     * @param position Offset of the first character, moved past the literal
+     * @param literal Expected literal
+     * @param error Error reported if the characters differ
+     * @param result Result filled in on error
+     * @return True if the literal is found, false otherwise
+     */
+    bool checkLiteral(const char* data, const size_t length, size_t& position, const char* literal, const ValidationError error,
+                      ValidationResult& result) {
+        const size_t literalLength = std::strlen(literal);
+        const size_t available = length - position;
+        const size_t counter = available < literalLength ? available : literalLength;
+
+        if(counter != literalLength || std::memcmp(data + position, literal, literalLength) != 0) {
+            return fail(result, error, position, counter);
+        }
 
-        return std::make_pair(false, errorMessage);
+        position += counter;
+        return true;
     }
 
+    /**
+     * @brief Checks a null, boolean, number or string value
+     * @param data Validated buffer
+     * @param length Number of characters in the buffer
+     * @param invalidUtf8 Offset of the first ill-formed UTF-8 sequence of the buffer, length if there is none
+     * @param position Offset of the first character, moved past the value
+     * @param result Result filled in on error
+     * @return True if the value is valid, false otherwise
+     */
+    bool checkPrimary(const char* data, const size_t length, const size_t invalidUtf8, size_t& position, ValidationResult& result) {
+        const char symbol = data[position];
+
+        switch(symbol) {
+            case 'n':
+                return checkLiteral(data, length, position, "null", ValidationError::InvalidNull, result);
+            case 't':
+                return checkLiteral(data, length, position, "true", ValidationError::InvalidBoolean, result);
+            case 'f':
+                return checkLiteral(data, length, position, "false", ValidationError::InvalidBoolean, result);
+            case '\"':
+                return checkString(data, length, invalidUtf8, position, result);
+            default:
+                break;
+        }
+
+        if(symbol != '-' && (symbol < '0' || symbol > '9')) {
+            return fail(result, ValidationError::InvalidValue, position, 0);
+        }
 
-    lastRowPosition += counter - 1;
+        const size_t start = position;
 
-    return  std::make_pair(true, value);
+        for(position++; position < length && !characterFlags.has(data[position], NumberEndFlag); position++) {}
 
-}
+        if(!JsonGrammar::isValidNumber(data + start, position - start)) {
+            return fail(result, ValidationError::InvalidNumber, start, position - start);
+        }
 
-/**
- * @brief Validates a JSON number value
- * @param stream Input stream to validate
- * @param lastSymbol Last character read
- * @param row Current row number
- * @param lastRowPosition Position in current row
- * @return Pair of validation result and error/success message
- */
-std::pair<bool, std::string> JsonValidator::validateNumber(std::istream& stream, const char lastSymbol, const size_t row, size_t& lastRowPosition){
+        return true;
+    }
 
-    std::string value(1, lastSymbol);
-    char symbol = '\0';
-    size_t counter = 1;
+    /**
+     * @brief Checks whether two keys have the same characters
+     * @param data Validated buffer
+     * @param left First key
+     * @param right Second key
+     * @return True if the keys are equal, false otherwise
+     */
+    inline bool isSameKey(const char* data, const KeySpan& left, const KeySpan& right) {
+        return left.length == right.length && std::memcmp(data + left.offset, data + right.offset, left.length) == 0;
+    }
 
-    while(stream.get(symbol)){
-        counter++;
+    /**
+     * @brief Keys of the key stack as JsonKeyTable reaches them
+     */
+    struct SpanKeys {
+        const char* data;                  ///< Validated buffer
+        const std::vector<KeySpan>& keys;  ///< Keys of the open objects
+
+        /**
+         * @brief Gets the number of keys on the stack
+         * @return Number of keys
+         */
+        size_t size() const {
+            return keys.size();
+        }
 
-        if(isspace(symbol) || symbol == ',' || symbol == '}' || symbol == ']'){
-            stream.seekg(-1, std::ios::cur);
-            counter--;
-            break;
+        /**
+         * @brief Hashes a key of the stack
+         * @param position Position of the key
+         * @return Hash of the key
+         */
+        size_t hash(const size_t position) const {
+            return ArenaStringHash()(data + keys[position].offset, keys[position].length);
         }
 
-        value.append(1, symbol);
+        /**
+         * @brief Compares two keys of the stack
+         * @param first Position of the first key
+         * @param second Position of the second key
+         * @return True if the keys are equal, false otherwise
+         */
+        bool isSame(const size_t first, const size_t second) const {
+            return isSameKey(data, keys[first], keys[second]);
+        }
+    };
+
+    /**
+     * @brief Keeps the keys of a level opened before the region being checked as it is closed
+     * @param stacks Stacks of the validator
+     * @param keysBase Position of the closed level's first key
+     */
+    void shareClosedKeys(ValidatorStacks& stacks, const size_t keysBase) {
+        stacks.sharedLevels = stacks.frames.size();
+
+        for(size_t key = keysBase; key < stacks.keys.size(); key++) {
+            stacks.sharedKeys.push_back(SharedKey{stacks.frames.size(), stacks.keys[key]});
+        }
     }
 
-    if(!std::regex_match(value, std::regex(R"(^-?(0|[1-9]\d*)(\.\d+)?([eE][+-]?\d+)?$)"))){
+    /**
+     * @brief Checks an array or object together with everything nested in it without recursion
+     * @param stacks Stacks of the validator, holding the levels enclosing the innermost one
+     * @param data Validated buffer
+     * @param length Number of characters in the buffer
+     * @param stop Offset of the comma the region ends at, length to check up to the closing brace/bracket
+     * @param invalidUtf8 Offset of the first ill-formed UTF-8 sequence of the buffer, length if there is none
+     * @param state State of the innermost level, updated when the value is closed or the region is done
+     * @param position Offset to continue from, moved past the closing brace/bracket or to the stop
+     * @param result Result filled in on error
+     * @return True if the value is valid up to where the check stopped, false otherwise
+     */
+    bool checkNested(ValidatorStacks& stacks, const char* data, const size_t length, const size_t stop, const size_t invalidUtf8,
+                     ValidatorState& state, size_t& position, ValidationResult& result) {
+        char brace = state.brace;
+        bool isObject = brace == '{';
+        bool isCommaFound = state.isCommaFound;
+        size_t stateOfReading = state.stateOfReading;
+        size_t keysBase = state.keysBase;
+        size_t tableBase = state.tableBase;
+
+        while(true) {
+            position = skipWhitespace(data, length, position);
+
+            if(position >= stop) {
+                if(position == stop && stop < length) {
+                    state = ValidatorState{brace, isCommaFound, stateOfReading, keysBase, tableBase};
+                    return true;
+                }
 
-        const std::string errorMessage = "Invalid number value!\nGot this: " + value +
-        " instead of valid number on row " + std::to_string(row)+" between positions " + std::to_string(lastRowPosition) + 
-        " and " + std::to_string(lastRowPosition + counter -1) + ".\n";
+                return fail(result, ValidationError::MissingClosingBracket, length, 0);
+            }
 
-        return std::make_pair(false, errorMessage);
-    }
+            const char symbol = data[position];
 
-    lastRowPosition += counter - 1;
+            if(symbol == '}' || symbol == ']') {
+                const bool isValidClosing = !isCommaFound && symbol - brace == 2 && (!isObject || stateOfReading == 0 || stateOfReading == 3);
 
-    return std::make_pair(true, value);
-}
+                if(!isValidClosing) {
+                    const ValidationError error = isCommaFound ? ValidationError::AdditionalComma :
+                                                  symbol - brace != 2 ? ValidationError::MismatchingClosingBracket :
+                                                  isObject && stateOfReading == 1 ? ValidationError::MissingKeySeparator :
+                                                  ValidationError::InvalidValue;
 
-/**
- * @brief Validates a JSON string value
- * @param stream Input stream to validate
- * @param lastSymbol Last character read
- * @param row Current row number
- * @param lastRowPosition Position in current row
- * @return Pair of validation result and error/success message
- */
-std::pair<bool, std::string> JsonValidator::validateString(std::istream& stream, const char lastSymbol, const size_t row, size_t& lastRowPosition){
+                    return fail(result, error, position, 0);
+                }
+
+                position++;
 
-    std::string value(1, lastSymbol);
-    char symbol = '\0';
-    size_t counter = 1;
-    bool isRevSolidusRead = false;
+                if(stacks.frames.size() < stacks.sharedLevels) {
+                    shareClosedKeys(stacks, keysBase);
+                }
 
-    while(stream.get(symbol)){
-        counter++;
+                stacks.keys.resize(keysBase);
 
-        if(symbol == '\\'){
-            if(isRevSolidusRead && value[value.length() - 1] != '\\'){
-                const std::string errorMessage = "Invalid string value!\nGot unescaped \\ in this: " + value +
-                " on row " + std::to_string(row)+" between positions " + std::to_string(lastRowPosition) + 
-                " and " + std::to_string(lastRowPosition + counter -1) + ".\n";
+                stacks.keyTable.release(tableBase);
 
-                return std::make_pair(false, errorMessage);
+                if(stacks.frames.empty()) {
+                    state.brace = '\0';
+                    return true;
+                }
+
+                const ValidatorFrame& parent = stacks.frames.back();
+
+                brace = parent.brace;
+                isObject = brace == '{';
+                keysBase = parent.keysBase;
+                tableBase = parent.tableBase;
+                stateOfReading = isObject ? 3 : 1;
+                isCommaFound = false;
+
+                stacks.frames.pop_back();
+                continue;
             }
 
-            isRevSolidusRead = true;
-        }
+            if(isObject && stateOfReading == 0) {
+                isCommaFound = false;
+                stateOfReading++;
 
-        else if(iscntrl(symbol)){
+                if(symbol != '\"') {
+                    return fail(result, ValidationError::InvalidKey, position, 0);
+                }
 
-            if(value[value.length() - 1] != '\\'){
-                const std::string errorMessage = "Invalid string value!\nGot control character or \\ in this: " + value +
-                " on row " + std::to_string(row)+" between positions " + std::to_string(lastRowPosition) + 
-                " and " + std::to_string(lastRowPosition + counter -1) + ".\n";
+                const size_t keyStart = position;
 
-                return std::make_pair(false, errorMessage);
+                if(!checkString(data, length, invalidUtf8, position, result)) {
+                    return false;
+                }
+
+                stacks.keys.push_back(KeySpan{keyStart + 1, position - keyStart - 2});
+
+                if(stacks.keyTable.isDuplicate(SpanKeys{data, stacks.keys}, keysBase, tableBase)) {
+                    return fail(result, ValidationError::DuplicateKey, keyStart, position - keyStart);
+                }
+
+                continue;
             }
 
-            isRevSolidusRead = false;
-        }
+            if(isObject && stateOfReading == 1) {
+                stateOfReading++;
 
-        else if(symbol == '\"' && value[value.length() - 1] != '\\'){
-            value.append(1, symbol);
-            break;
-        }
+                if(symbol != ':') {
+                    return fail(result, ValidationError::MissingKeySeparator, position, 0);
+                }
 
-        isRevSolidusRead = false;
-        value.append(1, symbol);
-    }
+                position++;
+                continue;
+            }
 
-    if(value.length() < 2 || value[value.length() - 1] != '\"'){
+            const bool isValueExpected = isObject ? stateOfReading == 2 : stateOfReading == 0;
 
-        const std::string errorMessage = "Invalid string value!\nGot unclosed string value: " + value +
-        " on row " + std::to_string(row)+" between positions " + std::to_string(lastRowPosition) + 
-        " and " + std::to_string(lastRowPosition + counter -1) + ".\n";
+            if(!isValueExpected) {
+                if(symbol != ',') {
+                    return fail(result, ValidationError::MissingComma, position, 0);
+                }
 
-        return std::make_pair(false, errorMessage);
-    }
+                position++;
+                isCommaFound = true;
+                stateOfReading = 0;
 
-    lastRowPosition += counter - 1;
+                continue;
+            }
 
-    return std::make_pair(true, value);
-}
+            if(symbol == '{' || symbol == '[') {
+                if(stacks.frames.size() + 1 >= stacks.maxDepth) {
+                    return fail(result, ValidationError::MaximumDepthExceeded, position, 0);
+                }
 
-/**
- * @brief Validates a primary JSON value
- * @param stream Input stream to validate
- * @param symbol Current symbol being processed
- * @param row Current row number
- * @param position Current position in row
- * @param stateOfReading Current reading state
- * @param mode Current reading mode
- * @param isCommaFound Flag indicating if comma was found
- * @param objectKeys Set of object keys for duplicate detection
- * @return Pair of validation result and error/success message
- */
-std::pair<bool, std::string> JsonValidator::validatePrimary(std::istream& stream, const char symbol, const size_t row, size_t& position, size_t& stateOfReading, const ReadingMode& mode, bool& isCommaFound, std::unordered_set<std::string>& objectKeys){
-    size_t stateModeCase = stateOfReading;
-    
-    switch (mode)
-    {
-        case ReadingMode::ReadingArray:{
-            stateModeCase = stateOfReading == 0 ? 2 : 3;
-            break;
-        }
-        case ReadingMode::ReadingPrimary:{
-            stateModeCase = 2;
-            break;
-        }
-        default:
-            break;
-    }
+                stacks.frames.push_back(ValidatorFrame{brace, keysBase, tableBase});
+                position++;
 
-    switch(stateModeCase){
-        case 0:{
-            isCommaFound = false;
-            stateOfReading++;
+                brace = symbol;
+                isObject = brace == '{';
+                isCommaFound = false;
+                stateOfReading = 0;
+                keysBase = stacks.keys.size();
+                tableBase = JsonKeyTable::NoTable;
 
-            if(symbol != '\"'){
-                const std::string errorMessage = "Invalid key found on row " + std::to_string(row)+" on position " 
-                + std::to_string(position - 1) + ".\n";
+                continue;
+            }
 
-                return std::make_pair(false, errorMessage);
+            if(!checkPrimary(data, length, invalidUtf8, position, result)) {
+                return false;
             }
 
-            const std::pair<bool, std::string> result = validateString(stream, symbol, row, position);
-            if(!result.first){
-                return result;
+            stateOfReading++;
+            isCommaFound = false;
+        }
+    }
+
+    /**
+     * @brief Number of characters below which a buffer is validated on the calling thread alone
+     */
+    const size_t MinimumParallelSize = 1024 * 1024;
+
+    /**
+     * @brief Part of the buffer checked by one thread, cut right before a comma outside strings
+     */
+    struct ValidatorRegion {
+        size_t begin;                        ///< Offset of the first character, the comma except for the first region
+        std::vector<OpenBracket> enclosing;  ///< Levels open at the first character, outermost first
+    };
+
+    /**
+     * @brief Outcome of checking one region
+     */
+    struct RegionOutcome {
+        bool isValid = false;               ///< Whether the region is valid and ends the way the next region starts
+        bool isClosed = false;              ///< Whether the top-level value is closed in the region
+        std::vector<SharedKey> sharedKeys;  ///< Keys of the objects the region shares with others, by the offset of their opening brace
+    };
+
+    /**
+     * @brief Tasks of a parallel validation handed out to the threads in order
+     */
+    struct TaskQueue {
+        const std::function<void(const size_t)>& task;  ///< Task run for each position
+        const size_t count;                              ///< Number of tasks
+        std::atomic<size_t> next;                        ///< Position of the next task not taken by a thread
+        std::atomic<bool> isFailed;                      ///< Whether any task threw
+
+        /**
+         * @brief Constructs a queue of no task taken
+         * @param _task Task run for each position
+         * @param _count Number of tasks
+         */
+        TaskQueue(const std::function<void(const size_t)>& _task, const size_t _count) : task(_task), count(_count), next(0), isFailed(false) {}
+    };
+
+    /**
+     * @brief Takes tasks until none are left or any task threw
+     * @param queue Queue to take the tasks from
+     */
+    void drain(TaskQueue& queue) {
+        while(!queue.isFailed) {
+            const size_t position = queue.next++;
+
+            if(position >= queue.count) {
+                return;
             }
 
-            if(objectKeys.find(result.second) != objectKeys.end()){
-                const std::string errorMessage = "Dublicate keys in same object found. The dublicate key: " + result.second + " is on row " + std::to_string(row)+" on position " 
-                + std::to_string(position) + ".\n";
+            try {
+                queue.task(position);
+            }
+            catch(...) {
+                queue.isFailed = true;
+            }
+        }
+    }
 
-                return std::make_pair(false, errorMessage);
-            }   
+    /**
+     * @brief Runs tasks on worker threads and the calling thread
+     * @param count Number of tasks
+     * @param threadCount Number of threads including the calling one
+     * @param task Task run for each position
+     * @return True if every task finished, false if any threw
+     */
+    bool runTasks(const size_t count, const size_t threadCount, const std::function<void(const size_t)>& task) {
+        TaskQueue queue(task, count);
+        const size_t workerCount = std::min(threadCount, count) - 1;
+        std::vector<std::thread> workers;
+
+        for(size_t i = 0; i < workerCount; i++) {
+            try {
+                workers.push_back(std::thread(drain, std::ref(queue)));
+            }
+            catch(const std::system_error&) {
+                break;
+            }
+        }
 
-            objectKeys.insert(result.second);
+        drain(queue);
 
-            return std::make_pair(true, "It is valid!\n");
+        for(std::thread& worker : workers) {
+            worker.join();
         }
-        case 1:{
-            stateOfReading++;
 
-            if(symbol != ':'){
-                const std::string errorMessage = "Key value pair separator ':' not found on row " + std::to_string(row)+" on position " 
-                + std::to_string(position - 1) + ".\n";
+        return !queue.isFailed;
+    }
+
+    /**
+     * @brief Closes and opens the levels of a profile
+     * @param levels Levels open before the profile's part, updated to the ones open after it
+     * @param profile Brackets of the part
+     * @param depthLimit Number of levels the parser allows
+     * @return True if every closing bracket matches and the levels stay within the limit, false otherwise
+     */
+    bool applyProfile(std::vector<OpenBracket>& levels, const BracketProfile& profile, const size_t depthLimit) {
+        if(profile.isBroken) {
+            return false;
+        }
 
-                return std::make_pair(false, errorMessage);
+        for(const char symbol : profile.closers) {
+            if(levels.empty() || symbol - levels.back().brace != 2) {
+                return false;
             }
 
-            return std::make_pair(true, "It is valid!\n"); 
+            levels.pop_back();
         }
-        case 2:{
-            if(mode != ReadingMode::ReadingPrimary){
-                stateOfReading++;
-                isCommaFound = false;
+
+        levels.insert(levels.end(), profile.openers.begin(), profile.openers.end());
+        return levels.size() <= depthLimit;
+    }
+
+    /**
+     * @brief Settles whether each chunk starts inside a string and cuts the buffer into regions
+     * @param scans Scans of the chunks in order
+     * @param regions Regions to fill
+     * @param depthLimit Number of levels the parser allows
+     * @return True if the brackets match and every string is closed, false otherwise
+     */
+    bool planRegions(const std::vector<ChunkScan>& scans, std::vector<ValidatorRegion>& regions, const size_t depthLimit) {
+        std::vector<OpenBracket> levels;
+        bool isInString = false;
+
+        regions.push_back(ValidatorRegion{0, levels});
+
+        for(size_t chunk = 0; chunk < scans.size(); chunk++) {
+            const ChunkScan& scan = scans[chunk];
+            const size_t guess = isInString ? 1 : 0;
+
+            if(!applyProfile(levels, scan.heads[guess], depthLimit)) {
+                return false;
             }
 
-            if(!isdigit(symbol) && symbol != 'n' && symbol != 't' && symbol != 'f' && symbol != '-' && symbol != '\"'){
-                const std::string errorMessage = "Invalid json value found on row " + std::to_string(row)+" starting on position " 
-                + std::to_string(position - 1) + ".\n";
+            if(chunk > 0 && scan.hasComma[guess]) {
+                regions.push_back(ValidatorRegion{scan.commas[guess], levels});
+            }
 
-                return std::make_pair(false, errorMessage);
+            if(!applyProfile(levels, scan.tails[guess], depthLimit)) {
+                return false;
             }
 
-            std::pair<bool, std::string> result;
+            isInString = isInString != scan.isQuoteCountOdd;
+        }
 
-            switch (symbol)
-            {
-                case 'n':{
-                    result = validateNull(stream, symbol, row, position);
-                    break;
-                }
-                case 't':
-                case 'f':{
-                    result = validateBoolean(stream, symbol, row, position);
-                    break;
-                }
-                case '-':{
-                    result = validateNumber(stream, symbol, row, position);
-                    break;
-                }
-                case '\"':{
-                    result = validateString(stream, symbol, row, position);
-                    break;
-                }
-                default:{
-                    if(!isdigit(symbol)){
-                        const std::string errorMessage = "Invalid json value found on row " + std::to_string(row)+" starting on position " 
-                        + std::to_string(position - 1) + ".\n";
+        return !isInString && levels.empty();
+    }
 
-                        return std::make_pair(false, errorMessage);
-                    }
+    /**
+     * @brief Checks one region with the state machine, starting from the levels open at its first character
+     * @param data Validated buffer
+     * @param length Number of characters in the buffer
+     * @param regions Regions of the buffer
+     * @param region Position of the region to check
+     * @param maxDepth Number of arrays and objects allowed to enclose each other
+     * @param outcome Outcome to fill
+     */
+    void checkRegion(const char* data, const size_t length, const std::vector<ValidatorRegion>& regions, const size_t region,
+                     const size_t maxDepth, RegionOutcome& outcome) {
+        const ValidatorRegion& current = regions[region];
+        const size_t stop = region + 1 < regions.size() ? regions[region + 1].begin : length;
+
+        if(JsonUtf8::findInvalid(data + current.begin, data + stop) != data + stop) {
+            return;
+        }
 
-                    result = validateNumber(stream, symbol, row, position);
+        ValidationResult result = {ValidationError::None, 0, 0, 0};
+        ValidatorStacks stacks;
+        ValidatorState state = {'\0', false, 0, 0, JsonKeyTable::NoTable};
+        size_t position = skipWhitespace(data, length, current.begin);
 
-                    break;
-                }
+        stacks.maxDepth = maxDepth;
+
+        if(region == 0) {
+            state.brace = data[position];
+            position++;
+        } else {
+            if(current.enclosing.empty()) {
+                return;
             }
-            
-            return result;
-        }
-        default:{
-            if(symbol != ','){
-                const std::string errorMessage = "Missing ',' on row " + std::to_string(row)+" before position " 
-                + std::to_string(position - 1) + ".\n";
 
-                return std::make_pair(false, errorMessage);
+            for(size_t level = 0; level + 1 < current.enclosing.size(); level++) {
+                stacks.frames.push_back(ValidatorFrame{current.enclosing[level].brace, 0, JsonKeyTable::NoTable});
             }
 
-            isCommaFound = true;
-            stateOfReading = 0;
+            state.brace = current.enclosing.back().brace;
+            state.stateOfReading = state.brace == '{' ? 3 : 1;
+            stacks.sharedLevels = current.enclosing.size();
+        }
 
-            return std::make_pair(true, "It is valid!\n");
+        if(!checkNested(stacks, data, length, stop, length, state, position, result)) {
+            return;
         }
 
+        for(SharedKey& shared : stacks.sharedKeys) {
+            shared.object = current.enclosing[shared.object].offset;
+        }
+
+        if(state.brace == '\0') {
+            outcome.isClosed = true;
+            outcome.isValid = skipWhitespace(data, length, position) >= length;
+            outcome.sharedKeys.swap(stacks.sharedKeys);
+            return;
+        }
+
+        const ValidatorRegion& next = regions[region + 1];
+
+        if(next.enclosing.size() != stacks.frames.size() + 1 || state.isCommaFound || state.stateOfReading != (state.brace == '{' ? 3 : 1)) {
+            return;
+        }
+
+        for(size_t level = 0; level < next.enclosing.size(); level++) {
+            const bool isInnermost = level == stacks.frames.size();
+            const char brace = isInnermost ? state.brace : stacks.frames[level].brace;
+            const size_t first = isInnermost ? state.keysBase : stacks.frames[level].keysBase;
+            const size_t last = isInnermost ? stacks.keys.size() : level + 1 < stacks.frames.size() ? stacks.frames[level + 1].keysBase : state.keysBase;
+
+            if(brace != next.enclosing[level].brace) {
+                return;
+            }
+
+            for(size_t key = first; key < last; key++) {
+                stacks.sharedKeys.push_back(SharedKey{next.enclosing[level].offset, stacks.keys[key]});
+            }
+        }
+
+        outcome.isValid = true;
+        outcome.sharedKeys.swap(stacks.sharedKeys);
     }
-}
 
-/**
- * @brief Main validation function for JSON content
- * @param stream Input stream to validate
- * @param row Current row number
- * @param position Current position in row
- * @param lastBrace Last opening brace/bracket encountered
- * @param mode Current reading mode
- * @return Pair of validation result and error/success message
- */
-std::pair<bool, std::string> JsonValidator::validate(std::istream& stream, size_t& row, size_t& position, char lastBrace, const ReadingMode& mode){
+    /**
+     * @brief Checks whether two shared keys belong to the same object and have the same characters
+     * @param data Validated buffer
+     * @param left First key
+     * @param right Second key
+     * @return True if the keys are duplicates, false otherwise
+     */
+    inline bool isSameSharedKey(const char* data, const SharedKey& left, const SharedKey& right) {
+        return left.object == right.object && isSameKey(data, left.key, right.key);
+    }
+
+    /**
+     * @brief Checks a buffer on several threads
+     * @param data Validated buffer
+     * @param length Number of characters in the buffer, starting with an array or object
+     * @param threadCount Number of threads including the calling one
+     * @param maxDepth Number of arrays and objects allowed to enclose each other
+     * @return Number of regions checked if the whole buffer is valid, 0 if anything is invalid or could not be checked
+     */
+    size_t checkInParallel(const char* data, const size_t length, const size_t threadCount, const size_t maxDepth) {
+        std::vector<ChunkScan> scans(threadCount);
+        std::vector<ValidatorRegion> regions;
+
+        const bool isScanned = runTasks(threadCount, threadCount, [&](const size_t chunk) {
+            const size_t begin = length / threadCount * chunk;
+            const size_t end = chunk + 1 < threadCount ? begin + length / threadCount : length;
+
+            JsonStructuralIndexer::scanChunk(data, begin, end, maxDepth, scans[chunk]);
+        });
+
+        if(!isScanned || !planRegions(scans, regions, maxDepth)) {
+            return 0;
+        }
 
-    std::unordered_set<std::string> objectKeys;
+        std::vector<ChunkScan>().swap(scans);
+        std::vector<RegionOutcome> outcomes(regions.size());
 
-    char symbol = '\0';
-    bool isClosingBrackedFound = false;
-    bool isCommaFound = false;
-    size_t stateOfReading = 0;
+        const bool isChecked = runTasks(regions.size(), threadCount, [&](const size_t region) {
+            checkRegion(data, length, regions, region, maxDepth, outcomes[region]);
+        });
 
-    while(stream.get(symbol)){
+        if(!isChecked) {
+            return 0;
+        }
 
-        position++;
+        std::vector<SharedKey> sharedKeys;
 
-        switch(symbol){
-            case '\n':{
-                row++;
-                position = 0;
-                break;
+        for(size_t region = 0; region < outcomes.size(); region++) {
+            if(!outcomes[region].isValid || outcomes[region].isClosed != (region + 1 == outcomes.size())) {
+                return 0;
             }
-            case '{':
-            case '[':{
 
-                ReadingMode newMode = symbol == '{' ? ReadingMode::ReadingObject : ReadingMode::ReadingArray;
+            sharedKeys.insert(sharedKeys.end(), outcomes[region].sharedKeys.begin(), outcomes[region].sharedKeys.end());
+        }
 
-                const std::pair<bool, std::string> result = validate(stream, row, position, symbol, newMode);
+        std::sort(sharedKeys.begin(), sharedKeys.end(), [data](const SharedKey& left, const SharedKey& right) {
+            if(left.object != right.object || left.key.length != right.key.length) {
+                return left.object != right.object ? left.object < right.object : left.key.length < right.key.length;
+            }
 
-                if(!result.first){
-                    return result;
-                }
+            return std::memcmp(data + left.key.offset, data + right.key.offset, left.key.length) < 0;
+        });
 
-                isCommaFound = false;
+        for(size_t key = 1; key < sharedKeys.size(); key++) {
+            if(isSameSharedKey(data, sharedKeys[key - 1], sharedKeys[key])) {
+                return 0;
+            }
+        }
 
-                stateOfReading++;
+        return regions.size();
+    }
 
+    /**
+     * @brief Finds the first error in JSON content with a hand-written state machine
+     * @param data Pointer to the first character of the JSON text
+     * @param length Number of characters in the buffer
+     * @param maxDepth Number of arrays and objects allowed to enclose each other
+     * @return First error found, ValidationError::None when the JSON is valid
+     */
+    ValidationResult checkBuffer(const char* data, const size_t length, const size_t maxDepth) {
+        ValidationResult result = {ValidationError::None, 0, 0, 0};
+        ValidatorStacks stacks;
+        const size_t invalidUtf8 = JsonUtf8::findInvalid(data, data + length) - data;
+        size_t position = 0;
+        bool isValueFound = false;
+
+        stacks.maxDepth = maxDepth;
+
+        while(true) {
+            position = skipWhitespace(data, length, position);
+
+            if(position >= length) {
                 break;
             }
-            case '}':
-            case ']':{
-                if(isCommaFound && mode != ReadingMode::ReadingPrimary){
-                    const std::string errorMessage = "Additional comma found on row " + std::to_string(row)+" on position " 
-                    + std::to_string(position) + ".\n";
 
-                    return std::make_pair(false, errorMessage);
-                }
+            const char symbol = data[position];
 
-                isClosingBrackedFound = true;
-                break;
+            if(symbol == '}' || symbol == ']' || isValueFound) {
+                fail(result, symbol == '}' || symbol == ']' ? ValidationError::AdditionalClosingBracket : ValidationError::InvalidValue, position, 0);
+                return result;
             }
-            default:{
-                if(isspace(symbol)){
-                    break;
-                }
 
-                const std::pair<bool, std::string> result = validatePrimary(stream, symbol, row, position, stateOfReading, mode, isCommaFound, objectKeys);
+            bool isValid;
 
-                if(!result.first){
-                    return result;
-                }
+            if(symbol == '{' || symbol == '[') {
+                ValidatorState state = {symbol, false, 0, 0, JsonKeyTable::NoTable};
 
-                break;
+                position++;
+                isValid = checkNested(stacks, data, length, length, invalidUtf8, state, position, result);
+            } else {
+                isValid = checkPrimary(data, length, invalidUtf8, position, result);
             }
+
+            if(!isValid) {
+                return result;
+            }
+
+            isValueFound = true;
         }
 
-        if(symbol == '}' || symbol == ']')
-            break;
-    }
+        if(!isValueFound) {
+            fail(result, ValidationError::InvalidValue, length, 0);
+        }
 
-    if(mode != ReadingMode::ReadingPrimary && !isClosingBrackedFound){
+        return result;
+    }
+}
 
-        const std::string errorMessage = "Missing closing bracket on row " + std::to_string(row)+" on position " 
-        + std::to_string(position - 1) + ".\n";
+/**
+ * @brief Validates JSON content from a contiguous buffer, building the message only if an error was found
+ * @param data Pointer to the first character of the JSON text
+ * @param length Number of characters in the buffer
+ * @return Pair of validation result and error message
+ */
+std::pair<bool, std::string> JsonValidator::validateJson(const char* data, const size_t length){
+    const ValidationResult result = checkBuffer(data, length, DefaultMaxDepth);
 
-        return std::make_pair(false, errorMessage);
+    if(result.error == ValidationError::None) {
+        return std::make_pair(true, std::string(""));
     }
 
-    if(mode == ReadingMode::ReadingPrimary && isClosingBrackedFound){
-         const std::string errorMessage = "Additional closing bracket on row " + std::to_string(row)+" on position " 
-        + std::to_string(position - 1) + ".\n";
+    return std::make_pair(false, describe(data, length, result));
+}
+
+/**
+ * @brief Validates JSON content from a contiguous buffer on several threads
+ * @param data Pointer to the first character of the JSON text
+ * @param length Number of characters in the buffer
+ * @param threadCount Number of threads validating the buffer including the calling one, 0 to use one per hardware thread
+ * @param maxDepth Number of arrays and objects allowed to enclose each other
+ * @return Pair of validation result and error message
+ */
+std::pair<bool, std::string> JsonValidator::validateJson(const char* data, const size_t length, const size_t threadCount,
+                                                         const size_t maxDepth) {
+    const ValidationResult result = check(data, length, threadCount, maxDepth);
 
-        return std::make_pair(false, errorMessage);
+    if(result.error == ValidationError::None) {
+        return std::make_pair(true, std::string(""));
     }
 
-    if(mode != ReadingMode::ReadingPrimary && symbol - lastBrace != 2){
-        const std::string errorMessage = "Mismatching closing bracket on row " + std::to_string(row)+" on position " 
-        + std::to_string(position - 1) + ".\n";
+    return std::make_pair(false, describe(data, length, result, maxDepth));
+}
+
+/**
+ * @brief Validates JSON content from an input stream chunk by chunk with JsonEventParser
+ * @param stream Input stream to validate
+ * @param maxDepth Number of arrays and objects allowed to enclose each other
+ * @return Pair of validation result and error message
+ */
+std::pair<bool, std::string> JsonValidator::validateJson(std::istream& stream, const size_t maxDepth){
+    IgnoringEventHandler handler;
 
-        return std::make_pair(false, errorMessage);
+    try {
+        JsonEventParser::parse(stream, handler, maxDepth, true);
+    }
+    catch(const std::runtime_error& error) {
+        return std::make_pair(false, std::string(error.what()));
     }
 
-    return std::make_pair(true, "It is valid Json!\n");
+    return std::make_pair(true, std::string(""));
+}
+
+/**
+ * @brief Finds the first error in JSON content on the calling thread, allowing the default nesting depth
+ * @param data Pointer to the first character of the JSON text
+ * @param length Number of characters in the buffer
+ * @return First error found, ValidationError::None when the JSON is valid
+ */
+ValidationResult JsonValidator::check(const char* data, const size_t length) {
+    return checkBuffer(data, length, DefaultMaxDepth);
+}
+
+/**
+ * @brief Finds the first error in JSON content on several threads, falling back to one thread on any error
+ * @param data Pointer to the first character of the JSON text
+ * @param length Number of characters in the buffer
+ * @param threadCount Number of threads checking the buffer including the calling one, 0 to use one per hardware thread
+ * @param maxDepth Number of arrays and objects allowed to enclose each other
+ * @return First error found, ValidationError::None when the JSON is valid
+ */
+ValidationResult JsonValidator::check(const char* data, const size_t length, const size_t threadCount, const size_t maxDepth) {
+    const size_t threads = threadCount == 0 ? std::thread::hardware_concurrency() : threadCount;
+    const size_t begin = skipWhitespace(data, length, 0);
+
+    const bool isSplittable = threads > 1 && length >= MinimumParallelSize && begin < length && (data[begin] == '{' || data[begin] == '[');
+
+    const size_t regionCount = isSplittable ? checkInParallel(data, length, threads, maxDepth) : 0;
+
+    if(regionCount != 0) {
+        return ValidationResult{ValidationError::None, 0, 0, regionCount};
+    }
 
+    return checkBuffer(data, length, maxDepth);
 }
 
 /**
- * @brief Entry point for JSON validation
- * @param stream Input stream containing JSON to validate
- * @return Pair of validation result and error/success message
+ * @brief Builds the row/position message of an error, locating it only now
+ * @param data Pointer to the first character of the JSON text the error was found in
+ * @param length Number of characters in the buffer
+ * @param result Error to describe
+ * @param maxDepth Nesting depth the text was checked against, quoted when it was exceeded
+ * @return Human-readable message of the error, empty for ValidationError::None
  */
-std::pair<bool, std::string> JsonValidator::validateJson(std::istream& stream){
-    size_t row = 1, position = 1;
-    std::pair<bool, std::string> validationResult = validate(stream, row, position);
-    return validationResult;
-}
\ No newline at end of file
+std::string JsonValidator::describe(const char* data, const size_t length, const ValidationResult& result, const size_t maxDepth) {
+    const size_t consumed = result.error == ValidationError::DuplicateKey ? result.offset + result.length :
+                            result.offset < length ? result.offset + 1 : length;
+    const char* lastNewline = nullptr;
+    size_t row = 1;
+
+    for(const char* symbol = data; symbol < data + consumed; symbol++) {
+        if(*symbol == '\n') {
+            row++;
+            lastNewline = symbol;
+        }
+    }
+
+    const size_t position = lastNewline == nullptr ? consumed + 1 : data + consumed - 1 - lastNewline;
+    const std::string token(data + result.offset, result.length);
+    const std::string rowText = std::to_string(row);
+
+    switch(result.error) {
+        case ValidationError::None:
+            return "";
+        case ValidationError::InvalidNull:
+            return "Invalid null value!\nGot " + token + " instead of null on row " + rowText + " between positions " +
+                   std::to_string(position) + " and " + std::to_string(position + result.length - 1) + ".\n";
+        case ValidationError::InvalidBoolean:
+            return "Invalid boolean value!\nGot " + token + " instead of true or false on row " + rowText + " between positions " +
+                   std::to_string(position) + " and " + std::to_string(position + result.length - 1) + ".\n";
+        case ValidationError::InvalidNumber:
+            return "Invalid number value!\nGot this: " + token + " instead of valid number on row " + rowText + " between positions " +
+                   std::to_string(position) + " and " + std::to_string(position + result.length - 1) + ".\n";
+        case ValidationError::ControlCharacter:
+            return "Invalid string value!\nGot control character or \\ in this: " + token + " on row " + rowText + " between positions " +
+                   std::to_string(position) + " and " + std::to_string(position + result.length) + ".\n";
+        case ValidationError::InvalidEscape:
+            return "Invalid string value!\nGot invalid escape sequence in this: " + token + " on row " + rowText + " between positions " +
+                   std::to_string(position) + " and " + std::to_string(position + result.length) + ".\n";
+        case ValidationError::InvalidUtf8:
+            return "Invalid string value!\nGot invalid UTF-8 sequence in this: " + token + " on row " + rowText + " between positions " +
+                   std::to_string(position) + " and " + std::to_string(position + result.length) + ".\n";
+        case ValidationError::UnclosedString:
+            return "Invalid string value!\nGot unclosed string value: " + token + " on row " + rowText + " between positions " +
+                   std::to_string(position) + " and " + std::to_string(position + result.length - 1) + ".\n";
+        case ValidationError::InvalidValue:
+            return "Invalid json value found on row " + rowText + " starting on position " + std::to_string(position - 1) + ".\n";
+        case ValidationError::AdditionalClosingBracket:
+            return "Additional closing bracket on row " + rowText + " on position " + std::to_string(position - 1) + ".\n";
+        case ValidationError::MissingClosingBracket:
+            return "Missing closing bracket on row " + rowText + " on position " + std::to_string(position - 1) + ".\n";
+        case ValidationError::AdditionalComma:
+            return "Additional comma found on row " + rowText + " on position " + std::to_string(position) + ".\n";
+        case ValidationError::MismatchingClosingBracket:
+            return "Mismatching closing bracket on row " + rowText + " on position " + std::to_string(position - 1) + ".\n";
+        case ValidationError::MissingKeySeparator:
+            return "Key value pair separator ':' not found on row " + rowText + " on position " + std::to_string(position - 1) + ".\n";
+        case ValidationError::InvalidKey:
+            return "Invalid key found on row " + rowText + " on position " + std::to_string(position - 1) + ".\n";
+        case ValidationError::DuplicateKey:
+            return "Dublicate keys in same object found. The dublicate key: " + token + " is on row " + rowText + " on position " +
+                   std::to_string(position) + ".\n";
+        case ValidationError::MissingComma:
+            return "Missing ',' on row " + rowText + " before position " + std::to_string(position - 1) + ".\n";
+        case ValidationError::MaximumDepthExceeded:
+        default:
+            return "Maximum nesting depth of " + std::to_string(maxDepth) + " exceeded on row " + rowText +
+                   " on position " + std::to_string(position - 1) + ".\n";
+    }
+}
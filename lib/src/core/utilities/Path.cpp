@@ -1,5 +1,8 @@
+#include <algorithm>
 #include "Path.hpp"
 #include "JsonObject.hpp"
+#include "JsonEscaper.hpp"
+#include "JsonStringWriter.hpp"
 
 /**
  * @brief Validates if a path exists in the JSON structure
@@ -93,7 +96,7 @@ const JsonObject* Path::getParent(const JsonValue* const rootValue, const std::s
  */
 std::string Path::getKey(const std::string& path) {
     if(getChildren(path) == "") {
-        return path;
+        return getRoot(path);
     }
 
     return getKey(getChildren(path));
@@ -122,18 +125,23 @@ std::string Path::getLastPath(const JsonValue* const rootValue, const std::strin
 }
 
 /**
- * @brief Gets the root segment of a path
+ * @brief Gets the root segment of a path as an escaped key
  * @param path Path to extract root from
- * @return The root segment (before first '/')
+ * @return The root segment (before first '/'), escaped as the content of a JSON string
  */
 std::string Path::getRoot(const std::string& path) {
-    const size_t slash_pos = path.find('/');
+    const size_t slash_pos = std::min(path.find('/'), path.length());
 
-    if (slash_pos == std::string::npos) {
-        return path;
+    if (JsonEscaper::findEscape(path.data(), path.data() + slash_pos) == path.data() + slash_pos) {
+        return path.substr(0, slash_pos);
     }
 
-    return path.substr(0, slash_pos);
+    std::string root;
+    JsonStringWriter writer(root);
+    JsonEscaper::write(writer, path.data(), slash_pos);
+    writer.flush();
+
+    return root;
 }
 
 /**
@@ -0,0 +1,255 @@
+#include <algorithm>
+#include <new>
+#include "JsonArena.hpp"
+
+/**
+ * @brief Anonymous namespace for the allocation layout constants
+ */
+namespace {
+    /**
+     * @brief Alignment of every allocation, enough for pointers, sizes and doubles
+     */
+    const size_t Alignment = 8;
+
+    /**
+     * @brief Size of the tag stored in front of every allocation, naming the owning arena or nullptr for the heap
+     */
+    const size_t HeaderSize = 8;
+
+    /**
+     * @brief Usable size of the first chunk of an arena
+     */
+    const size_t FirstChunkSize = 64 * 1024;
+
+    /**
+     * @brief Usable size regular chunks stop growing at
+     */
+    const size_t MaxChunkSize = 4 * 1024 * 1024;
+
+    /**
+     * @brief Rounds a size up to the alignment
+     * @param size Size to round
+     * @return Rounded size
+     */
+    inline size_t align(const size_t size) {
+        return (size + Alignment - 1) & ~(Alignment - 1);
+    }
+
+    /**
+     * @brief Reads the tag in front of an allocation
+     * @param pointer Pointer returned by JsonArena::allocate
+     * @return Owning arena, nullptr for heap memory
+     */
+    inline JsonArena* getOwner(void* pointer) {
+        return *reinterpret_cast<JsonArena**>(static_cast<char*>(pointer) - HeaderSize);
+    }
+
+    /**
+     * @brief Gets the free list holding blocks of a size
+     * @param size Number of bytes passed to JsonArena::allocate, not 0
+     * @return Index of the free list
+     */
+    inline size_t getFreeList(const size_t size) {
+        return (size - 1) / Alignment;
+    }
+}
+
+thread_local JsonArena* JsonArena::active = nullptr;
+
+/**
+ * @brief Activates an arena, remembering the previously active one
+ * @param arena Arena to allocate from
+ */
+JsonArena::Scope::Scope(JsonArena& arena) : previous(JsonArena::active) {
+    JsonArena::active = &arena;
+}
+
+/**
+ * @brief Restores the previously active arena
+ */
+JsonArena::Scope::~Scope() {
+    JsonArena::active = previous;
+}
+
+/**
+ * @brief Constructs an empty arena, chunks are only allocated on first use
+ */
+JsonArena::JsonArena() : chunks(nullptr), current(nullptr), limit(nullptr), chunkCount(0), nextChunkSize(FirstChunkSize) {
+    std::fill(freeLists, freeLists + FreeListCount, nullptr);
+}
+
+/**
+ * @brief Destructor that releases all chunks
+ */
+JsonArena::~JsonArena() {
+    release();
+}
+
+/**
+ * @brief Allocates tagged memory from the active arena, reusing a freed block of the same size, or from the heap
+ * @param size Number of bytes to allocate
+ * @return Pointer to the memory right after the tag
+ */
+void* JsonArena::allocate(const size_t size) {
+    JsonArena* owner = active;
+    char* memory = nullptr;
+
+    if(owner == nullptr) {
+        memory = static_cast<char*>(::operator new(HeaderSize + size));
+    } else if(size != 0 && size <= FreeListCount * Alignment && owner -> freeLists[getFreeList(size)] != nullptr) {
+        void*& head = owner -> freeLists[getFreeList(size)];
+        memory = static_cast<char*>(head) - HeaderSize;
+        head = *static_cast<void**>(head);
+    } else {
+        memory = static_cast<char*>(owner -> carve(HeaderSize + align(size)));
+    }
+
+    *reinterpret_cast<JsonArena**>(memory) = owner;
+
+    return memory + HeaderSize;
+}
+
+/**
+ * @brief Frees heap memory and puts small blocks of the active arena on its free lists
+ * @param pointer Pointer returned by allocate, may be nullptr
+ * @param size Number of bytes passed to allocate
+ */
+void JsonArena::deallocate(void* pointer, const size_t size) {
+    if(pointer == nullptr) {
+        return;
+    }
+
+    JsonArena* owner = getOwner(pointer);
+
+    if(owner == nullptr) {
+        ::operator delete(static_cast<char*>(pointer) - HeaderSize);
+    } else if(owner == active && size != 0 && size <= FreeListCount * Alignment) {
+        void*& head = owner -> freeLists[getFreeList(size)];
+        *static_cast<void**>(pointer) = head;
+        head = pointer;
+    }
+}
+
+/**
+ * @brief Gets the arena allocate carves from on the current thread
+ * @return Active arena, nullptr when allocations go to the heap
+ */
+JsonArena* JsonArena::getActive() {
+    return active;
+}
+
+/**
+ * @brief Takes over all chunks of another arena, linking them behind the current one
+ * @param other Arena to take the chunks of
+ */
+void JsonArena::adopt(JsonArena& other) {
+    if(this == &other || other.chunks == nullptr) {
+        return;
+    }
+
+    Chunk* last = other.chunks;
+
+    while(last -> next != nullptr) {
+        last = last -> next;
+    }
+
+    if(chunks != nullptr) {
+        last -> next = chunks -> next;
+        chunks -> next = other.chunks;
+    } else {
+        chunks = other.chunks;
+        current = other.current;
+        limit = other.limit;
+        nextChunkSize = other.nextChunkSize;
+    }
+
+    chunkCount += other.chunkCount;
+
+    other.chunks = nullptr;
+    other.current = nullptr;
+    other.limit = nullptr;
+    other.chunkCount = 0;
+    other.nextChunkSize = FirstChunkSize;
+    std::fill(other.freeLists, other.freeLists + FreeListCount, nullptr);
+}
+
+/**
+ * @brief Frees all chunks at once
+ */
+void JsonArena::release() {
+    while(chunks != nullptr) {
+        Chunk* next = chunks -> next;
+        ::operator delete(chunks);
+        chunks = next;
+    }
+
+    current = nullptr;
+    limit = nullptr;
+    chunkCount = 0;
+    nextChunkSize = FirstChunkSize;
+    std::fill(freeLists, freeLists + FreeListCount, nullptr);
+}
+
+/**
+ * @brief Gets the number of chunks currently held by the arena
+ * @return Number of chunks
+ */
+size_t JsonArena::getChunkCount() const {
+    return chunkCount;
+}
+
+/**
+ * @brief Bumps the current chunk, giving allocations over a quarter of a chunk a chunk of their own
+ * @param size Number of bytes to carve, multiple of the alignment
+ * @return Pointer to the carved memory
+ */
+void* JsonArena::carve(const size_t size) {
+    if(static_cast<size_t>(limit - current) >= size) {
+        char* memory = current;
+        current += size;
+        return memory;
+    }
+
+    if(size > nextChunkSize / 4) {
+        return addChunk(size, true);
+    }
+
+    char* memory = addChunk(nextChunkSize, false);
+
+    if(nextChunkSize < MaxChunkSize) {
+        nextChunkSize *= 2;
+    }
+
+    current = memory + size;
+
+    return memory;
+}
+
+/**
+ * @brief Allocates a new chunk and links it in
+ * @param size Minimum usable size of the chunk
+ * @param isDedicated Whether the chunk holds a single large allocation and leaves the current chunk in use
+ * @return Pointer to the usable memory of the chunk
+ */
+char* JsonArena::addChunk(const size_t size, const bool isDedicated) {
+    const size_t headerSize = align(sizeof(Chunk));
+    Chunk* chunk = static_cast<Chunk*>(::operator new(headerSize + size));
+    char* memory = reinterpret_cast<char*>(chunk) + headerSize;
+
+    if(isDedicated && chunks != nullptr) {
+        chunk -> next = chunks -> next;
+        chunks -> next = chunk;
+    } else {
+        chunk -> next = chunks;
+        chunks = chunk;
+    }
+
+    chunkCount++;
+
+    if(!isDedicated) {
+        current = memory;
+        limit = memory + size;
+    }
+
+    return memory;
+}
\ No newline at end of file
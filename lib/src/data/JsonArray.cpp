@@ -1,5 +1,6 @@
 #include "JsonValueVisitor.hpp"
 #include "JsonFormatConfig.hpp"
+#include "JsonStreamWriter.hpp"
 
 /**
  * @brief Gets the type of JSON value
@@ -14,15 +15,25 @@ ValueType JsonArray::getType() const {
  * @return Pointer to the cloned array
  */
 JsonValue* JsonArray::clone() const {
-    return new JsonArray(*this);
+    return cloneTree(this);
 }
 
 /**
- * @brief Prints array content to stream
+ * @brief Prints array content to stream with the default formatting options
  * @param stream Output stream to print to
  */
 void JsonArray::print(std::ostream& stream) const {
-    stream << JsonFormatConfig::getFormatter() -> format(this);
+    JsonStreamWriter writer(stream);
+
+    JsonFormatConfig::writeJson(writer, this, JsonFormatOptions());
+}
+
+/**
+ * @brief Appends array content to a writer with the default formatting options
+ * @param writer Writer to append to
+ */
+void JsonArray::print(JsonWriter& writer) const {
+    JsonFormatConfig::writeJson(writer, this, JsonFormatOptions());
 }
 
 /**
@@ -37,16 +48,30 @@ void JsonArray::accept(JsonValueVisitor& visitor) {
  * @brief Constructor that initializes array with vector of values
  * @param _arrayData Vector of JSON values to copy
  */
-JsonArray::JsonArray(const std::vector<JsonValue*>& _arrayData) : values(std::vector<JsonValue*>(_arrayData.size(), nullptr)) {
-    copyData(_arrayData);
+JsonArray::JsonArray(const std::vector<JsonValue*>& _arrayData) : values(_arrayData.size(), nullptr) {
+    copyData(_arrayData.data(), _arrayData.size());
 }
 
+/**
+ * @brief Constructor that takes ownership of the values instead of cloning them
+ * @param _arrayData Storage of JSON values to take over
+ */
+JsonArray::JsonArray(Values&& _arrayData) : values(std::move(_arrayData)) {}
+
+/**
+ * @brief Constructor of an array whose elements are parsed from its source when first accessed
+ * @param _unparsed Span of the array's text, carved from the active JsonArena
+ */
+JsonArray::JsonArray(JsonSpan* _unparsed) : unparsed(_unparsed) {}
+
 /**
  * @brief Copy constructor
  * @param other Array to copy from
  */
-JsonArray::JsonArray(const JsonArray& other) : values(std::vector<JsonValue*>(other.values.size(), nullptr)) {
-    copyData(other.values);
+JsonArray::JsonArray(const JsonArray& other) : JsonValue(other) {
+    other.load();
+    values.resize(other.values.size(), nullptr);
+    copyData(other.values.data(), other.values.size());
 }
 
 /**
@@ -56,9 +81,11 @@ JsonArray::JsonArray(const JsonArray& other) : values(std::vector<JsonValue*>(ot
  */
 JsonArray& JsonArray::operator=(const JsonArray& other) {
     if(this != &other) {
+        other.load();
+        discardUnparsed();
         deleteData();
         values.resize(other.values.size(), nullptr);
-        copyData(other.values);
+        copyData(other.values.data(), other.values.size());
     }
 
     return *this;
@@ -68,9 +95,9 @@ JsonArray& JsonArray::operator=(const JsonArray& other) {
  * @brief Move constructor
  * @param other Array to move from
  */
-JsonArray::JsonArray(JsonArray&& other) noexcept {
-    values = other.values;
-    resetData(other.values);
+JsonArray::JsonArray(JsonArray&& other) noexcept : values(std::move(other.values)), unparsed(other.unparsed) {
+    other.values.clear();
+    other.unparsed = nullptr;
 }
 
 /**
@@ -80,9 +107,12 @@ JsonArray::JsonArray(JsonArray&& other) noexcept {
  */
 JsonArray& JsonArray::operator=(JsonArray&& other) noexcept {
     if(this != &other){
+        discardUnparsed();
         deleteData();
-        values = other.values;
-        resetData(other.values);
+        values = std::move(other.values);
+        unparsed = other.unparsed;
+        other.values.clear();
+        other.unparsed = nullptr;
     }
 
     return *this;
@@ -92,44 +122,90 @@ JsonArray& JsonArray::operator=(JsonArray&& other) noexcept {
  * @brief Destructor that cleans up array contents
  */
 JsonArray::~JsonArray() {
+    discardUnparsed();
     deleteData();
 }
 
 /**
  * @brief Helper method to deep copy array data
- * @param _arrayData Vector of values to copy
+ * @param _arrayData Pointer to the first value to copy
+ * @param size Number of values to copy
  */
-void JsonArray::copyData(const std::vector<JsonValue*>& _arrayData) {
-    size_t size = _arrayData.size();
-
-
+void JsonArray::copyData(JsonValue* const* _arrayData, const size_t size) {
     for(size_t i = 0; i < size; i++){
         values[i] = _arrayData[i] -> clone();
     }
 }
 
 /**
- * @brief Helper method to reset array data
- * @param _arrayData Vector of values to reset
+ * @brief Copies the array with its elements set to nullptr, leaving a task for each of them
+ * @param pending List to append the elements' tasks to
+ * @return Pointer to the copy
  */
-void JsonArray::resetData(std::vector<JsonValue*>& _arrayData) {
-    size_t size = _arrayData.size();
+JsonValue* JsonArray::cloneShallow(std::vector<CloneTask>& pending) const {
+    load();
+    pending.reserve(pending.size() + values.size());
 
-    for(size_t i = 0; i < size; i++){
-        _arrayData[i] = nullptr;
+    JsonArray* copy = new JsonArray(Values(values.size(), nullptr));
+
+    for(size_t i = values.size(); i > 0; i--) {
+        pending.push_back(CloneTask{values[i - 1], &copy -> values[i - 1]});
     }
+
+    return copy;
 }
 
 /**
- * @brief Helper method to delete array contents
+ * @brief Parses the elements from the source on first access
+ * @throws std::runtime_error if the source text is invalid
  */
-void JsonArray::deleteData() {
-    size_t size = values.size();
+void JsonArray::load() const {
+    if(unparsed == nullptr) {
+        return;
+    }
 
-    for(size_t i = 0; i < size; i++){
-        delete values[i];
-        values[i] = nullptr;
+    JsonSpan* span = unparsed;
+    unparsed = nullptr;
+
+    try {
+        span -> source -> load(const_cast<JsonArray&>(*this), span -> begin, span -> end);
     }
+    catch(...) {
+        unparsed = span;
+        throw;
+    }
+
+    JsonArena::deallocate(span, sizeof(JsonSpan));
+}
+
+/**
+ * @brief Drops the unparsed text without parsing it
+ */
+void JsonArray::discardUnparsed() {
+    JsonArena::deallocate(unparsed, sizeof(JsonSpan));
+    unparsed = nullptr;
+}
+
+/**
+ * @brief Helper method to delete array contents and empty it
+ */
+void JsonArray::deleteData() {
+    if(values.empty()) {
+        return;
+    }
+
+    std::vector<JsonValue*> children;
+    releaseChildren(children);
+    deleteTrees(children);
+}
+
+/**
+ * @brief Moves the elements to the end of a list, leaving the array empty
+ * @param children List to append the elements to
+ */
+void JsonArray::releaseChildren(std::vector<JsonValue*>& children) {
+    children.insert(children.end(), values.begin(), values.end());
+    values.clear();
 }
 
 /**
@@ -137,6 +213,7 @@ void JsonArray::deleteData() {
  * @return Number of elements in array
  */
 size_t JsonArray::getSize() const {
+    load();
     return values.size();
 }
 
@@ -147,6 +224,8 @@ size_t JsonArray::getSize() const {
  * @throws std::out_of_range if index is invalid
  */
 JsonValue* JsonArray::operator[](const size_t index) {
+    load();
+
     if(index >= values.size())
         throw std::out_of_range("Index out of range in JsonArray");
 
@@ -160,6 +239,8 @@ JsonValue* JsonArray::operator[](const size_t index) {
  * @throws std::out_of_range if index is invalid
  */
 const JsonValue* JsonArray::operator[](const size_t index) const {
+    load();
+
     if(index >= values.size())
         throw std::out_of_range("Index out of range in JsonArray");
 
@@ -171,5 +252,6 @@ const JsonValue* JsonArray::operator[](const size_t index) const {
  * @param value Pointer to the JSON value to add
  */
 void JsonArray::addValue(const JsonValue* const value) {
+    load();
     values.push_back(value -> clone());
 }
\ No newline at end of file
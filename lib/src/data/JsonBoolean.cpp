@@ -1,4 +1,5 @@
 #include "JsonValueVisitor.hpp"
+#include "JsonWriter.hpp"
 
 /**
  * @brief Constructor that initializes the boolean value
@@ -6,6 +7,14 @@
  */
 JsonBoolean::JsonBoolean(const bool _value) : value(_value) {}
 
+/**
+ * @brief Gets the stored boolean value
+ * @return The boolean value
+ */
+bool JsonBoolean::getValue() const {
+    return value;
+}
+
 /**
  * @brief Gets the type of JSON value
  * @return ValueType::Boolean
@@ -30,6 +39,18 @@ void JsonBoolean::print(std::ostream& stream) const {
     stream << (value ? "true" : "false");
 }
 
+/**
+ * @brief Appends boolean value to a writer
+ * @param writer Writer to append to
+ */
+void JsonBoolean::print(JsonWriter& writer) const {
+    if(value) {
+        writer.write("true", 4);
+    } else {
+        writer.write("false", 5);
+    }
+}
+
 /**
  * @brief Accepts a visitor for the Visitor pattern
  * @param visitor Reference to the visitor
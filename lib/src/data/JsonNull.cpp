@@ -1,4 +1,5 @@
 #include "JsonValueVisitor.hpp"
+#include "JsonWriter.hpp"
 
 /**
  * @brief Gets the type of JSON value
@@ -24,6 +25,14 @@ void JsonNull::print(std::ostream& stream) const {
     stream << "null";
 }
 
+/**
+ * @brief Appends null value to a writer
+ * @param writer Writer to append to
+ */
+void JsonNull::print(JsonWriter& writer) const {
+    writer.write("null", 4);
+}
+
 /**
  * @brief Accepts a visitor for the Visitor pattern
  * @param visitor Reference to the visitor
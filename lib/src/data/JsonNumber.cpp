@@ -1,10 +1,104 @@
+#include <cmath>
+#include <cstring>
+#include <stdexcept>
 #include "JsonValueVisitor.hpp"
+#include "JsonNumberConverter.hpp"
+#include "JsonWriter.hpp"
 
 /**
  * @brief Constructor that initializes the number value
  * @param _value String representation of the number
  */
-JsonNumber::JsonNumber(const std::string& _value) : value(_value) {}
+JsonNumber::JsonNumber(const std::string& _value) : text(nullptr) {
+    setValue(_value.data(), _value.length());
+}
+
+/**
+ * @brief Constructor that initializes the number value from a range of characters
+ * @param data Pointer to the first character of the value
+ * @param length Number of characters in the value
+ */
+JsonNumber::JsonNumber(const char* data, const size_t length) : text(nullptr) {
+    setValue(data, length);
+}
+
+/**
+ * @brief Constructor that initializes the number from a computed double
+ * @param _value Value of the number, printed as the shortest decimal that reads back as it
+ */
+JsonNumber::JsonNumber(const double _value) : type(NumberType::Double), floating(_value), text(nullptr) {}
+
+/**
+ * @brief Constructor that initializes the number from a computed signed integer
+ * @param _value Value of the number
+ */
+JsonNumber::JsonNumber(const int _value) : JsonNumber(static_cast<long long>(_value)) {}
+
+/**
+ * @brief Constructor that initializes the number from a computed signed integer
+ * @param _value Value of the number
+ */
+JsonNumber::JsonNumber(const long _value) : JsonNumber(static_cast<long long>(_value)) {}
+
+/**
+ * @brief Constructor that initializes the number from a computed signed integer
+ * @param _value Value of the number
+ */
+JsonNumber::JsonNumber(const long long _value) : type(NumberType::Integer), integer(_value), text(nullptr) {}
+
+/**
+ * @brief Constructor that initializes the number from a computed unsigned integer
+ * @param _value Value of the number
+ */
+JsonNumber::JsonNumber(const unsigned int _value) : JsonNumber(static_cast<unsigned long long>(_value)) {}
+
+/**
+ * @brief Constructor that initializes the number from a computed unsigned integer
+ * @param _value Value of the number
+ */
+JsonNumber::JsonNumber(const unsigned long _value) : JsonNumber(static_cast<unsigned long long>(_value)) {}
+
+/**
+ * @brief Constructor that initializes the number from a computed unsigned integer
+ * @param _value Value of the number
+ */
+JsonNumber::JsonNumber(const unsigned long long _value) : type(_value > INT64_MAX ? NumberType::UnsignedInteger : NumberType::Integer), unsignedInteger(_value), text(nullptr) {}
+
+/**
+ * @brief Copy constructor
+ * @param other Number to copy from
+ */
+JsonNumber::JsonNumber(const JsonNumber& other) : JsonValue(other), type(other.type), unsignedInteger(other.unsignedInteger), text(nullptr) {
+    if(other.text != nullptr) {
+        setText(other.text, std::strlen(other.text));
+    }
+}
+
+/**
+ * @brief Copy assignment operator
+ * @param other Number to copy from
+ * @return Reference to this number
+ */
+JsonNumber& JsonNumber::operator=(const JsonNumber& other) {
+    if(this != &other) {
+        releaseText();
+        type = other.type;
+        unsignedInteger = other.unsignedInteger;
+
+        if(other.text != nullptr) {
+            setText(other.text, std::strlen(other.text));
+        }
+    }
+
+    return *this;
+}
+
+/**
+ * @brief Destructor that frees the kept source text
+ */
+JsonNumber::~JsonNumber() {
+    releaseText();
+}
 
 /**
  * @brief Gets the type of JSON value
@@ -19,15 +113,45 @@ ValueType JsonNumber::getType() const {
  * @return Pointer to the cloned number
  */
 JsonValue* JsonNumber::clone() const {
-    return new JsonNumber(value);
+    return new JsonNumber(*this);
 }
 
 /**
- * @brief Prints number value to stream
+ * @brief Prints number value to stream, using the source text when it was kept
  * @param stream Output stream to print to
  */
 void JsonNumber::print(std::ostream& stream) const {
-    stream << value;
+    if(text != nullptr) {
+        stream << text;
+        return;
+    }
+
+    NumberValue value;
+    value.type = type;
+    value.unsignedInteger = unsignedInteger;
+    value.isTextNeeded = false;
+
+    char buffer[JsonNumberConverter::MaxTextLength];
+    stream.write(buffer, JsonNumberConverter::format(value, buffer));
+}
+
+/**
+ * @brief Appends number value to a writer, using the source text when it was kept
+ * @param writer Writer to append to
+ */
+void JsonNumber::print(JsonWriter& writer) const {
+    if(text != nullptr) {
+        writer.write(text);
+        return;
+    }
+
+    NumberValue value;
+    value.type = type;
+    value.unsignedInteger = unsignedInteger;
+    value.isTextNeeded = false;
+
+    char buffer[JsonNumberConverter::MaxTextLength];
+    writer.write(buffer, JsonNumberConverter::format(value, buffer));
 }
 
 /**
@@ -37,3 +161,116 @@ void JsonNumber::print(std::ostream& stream) const {
 void JsonNumber::accept(JsonValueVisitor& visitor) {
     visitor.visit(*this);
 }
+
+/**
+ * @brief Gets the binary representation the number is stored in
+ * @return NumberType of the number
+ */
+NumberType JsonNumber::getNumberType() const {
+    return type;
+}
+
+/**
+ * @brief Gets the number as a signed 64-bit integer
+ * @return Value of the number
+ * @throws std::out_of_range if the number is not an integer that fits int64_t
+ */
+int64_t JsonNumber::getInt64() const {
+    switch(type) {
+        case NumberType::Integer:
+            return integer;
+        case NumberType::Double:
+            // -2^63 is exact, 2^63 is the first double that no longer fits
+            if(floating >= -9223372036854775808.0 && floating < 9223372036854775808.0 && std::trunc(floating) == floating) {
+                return static_cast<int64_t>(floating);
+            }
+            break;
+        case NumberType::UnsignedInteger:
+        default:
+            break;
+    }
+
+    throw std::out_of_range("Value out of range of int64 in JsonNumber");
+}
+
+/**
+ * @brief Gets the number as an unsigned 64-bit integer
+ * @return Value of the number
+ * @throws std::out_of_range if the number is not an integer that fits uint64_t
+ */
+uint64_t JsonNumber::getUint64() const {
+    switch(type) {
+        case NumberType::Integer:
+            if(integer >= 0) {
+                return static_cast<uint64_t>(integer);
+            }
+            break;
+        case NumberType::UnsignedInteger:
+            return unsignedInteger;
+        case NumberType::Double:
+            if(floating >= 0 && floating < 18446744073709551616.0 && std::trunc(floating) == floating) {
+                return static_cast<uint64_t>(floating);
+            }
+            break;
+        default:
+            break;
+    }
+
+    throw std::out_of_range("Value out of range of uint64 in JsonNumber");
+}
+
+/**
+ * @brief Gets the number as a double, rounding integers above 2^53 to the nearest double
+ * @return Value of the number
+ */
+double JsonNumber::getDouble() const {
+    switch(type) {
+        case NumberType::Integer:
+            return static_cast<double>(integer);
+        case NumberType::UnsignedInteger:
+            return static_cast<double>(unsignedInteger);
+        case NumberType::Double:
+        default:
+            return floating;
+    }
+}
+
+/**
+ * @brief Converts a number token and keeps its text if needed
+ * @param data Pointer to the first character of the token
+ * @param length Number of characters in the token
+ */
+void JsonNumber::setValue(const char* data, const size_t length) {
+    const NumberValue value = JsonNumberConverter::parse(data, length);
+    type = value.type;
+    unsignedInteger = value.unsignedInteger;
+
+    if(value.isTextNeeded) {
+        setText(data, length);
+    }
+}
+
+/**
+ * @brief Copies the source text into memory from JsonArena::allocate
+ * @param data Pointer to the first character of the text, may be nullptr
+ * @param length Number of characters in the text
+ */
+void JsonNumber::setText(const char* data, const size_t length) {
+    text = static_cast<char*>(JsonArena::allocate(length + 1));
+
+    if(length != 0) {
+        std::memcpy(text, data, length);
+    }
+
+    text[length] = '\0';
+}
+
+/**
+ * @brief Frees the kept source text
+ */
+void JsonNumber::releaseText() {
+    if(text != nullptr) {
+        JsonArena::deallocate(text, std::strlen(text) + 1);
+        text = nullptr;
+    }
+}
@@ -1,6 +1,107 @@
 #include <algorithm>
+#include <cstring>
+#include <stdexcept>
 #include "JsonValueVisitor.hpp"
 #include "JsonFormatConfig.hpp"
+#include "JsonStreamWriter.hpp"
+
+/**
+ * @brief Anonymous namespace for key conversion helpers and index constants
+ */
+namespace {
+    /**
+     * @brief Number of pairs from which lookups go through the hash index instead of a linear scan
+     */
+    const size_t IndexThreshold = 8;
+
+    /**
+     * @brief Smallest number of slots of the hash index
+     */
+    const size_t MinIndexSize = 16;
+
+    /**
+     * @brief Converts a key to the string type the object stores
+     * @param key Key to convert
+     * @return Key as an arena string
+     */
+    inline ArenaString toKey(const std::string& key) {
+        return ArenaString(key.data(), key.length());
+    }
+
+    /**
+     * @brief Checks whether a stored key equals a range of characters
+     * @param key Stored key
+     * @param data Pointer to the first character to compare with
+     * @param length Number of characters to compare with
+     * @return True if they are equal, false otherwise
+     */
+    inline bool isSameKey(const ArenaString& key, const char* data, const size_t length) {
+        return key.length() == length && std::memcmp(key.data(), data, length) == 0;
+    }
+}
+
+/**
+ * @brief Constructs an iterator positioned on the first pair in a range that is not removed
+ * @param _current Entry to start from
+ * @param _end One past the last entry of the object
+ */
+JsonObject::ConstIterator::ConstIterator(const Entry* _current, const Entry* _end) : current(_current), end(_end) {
+    skipRemoved();
+}
+
+/**
+ * @brief Gets the pair the iterator is positioned on
+ * @return Reference to the pair
+ */
+const JsonObject::Entry& JsonObject::ConstIterator::operator*() const {
+    return *current;
+}
+
+/**
+ * @brief Gets the pair the iterator is positioned on
+ * @return Pointer to the pair
+ */
+const JsonObject::Entry* JsonObject::ConstIterator::operator->() const {
+    return current;
+}
+
+/**
+ * @brief Advances to the next pair that is not removed
+ * @return Reference to this iterator
+ */
+JsonObject::ConstIterator& JsonObject::ConstIterator::operator++() {
+    current++;
+    skipRemoved();
+
+    return *this;
+}
+
+/**
+ * @brief Checks if two iterators are positioned on the same pair
+ * @param other Iterator to compare with
+ * @return True if both are on the same pair, false otherwise
+ */
+bool JsonObject::ConstIterator::operator==(const ConstIterator& other) const {
+    return current == other.current;
+}
+
+/**
+ * @brief Checks if two iterators are positioned on different pairs
+ * @param other Iterator to compare with
+ * @return True if they are on different pairs, false otherwise
+ */
+bool JsonObject::ConstIterator::operator!=(const ConstIterator& other) const {
+    return current != other.current;
+}
+
+/**
+ * @brief Moves forward until a pair that is not removed or the end is reached
+ */
+void JsonObject::ConstIterator::skipRemoved() {
+    while(current != end && current -> value == nullptr) {
+        current++;
+    }
+}
 
 /**
  * @brief Gets the type of JSON value
@@ -15,15 +116,25 @@ ValueType JsonObject::getType() const {
  * @return Pointer to the cloned object
  */
 JsonValue* JsonObject::clone() const {
-    return new JsonObject(*this);
+    return cloneTree(this);
 }
 
 /**
- * @brief Prints object content to stream
+ * @brief Prints object content to stream with the default formatting options
  * @param stream Output stream to print to
  */
 void JsonObject::print(std::ostream& stream) const {
-    stream << JsonFormatConfig::getFormatter() -> format(this);
+    JsonStreamWriter writer(stream);
+
+    JsonFormatConfig::writeJson(writer, this, JsonFormatOptions());
+}
+
+/**
+ * @brief Appends object content to a writer with the default formatting options
+ * @param writer Writer to append to
+ */
+void JsonObject::print(JsonWriter& writer) const {
+    JsonFormatConfig::writeJson(writer, this, JsonFormatOptions());
 }
 
 /**
@@ -34,21 +145,59 @@ void JsonObject::accept(JsonValueVisitor& visitor) {
     visitor.visit(*this);
 }
 
+/**
+ * @brief Default constructor that creates an empty object
+ */
+JsonObject::JsonObject() : removedCount(0) {}
+
 /**
  * @brief Constructor that initializes object with keys and values
  * @param _keys List of keys
  * @param _objectData Map of key-value pairs
  */
-JsonObject::JsonObject(const std::list<std::string>& _keys, const std::unordered_map<std::string, JsonValue*>& _objectData) {
+JsonObject::JsonObject(const std::list<std::string>& _keys, const std::unordered_map<std::string, JsonValue*>& _objectData) : removedCount(0) {
     copyData(_keys, _objectData);
 }
 
+/**
+ * @brief Constructor that takes ownership of the values instead of cloning them, the keys are copied
+ * @param _keys List of keys
+ * @param _objectData Map of key-value pairs whose values to take over
+ */
+JsonObject::JsonObject(std::list<std::string>&& _keys, std::unordered_map<std::string, JsonValue*>&& _objectData) : removedCount(0) {
+    entries.reserve(_objectData.size());
+
+    for(const std::string& key : _keys) {
+        const auto& valueIterator = _objectData.find(key);
+
+        if(valueIterator != _objectData.end() && valueIterator -> second != nullptr) {
+            append(toKey(key), valueIterator -> second);
+            valueIterator -> second = nullptr;
+        }
+    }
+}
+
+/**
+ * @brief Constructor that takes ownership of the key-value pairs without copying them
+ * @param _entries Pairs with unique keys to take over, in insertion order
+ */
+JsonObject::JsonObject(Entries&& _entries) : entries(std::move(_entries)), removedCount(0) {
+    rebuildIndex();
+}
+
+/**
+ * @brief Constructor of an object whose key-value pairs are parsed from its source when first accessed
+ * @param _unparsed Span of the object's text, carved from the active JsonArena
+ */
+JsonObject::JsonObject(JsonSpan* _unparsed) : removedCount(0), unparsed(_unparsed) {}
+
 /**
  * @brief Copy constructor
  * @param other Object to copy from
  */
-JsonObject::JsonObject(const JsonObject& other) {
-    copyData(other.keys, other.values);
+JsonObject::JsonObject(const JsonObject& other) : JsonValue(other), removedCount(0) {
+    other.load();
+    copyData(other);
 }
 
 /**
@@ -58,9 +207,10 @@ JsonObject::JsonObject(const JsonObject& other) {
  */
 JsonObject& JsonObject::operator=(const JsonObject& other) {
      if(this != &other) {
+        other.load();
+        discardUnparsed();
         deleteData();
-        values.clear();
-        copyData(other.keys, other.values);
+        copyData(other);
     }
 
     return *this;
@@ -70,10 +220,12 @@ JsonObject& JsonObject::operator=(const JsonObject& other) {
  * @brief Move constructor
  * @param other Object to move from
  */
-JsonObject::JsonObject(JsonObject&& other) noexcept {
-    keys = other.keys;
-    values = other.values;
-    resetData(other.values);
+JsonObject::JsonObject(JsonObject&& other) noexcept : entries(std::move(other.entries)), index(std::move(other.index)), removedCount(other.removedCount),
+    unparsed(other.unparsed) {
+    other.entries.clear();
+    other.index.clear();
+    other.removedCount = 0;
+    other.unparsed = nullptr;
 }
 
 /**
@@ -83,9 +235,16 @@ JsonObject::JsonObject(JsonObject&& other) noexcept {
  */
 JsonObject& JsonObject::operator=(JsonObject&& other) noexcept {
     if(this != &other){
+        discardUnparsed();
         deleteData();
-        values = other.values;
-        resetData(other.values);
+        entries = std::move(other.entries);
+        index = std::move(other.index);
+        removedCount = other.removedCount;
+        unparsed = other.unparsed;
+        other.entries.clear();
+        other.index.clear();
+        other.removedCount = 0;
+        other.unparsed = nullptr;
     }
 
     return *this;
@@ -95,41 +254,231 @@ JsonObject& JsonObject::operator=(JsonObject&& other) noexcept {
  * @brief Destructor that cleans up object contents
  */
 JsonObject::~JsonObject() {
+    discardUnparsed();
     deleteData();
 }
 
 /**
- * @brief Helper method to deep copy object data
+ * @brief Parses the key-value pairs from the source on first access
+ * @throws std::runtime_error if the source text is invalid
+ */
+void JsonObject::load() const {
+    if(unparsed == nullptr) {
+        return;
+    }
+
+    JsonSpan* span = unparsed;
+    unparsed = nullptr;
+
+    try {
+        span -> source -> load(const_cast<JsonObject&>(*this), span -> begin, span -> end);
+    }
+    catch(...) {
+        unparsed = span;
+        throw;
+    }
+
+    JsonArena::deallocate(span, sizeof(JsonSpan));
+}
+
+/**
+ * @brief Drops the unparsed text without parsing it
+ */
+void JsonObject::discardUnparsed() {
+    JsonArena::deallocate(unparsed, sizeof(JsonSpan));
+    unparsed = nullptr;
+}
+
+/**
+ * @brief Helper method to deep copy object data given as standard containers, keys without a value are skipped
  * @param _keys List of keys to copy
  * @param _objectData Map of values to copy
  */
 void JsonObject::copyData(const std::list<std::string>& _keys, const std::unordered_map<std::string, JsonValue*>& _objectData) {
-    keys = _keys;
+    entries.reserve(_objectData.size());
+
+    for(const std::string& key : _keys) {
+        const auto& valueIterator = _objectData.find(key);
 
-    for(auto it = _objectData.begin(); it != _objectData.end(); it++) {
-        values.emplace(it -> first, it -> second -> clone());
+        if(valueIterator != _objectData.end() && find(key.data(), key.length()) == entries.size()) {
+            append(toKey(key), valueIterator -> second -> clone());
+        }
     }
 }
 
 /**
- * @brief Helper method to reset object data
- * @param _objectData Map of values to reset
+ * @brief Helper method to deep copy object data, dropping removed pairs
+ * @param other Object to copy from
  */
-void JsonObject::resetData(std::unordered_map<std::string, JsonValue*>& _objectData) {
-    for(auto it = _objectData.begin(); it != _objectData.end(); it++) {
-        it -> second = nullptr;
+void JsonObject::copyData(const JsonObject& other) {
+    entries.reserve(other.getSize());
+
+    for(const Entry& entry : other) {
+        entries.push_back(Entry{entry.key, entry.value -> clone()});
     }
+
+    rebuildIndex();
 }
 
 /**
- * @brief Helper method to delete object contents
+ * @brief Copies the keys of the object with their values set to nullptr, leaving a task for each value
+ * @param pending List to append the values' tasks to
+ * @return Pointer to the copy
+ */
+JsonValue* JsonObject::cloneShallow(std::vector<CloneTask>& pending) const {
+    const size_t size = getSize();
+
+    pending.reserve(pending.size() + size);
+
+    Entries copiedEntries;
+    copiedEntries.reserve(size);
+
+    for(const Entry& entry : *this) {
+        copiedEntries.push_back(Entry{entry.key, nullptr});
+    }
+
+    JsonObject* copy = new JsonObject(std::move(copiedEntries));
+    Entry* copiedEntry = copy -> entries.data();
+
+    for(const Entry& entry : *this) {
+        pending.push_back(CloneTask{entry.value, &(copiedEntry++) -> value});
+    }
+
+    std::reverse(pending.end() - size, pending.end());
+
+    return copy;
+}
+
+/**
+ * @brief Helper method to delete object contents and empty it
  */
 void JsonObject::deleteData() {
-    for(auto it = values.begin(); it != values.end(); it++) {
-        delete it -> second;
+    std::vector<JsonValue*> children;
+    releaseChildren(children);
+    deleteTrees(children);
+}
 
-        it -> second = nullptr;
+/**
+ * @brief Moves the values to the end of a list, leaving the object empty
+ * @param children List to append the values to
+ */
+void JsonObject::releaseChildren(std::vector<JsonValue*>& children) {
+    for(const Entry& entry : entries) {
+        if(entry.value != nullptr) {
+            children.push_back(entry.value);
+        }
+    }
+
+    entries.clear();
+    index.clear();
+    removedCount = 0;
+}
+
+/**
+ * @brief Finds the entry holding a key, through the hash index for large objects and by a linear scan otherwise
+ * @param data Pointer to the first character of the key
+ * @param length Number of characters in the key
+ * @return Position of the entry, entries.size() if the key does not exist
+ */
+size_t JsonObject::find(const char* data, const size_t length) const {
+    if(index.empty()) {
+        for(size_t i = 0; i < entries.size(); i++) {
+            if(entries[i].value != nullptr && isSameKey(entries[i].key, data, length)) {
+                return i;
+            }
+        }
+
+        return entries.size();
+    }
+
+    const size_t mask = index.size() - 1;
+
+    for(size_t slot = ArenaStringHash()(data, length) & mask; index[slot] != 0; slot = (slot + 1) & mask) {
+        const Entry& entry = entries[index[slot] - 1];
+
+        if(entry.value != nullptr && isSameKey(entry.key, data, length)) {
+            return index[slot] - 1;
+        }
+    }
+
+    return entries.size();
+}
+
+/**
+ * @brief Appends a key-value pair and indexes it, growing the index so at most half of its slots are used
+ * @param key Key to add, must not exist yet
+ * @param value Value to take ownership of
+ */
+void JsonObject::append(ArenaString&& key, JsonValue* value) {
+    entries.push_back(Entry{std::move(key), value});
+
+    if(index.empty() ? entries.size() - removedCount >= IndexThreshold : entries.size() * 2 > index.size()) {
+        rebuildIndex();
+    } else if(!index.empty()) {
+        insertIntoIndex(entries.size() - 1);
+    }
+}
+
+/**
+ * @brief Adds an entry to the hash index using linear probing
+ * @param position Position of the entry
+ */
+void JsonObject::insertIntoIndex(const size_t position) {
+    const size_t mask = index.size() - 1;
+    const ArenaString& key = entries[position].key;
+    size_t slot = ArenaStringHash()(key.data(), key.length()) & mask;
+
+    while(index[slot] != 0) {
+        slot = (slot + 1) & mask;
+    }
+
+    index[slot] = static_cast<uint32_t>(position + 1);
+}
+
+/**
+ * @brief Rebuilds the hash index for the current entries, or drops it if the object is small
+ */
+void JsonObject::rebuildIndex() {
+    if(entries.size() - removedCount < IndexThreshold) {
+        Index().swap(index);
+        return;
+    }
+
+    size_t size = MinIndexSize;
+
+    while(size < entries.size() * 2) {
+        size *= 2;
     }
+
+    index.assign(size, 0);
+
+    for(size_t i = 0; i < entries.size(); i++) {
+        if(removedCount == 0 || entries[i].value != nullptr) {
+            insertIntoIndex(i);
+        }
+    }
+}
+
+/**
+ * @brief Removes the pairs marked as removed from entries, keeping the order of the rest, and rebuilds the index
+ */
+void JsonObject::compact() {
+    size_t kept = 0;
+
+    for(size_t i = 0; i < entries.size(); i++) {
+        if(entries[i].value != nullptr) {
+            if(kept != i) {
+                entries[kept] = std::move(entries[i]);
+            }
+
+            kept++;
+        }
+    }
+
+    entries.erase(entries.begin() + kept, entries.end());
+    removedCount = 0;
+
+    rebuildIndex();
 }
 
 /**
@@ -137,7 +486,8 @@ void JsonObject::deleteData() {
  * @return Size of the object
  */
 size_t JsonObject::getSize() const {
-    return values.size();
+    load();
+    return entries.size() - removedCount;
 }
 
 /**
@@ -145,11 +495,11 @@ size_t JsonObject::getSize() const {
  * @return Vector of keys
  */
 std::vector<std::string> JsonObject::getKeys() const {
-    std::vector<std::string> _keys(values.size());
-    size_t index = 0;
+    std::vector<std::string> _keys;
+    _keys.reserve(getSize());
 
-    for(const std::string& key : keys){
-        _keys[index++] = key;
+    for(const Entry& entry : *this){
+        _keys.emplace_back(entry.key.data(), entry.key.length());
     }
 
     return _keys;
@@ -160,11 +510,11 @@ std::vector<std::string> JsonObject::getKeys() const {
  * @return Vector of values
  */
 std::vector<const JsonValue*> JsonObject::getValues() const {
-    std::vector<const JsonValue*> _values(values.size());
-    size_t index = 0;
+    std::vector<const JsonValue*> _values;
+    _values.reserve(getSize());
 
-    for(const std::string& key : keys){
-        _values[index++] = values.at(key) -> clone();
+    for(const Entry& entry : *this){
+        _values.push_back(entry.value -> clone());
     }
 
     return _values;
@@ -176,7 +526,8 @@ std::vector<const JsonValue*> JsonObject::getValues() const {
  * @return True if key exists, false otherwise
  */
 bool JsonObject::containsKey(const std::string& key) const {
-    return values.find(key) != values.end();
+    load();
+    return find(key.data(), key.length()) != entries.size();
 }
 
 /**
@@ -191,43 +542,103 @@ void JsonObject::addKVP(const std::string& key, const JsonValue* const value) {
         throw std::runtime_error(message);
     }
 
-    values.emplace(key, value -> clone());
-    keys.push_back(key);
+    append(toKey(key), value -> clone());
+}
+
+/**
+ * @brief Adds a key-value pair taking ownership of the value instead of cloning it
+ * @param key Key to add
+ * @param value Value to take ownership of
+ * @throws std::runtime_error if key already exists, the value is then still owned by the caller
+ */
+void JsonObject::adoptKVP(const std::string& key, JsonValue* const value) {
+    if(containsKey(key)){
+        const std::string message = "Key \"" + key + "\" already exists in JsonObject!";
+        throw std::runtime_error(message);
+    }
+
+    append(toKey(key), value);
 }
 
 /**
  * @brief Edits an existing key-value pair
  * @param key Key to edit
  * @param value New value to set
+ * @throws std::out_of_range if key doesn't exist
  */
 void JsonObject::editKVP(const std::string& key, const JsonValue* const value) {
-    delete values.at(key);
+    load();
+
+    const size_t position = find(key.data(), key.length());
+
+    if(position == entries.size()) {
+        throw std::out_of_range("Key not found in JsonObject");
+    }
+
+    delete entries[position].value;
+
+    entries[position].value = value -> clone();
+}
+
+/**
+ * @brief Replaces the value of an existing key-value pair with one the object takes ownership of
+ * @param key Key to edit
+ * @param value Value to take ownership of
+ * @return Previous value, now owned by the caller
+ * @throws std::out_of_range if key doesn't exist, the value is then still owned by the caller
+ */
+JsonValue* JsonObject::exchangeKVP(const std::string& key, JsonValue* const value) {
+    load();
+
+    const size_t position = find(key.data(), key.length());
+
+    if(position == entries.size()) {
+        throw std::out_of_range("Key not found in JsonObject");
+    }
 
-    values[key] = value -> clone();
+    JsonValue* previous = entries[position].value;
+    entries[position].value = value;
+
+    return previous;
 }
 
 /**
- * @brief Removes a key-value pair
+ * @brief Removes a key-value pair and deletes its value
  * @param key Key to remove
  * @throws std::runtime_error if key doesn't exist
  */
 void JsonObject::removeKVP(const std::string& key) {
-    if(!containsKey(key)){
+    delete releaseKVP(key);
+}
+
+/**
+ * @brief Removes a key-value pair, handing its value over instead of deleting it
+ * @param key Key to remove
+ * @return Value of the pair, now owned by the caller
+ * @throws std::runtime_error if key doesn't exist
+ */
+JsonValue* JsonObject::releaseKVP(const std::string& key) {
+    load();
+
+    const size_t position = find(key.data(), key.length());
+
+    if(position == entries.size()){
         const std::string message = "Key \"" + key + "\" does not exist in JsonObject!";
         throw std::runtime_error(message);
     }
 
-    const auto& keyIterator = std::find(keys.begin(), keys.end(), key); 
+    Entry& entry = entries[position];
+    JsonValue* value = entry.value;
 
-    if(keyIterator == keys.end()){
-        const std::string message = "Key \"" + key + "\" does not found in keys list!";
-        throw std::runtime_error(message);
-    }
+    entry.value = nullptr;
+    ArenaString().swap(entry.key);
+    removedCount++;
 
-    keys.erase(keyIterator);
+    if(removedCount * 2 > entries.size()) {
+        compact();
+    }
 
-    delete values.at(key);
-    values.erase(key);
+    return value;
 }
 
 /**
@@ -237,10 +648,34 @@ void JsonObject::removeKVP(const std::string& key) {
  * @throws std::runtime_error if key doesn't exist
  */
 const JsonValue* JsonObject::getValue(const std::string& key) const {
-    if(!containsKey(key)){
+    load();
+
+    const size_t position = find(key.data(), key.length());
+
+    if(position == entries.size()){
         const std::string message = "Key \"" + key + "\" does not exist in JsonObject!";
         throw std::runtime_error(message);
     }
 
-    return values.at(key);
+    return entries[position].value;
+}
+
+/**
+ * @brief Gets an iterator to the first key-value pair in insertion order
+ * @return Iterator to the first pair
+ */
+JsonObject::ConstIterator JsonObject::begin() const {
+    load();
+    return ConstIterator(entries.data(), entries.data() + entries.size());
+}
+
+/**
+ * @brief Gets an iterator past the last key-value pair
+ * @return Iterator past the last pair
+ */
+JsonObject::ConstIterator JsonObject::end() const {
+    load();
+
+    const Entry* last = entries.data() + entries.size();
+    return ConstIterator(last, last);
 }
@@ -1,10 +1,78 @@
+#include <cstring>
 #include "JsonValueVisitor.hpp"
+#include "JsonWriter.hpp"
 
 /**
  * @brief Constructor that initializes the string value
  * @param _value String value to store
  */
-JsonString::JsonString(const std::string& _value) : value(_value) {}
+JsonString::JsonString(const std::string& _value) : text(nullptr), length(0), isBorrowed(false) {
+    setText(_value.data(), _value.length());
+}
+
+/**
+ * @brief Constructor that initializes the string value from a range of characters
+ * @param data Pointer to the first character of the value
+ * @param _length Number of characters in the value
+ * @param _isBorrowed Whether the string refers to the characters instead of copying them; they must then outlive it
+ */
+JsonString::JsonString(const char* data, const size_t _length, const bool _isBorrowed) : text(data), length(_length), isBorrowed(_isBorrowed) {
+    if(!isBorrowed) {
+        setText(data, _length);
+    }
+}
+
+/**
+ * @brief Copy constructor, the copy always owns its characters so it may outlive the other string's document
+ * @param other String to copy from
+ */
+JsonString::JsonString(const JsonString& other) : JsonValue(other), text(nullptr), length(0), isBorrowed(false) {
+    setText(other.text, other.length);
+}
+
+/**
+ * @brief Copy assignment operator
+ * @param other String to copy from
+ * @return Reference to this string
+ */
+JsonString& JsonString::operator=(const JsonString& other) {
+    if(this != &other) {
+        const char* previous = isBorrowed ? nullptr : text;
+        const size_t previousLength = length;
+
+        setText(other.text, other.length);
+        isBorrowed = false;
+
+        JsonArena::deallocate(const_cast<char*>(previous), previousLength != 0 ? previousLength : 1);
+    }
+
+    return *this;
+}
+
+/**
+ * @brief Destructor that frees the owned characters; borrowed ones belong to the document's text
+ */
+JsonString::~JsonString() {
+    if(!isBorrowed) {
+        JsonArena::deallocate(const_cast<char*>(text), length != 0 ? length : 1);
+    }
+}
+
+/**
+ * @brief Gets the raw token of the string, quotes and escapes included
+ * @return Pointer to the opening quote
+ */
+const char* JsonString::getText() const {
+    return text;
+}
+
+/**
+ * @brief Gets the number of characters in the raw token
+ * @return Length of the token, quotes included
+ */
+size_t JsonString::getLength() const {
+    return length;
+}
 
 /**
  * @brief Gets the type of JSON value
@@ -19,7 +87,7 @@ ValueType JsonString::getType() const {
  * @return Pointer to the cloned string
  */
 JsonValue* JsonString::clone() const {
-    return new JsonString(value);
+    return new JsonString(*this);
 }
 
 /**
@@ -27,7 +95,15 @@ JsonValue* JsonString::clone() const {
  * @param stream Output stream to print to
  */
 void JsonString::print(std::ostream& stream) const {
-    stream << value;
+    stream.write(text, length);
+}
+
+/**
+ * @brief Appends string value to a writer
+ * @param writer Writer to append to
+ */
+void JsonString::print(JsonWriter& writer) const {
+    writer.write(text, length);
 }
 
 /**
@@ -37,3 +113,19 @@ void JsonString::print(std::ostream& stream) const {
 void JsonString::accept(JsonValueVisitor& visitor) {
     visitor.visit(*this);
 }
+
+/**
+ * @brief Copies characters into memory from JsonArena::allocate
+ * @param data Pointer to the first character to copy
+ * @param _length Number of characters to copy
+ */
+void JsonString::setText(const char* data, const size_t _length) {
+    char* copy = static_cast<char*>(JsonArena::allocate(_length != 0 ? _length : 1));
+
+    if(_length != 0) {
+        std::memcpy(copy, data, _length);
+    }
+
+    text = copy;
+    length = _length;
+}
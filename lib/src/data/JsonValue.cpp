@@ -0,0 +1,76 @@
+#include "JsonValue.hpp"
+
+/**
+ * @brief Allocates JSON values from the active JsonArena, or from the heap when none is active
+ * @param size Size of the value in bytes
+ * @return Pointer to the allocated memory
+ */
+void* JsonValue::operator new(const size_t size) {
+    return JsonArena::allocate(size);
+}
+
+/**
+ * @brief Frees a JSON value allocated by operator new, see JsonArena::deallocate
+ * @param pointer Pointer to the value
+ * @param size Size of the value in bytes
+ */
+void JsonValue::operator delete(void* pointer, const size_t size) {
+    JsonArena::deallocate(pointer, size);
+}
+
+/**
+ * @brief Copies the value without its children
+ * @param pending List to append the children's tasks to
+ * @return Pointer to the copy
+ */
+JsonValue* JsonValue::cloneShallow(std::vector<CloneTask>&) const {
+    return clone();
+}
+
+/**
+ * @brief Deep copies a value together with everything nested in it without recursion
+ * @param value Value to copy
+ * @return Pointer to the copy
+ */
+JsonValue* JsonValue::cloneTree(const JsonValue* value) {
+    JsonValue* root = nullptr;
+    std::vector<CloneTask> pending(1, CloneTask{value, &root});
+
+    try {
+        while(!pending.empty()) {
+            const CloneTask task = pending.back();
+            pending.pop_back();
+
+            *task.target = task.source -> cloneShallow(pending);
+        }
+    }
+    catch(...) {
+        std::vector<JsonValue*> values(1, root);
+        deleteTrees(values);
+        throw;
+    }
+
+    return root;
+}
+
+/**
+ * @brief Moves the children of an array or object to the end of a list; other values have none
+ * @param children List to append the children to
+ */
+void JsonValue::releaseChildren(std::vector<JsonValue*>&) {}
+
+/**
+ * @brief Deletes values together with everything nested in them without recursion
+ * @param values Values to delete, left empty
+ */
+void JsonValue::deleteTrees(std::vector<JsonValue*>& values) {
+    while(!values.empty()) {
+        JsonValue* value = values.back();
+        values.pop_back();
+
+        if(value != nullptr) {
+            value -> releaseChildren(values);
+            delete value;
+        }
+    }
+}
\ No newline at end of file
@@ -0,0 +1,128 @@
+#include <iostream>
+#include <string>
+#include "JsonArena.hpp"
+#include "JsonParser.hpp"
+#include "JsonEditor.hpp"
+#include "JsonPrinter.hpp"
+
+/**
+ * @brief Anonymous namespace for the edit rounds and the checks of reused arena memory
+ */
+namespace {
+    /**
+     * @brief Number of rounds of edits made on one document
+     */
+    const size_t RoundCount = 100000;
+
+    /**
+     * @brief Number of rounds after which the arena must have stopped growing
+     */
+    const size_t WarmupCount = 100;
+
+    /**
+     * @brief Number of failed checks
+     */
+    size_t failures = 0;
+
+    /**
+     * @brief Records a failed check when a condition does not hold
+     * @param condition Result of the check
+     * @param name Name of the check
+     */
+    void check(const bool condition, const std::string& name) {
+        if(condition) {
+            return;
+        }
+
+        if(failures < 10) {
+            std::cerr << name << " failed\n";
+        }
+
+        failures++;
+    }
+
+    /**
+     * @brief Sets, creates, moves and erases values of every type once
+     * @param root Root of the document to edit
+     * @param round Number of the round, changing the values set
+     */
+    void edit(JsonValue*& root, const size_t round) {
+        JsonEditor editor(root);
+        root -> accept(editor);
+
+        editor.set("a", "{\"list\":[" + std::to_string(round) + ",2.5,\"text long enough to be copied\"],\"flag\":true}");
+        editor.create("b/c", "[\"x\",{\"y\":null},-0.125e3]");
+        editor.move("a", "m");
+        editor.move("m", "a");
+        editor.erase("b");
+    }
+
+    /**
+     * @brief Checks that repeated edits of a document reuse the memory of the values they replace, so the arena
+     * stops growing
+     */
+    void checkEdits() {
+        JsonArena arena;
+        JsonArena::Scope scope(arena);
+        const std::string text = "{\"a\":null,\"keep\":\"kept\"}";
+        JsonValue* root = JsonParser::parse(text.data(), text.size());
+        size_t chunkCount = 0;
+
+        for(size_t round = 0; round < RoundCount; round++) {
+            edit(root, round);
+
+            if(round == WarmupCount) {
+                chunkCount = arena.getChunkCount();
+            }
+        }
+
+        check(arena.getChunkCount() == chunkCount, "arena size after " + std::to_string(RoundCount) + " rounds of edits");
+        check(JsonPrinter::print(root) == "{\"keep\":\"kept\",\"a\":{\"list\":[" + std::to_string(RoundCount - 1)
+              + ",2.5,\"text long enough to be copied\"],\"flag\":true}}", "document after the edits");
+
+        delete root;
+    }
+
+    /**
+     * @brief Checks that a freed block is handed out again by the arena holding it, and never by another one
+     */
+    void checkReuse() {
+        JsonArena first;
+        JsonArena second;
+        void* block = nullptr;
+
+        {
+            JsonArena::Scope scope(first);
+            block = JsonArena::allocate(24);
+            JsonArena::deallocate(block, 24);
+            check(JsonArena::allocate(20) == block, "reuse of a block of the same aligned size");
+        }
+
+        {
+            JsonArena::Scope scope(second);
+            JsonArena::deallocate(block, 24);
+            check(JsonArena::allocate(24) != block, "reuse of a block of another arena");
+        }
+
+        void* heap = JsonArena::allocate(24);
+        JsonArena::deallocate(heap, 24);
+    }
+}
+
+/**
+ * @brief Checks that memory freed by edits is reused by the document's arena
+ * @return 0 if every check held, 1 otherwise
+ */
+int main() {
+    checkEdits();
+    checkReuse();
+
+    std::cout << "checked " << RoundCount << " rounds of edits and reuse of freed blocks\n";
+
+    if(failures != 0) {
+        std::cerr << failures << " checks failed\n";
+        return 1;
+    }
+
+    return 0;
+}
@@ -0,0 +1,239 @@
+#include <iostream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include "Json.hpp"
+#include "JsonArena.hpp"
+#include "JsonParser.hpp"
+#include "JsonParallelParser.hpp"
+#include "JsonValidator.hpp"
+#include "JsonEventParser.hpp"
+#include "JsonPrinter.hpp"
+
+/**
+ * @brief Anonymous namespace for the deeply nested documents and the checks run on them
+ */
+namespace {
+    /**
+     * @brief Number of arrays or objects enclosing each other in the deep documents
+     */
+    const size_t DeepLevels = 100000;
+
+    /**
+     * @brief Nesting depth the per-call limit is checked with
+     */
+    const size_t SmallDepth = 10;
+
+    /**
+     * @brief Number of failed checks
+     */
+    size_t failures = 0;
+
+    /**
+     * @brief Records a failed check when a condition does not hold
+     * @param condition Result of the check
+     * @param name Name of the check
+     */
+    void check(const bool condition, const std::string& name) {
+        if(condition) {
+            return;
+        }
+
+        if(failures < 10) {
+            std::cerr << name << " failed\n";
+        }
+
+        failures++;
+    }
+
+    /**
+     * @brief Handler ignoring every token
+     */
+    class NullHandler : public JsonEventHandler {
+        public:
+            /**
+             * @brief Ignores the start of an object
+             */
+            void startObject() override {}
+
+            /**
+             * @brief Ignores the end of an object
+             */
+            void endObject() override {}
+
+            /**
+             * @brief Ignores the start of an array
+             */
+            void startArray() override {}
+
+            /**
+             * @brief Ignores the end of an array
+             */
+            void endArray() override {}
+
+            /**
+             * @brief Ignores a key
+             */
+            void visitKey(const char*, const size_t) override {}
+
+            /**
+             * @brief Ignores a null
+             */
+            void visitNull() override {}
+
+            /**
+             * @brief Ignores a boolean
+             */
+            void visitBoolean(const bool) override {}
+
+            /**
+             * @brief Ignores a number
+             */
+            void visitNumber(const char*, const size_t) override {}
+
+            /**
+             * @brief Ignores a string
+             */
+            void visitString(const char*, const size_t) override {}
+    };
+
+    /**
+     * @brief Builds arrays, or objects holding one key each, nested in each other around a number
+     * @param levels Number of arrays or objects
+     * @param isObject Whether objects are nested instead of arrays
+     * @return Compact text of the document
+     */
+    std::string makeNested(const size_t levels, const bool isObject) {
+        std::string document;
+
+        for(size_t i = 0; i < levels; i++) {
+            document += isObject ? "{\"a\":" : "[";
+        }
+
+        document += "1";
+
+        return document + std::string(levels, isObject ? '}' : ']');
+    }
+
+    /**
+     * @brief Runs a reader on a document and catches its error
+     * @param read Reader to run
+     * @return Message of the error, empty if the reader succeeded
+     */
+    template <typename Reader>
+    std::string getError(const Reader& read) {
+        try {
+            read();
+        }
+        catch(const std::runtime_error& error) {
+            return error.what();
+        }
+
+        return "";
+    }
+
+    /**
+     * @brief Parses, validates, prints and destroys a deeply nested document with the default depth limit
+     * @param document Compact text of the document
+     * @param name Name of the document
+     */
+    void checkDeep(const std::string& document, const std::string& name) {
+        {
+            Json json(document.data(), document.size());
+            std::ostringstream printed;
+            json.print(printed);
+            check(printed.str() == document, "Json::print of " + name);
+        }
+
+        {
+            JsonArena arena;
+            JsonArena::Scope scope(arena);
+            JsonValue* value = JsonParser::parse(document.data(), document.size());
+            check(JsonPrinter::print(value) == document, "JsonParser::parse of " + name);
+            delete value;
+        }
+
+        {
+            JsonArena arena;
+            JsonArena::Scope scope(arena);
+            JsonParallelParser parser(4);
+            JsonValue* value = parser.parse(document.data(), document.size());
+            check(JsonPrinter::print(value) == document, "JsonParallelParser::parse of " + name);
+            delete value;
+        }
+
+        std::istringstream stream(document);
+        NullHandler handler;
+
+        check(JsonValidator::validateJson(document.data(), document.size()).first, "JsonValidator::validateJson of " + name);
+        check(JsonValidator::validateJson(document.data(), document.size(), 4).first, "threaded JsonValidator::validateJson of " + name);
+        check(JsonValidator::validateJson(stream).first, "JsonValidator::validateJson of a stream of " + name);
+        check(getError([&]() { JsonEventParser::parse(document.data(), document.size(), handler, JsonValidator::DefaultMaxDepth, true); }).empty(),
+              "JsonEventParser::parse of " + name);
+    }
+
+    /**
+     * @brief Checks that every reader accepts a document as deep as the limit passed to it, and rejects one level
+     * more with the same message
+     * @param isObject Whether objects are nested instead of arrays
+     */
+    void checkLimit(const bool isObject) {
+        const std::string kind = isObject ? "objects" : "arrays";
+        const std::string fitting = makeNested(SmallDepth, isObject);
+        const std::string deeper = makeNested(SmallDepth + 1, isObject);
+        const size_t position = isObject ? SmallDepth * 5 + 1 : SmallDepth + 1;
+        const std::string expected = "Maximum nesting depth of " + std::to_string(SmallDepth) + " exceeded on row 1 on position "
+                                   + std::to_string(position) + ".\n";
+        JsonArena arena;
+        JsonArena::Scope scope(arena);
+        NullHandler handler;
+
+        for(int isDeeper = 0; isDeeper < 2; isDeeper++) {
+            const std::string& document = isDeeper ? deeper : fitting;
+            const std::string message = isDeeper ? expected : "";
+            const std::string name = (isDeeper ? " of too deep " : " of fitting ") + kind;
+            std::istringstream stream(document);
+            JsonParallelParser parser(4, false, SmallDepth);
+
+            check(getError([&]() { delete JsonParser::parse(document.data(), document.size(), SmallDepth); }) == message,
+                  "JsonParser::parse" + name);
+            check(getError([&]() { delete JsonParser::parseValidated(document.data(), document.size(), false, SmallDepth); }) == message,
+                  "JsonParser::parseValidated" + name);
+            check(getError([&]() { delete parser.parse(document.data(), document.size()); }) == message,
+                  "JsonParallelParser::parse" + name);
+            check(getError([&]() { JsonEventParser::parse(document.data(), document.size(), handler, SmallDepth); }) == message,
+                  "JsonEventParser::parse" + name);
+            check(JsonValidator::validateJson(document.data(), document.size(), 4, SmallDepth).first != isDeeper,
+                  "JsonValidator::validateJson" + name);
+            check(JsonValidator::validateJson(stream, SmallDepth) == std::make_pair(!isDeeper, message),
+                  "JsonValidator::validateJson of a stream" + name);
+
+            if(isDeeper) {
+                check(JsonValidator::validateJson(document.data(), document.size(), 4, SmallDepth).second == message,
+                      "JsonValidator::validateJson message" + name);
+            }
+        }
+    }
+}
+
+/**
+ * @brief Checks that documents nested 100000 levels deep are handled without recursion and that the nesting
+ * limit passed to each call is enforced with the same message everywhere
+ * @return 0 if every check held, 1 otherwise
+ */
+int main() {
+    checkDeep(makeNested(DeepLevels, false), std::to_string(DeepLevels) + " nested arrays");
+    checkDeep(makeNested(DeepLevels, true), std::to_string(DeepLevels) + " nested objects");
+    checkLimit(false);
+    checkLimit(true);
+
+    std::cout << "checked documents nested " << DeepLevels << " levels deep and a limit of " << SmallDepth << " levels\n";
+
+    if(failures != 0) {
+        std::cerr << failures << " checks failed\n";
+        return 1;
+    }
+
+    return 0;
+}
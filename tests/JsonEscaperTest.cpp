@@ -0,0 +1,201 @@
+#include <cstdio>
+#include <iostream>
+#include <random>
+#include <sstream>
+#include <string>
+#include "Json.hpp"
+#include "JsonEscaper.hpp"
+#include "JsonStringWriter.hpp"
+
+/**
+ * @brief Anonymous namespace for the reference escaper and the checks of escaped and sorted keys
+ */
+namespace {
+    /**
+     * @brief Number of random texts the escaper is compared on
+     */
+    const size_t TextCount = 2000;
+
+    /**
+     * @brief Number of failed checks
+     */
+    size_t failures = 0;
+
+    /**
+     * @brief Records a failed check when a condition does not hold
+     * @param condition Result of the check
+     * @param name Name of the check
+     * @param text Text the check was made on
+     */
+    void check(const bool condition, const std::string& name, const std::string& text) {
+        if(condition) {
+            return;
+        }
+
+        if(failures < 10) {
+            std::cerr << name << " failed on " << text.size() << " characters: " << text << "\n";
+        }
+
+        failures++;
+    }
+
+    /**
+     * @brief Escapes text one character at a time
+     * @param text Text to escape
+     * @return Content of a JSON string holding the text
+     */
+    std::string escapeSlowly(const std::string& text) {
+        std::string escaped;
+
+        for(const char symbol : text) {
+            switch(symbol) {
+                case '\"': escaped += "\\\""; break;
+                case '\\': escaped += "\\\\"; break;
+                case '\b': escaped += "\\b"; break;
+                case '\f': escaped += "\\f"; break;
+                case '\n': escaped += "\\n"; break;
+                case '\r': escaped += "\\r"; break;
+                case '\t': escaped += "\\t"; break;
+                default: {
+                    if(static_cast<unsigned char>(symbol) < 0x20) {
+                        char sequence[7];
+                        std::snprintf(sequence, sizeof(sequence), "\\u%04x", static_cast<unsigned int>(symbol));
+                        escaped += sequence;
+                    }
+                    else {
+                        escaped += symbol;
+                    }
+                }
+            }
+        }
+
+        return escaped;
+    }
+
+    /**
+     * @brief Escapes text with JsonEscaper
+     * @param text Text to escape
+     * @return Content of a JSON string holding the text
+     */
+    std::string escape(const std::string& text) {
+        std::string escaped;
+        JsonStringWriter writer(escaped);
+        JsonEscaper::write(writer, text.data(), text.size());
+        writer.flush();
+
+        return escaped;
+    }
+
+    /**
+     * @brief Compares JsonEscaper::write against escaping one character at a time on random texts, mostly clean
+     * and long enough to be checked with vectors
+     * @param random Generator to draw from
+     */
+    void compareEscapes(std::mt19937& random) {
+        static const char Specials[] = {'\"', '\\', '\n', '\t', '\x01', '\x1f', '\b'};
+
+        for(size_t i = 0; i < TextCount; i++) {
+            std::string text;
+
+            for(size_t length = random() % 200; length > 0; length--) {
+                text += random() % 16 == 0 ? Specials[random() % sizeof(Specials)] : static_cast<char>(0x20 + random() % 0x60);
+            }
+
+            check(escape(text) == escapeSlowly(text), "JsonEscaper::write", text);
+        }
+    }
+
+    /**
+     * @brief Prints a document compactly
+     * @param json Document to print
+     * @return Compact text of the document
+     */
+    std::string print(Json& json) {
+        std::ostringstream stream;
+        json.print(stream);
+
+        return stream.str();
+    }
+
+    /**
+     * @brief Checks that keys created from paths holding quotes and control characters print as valid JSON and
+     * are found again by the same paths
+     */
+    void checkPathKeys() {
+        const std::string key = "say \"hi\"\tthere";
+        const std::string expected = "{\"say \\\"hi\\\"\\tthere\":{\"inner\":1}}";
+        Json json("{}", 2);
+
+        json.create(key + "/inner", "1");
+        check(print(json) == expected, "Json::create with an escaped key", key);
+
+        std::istringstream printed(print(json));
+        check(Json::validate(printed) == "The json is valid!", "Json::validate of an escaped key", key);
+
+        json.set(key + "/inner", "2");
+        check(print(json) == "{\"say \\\"hi\\\"\\tthere\":{\"inner\":2}}", "Json::set by an escaped key", key);
+
+        json.move(key, "plain");
+        check(print(json) == "{\"plain\":{\"inner\":2}}", "Json::move from an escaped key", key);
+
+        json.move("plain", key);
+        json.erase(key + "/inner");
+        check(print(json) == "{\"say \\\"hi\\\"\\tthere\":{}}", "Json::erase by an escaped key", key);
+    }
+
+    /**
+     * @brief Checks that escaped text decodes back to the text it was escaped from, and that sorted keys are
+     * ordered by their decoded text however they are escaped
+     * @param random Generator to draw from
+     */
+    void checkDecodes(std::mt19937& random) {
+        for(size_t i = 0; i < TextCount; i++) {
+            std::string text;
+
+            for(size_t length = random() % 100; length > 0; length--) {
+                text += static_cast<char>(random() % 0x80);
+            }
+
+            const std::string escaped = escape(text);
+            std::string decoded;
+            JsonEscaper::decode(escaped.data(), escaped.data() + escaped.size(), decoded);
+            check(decoded == text, "JsonEscaper::decode", escaped);
+        }
+
+        const std::string surrogates = "\\ud83d\\ude00\\u00e9";
+        std::string decoded;
+        JsonEscaper::decode(surrogates.data(), surrogates.data() + surrogates.size(), decoded);
+        check(decoded == "\xf0\x9f\x98\x80\xc3\xa9", "JsonEscaper::decode of a surrogate pair", surrogates);
+
+        const std::string text = "{\"C\":3,\"\\u0041\":2,\"B\":1,\"\\u00e9\":4,\"z\":5,\"\\n\":6}";
+        Json json(text.data(), text.size());
+        JsonFormatOptions options;
+        options.type = FormatterType::Compact;
+        options.sortKeys = true;
+        std::ostringstream sorted;
+        json.save(sorted, "", options);
+        check(sorted.str() == "{\"\\n\":6,\"\\u0041\":2,\"B\":1,\"C\":3,\"z\":5,\"\\u00e9\":4}", "sorted escaped keys", sorted.str());
+    }
+}
+
+/**
+ * @brief Checks that JsonEscaper escapes like a character-at-a-time escaper and decodes what it escaped, that
+ * edits by path escape keys and that sorted keys are compared decoded
+ * @return 0 if every check held, 1 otherwise
+ */
+int main() {
+    std::mt19937 random(24680);
+
+    compareEscapes(random);
+    checkPathKeys();
+    checkDecodes(random);
+
+    std::cout << "checked " << TextCount << " escaped and decoded texts, keys created from paths and sorted keys\n";
+
+    if(failures != 0) {
+        std::cerr << failures << " checks failed\n";
+        return 1;
+    }
+
+    return 0;
+}
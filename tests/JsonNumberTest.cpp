@@ -0,0 +1,301 @@
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <random>
+#include <string>
+#include "JsonNumber.hpp"
+#include "JsonNumberConverter.hpp"
+
+/**
+ * @brief Anonymous namespace for the number tokens and the checks against the C library
+ */
+namespace {
+    /**
+     * @brief Number of random doubles converted
+     */
+    const size_t RandomCount = 100000;
+
+    /**
+     * @brief Number of exact halfway points between two doubles converted
+     */
+    const size_t HalfwayCount = 2000;
+
+    /**
+     * @brief Tokens that must become doubles: subnormals, halfway ties, the edges of 2^53 and of the double range,
+     * negative zero and integers beyond 64 bits
+     */
+    const char* const DoubleTokens[] = {
+        "4.9406564584124654e-324", "2.4703282292062327e-324", "2.4703282292062328e-324", "1e-324", "3e-324",
+        "2.2250738585072009e-308", "2.2250738585072011e-308", "2.2250738585072014e-308", "1e-310", "-1.5e-320",
+        "9007199254740991.0", "9007199254740992.0", "9007199254740993.0", "9007199254740995.0", "9007199254740993e0",
+        "9007199254740993.0000000000000000000001", "9007199254740994.9999999999999999999999", "0.1", "0.3",
+        "1.7976931348623157e308", "1.7976931348623158e308", "1e308", "-1e308", "1e23", "8.5e-1", "-0", "-0.0", "0e-5",
+        "1E+2", "-9223372036854775809", "18446744073709551616", "123456789012345678901234567890"
+    };
+
+    /**
+     * @brief Number of failed checks
+     */
+    size_t failures = 0;
+
+    /**
+     * @brief Records a failed check when a condition does not hold
+     * @param condition Result of the check
+     * @param name Name of the check
+     * @param token Token the check was made on
+     */
+    void check(const bool condition, const std::string& name, const std::string& token) {
+        if(condition) {
+            return;
+        }
+
+        if(failures < 10) {
+            std::cerr << name << " failed on " << token.substr(0, 80) << "\n";
+        }
+
+        failures++;
+    }
+
+    /**
+     * @brief Checks if two doubles have the same bits, so that zeros of different signs differ
+     * @param left First double
+     * @param right Second double
+     * @return True if the bits are equal, false otherwise
+     */
+    bool isSame(const double left, const double right) {
+        return std::memcmp(&left, &right, sizeof(double)) == 0;
+    }
+
+    /**
+     * @brief Checks that a token becomes the double strtod rounds it to
+     * @param token Token to convert
+     */
+    void checkDouble(const std::string& token) {
+        const NumberValue value = JsonNumberConverter::parse(token.data(), token.size());
+
+        check(value.type == NumberType::Double && isSame(value.floating, std::strtod(token.c_str(), nullptr)),
+              "JsonNumberConverter::parse", token);
+    }
+
+    /**
+     * @brief Checks that a token becomes a signed integer
+     * @param token Token to convert
+     * @param expected Value the token must have
+     */
+    void checkInteger(const std::string& token, const int64_t expected) {
+        const NumberValue value = JsonNumberConverter::parse(token.data(), token.size());
+
+        check(value.type == NumberType::Integer && value.integer == expected && !value.isTextNeeded,
+              "JsonNumberConverter::parse to int64_t", token);
+    }
+
+    /**
+     * @brief Checks that a token becomes an unsigned integer
+     * @param token Token to convert
+     * @param expected Value the token must have
+     */
+    void checkUnsigned(const std::string& token, const uint64_t expected) {
+        const NumberValue value = JsonNumberConverter::parse(token.data(), token.size());
+
+        check(value.type == NumberType::UnsignedInteger && value.unsignedInteger == expected && !value.isTextNeeded,
+              "JsonNumberConverter::parse to uint64_t", token);
+    }
+
+    /**
+     * @brief Converts random doubles printed with 17 digits and with fewer
+     * @param random Generator to draw from
+     */
+    void checkRandomDoubles(std::mt19937_64& random) {
+        for(size_t i = 0; i < RandomCount; i++) {
+            const uint64_t bits = random();
+            double number;
+            std::memcpy(&number, &bits, sizeof(number));
+
+            if(!std::isfinite(number)) {
+                continue;
+            }
+
+            char token[64];
+            std::snprintf(token, sizeof(token), "%.*e", static_cast<int>(i % 17) + 1, number);
+            checkDouble(token);
+        }
+    }
+
+    /**
+     * @brief Converts the exact decimal value of the midpoint between two neighbouring doubles, which needs the
+     * fallback's tie to even, and the midpoint with its last digit changed
+     * @param random Generator to draw from
+     */
+    void checkHalfwayPoints(std::mt19937_64& random) {
+        for(size_t i = 0; i < HalfwayCount; i++) {
+            const double number = std::ldexp(static_cast<double>(random() >> 11), static_cast<int>(random() % 2000) - 1074 - 53);
+            const long double midpoint = (static_cast<long double>(number) + std::nextafter(number, INFINITY)) / 2;
+
+            if(!std::isfinite(number) || static_cast<double>(midpoint) == midpoint) {
+                continue;
+            }
+
+            std::string token(1100, '\0');
+            token.resize(std::snprintf(&token[0], token.size(), "%.1000Le", midpoint));
+            checkDouble(token);
+
+            const size_t last = token.find('e') - 1;
+            token[last] = token[last] == '9' ? '8' : static_cast<char>(token[last] + 1);
+            checkDouble(token);
+        }
+    }
+
+    /**
+     * @brief Counts the significant digits of a decimal, ignoring its sign, point, exponent and zeros at either end
+     * @param text Decimal to count the digits of
+     * @return Number of significant digits
+     */
+    size_t countDigits(const std::string& text) {
+        std::string digits;
+
+        for(size_t i = 0; i < text.size() && text[i] != 'e' && text[i] != 'E'; i++) {
+            if(text[i] >= '0' && text[i] <= '9') {
+                digits += text[i];
+            }
+        }
+
+        const size_t first = digits.find_first_not_of('0');
+
+        return first == std::string::npos ? 1 : digits.find_last_not_of('0') - first + 1;
+    }
+
+    /**
+     * @brief Checks that a double is formatted as a decimal that reads back as it, with no more digits than the
+     * shortest "%.*g" that does
+     * @param number Double to format
+     */
+    void checkFormat(const double number) {
+        NumberValue value;
+        value.type = NumberType::Double;
+        value.floating = number;
+        value.isTextNeeded = false;
+
+        char buffer[JsonNumberConverter::MaxTextLength + 1];
+        const std::string text(buffer, JsonNumberConverter::format(value, buffer));
+
+        size_t precision = 1;
+        char shortest[64];
+
+        for(; precision < 17; precision++) {
+            std::snprintf(shortest, sizeof(shortest), "%.*g", static_cast<int>(precision), number);
+
+            if(isSame(std::strtod(shortest, nullptr), number)) {
+                break;
+            }
+        }
+
+        check(isSame(std::strtod(text.c_str(), nullptr), number) && countDigits(text) <= precision,
+              "JsonNumberConverter::format", text);
+
+        const NumberValue parsed = JsonNumberConverter::parse(text.data(), text.size());
+        check(parsed.type == NumberType::Double ? isSame(parsed.floating, number) : static_cast<double>(parsed.integer) == number,
+              "JsonNumberConverter::parse of a formatted double", text);
+    }
+
+    /**
+     * @brief Checks that an integer is formatted as its exact decimal
+     * @param value Binary value of the integer
+     * @param expected Decimal the integer must be formatted as
+     */
+    void checkFormat(const NumberValue& value, const std::string& expected) {
+        char buffer[JsonNumberConverter::MaxTextLength + 1];
+
+        check(std::string(buffer, JsonNumberConverter::format(value, buffer)) == expected, "JsonNumberConverter::format", expected);
+    }
+
+    /**
+     * @brief Formats the edge cases and random doubles of every magnitude
+     * @param random Generator to draw from
+     */
+    void checkFormats(std::mt19937_64& random) {
+        const double edges[] = {0.0, -0.0, 5e-324, 2.2250738585072009e-308, 2.2250738585072014e-308, 9007199254740991.0,
+            9007199254740992.0, 9007199254740994.0, 1.7976931348623157e308, 1e308, -1e308, 1e23, 0.1, 0.3, 1e21, 1e22, 123.0};
+
+        for(const double number : edges) {
+            checkFormat(number);
+        }
+
+        for(size_t i = 0; i < RandomCount; i++) {
+            const uint64_t bits = random();
+            double number;
+            std::memcpy(&number, &bits, sizeof(number));
+
+            if(std::isfinite(number)) {
+                checkFormat(number);
+            }
+        }
+
+        NumberValue value;
+        value.isTextNeeded = false;
+        value.type = NumberType::Integer;
+
+        const int64_t integers[] = {0, -1, 9007199254740993LL, INT64_MAX, INT64_MIN};
+
+        for(const int64_t integer : integers) {
+            value.integer = integer;
+            checkFormat(value, std::to_string(static_cast<long long>(integer)));
+        }
+
+        value.type = NumberType::UnsignedInteger;
+        value.unsignedInteger = UINT64_MAX;
+        checkFormat(value, "18446744073709551615");
+    }
+
+    /**
+     * @brief Checks that JsonNumber has a constructor for every integer type, so that integer literals are not
+     * ambiguous between them
+     */
+    void checkConstructors() {
+        check(JsonNumber(5).getInt64() == 5, "JsonNumber(int)", "5");
+        check(JsonNumber(-5L).getInt64() == -5, "JsonNumber(long)", "-5L");
+        check(JsonNumber(INT64_MIN).getInt64() == INT64_MIN, "JsonNumber(long long)", "INT64_MIN");
+        check(JsonNumber(5u).getUint64() == 5, "JsonNumber(unsigned int)", "5u");
+        check(JsonNumber(5ul).getNumberType() == NumberType::Integer, "JsonNumber(unsigned long)", "5ul");
+        check(JsonNumber(UINT64_MAX).getNumberType() == NumberType::UnsignedInteger, "JsonNumber(unsigned long long)", "UINT64_MAX");
+        check(JsonNumber(-0.0).getDouble() == 0 && std::signbit(JsonNumber(-0.0).getDouble()), "JsonNumber(double)", "-0.0");
+    }
+}
+
+/**
+ * @brief Checks that number tokens become the same doubles as with strtod, that integers stay exact up to the
+ * 64-bit limits and that formatted numbers are the shortest that read back
+ * @return 0 if every check held, 1 otherwise
+ */
+int main() {
+    std::mt19937_64 random(97531);
+
+    for(const char* token : DoubleTokens) {
+        checkDouble(token);
+    }
+
+    checkInteger("9007199254740991", 9007199254740991LL);
+    checkInteger("9007199254740993", 9007199254740993LL);
+    checkInteger("9223372036854775807", INT64_MAX);
+    checkInteger("-9223372036854775808", INT64_MIN);
+    checkInteger("0", 0);
+    checkUnsigned("9223372036854775808", 9223372036854775808ULL);
+    checkUnsigned("18446744073709551615", UINT64_MAX);
+
+    checkRandomDoubles(random);
+    checkHalfwayPoints(random);
+    checkFormats(random);
+    checkConstructors();
+
+    std::cout << "checked " << RandomCount << " random doubles, " << HalfwayCount << " halfway points and "
+              << RandomCount << " formatted doubles\n";
+
+    if(failures != 0) {
+        std::cerr << failures << " checks failed\n";
+        return 1;
+    }
+
+    return 0;
+}
@@ -0,0 +1,238 @@
+#include <iostream>
+#include <random>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include "JsonArena.hpp"
+#include "JsonParser.hpp"
+#include "JsonValidator.hpp"
+#include "JsonEventParser.hpp"
+
+/**
+ * @brief Anonymous namespace for the shared corpus and the comparisons between the parser, the validator and
+ * the event parser
+ */
+namespace {
+    /**
+     * @brief Number of random documents added to the corpus
+     */
+    const size_t RandomCount = 3000;
+
+    /**
+     * @brief Documents every reader must accept or reject with the same message
+     */
+    const char* const Corpus[] = {
+        "{}", "[]", "0", "-0.5e+3", "\"\\u00e9\\ud83d\\ude00\"", "true", "null", " [1, {\"a\": [false]}] ",
+        "{\"a\":1,\"b\":{\"a\":2}}", "{\"a\":1,\"a\":2}", "{\"x\":{},\"y\":[],\"x\":null}", "[{\"k\":1,\"k\":1}]",
+        "", "   ", "[", "]", "{", "}", "[1,]", "[,1]", "{\"a\"}", "{\"a\":}", "{\"a\" 1}", "{a:1}", "{\"a\":1,}",
+        "[1 2]", "[1] [2]", "[1] x", "01", "1.", "-", "1e", ".5", "+1", "tru", "nul", "falsey", "\"abc", "\"\\x\"",
+        "\"\\u12\"", "\"\\u12G4\"", "\"\x01\"", "\"\xc3\"", "\"\xed\xa0\x80\"", "\"\xf4\x90\x80\x80\"", "[\"a\"\"b\"]",
+        "{\"a\":1 \"b\":2}", "[[[[[]]]]]", "[[[[[]]]]", "{\"a\":[}", "[\"\\\"\"]", "\n\n  {\"row\":\n 1,]"
+    };
+
+    /**
+     * @brief Pieces random documents are made of, valid or not once put together
+     */
+    const char* const Pieces[] = {
+        "{", "}", "[", "]", ":", ",", " ", "\n", "\"k\"", "\"k\":", "\"v\\n\"", "1", "-2.5e3", "true", "null", "\"k2\":"
+    };
+
+    /**
+     * @brief Number of failed comparisons
+     */
+    size_t failures = 0;
+
+    /**
+     * @brief Records a failed comparison when a condition does not hold
+     * @param condition Result of the comparison
+     * @param name Name of the reader that differs
+     * @param document Document the comparison was made on
+     */
+    void check(const bool condition, const std::string& name, const std::string& document) {
+        if(condition) {
+            return;
+        }
+
+        if(failures < 10) {
+            std::cerr << name << " differs from JsonParser on " << document.substr(0, 80) << "\n";
+        }
+
+        failures++;
+    }
+
+    /**
+     * @brief Handler ignoring every token
+     */
+    class NullHandler : public JsonEventHandler {
+        public:
+            /**
+             * @brief Ignores the start of an object
+             */
+            void startObject() override {}
+
+            /**
+             * @brief Ignores the end of an object
+             */
+            void endObject() override {}
+
+            /**
+             * @brief Ignores the start of an array
+             */
+            void startArray() override {}
+
+            /**
+             * @brief Ignores the end of an array
+             */
+            void endArray() override {}
+
+            /**
+             * @brief Ignores a key
+             */
+            void visitKey(const char*, const size_t) override {}
+
+            /**
+             * @brief Ignores a null
+             */
+            void visitNull() override {}
+
+            /**
+             * @brief Ignores a boolean
+             */
+            void visitBoolean(const bool) override {}
+
+            /**
+             * @brief Ignores a number
+             */
+            void visitNumber(const char*, const size_t) override {}
+
+            /**
+             * @brief Ignores a string
+             */
+            void visitString(const char*, const size_t) override {}
+    };
+
+    /**
+     * @brief Parses a document with JsonParser
+     * @param document Document to parse
+     * @return Validity and error message of the document
+     */
+    std::pair<bool, std::string> parse(const std::string& document) {
+        JsonArena arena;
+        JsonArena::Scope scope(arena);
+
+        try {
+            delete JsonParser::parseValidated(document.data(), document.size());
+        }
+        catch(const std::runtime_error& error) {
+            return std::make_pair(false, std::string(error.what()));
+        }
+
+        return std::make_pair(true, std::string(""));
+    }
+
+    /**
+     * @brief Reads a document with JsonEventParser, rejecting duplicate keys
+     * @param document Document to read
+     * @param isStreamed Whether the document is read from a stream instead of a buffer
+     * @return Validity and error message of the document
+     */
+    std::pair<bool, std::string> readEvents(const std::string& document, const bool isStreamed) {
+        NullHandler handler;
+
+        try {
+            if(isStreamed) {
+                std::istringstream stream(document);
+                JsonEventParser::parse(stream, handler, JsonValidator::DefaultMaxDepth, true);
+            }
+            else {
+                JsonEventParser::parse(document.data(), document.size(), handler, JsonValidator::DefaultMaxDepth, true);
+            }
+        }
+        catch(const std::runtime_error& error) {
+            return std::make_pair(false, std::string(error.what()));
+        }
+
+        return std::make_pair(true, std::string(""));
+    }
+
+    /**
+     * @brief Compares the validator and the event parser, from a buffer and from a stream, with the parser
+     * @param document Document to compare on
+     */
+    void compare(const std::string& document) {
+        const std::pair<bool, std::string> expected = parse(document);
+        const std::pair<bool, std::string> validated = JsonValidator::validateJson(document.data(), document.size());
+        std::istringstream stream(document);
+        const std::pair<bool, std::string> streamed = JsonValidator::validateJson(stream);
+
+        check(validated.first == expected.first && (validated.first || validated.second == expected.second),
+              "JsonValidator::validateJson of a buffer", document);
+        check(streamed.first == expected.first && (streamed.first || streamed.second == expected.second),
+              "JsonValidator::validateJson of a stream", document);
+        check(readEvents(document, false) == expected, "JsonEventParser::parse of a buffer", document);
+        check(readEvents(document, true) == expected, "JsonEventParser::parse of a stream", document);
+    }
+
+    /**
+     * @brief Checks that the event parser only rejects duplicate keys when asked to, and that an object wider
+     * than a stream chunk is read either way
+     */
+    void checkDuplicates() {
+        std::string wide = "{";
+
+        for(size_t i = 0; i < 100000; i++) {
+            wide += (i == 0 ? "\"key" : ",\"key") + std::to_string(i) + "\":" + std::to_string(i);
+        }
+
+        const std::string duplicated = wide + ",\"key7\":0}";
+        wide += "}";
+
+        NullHandler handler;
+        std::istringstream stream(duplicated);
+
+        try {
+            JsonEventParser::parse(stream, handler);
+            JsonEventParser::parse(wide.data(), wide.size(), handler, JsonValidator::DefaultMaxDepth, true);
+        }
+        catch(const std::runtime_error& error) {
+            check(false, std::string("JsonEventParser::parse, ") + error.what(), "a wide object");
+        }
+
+        check(!readEvents(duplicated, true).first, "JsonEventParser::parse rejecting duplicates", "a wide object");
+    }
+}
+
+/**
+ * @brief Checks that the parser, the validator and the event parser accept and reject the same documents with
+ * the same messages
+ * @return 0 if every comparison held, 1 otherwise
+ */
+int main() {
+    std::mt19937 random(13579);
+
+    for(const char* document : Corpus) {
+        compare(document);
+    }
+
+    for(size_t i = 0; i < RandomCount; i++) {
+        std::string document;
+
+        for(size_t length = 1 + random() % 24; length > 0; length--) {
+            document += Pieces[random() % (sizeof(Pieces) / sizeof(Pieces[0]))];
+        }
+
+        compare(document);
+    }
+
+    checkDuplicates();
+
+    std::cout << "checked " << sizeof(Corpus) / sizeof(Corpus[0]) + RandomCount << " documents\n";
+
+    if(failures != 0) {
+        std::cerr << failures << " comparisons failed\n";
+        return 1;
+    }
+
+    return 0;
+}
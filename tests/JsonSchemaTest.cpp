@@ -0,0 +1,200 @@
+#include <cstring>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include "JsonSchema.hpp"
+
+/**
+ * @brief Anonymous namespace for the schema cases and the checks run on them
+ */
+namespace {
+    /**
+     * @brief Schema, instance and expected outcome of one check
+     */
+    struct SchemaCase {
+        const char* schema;    ///< Text of the schema
+        const char* instance;  ///< Text of the instance
+        bool isValid;          ///< True if the instance must be accepted
+    };
+
+    /**
+     * @brief One accepted and one rejected instance for every supported keyword, then $ref to itself and between
+     * definitions
+     */
+    const SchemaCase Cases[] = {
+        {"true", "{\"a\":1}", true},
+        {"false", "1", false},
+        {"{\"type\":\"string\"}", "\"a\"", true},
+        {"{\"type\":\"string\"}", "1", false},
+        {"{\"type\":[\"integer\",\"null\"]}", "2.0", true},
+        {"{\"type\":[\"integer\",\"null\"]}", "2.5", false},
+        {"{\"const\":{\"a\":[1,2]}}", "{ \"a\" : [1.0, 2] }", true},
+        {"{\"const\":{\"a\":[1,2]}}", "{\"a\":[2,1]}", false},
+        {"{\"enum\":[\"x\",1,null]}", "null", true},
+        {"{\"enum\":[\"x\",1,null]}", "\"y\"", false},
+        {"{\"multipleOf\":0.5}", "2.5", true},
+        {"{\"multipleOf\":0.5}", "2.3", false},
+        {"{\"minimum\":3}", "3", true},
+        {"{\"minimum\":3}", "2.999", false},
+        {"{\"exclusiveMinimum\":3}", "3.001", true},
+        {"{\"exclusiveMinimum\":3}", "3", false},
+        {"{\"maximum\":9007199254740993}", "9007199254740993", true},
+        {"{\"maximum\":9007199254740992}", "9007199254740993", false},
+        {"{\"exclusiveMaximum\":3}", "2", true},
+        {"{\"exclusiveMaximum\":3}", "3", false},
+        {"{\"minLength\":2}", "\"ab\"", true},
+        {"{\"minLength\":2}", "\"\\u00e9\"", false},
+        {"{\"maxLength\":1}", "\"\xc3\xa9\"", true},
+        {"{\"maxLength\":1}", "\"ab\"", false},
+        {"{\"pattern\":\"^a+b$\"}", "\"aab\"", true},
+        {"{\"pattern\":\"^a+b$\"}", "\"abc\"", false},
+        {"{\"minItems\":2}", "[1,2]", true},
+        {"{\"minItems\":2}", "[1]", false},
+        {"{\"maxItems\":1}", "[1]", true},
+        {"{\"maxItems\":1}", "[1,2]", false},
+        {"{\"uniqueItems\":true}", "[1,\"1\",{\"a\":1}]", true},
+        {"{\"uniqueItems\":true}", "[{\"a\":1,\"b\":2},{\"b\":2,\"a\":1}]", false},
+        {"{\"prefixItems\":[{\"type\":\"string\"},{\"type\":\"number\"}]}", "[\"a\",1,null]", true},
+        {"{\"prefixItems\":[{\"type\":\"string\"},{\"type\":\"number\"}]}", "[\"a\",\"b\"]", false},
+        {"{\"prefixItems\":[true],\"items\":{\"type\":\"number\"}}", "[\"a\",1,2]", true},
+        {"{\"prefixItems\":[true],\"items\":{\"type\":\"number\"}}", "[\"a\",1,\"b\"]", false},
+        {"{\"contains\":{\"type\":\"null\"},\"minContains\":2,\"maxContains\":3}", "[null,1,null]", true},
+        {"{\"contains\":{\"type\":\"null\"},\"minContains\":2,\"maxContains\":3}", "[null,1]", false},
+        {"{\"contains\":{\"type\":\"null\"},\"maxContains\":1}", "[null,null]", false},
+        {"{\"minProperties\":1}", "{\"a\":1}", true},
+        {"{\"minProperties\":1}", "{}", false},
+        {"{\"maxProperties\":1}", "{\"a\":1}", true},
+        {"{\"maxProperties\":1}", "{\"a\":1,\"b\":2}", false},
+        {"{\"required\":[\"a\",\"b\"]}", "{\"b\":1,\"a\":2}", true},
+        {"{\"required\":[\"a\",\"b\"]}", "{\"a\":1}", false},
+        {"{\"dependentRequired\":{\"a\":[\"b\"]}}", "{\"b\":1}", true},
+        {"{\"dependentRequired\":{\"a\":[\"b\"]}}", "{\"a\":1}", false},
+        {"{\"dependentSchemas\":{\"a\":{\"required\":[\"b\"]}}}", "{\"a\":1,\"b\":2}", true},
+        {"{\"dependentSchemas\":{\"a\":{\"required\":[\"b\"]}}}", "{\"a\":1}", false},
+        {"{\"properties\":{\"a\":{\"type\":\"number\"}}}", "{\"a\":1,\"b\":\"x\"}", true},
+        {"{\"properties\":{\"a\":{\"type\":\"number\"}}}", "{\"a\":\"x\"}", false},
+        {"{\"patternProperties\":{\"^n_\":{\"type\":\"number\"}}}", "{\"n_a\":1,\"s\":\"x\"}", true},
+        {"{\"patternProperties\":{\"^n_\":{\"type\":\"number\"}}}", "{\"n_a\":\"x\"}", false},
+        {"{\"properties\":{\"a\":true},\"patternProperties\":{\"^b\":true},\"additionalProperties\":false}", "{\"a\":1,\"bc\":2}", true},
+        {"{\"properties\":{\"a\":true},\"patternProperties\":{\"^b\":true},\"additionalProperties\":false}", "{\"a\":1,\"c\":2}", false},
+        {"{\"propertyNames\":{\"maxLength\":2}}", "{\"ab\":1}", true},
+        {"{\"propertyNames\":{\"maxLength\":2}}", "{\"abc\":1}", false},
+        {"{\"allOf\":[{\"minimum\":1},{\"maximum\":3}]}", "2", true},
+        {"{\"allOf\":[{\"minimum\":1},{\"maximum\":3}]}", "4", false},
+        {"{\"anyOf\":[{\"type\":\"string\"},{\"minimum\":5}]}", "6", true},
+        {"{\"anyOf\":[{\"type\":\"string\"},{\"minimum\":5}]}", "4", false},
+        {"{\"oneOf\":[{\"minimum\":5},{\"maximum\":10}]}", "11", true},
+        {"{\"oneOf\":[{\"minimum\":5},{\"maximum\":10}]}", "7", false},
+        {"{\"not\":{\"type\":\"null\"}}", "0", true},
+        {"{\"not\":{\"type\":\"null\"}}", "null", false},
+        {"{\"if\":{\"minimum\":0},\"then\":{\"multipleOf\":2},\"else\":{\"multipleOf\":3}}", "-3", true},
+        {"{\"if\":{\"minimum\":0},\"then\":{\"multipleOf\":2},\"else\":{\"multipleOf\":3}}", "3", false},
+        {"{\"$defs\":{\"n\":{\"type\":\"number\"}},\"$ref\":\"#/$defs/n\"}", "1", true},
+        {"{\"$defs\":{\"n\":{\"type\":\"number\"}},\"$ref\":\"#/$defs/n\"}", "\"1\"", false},
+        {"{\"$defs\":{\"n\":{\"$anchor\":\"num\",\"type\":\"number\"}},\"items\":{\"$ref\":\"#num\"}}", "[1,2]", true},
+        {"{\"$defs\":{\"n\":{\"$anchor\":\"num\",\"type\":\"number\"}},\"items\":{\"$ref\":\"#num\"}}", "[1,\"2\"]", false},
+        {"{\"type\":\"object\",\"properties\":{\"next\":{\"$ref\":\"#\"}},\"additionalProperties\":false}", "{\"next\":{\"next\":{}}}", true},
+        {"{\"type\":\"object\",\"properties\":{\"next\":{\"$ref\":\"#\"}},\"additionalProperties\":false}", "{\"next\":{\"next\":{\"other\":1}}}", false},
+        {"{\"$defs\":{\"a\":{\"items\":{\"$ref\":\"#/$defs/b\"}},\"b\":{\"type\":\"array\",\"items\":{\"$ref\":\"#/$defs/a\"}}},\"$ref\":\"#/$defs/a\"}", "[[[[]]]]", true},
+        {"{\"$defs\":{\"a\":{\"items\":{\"$ref\":\"#/$defs/b\"}},\"b\":{\"type\":\"array\",\"items\":{\"$ref\":\"#/$defs/a\"}}},\"$ref\":\"#/$defs/a\"}", "[[],1]", false},
+        {"{\"$ref\":\"#\"}", "1", false},
+        {"{\"$defs\":{\"a\":{\"$ref\":\"#/$defs/b\"},\"b\":{\"$ref\":\"#/$defs/a\"}},\"$ref\":\"#/$defs/a\"}", "1", false}
+    };
+
+    /**
+     * @brief Schemas that must not compile, each with a word its message must contain
+     */
+    const char* const Rejected[][2] = {
+        {"{\"unevaluatedProperties\":false}", "unevaluatedProperties"},
+        {"{\"$dynamicRef\":\"#x\"}", "$dynamicRef"},
+        {"{\"minimum\":\"1\"}", "minimum"},
+        {"{\"pattern\":\"(\"}", "not a valid regex"},
+        {"{\"$ref\":\"#/$defs/missing\"}", "cannot be resolved"},
+        {"[]", "must be an object or a boolean"}
+    };
+
+    /**
+     * @brief Number of failed checks
+     */
+    size_t failures = 0;
+
+    /**
+     * @brief Records a failed check when a condition does not hold
+     * @param condition Result of the check
+     * @param schema Schema the check was made with
+     * @param detail Instance or expected message of the check
+     */
+    void check(const bool condition, const std::string& schema, const std::string& detail) {
+        if(condition) {
+            return;
+        }
+
+        if(failures < 10) {
+            std::cerr << "schema " << schema << " failed on " << detail << "\n";
+        }
+
+        failures++;
+    }
+
+    /**
+     * @brief Validates the instance of a case and compares the outcome, and the presence of a message, with the
+     * expected one
+     * @param schemaCase Case to check
+     */
+    void checkCase(const SchemaCase& schemaCase) {
+        try {
+            JsonSchema schema(schemaCase.schema, std::strlen(schemaCase.schema));
+            const std::pair<bool, std::string> result = schema.validate(schemaCase.instance, std::strlen(schemaCase.instance));
+
+            check(result.first == schemaCase.isValid && result.second.empty() == schemaCase.isValid, schemaCase.schema,
+                  schemaCase.instance);
+        }
+        catch(const std::runtime_error& error) {
+            check(false, schemaCase.schema, std::string("compiling: ") + error.what());
+        }
+    }
+
+    /**
+     * @brief Checks that a schema does not compile and that the message names what is wrong
+     * @param schema Text of the schema
+     * @param word Word the message must contain
+     */
+    void checkRejected(const char* schema, const char* word) {
+        try {
+            JsonSchema compiled(schema, std::strlen(schema));
+            check(false, schema, "compiling");
+        }
+        catch(const std::runtime_error& error) {
+            check(std::string(error.what()).find(word) != std::string::npos, schema, error.what());
+        }
+    }
+}
+
+/**
+ * @brief Checks every supported keyword against a valid and an invalid instance, $ref cycles and schemas that
+ * must not compile
+ * @return 0 if every check held, 1 otherwise
+ */
+int main() {
+    for(const SchemaCase& schemaCase : Cases) {
+        checkCase(schemaCase);
+    }
+
+    for(const auto& rejected : Rejected) {
+        checkRejected(rejected[0], rejected[1]);
+    }
+
+    const char* const cycle = "{\"$ref\":\"#\"}";
+    const std::string message = JsonSchema(cycle, std::strlen(cycle)).validate("1", 1).second;
+    check(message.find("reference itself endlessly") != std::string::npos, cycle, message);
+
+    std::cout << "checked " << sizeof(Cases) / sizeof(Cases[0]) << " instances and "
+              << sizeof(Rejected) / sizeof(Rejected[0]) << " rejected schemas\n";
+
+    if(failures != 0) {
+        std::cerr << failures << " checks failed\n";
+        return 1;
+    }
+
+    return 0;
+}
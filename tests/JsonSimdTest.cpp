@@ -0,0 +1,207 @@
+#include <cstring>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+#include "JsonStructuralIndexer.hpp"
+#include "JsonUtf8.hpp"
+#include "JsonEscaper.hpp"
+#include "JsonInstructionSet.hpp"
+
+/**
+ * @brief Anonymous namespace for the input generator and the comparisons between instruction sets
+ */
+namespace {
+    /**
+     * @brief Number of random buffers every instruction set is checked on
+     */
+    const size_t BufferCount = 2000;
+
+    /**
+     * @brief Pieces random buffers are made of: JSON punctuation, whitespace, escapes, control characters and
+     * well-formed UTF-8 sequences
+     */
+    const char* const CleanPieces[] = {
+        "{", "}", "[", "]", ":", ",", "\"", "\\", "\\\"", "\\\\", " ", "\t", "\n", "\r", "\v", "\f", "\x01", "\x1f",
+        "a", "z", "0", "-1.5e3", "true", "null", "\xc3\xa9", "\xe2\x82\xac", "\xf0\x9f\x98\x80", "\x7f"
+    };
+
+    /**
+     * @brief Ill-formed UTF-8 sequences, at most one of which is put in a buffer
+     */
+    const char* const InvalidPieces[] = {
+        "\x80", "\xbf", "\xc0\xaf", "\xc1\xbf", "\xe0\x80\xaf", "\xed\xa0\x80", "\xf0\x80\x80\xaf", "\xf4\x90\x80\x80",
+        "\xf5\x80\x80\x80", "\xff", "\xc3", "\xe2\x82", "\xf0\x9f\x98"
+    };
+
+    /**
+     * @brief Instruction sets compared against the scalar code
+     */
+    const InstructionSet VectorSets[] = {InstructionSet::Sse, InstructionSet::Avx2};
+
+    /**
+     * @brief Names of the instruction sets, in the order of VectorSets
+     */
+    const char* const VectorSetNames[] = {"SSE", "AVX2"};
+
+    /**
+     * @brief Number of failed comparisons
+     */
+    size_t failures = 0;
+
+    /**
+     * @brief Records a failed comparison when a condition does not hold
+     * @param condition Result of the comparison
+     * @param name Name of the instruction set and of the checked function
+     * @param buffer Buffer the comparison was made on
+     */
+    void check(const bool condition, const std::string& name, const std::string& buffer) {
+        if(condition) {
+            return;
+        }
+
+        if(failures < 10) {
+            std::cerr << name << " differs from the scalar code on a buffer of " << buffer.size() << " characters\n";
+        }
+
+        failures++;
+    }
+
+    /**
+     * @brief Builds a random buffer of pieces, sometimes with one ill-formed UTF-8 sequence
+     * @param random Generator to draw from
+     * @return Generated buffer
+     */
+    std::string makeBuffer(std::mt19937& random) {
+        const size_t cleanCount = sizeof(CleanPieces) / sizeof(CleanPieces[0]);
+        const size_t invalidCount = sizeof(InvalidPieces) / sizeof(InvalidPieces[0]);
+        const size_t pieces = random() % 200;
+        const size_t invalidAt = random() % 2 == 0 ? random() % (pieces + 1) : pieces + 1;
+        std::string buffer;
+
+        for(size_t i = 0; i <= pieces; i++) {
+            if(i == invalidAt) {
+                buffer += InvalidPieces[random() % invalidCount];
+            }
+
+            if(i < pieces) {
+                buffer += random() % 3 == 0 ? CleanPieces[random() % cleanCount] : "x";
+            }
+        }
+
+        return buffer;
+    }
+
+    /**
+     * @brief Compares two bracket profiles
+     * @param first First profile
+     * @param second Second profile
+     * @return True if both hold the same brackets, false otherwise
+     */
+    bool isSameProfile(const BracketProfile& first, const BracketProfile& second) {
+        if(first.closers != second.closers || first.isBroken != second.isBroken || first.openers.size() != second.openers.size()) {
+            return false;
+        }
+
+        for(size_t i = 0; i < first.openers.size(); i++) {
+            if(first.openers[i].brace != second.openers[i].brace || first.openers[i].offset != second.openers[i].offset) {
+                return false;
+            }
+        }
+
+        return true;
+    }
+
+    /**
+     * @brief Compares two chunk scans
+     * @param first First scan
+     * @param second Second scan
+     * @return True if both found the same quotes, commas and brackets, false otherwise
+     */
+    bool isSameScan(const ChunkScan& first, const ChunkScan& second) {
+        if(first.isQuoteCountOdd != second.isQuoteCountOdd) {
+            return false;
+        }
+
+        for(size_t guess = 0; guess < 2; guess++) {
+            if(first.hasComma[guess] != second.hasComma[guess] || (first.hasComma[guess] && first.commas[guess] != second.commas[guess]) ||
+               !isSameProfile(first.heads[guess], second.heads[guess]) || !isSameProfile(first.tails[guess], second.tails[guess])) {
+                return false;
+            }
+        }
+
+        return true;
+    }
+
+    /**
+     * @brief Compares every vectorized function of an instruction set against the scalar code on one buffer.
+     * The buffer is copied to an allocation of its exact size so reads past its end are caught by sanitizers
+     * @param set Instruction set to check
+     * @param name Name of the instruction set
+     * @param buffer Buffer to check on
+     * @param random Generator choosing the subranges
+     */
+    void compare(const InstructionSet set, const std::string& name, const std::string& buffer, std::mt19937& random) {
+        std::vector<char> copy(buffer.begin(), buffer.end());
+        const char* data = copy.data();
+        const size_t length = copy.size();
+
+        StructuralIndex expectedIndex;
+        StructuralIndex actualIndex;
+
+        JsonStructuralIndexer::index(data, length, expectedIndex, InstructionSet::Scalar);
+        JsonStructuralIndexer::index(data, length, actualIndex, set);
+        check(expectedIndex.structurals == actualIndex.structurals && expectedIndex.specials == actualIndex.specials,
+              name + " JsonStructuralIndexer::index", buffer);
+
+        const size_t begin = length == 0 ? 0 : random() % length;
+        const size_t end = begin + (length == begin ? 0 : random() % (length - begin + 1));
+        const size_t depthLimit = 1 + random() % 8;
+
+        ChunkScan expectedScan;
+        ChunkScan actualScan;
+
+        JsonStructuralIndexer::scanChunk(data, begin, end, depthLimit, expectedScan, InstructionSet::Scalar);
+        JsonStructuralIndexer::scanChunk(data, begin, end, depthLimit, actualScan, set);
+        check(isSameScan(expectedScan, actualScan), name + " JsonStructuralIndexer::scanChunk", buffer);
+
+        check(JsonUtf8::findInvalid(data, data + length, InstructionSet::Scalar) == JsonUtf8::findInvalid(data, data + length, set),
+              name + " JsonUtf8::findInvalid", buffer);
+        check(JsonUtf8::findInvalid(data + begin, data + end, InstructionSet::Scalar) == JsonUtf8::findInvalid(data + begin, data + end, set),
+              name + " JsonUtf8::findInvalid on a subrange", buffer);
+
+        check(JsonEscaper::findEscape(data, data + length, InstructionSet::Scalar) == JsonEscaper::findEscape(data, data + length, set),
+              name + " JsonEscaper::findEscape", buffer);
+        check(JsonEscaper::findEscape(data + begin, data + end, InstructionSet::Scalar) == JsonEscaper::findEscape(data + begin, data + end, set),
+              name + " JsonEscaper::findEscape on a subrange", buffer);
+    }
+}
+
+/**
+ * @brief Checks that every vectorized scanner the CPU supports gives the same results as the scalar code
+ * on random buffers
+ * @return 0 if every comparison held, 1 otherwise
+ */
+int main() {
+    for(size_t i = 0; i < sizeof(VectorSets) / sizeof(VectorSets[0]); i++) {
+        if(!JsonInstructionSet::isSupported(VectorSets[i])) {
+            std::cout << VectorSetNames[i] << ": skipped, not supported by this CPU\n";
+            continue;
+        }
+
+        std::mt19937 random(12345);
+
+        for(size_t j = 0; j < BufferCount; j++) {
+            compare(VectorSets[i], VectorSetNames[i], makeBuffer(random), random);
+        }
+
+        std::cout << VectorSetNames[i] << ": checked " << BufferCount << " buffers\n";
+    }
+
+    if(failures != 0) {
+        std::cerr << failures << " comparisons failed\n";
+        return 1;
+    }
+
+    return 0;
+}
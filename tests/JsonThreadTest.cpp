@@ -0,0 +1,345 @@
+#include <algorithm>
+#include <iostream>
+#include <random>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+#include "JsonArena.hpp"
+#include "JsonParser.hpp"
+#include "JsonParallelParser.hpp"
+#include "JsonValidator.hpp"
+#include "JsonLinesReader.hpp"
+#include "JsonPrinter.hpp"
+
+/**
+ * @brief Anonymous namespace for the document generator and the comparisons against single-threaded code
+ */
+namespace {
+    /**
+     * @brief Number of threads the multi-threaded code is run with
+     */
+    const size_t ThreadCount = 4;
+
+    /**
+     * @brief Number of failed comparisons
+     */
+    size_t failures = 0;
+
+    /**
+     * @brief Records a failed comparison when a condition does not hold
+     * @param condition Result of the comparison
+     * @param name Name of the comparison
+     */
+    void check(const bool condition, const std::string& name) {
+        if(condition) {
+            return;
+        }
+
+        if(failures < 10) {
+            std::cerr << name << " differs from the single-threaded result\n";
+        }
+
+        failures++;
+    }
+
+    /**
+     * @brief Records a failure when a document was not split between threads
+     * @param count Number of pieces or regions the document was split into
+     * @param name Name of the split code and of the document
+     */
+    void checkSplit(const size_t count, const std::string& name) {
+        if(count > 1) {
+            return;
+        }
+
+        if(failures < 10) {
+            std::cerr << name << " was not split between threads\n";
+        }
+
+        failures++;
+    }
+
+    /**
+     * @brief Builds a random record with nested arrays and objects
+     * @param random Generator to draw from
+     * @param depth Number of levels left to nest
+     * @return Generated record
+     */
+    std::string makeRecord(std::mt19937& random, const size_t depth) {
+        switch(depth == 0 ? random() % 4 : random() % 6) {
+            case 0: return std::to_string(static_cast<int>(random() % 100000) - 50000);
+            case 1: return "\"text \\\"" + std::to_string(random() % 1000) + "\\\" caf\xc3\xa9\"";
+            case 2: return random() % 2 == 0 ? "true" : "null";
+            case 3: return std::to_string(random() % 1000) + ".25e-3";
+            case 4: {
+                std::string array = "[";
+
+                for(size_t i = random() % 5; i > 0; i--) {
+                    array += makeRecord(random, depth - 1) + (i > 1 ? "," : "");
+                }
+
+                return array + "]";
+            }
+            default: {
+                std::string object = "{";
+
+                for(size_t i = random() % 5; i > 0; i--) {
+                    object += "\"key" + std::to_string(i) + "\": " + makeRecord(random, depth - 1) + (i > 1 ? ", " : "");
+                }
+
+                return object + "}";
+            }
+        }
+    }
+
+    /**
+     * @brief Builds a document large enough to be split between threads
+     * @param random Generator to draw from
+     * @return Generated document, an object of arrays of records
+     */
+    std::string makeDocument(std::mt19937& random) {
+        std::string document = "{\n";
+
+        for(size_t i = 0; i < 40; i++) {
+            document += "  \"part" + std::to_string(i) + "\": [";
+
+            for(size_t j = 0; j < 1000; j++) {
+                document += (j == 0 ? "" : ",\n    ") + makeRecord(random, 4);
+            }
+
+            document += i + 1 < 40 ? "],\n" : "]\n";
+        }
+
+        return document + "}\n";
+    }
+
+    /**
+     * @brief Parses a buffer on one thread
+     * @param document Buffer to parse
+     * @return Compact text of the parsed value, or the error message prefixed with "error: "
+     */
+    std::string parseSerially(const std::string& document) {
+        JsonArena arena;
+        JsonArena::Scope scope(arena);
+
+        try {
+            return JsonPrinter::print(JsonParser::parseValidated(document.data(), document.size()));
+        }
+        catch(const std::runtime_error& error) {
+            return std::string("error: ") + error.what();
+        }
+    }
+
+    /**
+     * @brief Parses a buffer with JsonParallelParser
+     * @param document Buffer to parse
+     * @param pieceCount Set to the number of pieces the buffer was split into
+     * @return Compact text of the parsed value, or the error message prefixed with "error: "
+     */
+    std::string parseInParallel(const std::string& document, size_t& pieceCount) {
+        JsonArena arena;
+        JsonArena::Scope scope(arena);
+        JsonParallelParser parser(ThreadCount);
+
+        try {
+            const std::string text = JsonPrinter::print(parser.parse(document.data(), document.size()));
+            pieceCount = parser.getPieceCount();
+            return text;
+        }
+        catch(const std::runtime_error& error) {
+            pieceCount = parser.getPieceCount();
+            return std::string("error: ") + error.what();
+        }
+    }
+
+    /**
+     * @brief Compares JsonParallelParser and the multi-threaded JsonValidator against their single-threaded
+     * counterparts on a document
+     * @param document Document to compare on
+     * @param name Name of the document
+     * @param isValid Whether the document is valid, so both must have split it between threads
+     */
+    void compareDocument(const std::string& document, const std::string& name, const bool isValid) {
+        size_t pieceCount = 0;
+
+        check(parseSerially(document) == parseInParallel(document, pieceCount), "JsonParallelParser on " + name);
+        check(JsonValidator::validateJson(document.data(), document.size()) == JsonValidator::validateJson(document.data(), document.size(), ThreadCount),
+              "JsonValidator::validateJson on " + name);
+
+        if(isValid) {
+            checkSplit(pieceCount, "JsonParallelParser on " + name);
+            checkSplit(JsonValidator::check(document.data(), document.size(), ThreadCount).regionCount, "JsonValidator::check on " + name);
+        }
+    }
+
+    /**
+     * @brief Builds a document of arrays of long strings whose chunk boundaries, where the validator cuts the
+     * document between threads, all fall inside an escape sequence
+     * @param variant Selects the escape sequence and where in it each boundary falls
+     * @return Generated document
+     */
+    std::string makeEscapedDocument(const size_t variant) {
+        static const char* const Escapes[] = {"\\\"", "\\\\", "\\u00e9", "\\\\\\\"", "\\\"\\n"};
+        const std::string text(797, 'a');
+        std::string document = "[";
+
+        for(size_t i = 0; i < 40; i++) {
+            document += i == 0 ? "[" : ",\n[";
+
+            for(size_t j = 0; j < 40; j++) {
+                document += (j == 0 ? "\"" : ",\"") + text + "\"";
+            }
+
+            document += "]";
+        }
+
+        document += "]";
+
+        while(true) {
+            bool isInside = true;
+
+            for(size_t chunk = 1; chunk < ThreadCount; chunk++) {
+                const size_t boundary = document.size() / ThreadCount * chunk;
+
+                isInside = isInside && document.find_first_not_of('a', boundary - 8) > boundary + 8;
+            }
+
+            if(isInside) {
+                break;
+            }
+
+            document.insert(0, " ");
+        }
+
+        for(size_t chunk = 1; chunk < ThreadCount; chunk++) {
+            const std::string escape = Escapes[(chunk + variant) % 5];
+            const size_t boundary = document.size() / ThreadCount * chunk;
+
+            document.replace(boundary - 1 - (chunk + variant) % escape.size(), escape.size(), escape);
+        }
+
+        return document;
+    }
+
+    /**
+     * @brief Handler collecting the records of newline-delimited JSON as text
+     */
+    class RecordCollector : public JsonLinesHandler {
+        public:
+            std::vector<std::pair<size_t, std::string>> records;  ///< Line and compact text or "error: " and message of every record
+
+            /**
+             * @brief Collects a valid record
+             * @param line Line of the record, counting from 1
+             * @param value Parsed record, nullptr when only validating
+             */
+            void visitRecord(const size_t line, JsonValue* value) override {
+                records.push_back(std::make_pair(line, value == nullptr ? std::string("valid") : JsonPrinter::print(value)));
+            }
+
+            /**
+             * @brief Collects an invalid record
+             * @param line Line of the record, counting from 1
+             * @param message The validator's message
+             */
+            void visitError(const size_t line, const std::string& message) override {
+                records.push_back(std::make_pair(line, "error: " + message));
+            }
+    };
+
+    /**
+     * @brief Compares JsonLinesReader, ordered and unordered, reading buffers and streams, against parsing
+     * every line on one thread
+     * @param random Generator to draw from
+     */
+    void compareLines(std::mt19937& random) {
+        std::string input;
+        std::vector<std::pair<size_t, std::string>> expected;
+        std::vector<std::pair<size_t, std::string>> validated;
+
+        for(size_t line = 1; line <= 20000; line++) {
+            std::string record = line % 97 == 0 ? "   " : makeRecord(random, 3);
+
+            if(line % 89 == 0) {
+                record.insert(random() % (record.size() + 1), 1, '}');
+            }
+
+            input += record + "\n";
+
+            if(record.find_first_not_of(' ') == std::string::npos) {
+                continue;
+            }
+
+            const std::string parsed = parseSerially(record);
+            const bool isValid = parsed.compare(0, 7, "error: ") != 0;
+
+            expected.push_back(std::make_pair(line, parsed));
+            validated.push_back(std::make_pair(line, isValid ? std::string("valid") : parsed));
+        }
+
+        for(int isOrdered = 0; isOrdered < 2; isOrdered++) {
+            JsonLinesReader reader(ThreadCount, isOrdered != 0);
+            RecordCollector fromBuffer;
+            RecordCollector fromStream;
+            RecordCollector validatedBuffer;
+            std::istringstream stream(input);
+
+            reader.read(input.data(), input.size(), fromBuffer);
+            reader.read(stream, fromStream);
+            reader.validate(input.data(), input.size(), validatedBuffer);
+
+            if(!isOrdered) {
+                std::sort(fromBuffer.records.begin(), fromBuffer.records.end());
+                std::sort(fromStream.records.begin(), fromStream.records.end());
+                std::sort(validatedBuffer.records.begin(), validatedBuffer.records.end());
+            }
+
+            const std::string mode = isOrdered ? " in order" : " out of order";
+
+            check(fromBuffer.records == expected, "JsonLinesReader::read of a buffer" + mode);
+            check(fromStream.records == expected, "JsonLinesReader::read of a stream" + mode);
+            check(validatedBuffer.records == validated, "JsonLinesReader::validate of a buffer" + mode);
+        }
+    }
+}
+
+/**
+ * @brief Checks that the multi-threaded parser, validator and JSON Lines reader give the same results as
+ * their single-threaded counterparts on valid and broken input
+ * @return 0 if every comparison held, 1 otherwise
+ */
+int main() {
+    std::mt19937 random(54321);
+    const std::string document = makeDocument(random);
+
+    compareDocument(document, "a valid document", true);
+
+    for(size_t i = 1; i <= 8; i++) {
+        std::string broken = document;
+        broken[random() % broken.size()] = i % 2 == 0 ? ']' : '\x01';
+        compareDocument(broken, "broken document " + std::to_string(i), false);
+    }
+
+    for(size_t variant = 0; variant < 5; variant++) {
+        const std::string escaped = makeEscapedDocument(variant);
+        std::string broken = escaped;
+
+        broken[escaped.size() / ThreadCount * 2 - 8] = '\"';
+
+        compareDocument(escaped, "a document split inside escapes " + std::to_string(variant), true);
+        compareDocument(broken, "a document split after a stray quote " + std::to_string(variant), false);
+    }
+
+    compareLines(random);
+
+    std::cout << "checked " << document.size() << " byte documents and JSON Lines input on " << ThreadCount << " threads\n";
+
+    if(failures != 0) {
+        std::cerr << failures << " comparisons failed\n";
+        return 1;
+    }
+
+    return 0;
+}